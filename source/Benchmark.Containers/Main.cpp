@@ -0,0 +1,628 @@
+#include "pch.h"
+#include "vector.h"
+#include "SmallVector.h"
+#include "SList.h"
+#include "Stack.h"
+#include "HashMap.h"
+#include "FlatHashMap.h"
+#ifdef BENCHMARK_DATUM
+#include "Datum.h"
+#endif
+
+using namespace std;
+
+namespace Benchmark
+{
+	using Clock = chrono::steady_clock;
+
+	/// <summary>
+	/// Container sizes that are measured, limited by --min-size and --max-size
+	/// </summary>
+	constexpr size_t Sizes[] = { 8, 64, 512, 4096, 32768, 262144, 1048576 };
+
+	/// <summary>
+	/// Small containers are measured in batches, so that one timed repetition always covers at least this many operations
+	/// </summary>
+	constexpr size_t MinOperations = 4096;
+
+	/// <summary>
+	/// Number of repetitions is chosen so that a measurement covers about this many operations
+	/// </summary>
+	constexpr size_t TargetOperations = 1 << 21;
+	constexpr size_t MinRepetitions = 5;
+	constexpr size_t MaxRepetitions = 51;
+
+	/// <summary>
+	/// Number of element compares one repetition of a linear lookup may cost
+	/// </summary>
+	constexpr size_t LinearLookupBudget = 1 << 18;
+
+	/// <summary>
+	/// Command line options
+	/// </summary>
+	struct Options
+	{
+		size_t mMinSize = Sizes[0];
+		size_t mMaxSize = Sizes[size(Sizes) - 1];
+		bool mJson = false;
+		string mFilter;
+	};
+
+	/// <summary>
+	/// One measured row of output. Times are nanoseconds per operation
+	/// </summary>
+	struct Result
+	{
+		const char* mFamily;
+		const char* mImplementation;
+		const char* mOperation;
+		size_t mSize;
+		size_t mOperations;
+		size_t mRepetitions;
+		double mMedian;
+		double mMin;
+		uint64_t mChecksum;
+	};
+
+#pragma region Adapters
+	/// <summary>
+	/// Get the value of a container item, maps store key-value pairs
+	/// </summary>
+	inline int ValueOf(int item) { return item; }
+	inline int ValueOf(const pair<const int, int>& item) { return item.second; }
+
+	/// <summary>
+	/// Sum values of an iterable container
+	/// </summary>
+	template <typename Container>
+	uint64_t Sum(const Container& container)
+	{
+		uint64_t sum = 0;
+		for (const auto& item : container)
+		{
+			sum += ValueOf(item);
+		}
+		return sum;
+	}
+
+	// Every adapter exposes the same static interface, so that one suite drives every implementation of a family.
+	// Sequences ignore the key when erasing and pop from their cheap end instead.
+
+	struct StdVector
+	{
+		using Container = vector<int>;
+		static constexpr const char* Family = "sequence";
+		static constexpr const char* Name = "std::vector";
+		static constexpr bool Iterable = true;
+		static constexpr bool Linear = true;
+		static void Insert(Container& container, int key) { container.push_back(key); }
+		static bool Contains(const Container& container, int key) { return find(container.begin(), container.end(), key) != container.end(); }
+		static void Erase(Container& container, int) { container.pop_back(); }
+		static uint64_t Checksum(const Container& container) { return Sum(container); }
+	};
+
+	struct EngineVector
+	{
+		using Container = GameEngine::Vector<int>;
+		static constexpr const char* Family = "sequence";
+		static constexpr const char* Name = "GameEngine::Vector";
+		static constexpr bool Iterable = true;
+		static constexpr bool Linear = true;
+		static void Insert(Container& container, int key) { container.PushBack(key); }
+		static bool Contains(const Container& container, int key) { return container.Find(key) != container.end(); }
+		static void Erase(Container& container, int) { container.PopBack(); }
+		static uint64_t Checksum(const Container& container) { return Sum(container); }
+	};
+
+	struct EngineSmallVector
+	{
+		using Container = GameEngine::SmallVector<int, 16>;
+		static constexpr const char* Family = "sequence";
+		static constexpr const char* Name = "GameEngine::SmallVector<16>";
+		static constexpr bool Iterable = true;
+		static constexpr bool Linear = true;
+		static void Insert(Container& container, int key) { container.PushBack(key); }
+		static bool Contains(const Container& container, int key) { return container.Find(key) != container.end(); }
+		static void Erase(Container& container, int) { container.PopBack(); }
+		static uint64_t Checksum(const Container& container) { return Sum(container); }
+	};
+
+	struct StdForwardList
+	{
+		using Container = forward_list<int>;
+		static constexpr const char* Family = "list";
+		static constexpr const char* Name = "std::forward_list";
+		static constexpr bool Iterable = true;
+		static constexpr bool Linear = true;
+		static void Insert(Container& container, int key) { container.push_front(key); }
+		static bool Contains(const Container& container, int key) { return find(container.begin(), container.end(), key) != container.end(); }
+		static void Erase(Container& container, int) { container.pop_front(); }
+		static uint64_t Checksum(const Container& container) { return Sum(container); }
+	};
+
+	struct EngineSList
+	{
+		using Container = GameEngine::SList<int>;
+		static constexpr const char* Family = "list";
+		static constexpr const char* Name = "GameEngine::SList";
+		static constexpr bool Iterable = true;
+		static constexpr bool Linear = true;
+		static void Insert(Container& container, int key) { container.PushFront(key); }
+		static bool Contains(const Container& container, int key) { return container.Find(key) != container.end(); }
+		static void Erase(Container& container, int) { container.PopFront(); }
+		static uint64_t Checksum(const Container& container) { return Sum(container); }
+	};
+
+	struct StdUnorderedMap
+	{
+		using Container = unordered_map<int, int>;
+		static constexpr const char* Family = "map";
+		static constexpr const char* Name = "std::unordered_map";
+		static constexpr bool Iterable = true;
+		static constexpr bool Linear = false;
+		static void Insert(Container& container, int key) { container.emplace(key, key); }
+		static bool Contains(const Container& container, int key) { return container.find(key) != container.end(); }
+		static void Erase(Container& container, int key) { container.erase(key); }
+		static uint64_t Checksum(const Container& container) { return Sum(container); }
+	};
+
+	struct EngineHashMap
+	{
+		using Container = GameEngine::HashMap<int, int>;
+		static constexpr const char* Family = "map";
+		static constexpr const char* Name = "GameEngine::HashMap";
+		static constexpr bool Iterable = true;
+		static constexpr bool Linear = false;
+		static void Insert(Container& container, int key) { container.Insert(make_pair(key, key)); }
+		static bool Contains(const Container& container, int key) { return container.Find(key) != container.end(); }
+		static void Erase(Container& container, int key) { container.Remove(key); }
+		static uint64_t Checksum(const Container& container) { return Sum(container); }
+	};
+
+	struct EngineFlatHashMap
+	{
+		using Container = GameEngine::FlatHashMap<int, int>;
+		static constexpr const char* Family = "map";
+		static constexpr const char* Name = "GameEngine::FlatHashMap";
+		static constexpr bool Iterable = true;
+		static constexpr bool Linear = false;
+		static void Insert(Container& container, int key) { container.Insert(make_pair(key, key)); }
+		static bool Contains(const Container& container, int key) { return container.Find(key) != container.end(); }
+		static void Erase(Container& container, int key) { container.Remove(key); }
+		static uint64_t Checksum(const Container& container) { return Sum(container); }
+	};
+
+	struct StdStack
+	{
+		using Container = stack<int>;
+		static constexpr const char* Family = "stack";
+		static constexpr const char* Name = "std::stack";
+		static constexpr bool Iterable = false;
+		static constexpr bool Linear = true;
+		static void Insert(Container& container, int key) { container.push(key); }
+		static void Erase(Container& container, int) { container.pop(); }
+		static uint64_t Checksum(const Container& container) { return container.empty() ? 0 : container.size() + container.top(); }
+	};
+
+	struct EngineStack
+	{
+		using Container = GameEngine::Stack<int>;
+		static constexpr const char* Family = "stack";
+		static constexpr const char* Name = "GameEngine::Stack";
+		static constexpr bool Iterable = false;
+		static constexpr bool Linear = true;
+		static void Insert(Container& container, int key) { container.Push(key); }
+		static void Erase(Container& container, int) { container.Pop(); }
+		static uint64_t Checksum(const Container& container) { return container.IsEmpty() ? 0 : container.Size() + container.Peak(); }
+	};
+#pragma endregion
+
+#pragma region Output
+	void PrintHeader(const Options& options)
+	{
+		if (!options.mJson)
+		{
+			printf("family,implementation,operation,size,operations,repetitions,median_ns,min_ns,checksum\n");
+		}
+	}
+
+	void Print(const Options& options, const Result& result)
+	{
+		const char* format = options.mJson ?
+			"{\"family\":\"%s\",\"implementation\":\"%s\",\"operation\":\"%s\",\"size\":%zu,\"operations\":%zu,\"repetitions\":%zu,\"median_ns\":%.3f,\"min_ns\":%.3f,\"checksum\":%llu}\n" :
+			"%s,%s,%s,%zu,%zu,%zu,%.3f,%.3f,%llu\n";
+		printf(format, result.mFamily, result.mImplementation, result.mOperation, result.mSize, result.mOperations, result.mRepetitions,
+			result.mMedian, result.mMin, static_cast<unsigned long long>(result.mChecksum));
+		fflush(stdout);
+	}
+#pragma endregion
+
+#pragma region Measurement
+	/// <summary>
+	/// Time the body on a fresh state from setup for several repetitions. Only the body is timed, the state is destroyed after the clock stops
+	/// </summary>
+	/// <param name="operations">Operations the body performs per repetition</param>
+	/// <param name="setup">Function that builds the state of one repetition</param>
+	/// <param name="body">Function that runs the operations on the state and returns a checksum</param>
+	/// <param name="check">Function that returns a checksum of the state after the body ran</param>
+	/// <returns>Result with times and checksum filled in</returns>
+	template <typename Setup, typename Body, typename Check>
+	Result Measure(size_t operations, Setup setup, Body body, Check check)
+	{
+		Result result = {};
+		result.mOperations = operations;
+		result.mRepetitions = clamp(TargetOperations / operations, MinRepetitions, MaxRepetitions);
+
+		vector<double> samples;
+		samples.reserve(result.mRepetitions);
+		for (size_t i = 0; i < result.mRepetitions; ++i)
+		{
+			auto state = setup();
+			const auto start = Clock::now();
+			const uint64_t checksum = body(state);
+			const auto elapsed = Clock::now() - start;
+			samples.push_back(chrono::duration<double, nano>(elapsed).count() / operations);
+			result.mChecksum = checksum + check(state);
+		}
+
+		sort(samples.begin(), samples.end());
+		result.mMedian = samples[samples.size() / 2];
+		result.mMin = samples.front();
+		return result;
+	}
+
+	/// <summary>
+	/// Make a random permutation of 0 to size-1, the same for every implementation
+	/// </summary>
+	vector<int> ShuffledKeys(size_t size, uint64_t seed)
+	{
+		vector<int> keys(size);
+		for (size_t i = 0; i < size; ++i)
+		{
+			keys[i] = static_cast<int>(i);
+		}
+		shuffle(keys.begin(), keys.end(), mt19937_64(seed));
+		return keys;
+	}
+
+	/// <summary>
+	/// Run every operation the adapter supports at given size
+	/// </summary>
+	template <typename Adapter>
+	void Run(const Options& options, size_t size)
+	{
+		using Container = typename Adapter::Container;
+		using Batch = vector<Container>;
+
+		auto enabled = [&options](const char* operation)
+		{
+			const string name = string(Adapter::Family) + "/" + Adapter::Name + "/" + operation;
+			return options.mFilter.empty() || name.find(options.mFilter) != string::npos;
+		};
+		auto report = [&options, size](const char* operation, Result result)
+		{
+			result.mFamily = Adapter::Family;
+			result.mImplementation = Adapter::Name;
+			result.mOperation = operation;
+			result.mSize = size;
+			Print(options, result);
+		};
+		auto none = [](const auto&) { return uint64_t(0); };
+
+		const vector<int> keys = ShuffledKeys(size, size);
+		const vector<int> eraseOrder = ShuffledKeys(size, ~size);
+		const size_t batchSize = max(size_t(1), MinOperations / size);
+		auto fill = [&keys]()
+		{
+			Container container;
+			for (int key : keys)
+			{
+				Adapter::Insert(container, key);
+			}
+			return container;
+		};
+		auto fillBatch = [&fill, batchSize]()
+		{
+			Batch batch;
+			batch.reserve(batchSize);
+			for (size_t i = 0; i < batchSize; ++i)
+			{
+				batch.push_back(fill());
+			}
+			return batch;
+		};
+
+		if (enabled("insert"))
+		{
+			report("insert", Measure(size * batchSize,
+				[batchSize]() { return Batch(batchSize); },
+				[&keys](Batch& batch)
+				{
+					for (Container& container : batch)
+					{
+						for (int key : keys)
+						{
+							Adapter::Insert(container, key);
+						}
+					}
+					return uint64_t(0);
+				},
+				[](const Batch& batch) { return Adapter::Checksum(batch.back()); }));
+		}
+
+		if constexpr (Adapter::Iterable)
+		{
+			const bool hit = enabled("lookup_hit");
+			const bool miss = enabled("lookup_miss");
+			const bool iterate = enabled("iterate");
+			if (hit || miss || iterate)
+			{
+				const Container container = fill();
+				const size_t probeCount = Adapter::Linear ? clamp(LinearLookupBudget / size, size_t(16), MinOperations) : clamp(size, MinOperations, size_t(1) << 16);
+				mt19937_64 random(size);
+				vector<int> hits(probeCount);
+				vector<int> misses(probeCount);
+				for (size_t i = 0; i < probeCount; ++i)
+				{
+					hits[i] = keys[random() % size];
+					misses[i] = static_cast<int>(size + random() % size);
+				}
+
+				auto lookup = [&container](const vector<int>& probes)
+				{
+					return [&container, &probes](const Container*)
+					{
+						uint64_t found = 0;
+						for (int key : probes)
+						{
+							found += Adapter::Contains(container, key);
+						}
+						return found;
+					};
+				};
+				auto shared = [&container]() { return &container; };
+
+				if (hit)
+				{
+					report("lookup_hit", Measure(probeCount, shared, lookup(hits), none));
+				}
+				if (miss)
+				{
+					report("lookup_miss", Measure(probeCount, shared, lookup(misses), none));
+				}
+				if (iterate)
+				{
+					report("iterate", Measure(size * batchSize, shared,
+						[batchSize](const Container* source)
+						{
+							// Read the container through a volatile pointer, otherwise the compiler sums it once and multiplies
+							const Container* volatile opaque = source;
+							uint64_t sum = 0;
+							for (size_t i = 0; i < batchSize; ++i)
+							{
+								sum += Sum(*opaque);
+							}
+							return sum;
+						}, none));
+				}
+			}
+		}
+
+		if (enabled("erase"))
+		{
+			report("erase", Measure(size * batchSize, fillBatch,
+				[&eraseOrder](Batch& batch)
+				{
+					for (Container& container : batch)
+					{
+						for (int key : eraseOrder)
+						{
+							Adapter::Erase(container, key);
+						}
+					}
+					return uint64_t(0);
+				},
+				[](const Batch& batch) { return Adapter::Checksum(batch.back()); }));
+		}
+
+		if (enabled("copy"))
+		{
+			const Container source = fill();
+			report("copy", Measure(size * batchSize,
+				[batchSize]()
+				{
+					Batch copies;
+					copies.reserve(batchSize);
+					return copies;
+				},
+				[&source, batchSize](Batch& copies)
+				{
+					for (size_t i = 0; i < batchSize; ++i)
+					{
+						copies.emplace_back(source);
+					}
+					return uint64_t(0);
+				},
+				[](const Batch& copies) { return Adapter::Checksum(copies.back()); }));
+		}
+	}
+
+#ifdef BENCHMARK_DATUM
+	/// <summary>
+	/// Parse vectors written exactly by Datum, the shape of a level file, one at a time with sscanf and Datum::SetFromString, and all at once with Datum::SetFromStrings
+	/// </summary>
+	void RunParse(const Options& options, size_t size)
+	{
+		using GameEngine::Datum;
+
+		auto enabled = [&options](const char* implementation)
+		{
+			const string name = string("parse/") + implementation + "/vec4";
+			return options.mFilter.empty() || name.find(options.mFilter) != string::npos;
+		};
+		auto report = [&options, size](const char* implementation, Result result)
+		{
+			result.mFamily = "parse";
+			result.mImplementation = implementation;
+			result.mOperation = "vec4";
+			result.mSize = size;
+			Print(options, result);
+		};
+		auto vectors = [size]()
+		{
+			Datum datum;
+			datum.SetType(Datum::DatumType::Vector);
+			datum.SetSize(size);
+			return datum;
+		};
+		auto checksum = [](const Datum& datum)
+		{
+			uint64_t sum = 0;
+			for (size_t i = 0; i < datum.Size(); ++i)
+			{
+				sum += static_cast<uint64_t>(datum.AsVector(i).x);
+			}
+			return sum;
+		};
+
+		Datum source = vectors();
+		vector<string> lines(size);
+		string text;
+		for (size_t i = 0; i < size; ++i)
+		{
+			const float value = static_cast<float>(i) * 0.37f;
+			source.Set(glm::vec4(value, -value, value * 0.5f, 1.f), i);
+			lines[i] = source.ToString(i, true);
+			text.append(i > 0 ? ", " : "").append(lines[i]);
+		}
+
+		if (enabled("sscanf"))
+		{
+			report("sscanf", Measure(size, vectors,
+				[&lines](Datum& datum)
+				{
+					uint64_t parsed = 0;
+					for (size_t i = 0; i < lines.size(); ++i)
+					{
+						float v[4];
+						if (sscanf(lines[i].c_str(), "vec4(%f, %f, %f, %f)", &v[0], &v[1], &v[2], &v[3]) == 4)
+						{
+							datum.Set(glm::vec4(v[0], v[1], v[2], v[3]), i);
+							++parsed;
+						}
+					}
+					return parsed;
+				}, checksum));
+		}
+		if (enabled("GameEngine::Datum::SetFromString"))
+		{
+			report("GameEngine::Datum::SetFromString", Measure(size, vectors,
+				[&lines](Datum& datum)
+				{
+					uint64_t parsed = 0;
+					for (size_t i = 0; i < lines.size(); ++i)
+					{
+						parsed += datum.SetFromString(lines[i], i);
+					}
+					return parsed;
+				}, checksum));
+		}
+		if (enabled("GameEngine::Datum::SetFromStrings"))
+		{
+			report("GameEngine::Datum::SetFromStrings", Measure(size,
+				[]()
+				{
+					Datum datum;
+					datum.SetType(Datum::DatumType::Vector);
+					return datum;
+				},
+				[&text](Datum& datum) { return uint64_t(datum.SetFromStrings(text)); }, checksum));
+		}
+	}
+#endif
+
+	/// <summary>
+	/// Run every family at every size inside the limits
+	/// </summary>
+	void RunAll(const Options& options)
+	{
+		PrintHeader(options);
+		for (size_t size : Sizes)
+		{
+			if (size < options.mMinSize || size > options.mMaxSize)
+			{
+				continue;
+			}
+
+			Run<StdVector>(options, size);
+			Run<EngineVector>(options, size);
+			Run<EngineSmallVector>(options, size);
+			Run<StdForwardList>(options, size);
+			Run<EngineSList>(options, size);
+			Run<StdUnorderedMap>(options, size);
+			Run<EngineHashMap>(options, size);
+			Run<EngineFlatHashMap>(options, size);
+			Run<StdStack>(options, size);
+			Run<EngineStack>(options, size);
+#ifdef BENCHMARK_DATUM
+			RunParse(options, size);
+#endif
+		}
+	}
+#pragma endregion
+
+	/// <summary>
+	/// Parse command line into options
+	/// </summary>
+	/// <exception cref="std::invalid_argument">Unknown argument or malformed value</exception>
+	Options Parse(int argc, const char* argv[])
+	{
+		Options options;
+		for (int i = 1; i < argc; ++i)
+		{
+			const string argument = argv[i];
+			const size_t equal = argument.find('=');
+			const string name = argument.substr(0, equal);
+			const string value = equal == string::npos ? string() : argument.substr(equal + 1);
+			if (name == "--format" && (value == "csv" || value == "json"))
+			{
+				options.mJson = value == "json";
+			}
+			else if (name == "--min-size" && !value.empty())
+			{
+				options.mMinSize = stoull(value);
+			}
+			else if (name == "--max-size" && !value.empty())
+			{
+				options.mMaxSize = stoull(value);
+			}
+			else if (name == "--filter")
+			{
+				options.mFilter = value;
+			}
+			else
+			{
+				throw invalid_argument("Unknown argument " + argument);
+			}
+		}
+		return options;
+	}
+}
+
+int main(int argc, const char* argv[])
+{
+	Benchmark::Options options;
+	try
+	{
+		options = Benchmark::Parse(argc, argv);
+	}
+	catch (const exception& e)
+	{
+		fprintf(stderr, "%s\n", e.what());
+		fprintf(stderr, "Usage: %s [--format=csv|json] [--min-size=N] [--max-size=N] [--filter=family/implementation/operation]\n", argv[0]);
+		return 1;
+	}
+
+	Benchmark::RunAll(options);
+	return 0;
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+// Standard
+#include <exception>
+#include <stdexcept>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <memory>
+#include <functional>
+#include <algorithm>
+#include <type_traits>
+#include <chrono>
+#include <random>
+#include <vector>
+#include <forward_list>
+#include <unordered_map>
+#include <stack>
+
+#ifdef BENCHMARK_DATUM
+// Datum
+#include <atomic>
+#include <mutex>
+#include <shared_mutex>
+#include <tuple>
+#include <glm/glm.hpp>
+#endif
@@ -35,6 +35,7 @@ const std::string& Action::Name() const
 void Action::SetName(const std::string& name)
 {
 	mName = name;
+	MarkAttributeChanged("Name");
 }
 
 const Vector<Attributed::Signature> Action::Signatures()
@@ -0,0 +1,146 @@
+#include "pch.h"
+#include "Arena.h"
+#include <algorithm>
+#include <cstdlib>
+#include <new>
+
+namespace GameEngine
+{
+#pragma region Arena
+	thread_local Arena* Arena::sCurrent = nullptr;
+
+	Arena::Arena(size_t chunkSize) :
+		mChunkSize(std::max(chunkSize, MaxSmallSize))
+	{
+	}
+
+	Arena::~Arena()
+	{
+		Release();
+	}
+
+	void* Arena::Allocate(size_t size)
+	{
+		const size_t rounded = std::max(size + Alignment - 1, Alignment) / Alignment * Alignment;
+		if (rounded > MaxSmallSize)
+		{
+			mLiveBytes += rounded;
+			return AllocateChunk(mLargeBlocks, rounded);
+		}
+
+		// Reuse a freed block of the same size class first
+		FreeBlock*& freeList = mFreeLists[rounded / Alignment - 1];
+		void* block = freeList;
+		if (block != nullptr)
+		{
+			freeList = freeList->mNext;
+		}
+		else
+		{
+			if (mCursor == nullptr || static_cast<size_t>(mEnd - mCursor) < rounded)
+			{
+				mCursor = AllocateChunk(mChunks, mChunkSize);
+				mEnd = mCursor + mChunkSize;
+				++mChunkCount;
+			}
+			block = mCursor;
+			mCursor += rounded;
+		}
+		mLiveBytes += rounded;
+		return block;
+	}
+
+	void Arena::Deallocate(void* block, size_t size)
+	{
+		if (block == nullptr)
+		{
+			return;
+		}
+
+		const size_t rounded = std::max(size + Alignment - 1, Alignment) / Alignment * Alignment;
+		mLiveBytes -= rounded;
+		if (rounded > MaxSmallSize)
+		{
+			Chunk* chunk = reinterpret_cast<Chunk*>(static_cast<char*>(block) - HeaderSize);
+			(chunk->mPrevious != nullptr ? chunk->mPrevious->mNext : mLargeBlocks) = chunk->mNext;
+			if (chunk->mNext != nullptr)
+			{
+				chunk->mNext->mPrevious = chunk->mPrevious;
+			}
+			free(chunk);
+		}
+		else
+		{
+			FreeBlock* freeBlock = static_cast<FreeBlock*>(block);
+			FreeBlock*& freeList = mFreeLists[rounded / Alignment - 1];
+			freeBlock->mNext = freeList;
+			freeList = freeBlock;
+		}
+	}
+
+	void Arena::Release()
+	{
+		for (Chunk* list : { mChunks, mLargeBlocks })
+		{
+			while (list != nullptr)
+			{
+				Chunk* next = list->mNext;
+				free(list);
+				list = next;
+			}
+		}
+		std::fill(std::begin(mFreeLists), std::end(mFreeLists), nullptr);
+		mChunks = nullptr;
+		mLargeBlocks = nullptr;
+		mCursor = nullptr;
+		mEnd = nullptr;
+		mLiveBytes = 0;
+		mChunkCount = 0;
+	}
+
+	size_t Arena::LiveBytes() const
+	{
+		return mLiveBytes;
+	}
+
+	size_t Arena::ChunkCount() const
+	{
+		return mChunkCount;
+	}
+
+	Arena* Arena::Current()
+	{
+		return sCurrent;
+	}
+
+	char* Arena::AllocateChunk(Chunk*& list, size_t size)
+	{
+		Chunk* chunk = static_cast<Chunk*>(malloc(HeaderSize + size));
+		if (chunk == nullptr)
+		{
+			throw std::bad_alloc();
+		}
+		chunk->mPrevious = nullptr;
+		chunk->mNext = list;
+		if (list != nullptr)
+		{
+			list->mPrevious = chunk;
+		}
+		list = chunk;
+		return reinterpret_cast<char*>(chunk) + HeaderSize;
+	}
+#pragma endregion
+
+#pragma region ArenaGuard
+	ArenaGuard::ArenaGuard(Arena* arena) :
+		mPrevious(Arena::sCurrent)
+	{
+		Arena::sCurrent = arena;
+	}
+
+	ArenaGuard::~ArenaGuard()
+	{
+		Arena::sCurrent = mPrevious;
+	}
+#pragma endregion
+}
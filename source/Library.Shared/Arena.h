@@ -0,0 +1,148 @@
+#pragma once
+
+/// \file Arena.h
+/// \brief Contains the declaration of Arena and ArenaGuard
+
+#include <cstddef>
+
+namespace GameEngine
+{
+	/// <summary>
+	/// A region allocator that carves blocks out of large chunks, so data allocated together stays close in memory.
+	/// Small freed blocks go to a free list per size class and are handed out again before a chunk is extended.
+	/// Large blocks are allocated one by one but still belong to the arena. Everything is released at once when the arena is destroyed.
+	/// An arena is not thread-safe, everything allocating from one arena must run on the same thread
+	/// </summary>
+	class Arena final
+	{
+	public:
+		/// <summary>
+		/// Alignment of every block
+		/// </summary>
+		static constexpr size_t Alignment = 16;
+
+		/// <summary>
+		/// Default size of one chunk in bytes
+		/// </summary>
+		static constexpr size_t DefaultChunkSize = 64 * 1024;
+
+		/// <summary>
+		/// Largest block carved out of chunks, larger blocks are allocated separately
+		/// </summary>
+		static constexpr size_t MaxSmallSize = 1024;
+
+		/// <summary>
+		/// Constructor, create an empty arena without any chunk
+		/// </summary>
+		/// <param name="chunkSize">Size of each chunk in bytes</param>
+		explicit Arena(size_t chunkSize = DefaultChunkSize);
+
+		Arena(const Arena&) = delete;
+		Arena& operator=(const Arena&) = delete;
+
+		/// <summary>
+		/// Destructor, release all memory. Blocks still in use become invalid
+		/// </summary>
+		~Arena();
+
+		/// <summary>
+		/// Get a block of at least given size
+		/// </summary>
+		/// <param name="size">Size of block</param>
+		/// <returns>Address of the block, aligned to Alignment</returns>
+		void* Allocate(size_t size);
+
+		/// <summary>
+		/// Return a block to the arena
+		/// </summary>
+		/// <param name="block">Address of block allocated by this arena, nullptr is ignored</param>
+		/// <param name="size">Size passed to Allocate for this block</param>
+		void Deallocate(void* block, size_t size);
+
+		/// <summary>
+		/// Release all chunks and large blocks at once. Blocks still in use become invalid
+		/// </summary>
+		void Release();
+
+		/// <summary>
+		/// Get number of bytes in blocks currently in use, rounded up to alignment
+		/// </summary>
+		/// <returns>Bytes in use</returns>
+		size_t LiveBytes() const;
+
+		/// <summary>
+		/// Get number of chunks allocated so far
+		/// </summary>
+		/// <returns>Number of chunks</returns>
+		size_t ChunkCount() const;
+
+		/// <summary>
+		/// Get the arena that scopes and datums created on this thread allocate from
+		/// </summary>
+		/// <returns>Current arena, nullptr if they allocate from the heap</returns>
+		static Arena* Current();
+
+	private:
+		/// <summary>
+		/// Header of a chunk or a large block
+		/// </summary>
+		struct Chunk
+		{
+			Chunk* mPrevious;
+			Chunk* mNext;
+		};
+
+		/// <summary>
+		/// A freed small block
+		/// </summary>
+		struct FreeBlock
+		{
+			FreeBlock* mNext;
+		};
+
+		static constexpr size_t HeaderSize = (sizeof(Chunk) + Alignment - 1) / Alignment * Alignment;
+		static constexpr size_t SizeClassCount = MaxSmallSize / Alignment;
+
+		/// <summary>
+		/// Allocate a chunk or a large block and link it to the given list
+		/// </summary>
+		static char* AllocateChunk(Chunk*& list, size_t size);
+
+		FreeBlock* mFreeLists[SizeClassCount] = {};
+		Chunk* mChunks = nullptr;
+		Chunk* mLargeBlocks = nullptr;
+		char* mCursor = nullptr;
+		char* mEnd = nullptr;
+		size_t mChunkSize;
+		size_t mChunkCount = 0;
+		size_t mLiveBytes = 0;
+
+		friend class ArenaGuard;
+		static thread_local Arena* sCurrent;
+	};
+
+	/// <summary>
+	/// Make an arena current on this thread for the lifetime of the guard, then restore the previous one.
+	/// Scopes created with new and datums constructed while the guard is alive allocate from the arena
+	/// </summary>
+	class ArenaGuard final
+	{
+	public:
+		/// <summary>
+		/// Make given arena current
+		/// </summary>
+		/// <param name="arena">The arena, nullptr makes the heap current</param>
+		explicit ArenaGuard(Arena* arena);
+
+		ArenaGuard(const ArenaGuard&) = delete;
+		ArenaGuard& operator=(const ArenaGuard&) = delete;
+
+		/// <summary>
+		/// Restore the arena that was current before
+		/// </summary>
+		~ArenaGuard();
+
+	private:
+		Arena* mPrevious;
+	};
+}
@@ -0,0 +1,263 @@
+#include "pch.h"
+#include "ArrayMath.h"
+
+#if defined(__AVX__) || defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define ARRAY_MATH_SSE2
+#include <immintrin.h>
+#endif
+
+// 32-bit integer multiply needs SSE4.1, which every AVX capable CPU has
+#if defined(ARRAY_MATH_SSE2) && (defined(__AVX__) || defined(__SSE4_1__))
+#define ARRAY_MATH_SSE41
+#endif
+
+namespace GameEngine
+{
+	namespace
+	{
+		using Operation = ArrayMath::Operation;
+		using Broadcast = ArrayMath::Broadcast;
+
+		template <Operation Op, typename T>
+		inline T Apply(T left, T right)
+		{
+			if constexpr (Op == Operation::Add)
+			{
+				return left + right;
+			}
+			else if constexpr (Op == Operation::Subtract)
+			{
+				return left - right;
+			}
+			else if constexpr (Op == Operation::Multiply)
+			{
+				return left * right;
+			}
+			else if constexpr (Op == Operation::Divide)
+			{
+				return left / right;
+			}
+			else
+			{
+				return left % right;
+			}
+		}
+
+#ifdef ARRAY_MATH_SSE2
+		template <Operation Op>
+		inline __m128 Apply(__m128 left, __m128 right)
+		{
+			if constexpr (Op == Operation::Add)
+			{
+				return _mm_add_ps(left, right);
+			}
+			else if constexpr (Op == Operation::Subtract)
+			{
+				return _mm_sub_ps(left, right);
+			}
+			else if constexpr (Op == Operation::Multiply)
+			{
+				return _mm_mul_ps(left, right);
+			}
+			else
+			{
+				return _mm_div_ps(left, right);
+			}
+		}
+
+		template <Operation Op>
+		inline __m128i Apply(__m128i left, __m128i right)
+		{
+			if constexpr (Op == Operation::Add)
+			{
+				return _mm_add_epi32(left, right);
+			}
+			else if constexpr (Op == Operation::Subtract)
+			{
+				return _mm_sub_epi32(left, right);
+			}
+			else
+			{
+#ifdef ARRAY_MATH_SSE41
+				return _mm_mullo_epi32(left, right);
+#else
+				return left;
+#endif
+			}
+		}
+#endif
+
+#ifdef __AVX__
+		template <Operation Op>
+		inline __m256 Apply(__m256 left, __m256 right)
+		{
+			if constexpr (Op == Operation::Add)
+			{
+				return _mm256_add_ps(left, right);
+			}
+			else if constexpr (Op == Operation::Subtract)
+			{
+				return _mm256_sub_ps(left, right);
+			}
+			else if constexpr (Op == Operation::Multiply)
+			{
+				return _mm256_mul_ps(left, right);
+			}
+			else
+			{
+				return _mm256_div_ps(left, right);
+			}
+		}
+#endif
+
+#ifdef __AVX2__
+		template <Operation Op>
+		inline __m256i Apply(__m256i left, __m256i right)
+		{
+			if constexpr (Op == Operation::Add)
+			{
+				return _mm256_add_epi32(left, right);
+			}
+			else if constexpr (Op == Operation::Subtract)
+			{
+				return _mm256_sub_epi32(left, right);
+			}
+			else
+			{
+				return _mm256_mullo_epi32(left, right);
+			}
+		}
+#endif
+
+		template <Operation Op, Broadcast B>
+		void Kernel(const float* left, const float* right, float* destination, size_t count)
+		{
+			size_t i = 0;
+#ifdef __AVX__
+			const __m256 leftWide = B == Broadcast::Left ? _mm256_broadcast_ps(reinterpret_cast<const __m128*>(left)) : __m256();
+			const __m256 rightWide = B == Broadcast::Right ? _mm256_broadcast_ps(reinterpret_cast<const __m128*>(right)) : __m256();
+			for (; i + 8 <= count; i += 8)
+			{
+				const __m256 a = B == Broadcast::Left ? leftWide : _mm256_loadu_ps(left + i);
+				const __m256 b = B == Broadcast::Right ? rightWide : _mm256_loadu_ps(right + i);
+				_mm256_storeu_ps(destination + i, Apply<Op>(a, b));
+			}
+#endif
+#ifdef ARRAY_MATH_SSE2
+			const __m128 leftPattern = B == Broadcast::Left ? _mm_loadu_ps(left) : _mm_setzero_ps();
+			const __m128 rightPattern = B == Broadcast::Right ? _mm_loadu_ps(right) : _mm_setzero_ps();
+			for (; i + 4 <= count; i += 4)
+			{
+				const __m128 a = B == Broadcast::Left ? leftPattern : _mm_loadu_ps(left + i);
+				const __m128 b = B == Broadcast::Right ? rightPattern : _mm_loadu_ps(right + i);
+				_mm_storeu_ps(destination + i, Apply<Op>(a, b));
+			}
+#endif
+			// Blocks start at multiples of 4, so element i always pairs with component i % 4 of a pattern
+			for (; i < count; ++i)
+			{
+				destination[i] = Apply<Op>(B == Broadcast::Left ? left[i % 4] : left[i], B == Broadcast::Right ? right[i % 4] : right[i]);
+			}
+		}
+
+		template <Operation Op, Broadcast B>
+		void Kernel(const std::int32_t* left, const std::int32_t* right, std::int32_t* destination, size_t count)
+		{
+			size_t i = 0;
+#ifdef __AVX2__
+			if constexpr (Op == Operation::Add || Op == Operation::Subtract || Op == Operation::Multiply)
+			{
+				const __m256i leftWide = B == Broadcast::Left ? _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(left))) : __m256i();
+				const __m256i rightWide = B == Broadcast::Right ? _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(right))) : __m256i();
+				for (; i + 8 <= count; i += 8)
+				{
+					const __m256i a = B == Broadcast::Left ? leftWide : _mm256_loadu_si256(reinterpret_cast<const __m256i*>(left + i));
+					const __m256i b = B == Broadcast::Right ? rightWide : _mm256_loadu_si256(reinterpret_cast<const __m256i*>(right + i));
+					_mm256_storeu_si256(reinterpret_cast<__m256i*>(destination + i), Apply<Op>(a, b));
+				}
+			}
+#endif
+#ifdef ARRAY_MATH_SSE2
+#ifdef ARRAY_MATH_SSE41
+			if constexpr (Op == Operation::Add || Op == Operation::Subtract || Op == Operation::Multiply)
+#else
+			if constexpr (Op == Operation::Add || Op == Operation::Subtract)
+#endif
+			{
+				const __m128i leftPattern = B == Broadcast::Left ? _mm_loadu_si128(reinterpret_cast<const __m128i*>(left)) : _mm_setzero_si128();
+				const __m128i rightPattern = B == Broadcast::Right ? _mm_loadu_si128(reinterpret_cast<const __m128i*>(right)) : _mm_setzero_si128();
+				for (; i + 4 <= count; i += 4)
+				{
+					const __m128i a = B == Broadcast::Left ? leftPattern : _mm_loadu_si128(reinterpret_cast<const __m128i*>(left + i));
+					const __m128i b = B == Broadcast::Right ? rightPattern : _mm_loadu_si128(reinterpret_cast<const __m128i*>(right + i));
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(destination + i), Apply<Op>(a, b));
+				}
+			}
+#endif
+			for (; i < count; ++i)
+			{
+				destination[i] = Apply<Op>(B == Broadcast::Left ? left[i % 4] : left[i], B == Broadcast::Right ? right[i % 4] : right[i]);
+			}
+		}
+
+		template <Operation Op, typename T>
+		void Dispatch(const T* left, const T* right, T* destination, size_t count, Broadcast broadcast)
+		{
+			switch (broadcast)
+			{
+			case Broadcast::Left:
+				Kernel<Op, Broadcast::Left>(left, right, destination, count);
+				break;
+			case Broadcast::Right:
+				Kernel<Op, Broadcast::Right>(left, right, destination, count);
+				break;
+			default:
+				Kernel<Op, Broadcast::None>(left, right, destination, count);
+				break;
+			}
+		}
+	}
+
+	void ArrayMath::Compute(Operation operation, const float* left, const float* right, float* destination, size_t count, Broadcast broadcast)
+	{
+		switch (operation)
+		{
+		case Operation::Add:
+			Dispatch<Operation::Add>(left, right, destination, count, broadcast);
+			break;
+		case Operation::Subtract:
+			Dispatch<Operation::Subtract>(left, right, destination, count, broadcast);
+			break;
+		case Operation::Multiply:
+			Dispatch<Operation::Multiply>(left, right, destination, count, broadcast);
+			break;
+		case Operation::Divide:
+			Dispatch<Operation::Divide>(left, right, destination, count, broadcast);
+			break;
+		default:
+			throw std::exception("Modulus is not supported for float arrays");
+		}
+	}
+
+	void ArrayMath::Compute(Operation operation, const std::int32_t* left, const std::int32_t* right, std::int32_t* destination, size_t count, Broadcast broadcast)
+	{
+		switch (operation)
+		{
+		case Operation::Add:
+			Dispatch<Operation::Add>(left, right, destination, count, broadcast);
+			break;
+		case Operation::Subtract:
+			Dispatch<Operation::Subtract>(left, right, destination, count, broadcast);
+			break;
+		case Operation::Multiply:
+			Dispatch<Operation::Multiply>(left, right, destination, count, broadcast);
+			break;
+		case Operation::Divide:
+			Dispatch<Operation::Divide>(left, right, destination, count, broadcast);
+			break;
+		default:
+			Dispatch<Operation::Modulus>(left, right, destination, count, broadcast);
+			break;
+		}
+	}
+}
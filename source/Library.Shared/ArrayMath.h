@@ -0,0 +1,67 @@
+#pragma once
+
+/// \file ArrayMath.h
+/// \brief Contains the declaration of ArrayMath
+
+#include <cstddef>
+#include <cstdint>
+
+namespace GameEngine
+{
+	/// <summary>
+	/// Element-wise arithmetic kernels over plain arrays of int32_t and float, vectorized with SSE2, or AVX when the build enables it.
+	/// One operand can be broadcast, it then points to a pattern of 4 values repeated over all elements,
+	/// which covers both a single scalar (4 copies) and a single vec4 applied to an array of vec4 components.
+	/// The destination may be the same array as a non-broadcast operand
+	/// </summary>
+	class ArrayMath final
+	{
+	public:
+		/// <summary>
+		/// Supported operations
+		/// </summary>
+		enum class Operation
+		{
+			Add,
+			Subtract,
+			Multiply,
+			Divide,
+			Modulus
+		};
+
+		/// <summary>
+		/// Which operand is a repeated pattern of 4 values rather than one value per element
+		/// </summary>
+		enum class Broadcast
+		{
+			None,
+			Left,
+			Right
+		};
+
+		ArrayMath() = delete;
+
+		/// <summary>
+		/// Compute destination[i] = left[i] op right[i] for float arrays
+		/// </summary>
+		/// <param name="operation">The operation, modulus is not supported for float</param>
+		/// <param name="left">Left operand</param>
+		/// <param name="right">Right operand</param>
+		/// <param name="destination">Where to write the result</param>
+		/// <param name="count">Number of elements</param>
+		/// <param name="broadcast">Which operand, if any, is a pattern of 4 values</param>
+		/// <exception cref="std::exception">Operation is modulus</exception>
+		static void Compute(Operation operation, const float* left, const float* right, float* destination, size_t count, Broadcast broadcast = Broadcast::None);
+
+		/// <summary>
+		/// Compute destination[i] = left[i] op right[i] for int32_t arrays. Division and modulus are never vectorized
+		/// </summary>
+		/// <param name="operation">The operation</param>
+		/// <param name="left">Left operand</param>
+		/// <param name="right">Right operand</param>
+		/// <param name="destination">Where to write the result</param>
+		/// <param name="count">Number of elements</param>
+		/// <param name="broadcast">Which operand, if any, is a pattern of 4 values</param>
+		static void Compute(Operation operation, const std::int32_t* left, const std::int32_t* right, std::int32_t* destination, size_t count, Broadcast broadcast = Broadcast::None);
+	};
+}
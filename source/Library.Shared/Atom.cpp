@@ -0,0 +1,242 @@
+#include "pch.h"
+#include "Atom.h"
+#include <cstring>
+#include <mutex>
+
+namespace GameEngine
+{
+	/// <summary>
+	/// Global table of atom entries, a chained hash table guarded by a mutex.
+	/// Buckets start in an array inside the table and only move to the heap while there are many atoms,
+	/// so once temporary atoms are gone the table holds no heap memory besides the live entries
+	/// </summary>
+	class AtomTable final
+	{
+	public:
+		/// <summary>
+		/// Get the table, which is created on first use so atoms can be created during static initialization
+		/// </summary>
+		/// <returns>The global table</returns>
+		static AtomTable& Instance();
+
+		AtomTable(const AtomTable&) = delete;
+		AtomTable& operator=(const AtomTable&) = delete;
+
+		/// <summary>
+		/// Find or create the entry with given text
+		/// </summary>
+		/// <param name="name">Text, not empty</param>
+		/// <returns>The entry, with a reference counted for the caller</returns>
+		Atom::Entry* Intern(std::string_view name);
+
+		/// <summary>
+		/// Find the entry with given text
+		/// </summary>
+		/// <param name="name">Text</param>
+		/// <returns>The entry with a reference counted for the caller, nullptr if the text isn't interned</returns>
+		Atom::Entry* Find(std::string_view name);
+
+		/// <summary>
+		/// Drop a reference that may be the last one, and remove the entry if it was
+		/// </summary>
+		/// <param name="entry">The entry</param>
+		void Release(Atom::Entry* entry);
+
+		/// <summary>
+		/// Get number of entries
+		/// </summary>
+		/// <returns>Number of entries</returns>
+		size_t Count();
+
+	private:
+		AtomTable() = default;
+		~AtomTable() = default;
+
+		/// <summary>
+		/// Find the entry with given text in its bucket. Caller holds the mutex
+		/// </summary>
+		Atom::Entry* Lookup(std::string_view name, size_t hash) const;
+
+		/// <summary>
+		/// Move all entries to a bucket array of given size, the inline array if the size is InitialBucketCount. Caller holds the mutex
+		/// </summary>
+		void Rehash(size_t bucketCount);
+
+		static constexpr size_t InitialBucketCount = 1024;
+		Atom::Entry* mInitialBuckets[InitialBucketCount] = {};
+		Atom::Entry** mBuckets = mInitialBuckets;
+		size_t mBucketCount = InitialBucketCount;
+		size_t mCount = 0;
+		std::mutex mMutex;
+	};
+
+#pragma region AtomTable
+	AtomTable& AtomTable::Instance()
+	{
+		static AtomTable table;
+		return table;
+	}
+
+	Atom::Entry* AtomTable::Intern(std::string_view name)
+	{
+		const size_t hash = DefaultHash<std::string>()(name);
+		std::lock_guard<std::mutex> lock(mMutex);
+		Atom::Entry* entry = Lookup(name, hash);
+		if (entry != nullptr)
+		{
+			entry->mReferenceCount.fetch_add(1, std::memory_order_relaxed);
+			return entry;
+		}
+
+		entry = new Atom::Entry(name, hash);
+		Atom::Entry*& bucket = mBuckets[hash & (mBucketCount - 1)];
+		entry->mNext = bucket;
+		bucket = entry;
+		if (++mCount > mBucketCount * 2)
+		{
+			Rehash(mBucketCount * 4);
+		}
+		return entry;
+	}
+
+	Atom::Entry* AtomTable::Find(std::string_view name)
+	{
+		const size_t hash = DefaultHash<std::string>()(name);
+		std::lock_guard<std::mutex> lock(mMutex);
+		Atom::Entry* entry = Lookup(name, hash);
+		if (entry != nullptr)
+		{
+			entry->mReferenceCount.fetch_add(1, std::memory_order_relaxed);
+		}
+		return entry;
+	}
+
+	void AtomTable::Release(Atom::Entry* entry)
+	{
+		// The count only drops to 0 under the mutex, so a concurrent Intern either sees the entry alive or doesn't find it at all
+		std::lock_guard<std::mutex> lock(mMutex);
+		if (entry->mReferenceCount.fetch_sub(1, std::memory_order_acq_rel) != 1)
+		{
+			return;
+		}
+
+		Atom::Entry** link = &mBuckets[entry->mHash & (mBucketCount - 1)];
+		while (*link != entry)
+		{
+			link = &(*link)->mNext;
+		}
+		*link = entry->mNext;
+		delete entry;
+
+		if (--mCount <= InitialBucketCount && mBuckets != mInitialBuckets)
+		{
+			Rehash(InitialBucketCount);
+		}
+	}
+
+	size_t AtomTable::Count()
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+		return mCount;
+	}
+
+	Atom::Entry* AtomTable::Lookup(std::string_view name, size_t hash) const
+	{
+		for (Atom::Entry* entry = mBuckets[hash & (mBucketCount - 1)]; entry != nullptr; entry = entry->mNext)
+		{
+			if (entry->mHash == hash && entry->mName == name)
+			{
+				return entry;
+			}
+		}
+		return nullptr;
+	}
+
+	void AtomTable::Rehash(size_t bucketCount)
+	{
+		Atom::Entry** oldBuckets = mBuckets;
+		const size_t oldBucketCount = mBucketCount;
+
+		if (bucketCount == InitialBucketCount)
+		{
+			mBuckets = mInitialBuckets;
+			memset(mInitialBuckets, 0, sizeof(mInitialBuckets));
+		}
+		else
+		{
+			mBuckets = new Atom::Entry*[bucketCount]();
+		}
+		mBucketCount = bucketCount;
+
+		for (size_t i = 0; i < oldBucketCount; ++i)
+		{
+			Atom::Entry* entry = oldBuckets[i];
+			while (entry != nullptr)
+			{
+				Atom::Entry* next = entry->mNext;
+				Atom::Entry*& bucket = mBuckets[entry->mHash & (mBucketCount - 1)];
+				entry->mNext = bucket;
+				bucket = entry;
+				entry = next;
+			}
+		}
+
+		if (oldBuckets != mInitialBuckets)
+		{
+			delete[] oldBuckets;
+		}
+	}
+#pragma endregion
+
+#pragma region Atom
+	Atom::Entry::Entry(std::string_view name, size_t hash) :
+		mName(name), mHash(hash)
+	{
+	}
+
+	Atom::Atom(std::string_view name) :
+		mEntry(name.empty() ? nullptr : AtomTable::Instance().Intern(name))
+	{
+	}
+
+	Atom::Atom(Entry* entry) :
+		mEntry(entry)
+	{
+	}
+
+	const std::string& Atom::Name() const
+	{
+		static const std::string empty;
+		return mEntry != nullptr ? mEntry->mName : empty;
+	}
+
+	Atom Atom::Find(std::string_view name)
+	{
+		return Atom(name.empty() ? nullptr : AtomTable::Instance().Find(name));
+	}
+
+	size_t Atom::Count()
+	{
+		return AtomTable::Instance().Count();
+	}
+
+	void Atom::Release()
+	{
+		if (mEntry != nullptr)
+		{
+			// Dropping a reference that isn't the last one needs no lock
+			size_t count = mEntry->mReferenceCount.load(std::memory_order_relaxed);
+			while (count > 1)
+			{
+				if (mEntry->mReferenceCount.compare_exchange_weak(count, count - 1, std::memory_order_acq_rel))
+				{
+					mEntry = nullptr;
+					return;
+				}
+			}
+			AtomTable::Instance().Release(mEntry);
+			mEntry = nullptr;
+		}
+	}
+#pragma endregion
+}
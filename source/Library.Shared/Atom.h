@@ -0,0 +1,173 @@
+#pragma once
+
+/// \file Atom.h
+/// \brief Contains the declaration of Atom
+
+#include <atomic>
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include "DefaultHashFunction.h"
+
+namespace GameEngine
+{
+	/// <summary>
+	/// An interned string. All atoms with the same text share one entry in a global table, which stores the text and its hash once.
+	/// Copying an atom copies a pointer, comparing two atoms compares pointers, and the hash is never recomputed.
+	/// Entries are reference counted and leave the table when the last atom referring to them is destroyed. The table is thread safe.
+	/// </summary>
+	class Atom final
+	{
+	public:
+		/// <summary>
+		/// Default constructor, create an empty atom
+		/// </summary>
+		Atom() = default;
+
+		/// <summary>
+		/// Intern given text, or refer to the existing entry if the text is already interned
+		/// </summary>
+		/// <param name="name">Text of the atom, empty text creates an empty atom</param>
+		explicit Atom(std::string_view name);
+
+		/// <summary>
+		/// Copy constructor, refer to the same entry
+		/// </summary>
+		/// <param name="other">The other atom to copy from</param>
+		Atom(const Atom& other);
+
+		/// <summary>
+		/// Move constructor, take over the entry of the other atom and leave it empty
+		/// </summary>
+		/// <param name="other">The other atom to move from</param>
+		Atom(Atom&& other) noexcept;
+
+		/// <summary>
+		/// Copy assignment, refer to the same entry
+		/// </summary>
+		/// <param name="other">The other atom to copy from</param>
+		/// <returns>This atom after copying</returns>
+		Atom& operator=(const Atom& other);
+
+		/// <summary>
+		/// Move assignment, take over the entry of the other atom and leave it empty
+		/// </summary>
+		/// <param name="other">The other atom to move from</param>
+		/// <returns>This atom after moving</returns>
+		Atom& operator=(Atom&& other) noexcept;
+
+		/// <summary>
+		/// Destructor, release the entry
+		/// </summary>
+		~Atom();
+
+		/// <summary>
+		/// Compare two atoms, which only compares the entries they refer to
+		/// </summary>
+		/// <param name="other">The other atom</param>
+		/// <returns>True if both atoms have the same text</returns>
+		bool operator==(const Atom& other) const;
+
+		/// <summary>
+		/// Compare two atoms, which only compares the entries they refer to
+		/// </summary>
+		/// <param name="other">The other atom</param>
+		/// <returns>True if the atoms have different text</returns>
+		bool operator!=(const Atom& other) const;
+
+		/// <summary>
+		/// Get the text of the atom
+		/// </summary>
+		/// <returns>Text of the atom, empty string for an empty atom</returns>
+		const std::string& Name() const;
+
+		/// <summary>
+		/// Get the hash of the text, equal to DefaultHash&lt;std::string&gt; of the same text
+		/// </summary>
+		/// <returns>Hash of the text</returns>
+		size_t Hash() const;
+
+		/// <summary>
+		/// Check if the atom has no text
+		/// </summary>
+		/// <returns>True if the atom is empty</returns>
+		bool IsEmpty() const;
+
+		/// <summary>
+		/// Find the atom of given text without interning it
+		/// </summary>
+		/// <param name="name">Text to search</param>
+		/// <returns>The atom with given text, or an empty atom if the text isn't interned</returns>
+		static Atom Find(std::string_view name);
+
+		/// <summary>
+		/// Get number of interned texts
+		/// </summary>
+		/// <returns>Number of entries in the atom table</returns>
+		static size_t Count();
+
+	private:
+		/// <summary>
+		/// One interned text. Chained into its bucket of the atom table
+		/// </summary>
+		struct Entry final
+		{
+			Entry(std::string_view name, size_t hash);
+
+			std::string mName;
+			size_t mHash;
+			std::atomic<size_t> mReferenceCount = 1;
+			Entry* mNext = nullptr;
+		};
+
+		/// <summary>
+		/// Adopt an entry whose reference is already counted
+		/// </summary>
+		/// <param name="entry">The entry</param>
+		explicit Atom(Entry* entry);
+
+		/// <summary>
+		/// Add a reference to current entry
+		/// </summary>
+		void Acquire();
+
+		/// <summary>
+		/// Drop the reference to current entry, remove it from the table if it was the last one
+		/// </summary>
+		void Release();
+
+		/// <summary>
+		/// The entry this atom refers to, nullptr for an empty atom
+		/// </summary>
+		Entry* mEntry = nullptr;
+
+		friend class AtomTable;
+	};
+
+	/// <summary>
+	/// Specialization of DefaultHash for Atom, returns the hash stored in the atom.
+	/// Transparent, std::string_view and string literals hash to the same value as the atom with the same text
+	/// </summary>
+	template<>
+	struct DefaultHash<Atom>
+	{
+		using is_transparent = void;
+		size_t operator()(const Atom& key) const;
+		size_t operator()(std::string_view key) const;
+	};
+
+	/// <summary>
+	/// Specialization of DefaultKeyEquality for Atom, two atoms compare by pointer.
+	/// Transparent, an atom can be compared with std::string_view by text
+	/// </summary>
+	template<>
+	struct DefaultKeyEquality<Atom>
+	{
+		using is_transparent = void;
+		bool operator()(const Atom& one, const Atom& two) const;
+		bool operator()(const Atom& one, std::string_view two) const;
+		bool operator()(std::string_view one, const Atom& two) const;
+	};
+}
+
+#include "Atom.inl"
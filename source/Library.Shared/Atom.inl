@@ -0,0 +1,100 @@
+#pragma once
+
+namespace GameEngine
+{
+#pragma region Atom
+	inline Atom::Atom(const Atom& other) :
+		mEntry(other.mEntry)
+	{
+		Acquire();
+	}
+
+	inline Atom::Atom(Atom&& other) noexcept :
+		mEntry(other.mEntry)
+	{
+		other.mEntry = nullptr;
+	}
+
+	inline Atom& Atom::operator=(const Atom& other)
+	{
+		if (mEntry != other.mEntry)
+		{
+			Release();
+			mEntry = other.mEntry;
+			Acquire();
+		}
+		return *this;
+	}
+
+	inline Atom& Atom::operator=(Atom&& other) noexcept
+	{
+		if (this != &other)
+		{
+			Release();
+			mEntry = other.mEntry;
+			other.mEntry = nullptr;
+		}
+		return *this;
+	}
+
+	inline Atom::~Atom()
+	{
+		Release();
+	}
+
+	inline bool Atom::operator==(const Atom& other) const
+	{
+		return mEntry == other.mEntry;
+	}
+
+	inline bool Atom::operator!=(const Atom& other) const
+	{
+		return mEntry != other.mEntry;
+	}
+
+	inline size_t Atom::Hash() const
+	{
+		return mEntry != nullptr ? mEntry->mHash : DefaultHash<std::string>()(std::string_view());
+	}
+
+	inline bool Atom::IsEmpty() const
+	{
+		return mEntry == nullptr;
+	}
+
+	inline void Atom::Acquire()
+	{
+		if (mEntry != nullptr)
+		{
+			mEntry->mReferenceCount.fetch_add(1, std::memory_order_relaxed);
+		}
+	}
+#pragma endregion
+
+#pragma region Functors
+	inline size_t DefaultHash<Atom>::operator()(const Atom& key) const
+	{
+		return key.Hash();
+	}
+
+	inline size_t DefaultHash<Atom>::operator()(std::string_view key) const
+	{
+		return DefaultHash<std::string>()(key);
+	}
+
+	inline bool DefaultKeyEquality<Atom>::operator()(const Atom& one, const Atom& two) const
+	{
+		return one == two;
+	}
+
+	inline bool DefaultKeyEquality<Atom>::operator()(const Atom& one, std::string_view two) const
+	{
+		return one.Name() == two;
+	}
+
+	inline bool DefaultKeyEquality<Atom>::operator()(std::string_view one, const Atom& two) const
+	{
+		return one == two.Name();
+	}
+#pragma endregion
+}
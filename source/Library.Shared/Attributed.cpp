@@ -51,17 +51,17 @@ namespace GameEngine
 		{
 			return true;
 		}
-		else if (mTable.Size() == other.mTable.Size())
+		else if (mTable.Size() == other.mTable.Size() && !HashesDiffer(other))
 		{
 			// Walk through each datum in this table and find a equal one in the other
 			bool equal = true;
 			for (const auto& pair : mTable)
 			{
-				auto it = other.mTable.Find(pair.first);
-				if (it->first == "this"s)  // Don't compare this, otherwise will have infinite recursion
+				if (pair.first == THIS_KEY)  // Don't compare this, otherwise will have infinite recursion
 				{
 					continue;
 				}
+				auto it = other.mTable.Find(pair.first);
 				if (it == other.mTable.end() || pair.second != it->second)
 				{
 					equal = false;
@@ -81,14 +81,14 @@ namespace GameEngine
 		return !operator==(other);
 	}
 
-	bool Attributed::IsAttribute(const std::string& name) const
+	bool Attributed::IsAttribute(std::string_view name) const
 	{
 		return Find(name) != nullptr;
 	}
 
-	bool Attributed::IsPrescribedAttribute(const std::string& name) const
+	bool Attributed::IsPrescribedAttribute(std::string_view name) const
 	{
-		bool isPrescribed = name == "this"s;
+		bool isPrescribed = name == "this"sv;
 		if (!isPrescribed)
 		{
 			const auto signatureList = AttributedTypeManager::GetSignature(TypeIdInstance());
@@ -96,7 +96,7 @@ namespace GameEngine
 			{
 				for (const auto& signature : *signatureList)
 				{
-					if (signature.mName == name)
+					if (signature.mName.Name() == name)
 					{
 						assert(IsAttribute(name));
 						isPrescribed = true;
@@ -109,12 +109,12 @@ namespace GameEngine
 		return isPrescribed;
 	}
 
-	bool Attributed::IsAuxiliaryAttribute(const std::string& name) const
+	bool Attributed::IsAuxiliaryAttribute(std::string_view name) const
 	{
 		return IsAttribute(name) && !IsPrescribedAttribute(name);
 	}
 
-	Datum& Attributed::AppendAuxiliaryAttribute(const std::string& name)
+	Datum& Attributed::AppendAuxiliaryAttribute(std::string_view name)
 	{
 		if (IsPrescribedAttribute(name))
 		{
@@ -167,16 +167,24 @@ namespace GameEngine
 		return PromoteToConst(const_cast<Attributed*>(this)->AuxiliaryAttributes());
 	}
 
-	void Attributed::RemoveAuxiliaryAttribute(const std::string& key)
+	void Attributed::RemoveAuxiliaryAttribute(std::string_view key)
 	{
 		if (IsAuxiliaryAttribute(key))
 		{
 			auto it = mTable.Find(key);
 			mDatumPointers.Remove(mDatumPointers.Find(&*it));
 			mTable.Remove(it);
+			MarkEntriesRemoved();
 		}
 	}
 
+	void Attributed::MarkAttributeChanged(std::string_view name)
+	{
+		Datum* datum = Find(name);
+		assert(datum != nullptr && datum->mInOwner);
+		datum->MarkChanged();
+	}
+
 	void Attributed::Clear()
 	{
 		Scope::Clear();
@@ -190,8 +198,17 @@ namespace GameEngine
 
 	void Attributed::Populate(IdType type)
 	{
+		// Copy the whole prebuilt table at once, then point "this" and external storage to this object
+		const auto prototype = AttributedTypeManager::GetPrototype(type);
+		if (prototype != nullptr)
+		{
+			Scope::operator=(*prototype);
+			RedirectStorage(type);
+			return;
+		}
+
 		// Append "this"
-		(*this)["this"] = this;
+		(*this)[THIS_KEY] = this;
 
 		// Populate other prescribed attributes
 		const auto signatureList = AttributedTypeManager::GetSignature(type);
@@ -207,6 +224,7 @@ namespace GameEngine
 				{
 					assert(signature.mType != Datum::DatumType::Table);     // External storage shouldn't have nested scope
 					datum.SetStorage(reinterpret_cast<uint8_t*>(this) + signature.mOffset, signature.mSize);
+					datum.mInOwner = true;
 				}
 				else                                                        // Internal storage
 				{
@@ -214,7 +232,7 @@ namespace GameEngine
 					{
 						for (size_t i = 0; i < signature.mSize; ++i)
 						{
-							AppendScope(signature.mName);
+							AppendScope(signature.mName.Name());
 						}
 					}
 					else
@@ -228,7 +246,7 @@ namespace GameEngine
 
 	void Attributed::RedirectStorage(IdType type)
 	{
-		(*this)["this"] = this;
+		(*this)[THIS_KEY] = this;
 		const auto signatureList = AttributedTypeManager::GetSignature(type);
 		if (signatureList != nullptr)
 		{
@@ -236,7 +254,9 @@ namespace GameEngine
 			{
 				if (signature.mOffset > 0)  // Only redirect external storage
 				{
-					Find(signature.mName)->SetStorage(reinterpret_cast<uint8_t*>(this) + signature.mOffset, signature.mSize);
+					Datum& datum = *Find(signature.mName);
+					datum.SetStorage(reinterpret_cast<uint8_t*>(this) + signature.mOffset, signature.mSize);
+					datum.mInOwner = true;
 				}
 			}
 		}
@@ -252,12 +272,40 @@ namespace GameEngine
 		return result;
 	}
 
-	Attributed::Signature::Signature(const std::string& name, Datum::DatumType type, size_t size, size_t offset) :
+	shared_ptr<const Scope> Attributed::BuildPrototype(const Vector<Signature>& signatures)
+	{
+		auto prototype = make_shared<Scope>(signatures.Size() + 1);
+		prototype->Append(THIS_KEY).first.SetType(Datum::DatumType::Pointer);
+		for (const auto& signature : signatures)
+		{
+			assert(prototype->Find(signature.mName) == nullptr);           // Should never have duplicated names
+			assert(signature.mType != Datum::DatumType::Unknown);         // User should provide valid type
+			Datum& datum = prototype->Append(signature.mName).first;
+			datum.SetType(signature.mType);
+			if (signature.mOffset == 0)                                    // Internal storage
+			{
+				if (signature.mType == Datum::DatumType::Table)
+				{
+					for (size_t i = 0; i < signature.mSize; ++i)
+					{
+						prototype->AppendScope(signature.mName.Name());
+					}
+				}
+				else
+				{
+					datum.SetSize(signature.mSize);
+				}
+			}
+		}
+		return prototype;
+	}
+
+	Attributed::Signature::Signature(std::string_view name, Datum::DatumType type, size_t size, size_t offset) :
 		mName(name), mType(type), mSize(size), mOffset(offset)
 	{}
 
 #pragma region Manager
-	HashMap<RTTI::IdType, AttributedTypeManager::TypeInfo> AttributedTypeManager::sTypeMap;
+	ConcurrentRegistry<RTTI::IdType, std::shared_ptr<const AttributedTypeManager::TypeInfo>> AttributedTypeManager::sTypeMap;
 
 	AttributedTypeManager::TypeInfo::TypeInfo(const Vector<Attributed::Signature>& signature, RTTI::IdType parentType) :
 		mSignatures(signature),
@@ -267,56 +315,89 @@ namespace GameEngine
 	void AttributedTypeManager::RegisterType(RTTI::IdType type, const Vector<Attributed::Signature>& signatures, RTTI::IdType parentType)
 	{
 		assert(type != parentType);
-		sTypeMap.Insert(make_pair(type, TypeInfo(signatures, parentType)));
+		sTypeMap.Update([&](auto& map)
+		{
+			map.Insert(make_pair(type, make_shared<const TypeInfo>(signatures, parentType)));
+		});
 	}
 
-	const Vector<Attributed::Signature>* AttributedTypeManager::GetSignature(RTTI::IdType type)
+	shared_ptr<const Vector<Attributed::Signature>> AttributedTypeManager::GetSignature(RTTI::IdType type)
 	{
-		auto it = sTypeMap.Find(type);
-		if (it != sTypeMap.end())
+		// Share ownership of the type info inside the read, a later update may free it as soon as the read ends
+		return sTypeMap.Read([type](const auto* map) -> shared_ptr<const Vector<Attributed::Signature>>
 		{
-			return &it->second.mFinalSignatures;
-		}
-
-		return nullptr;
+			if (map != nullptr)
+			{
+				auto it = map->Find(type);
+				if (it != map->end())
+				{
+					return shared_ptr<const Vector<Attributed::Signature>>(it->second, &it->second->mFinalSignatures);
+				}
+			}
+			return nullptr;
+		});
 	}
 
-	void AttributedTypeManager::FinalizeSignature()
+	shared_ptr<const Scope> AttributedTypeManager::GetPrototype(RTTI::IdType type)
 	{
-		for (auto& pair : sTypeMap)
+		return sTypeMap.Read([type](const auto* map) -> shared_ptr<const Scope>
 		{
-			auto& type = pair.first;
-			auto& info = pair.second;
-
-			// Push all types in the hierarchy to the stack, top is ancestor, bottom is descendent
-			Stack<Vector<Attributed::Signature>*> typeStack;
-			HashMap<RTTI::IdType, TypeInfo>::Iterator it = sTypeMap.Find(type);
-			size_t signatureCount = 0;
-			while (it != sTypeMap.end())
+			if (map != nullptr)
 			{
-				typeStack.Push(&it->second.mSignatures);
-				signatureCount += it->second.mSignatures.Size();
-				it = sTypeMap.Find(it->second.mParentType);
+				auto it = map->Find(type);
+				if (it != map->end())
+				{
+					return it->second->mPrototype;
+				}
 			}
+			return nullptr;
+		});
+	}
 
-			// Pop from top to build the entire signature list
-			info.mFinalSignatures.Clear();
-			info.mFinalSignatures.Reserve(signatureCount);
-			while (!typeStack.IsEmpty())
+	void AttributedTypeManager::FinalizeSignature()
+	{
+		sTypeMap.Update([](auto& map)
+		{
+			for (auto& pair : map)
 			{
-				auto& partialSignature = typeStack.Peak();
-				for (const auto& sig : *partialSignature)
+				auto& type = pair.first;
+
+				// Push all types in the hierarchy to the stack, top is ancestor, bottom is descendent
+				Stack<const Vector<Attributed::Signature>*> typeStack;
+				auto it = map.Find(type);
+				size_t signatureCount = 0;
+				while (it != map.end())
 				{
-					info.mFinalSignatures.PushBack(sig);
+					typeStack.Push(&it->second->mSignatures);
+					signatureCount += it->second->mSignatures.Size();
+					it = map.Find(it->second->mParentType);
 				}
-				typeStack.Pop();
+
+				// Pop from top to build the entire signature list, readers may still hold the old info so build a new one
+				auto info = make_shared<TypeInfo>(*pair.second);
+				info->mFinalSignatures.Clear();
+				info->mFinalSignatures.Reserve(signatureCount);
+				while (!typeStack.IsEmpty())
+				{
+					auto& partialSignature = typeStack.Peak();
+					for (const auto& sig : *partialSignature)
+					{
+						info->mFinalSignatures.PushBack(sig);
+					}
+					typeStack.Pop();
+				}
+				info->mPrototype = Attributed::BuildPrototype(info->mFinalSignatures);
+				pair.second = move(info);
 			}
-		}
+		});
 	}
 
 	void AttributedTypeManager::UnregisterType(RTTI::IdType type)
 	{
-		sTypeMap.Remove(type);
+		sTypeMap.Update([type](auto& map)
+		{
+			map.Remove(type);
+		});
 	}
 
 	void AttributedTypeManager::UnregisterAllTypes()
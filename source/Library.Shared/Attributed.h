@@ -1,7 +1,8 @@
 #pragma once
 #include "vector.h"
 #include "Datum.h"
-#include "HashMap.h"
+#include "FlatHashMap.h"
+#include "ConcurrentRegistry.h"
 #include "Scope.h"
 
 namespace GameEngine
@@ -31,12 +32,12 @@ namespace GameEngine
 			/// <param name="type">Type of the attribute</param>
 			/// <param name="size">How many elements does this attribute have</param>
 			/// <param name="offset">The offset in bytes from start of instance base address to the address of member variable</param>
-			Signature(const std::string& name, Datum::DatumType type, size_t size, size_t offset = 0);
+			Signature(std::string_view name, Datum::DatumType type, size_t size, size_t offset = 0);
 
 			/// <summary>
-			/// Name of attribute
+			/// Name of attribute, interned so that populating a scope never hashes or copies the text
 			/// </summary>
-			std::string mName;
+			Atom mName;
 
 			/// <summary>
 			/// Type of attribute
@@ -65,21 +66,21 @@ namespace GameEngine
 		/// </summary>
 		/// <param name="name">The name to search</param>
 		/// <returns>True if this instance has an attribute with such name, False otherwise</returns>
-		bool IsAttribute(const std::string& name) const;
+		bool IsAttribute(std::string_view name) const;
 
 		/// <summary>
 		/// Check if this instance has an prescribed attribute with given name
 		/// </summary>
 		/// <param name="name">The name to search</param>
 		/// <returns>True if this instance has an prescribed attribute with such name, False otherwise</returns>
-		bool IsPrescribedAttribute(const std::string& name) const;
+		bool IsPrescribedAttribute(std::string_view name) const;
 
 		/// <summary>
 		/// Check if this instance has an auxiliary attribute with given name
 		/// </summary>
 		/// <param name="name">The name to search</param>
 		/// <returns>True if this instance has an auxiliary attribute with such name, False otherwise</returns>
-		bool IsAuxiliaryAttribute(const std::string& name) const;
+		bool IsAuxiliaryAttribute(std::string_view name) const;
 
 		/// <summary>
 		/// Append a new auxiliary attribute with given name. If such auxiliary attribute exists, just return that one
@@ -88,7 +89,7 @@ namespace GameEngine
 		/// <returns>The appended auxiliary attribute</returns>
 		/// <exception cref="std::exception">One prescribed attribute has same name</exception>
 		/// <exception cref="std::exception">Name is empty</exception>
-		Datum& AppendAuxiliaryAttribute(const std::string& name);
+		Datum& AppendAuxiliaryAttribute(std::string_view name);
 
 		/// <summary>
 		/// Get all attributes sorted by the order of insertion
@@ -126,7 +127,7 @@ namespace GameEngine
 		/// <returns>Vector of const auxiliary attribute pointers sorted by the order of insertion</returns>
 		Vector<const PairType*> AuxiliaryAttributes() const;
 
-		void RemoveAuxiliaryAttribute(const std::string& key);
+		void RemoveAuxiliaryAttribute(std::string_view key);
 
 		/// <summary>
 		/// Clear the scope table, delete all auxiliary attributes and rebuild prescribed attributes to default state.
@@ -191,10 +192,18 @@ namespace GameEngine
 		/// <returns>True if two objects are not equal, False otherwise</returns>
 		bool operator!=(const Attributed& other) const;
 
+		/// <summary>
+		/// Tell a prescribed attribute stored in a member variable that the member was written directly.
+		/// Its hash is cached like internal storage, so every setter writing such a member calls this
+		/// </summary>
+		/// <param name="name">Name of the prescribed attribute</param>
+		void MarkAttributeChanged(std::string_view name);
+
 	private:
 		/// <summary>
 		/// Create prescribed attributes according to given class type.
-		/// Prescribed attributes always start with "this", if the type has no corresponding signature table, no more prescribed attributes will be created
+		/// Prescribed attributes always start with "this", if the type has no corresponding signature table, no more prescribed attributes will be created.
+		/// After FinalizeSignature() the table is copied from the prototype of the type, otherwise it's built from the signatures
 		/// </summary>
 		/// <param name="type">Type of this object</param>
 		void Populate(IdType type);
@@ -211,10 +220,26 @@ namespace GameEngine
 		/// <param name="vector">The source vector of attributes</param>
 		/// <returns>The copy of source vector with type changed to const attribute</returns>
 		inline Vector<const PairType*> PromoteToConst(const Vector<PairType*>& vector) const;
+
+		/// <summary>
+		/// Build the prescribed attributes of given signatures into a plain Scope, which every instance of the type can copy from.
+		/// External storage attributes only get their type, they are pointed at the instance after copying
+		/// </summary>
+		/// <param name="signatures">Complete signature list of a type</param>
+		/// <returns>The prototype table</returns>
+		static std::shared_ptr<const Scope> BuildPrototype(const Vector<Signature>& signatures);
+
+		/// <summary>
+		/// Key of the "this" attribute. Created during static initialization so it never shows up as a leak
+		/// </summary>
+		inline static const Atom THIS_KEY = Atom("this");
+
+		friend class AttributedTypeManager;
 	};
 
 	/// <summary>
-	/// A helper singleton class that stores all prescribed attributes information for all types
+	/// A helper singleton class that stores all prescribed attributes information for all types.
+	/// GetSignature() is lock-free and can be called from any thread. Registration blocks until no lookup sees the old table
 	/// </summary>
 	class AttributedTypeManager final
 	{
@@ -222,6 +247,7 @@ namespace GameEngine
 		{
 			Vector<Attributed::Signature> mSignatures;
 			Vector<Attributed::Signature> mFinalSignatures;
+			std::shared_ptr<const Scope> mPrototype;
 			RTTI::IdType mParentType;
 			TypeInfo(const Vector<Attributed::Signature>& signature, RTTI::IdType parentType);
 		};
@@ -235,11 +261,20 @@ namespace GameEngine
 		static void RegisterType(RTTI::IdType type, const Vector<Attributed::Signature>& signatures, RTTI::IdType parentType);
 
 		/// <summary>
-		/// Retreive a signature table with given type
+		/// Retreive a signature table with given type.
+		/// The returned pointer keeps the table alive, even if the type is unregistered or FinalizeSignature() is called again on another thread
+		/// </summary>
+		/// <param name="type">Type of class</param>
+		/// <returns>Vector of prescribed attribute signatures, nullptr if the type isn't registered</returns>
+		static std::shared_ptr<const Vector<Attributed::Signature>> GetSignature(RTTI::IdType type);
+
+		/// <summary>
+		/// Retreive the prototype table with given type, which holds all prescribed attributes in order and is built by FinalizeSignature().
+		/// The returned pointer keeps the table alive, even if the type is unregistered or FinalizeSignature() is called again on another thread
 		/// </summary>
 		/// <param name="type">Type of class</param>
-		/// <returns>Vector of prescribed attribute signatures</returns>
-		static const Vector<Attributed::Signature>* GetSignature(RTTI::IdType type);
+		/// <returns>The prototype table, nullptr if the type isn't registered or signatures aren't finalized</returns>
+		static std::shared_ptr<const Scope> GetPrototype(RTTI::IdType type);
 
 		/// <summary>
 		/// Remove a signature table with given type
@@ -253,7 +288,7 @@ namespace GameEngine
 		static void UnregisterAllTypes();
 
 		/// <summary>
-		/// After all types are registered, generate the complete signature list for each type and store them as cache
+		/// After all types are registered, generate the complete signature list and the prototype table for each type and store them as cache
 		/// </summary>
 		static void FinalizeSignature();
 
@@ -264,8 +299,8 @@ namespace GameEngine
 		AttributedTypeManager();
 
 		/// <summary>
-		/// A map that stores type->signature table
+		/// A map that stores type->signature table. Type info is shared between snapshots, so signature tables don't move when other types are registered
 		/// </summary>
-		static HashMap<RTTI::IdType, TypeInfo> sTypeMap;
+		static ConcurrentRegistry<RTTI::IdType, std::shared_ptr<const TypeInfo>> sTypeMap;
 	};
 }
\ No newline at end of file
@@ -0,0 +1,139 @@
+#pragma once
+
+/// \file ConcurrentRegistry.h
+/// \brief Contains the declaration of ConcurrentRegistry
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include "FlatHashMap.h"
+
+namespace GameEngine
+{
+	/// <summary>
+	/// A read-mostly associative container that can be shared between threads.
+	/// The content is an immutable FlatHashMap snapshot. Readers never take a lock, they only announce themselves on a reader counter and read the current snapshot.
+	/// Writers are serialized by a mutex, build a modified copy of the snapshot, publish it, then wait until every reader that may still see the old snapshot leaves before freeing it.
+	/// Registration is therefore slow and lookups are cheap, which fits type and factory tables that are filled at startup and read everywhere afterwards.
+	/// An empty registry holds no snapshot at all, so it doesn't own any memory.
+	/// </summary>
+	template <typename TKey, typename TValue, typename HashFunctor = DefaultHash<TKey>, typename KeyEqualityFunctor = DefaultKeyEquality<TKey>>
+	class ConcurrentRegistry final
+	{
+	public:
+		using MapType = FlatHashMap<TKey, TValue, HashFunctor, KeyEqualityFunctor>;
+
+		/// <summary>
+		/// Default constructor, create an empty registry
+		/// </summary>
+		ConcurrentRegistry() = default;
+
+		ConcurrentRegistry(const ConcurrentRegistry&) = delete;
+		ConcurrentRegistry& operator=(const ConcurrentRegistry&) = delete;
+
+		/// <summary>
+		/// Destructor, free current snapshot. No thread may read the registry while it is destroyed
+		/// </summary>
+		~ConcurrentRegistry();
+
+		/// <summary>
+		/// Call given function with current snapshot. The snapshot stays alive until the function returns, but pointers into it must not be kept after that
+		/// unless the value itself owns the data they point to
+		/// </summary>
+		/// <param name="function">Function that takes a pointer to const MapType, which is nullptr if the registry is empty</param>
+		/// <returns>Whatever the function returns</returns>
+		template <typename Function>
+		decltype(auto) Read(Function&& function) const;
+
+		/// <summary>
+		/// Copy out the value with given key
+		/// </summary>
+		/// <param name="key">Key to search, TKey or a key type accepted by transparent functors</param>
+		/// <param name="value">Output value, untouched if key doesn't exist</param>
+		/// <returns>True if key exists, False otherwise</returns>
+		template <typename TLookupKey>
+		bool TryGet(const TLookupKey& key, TValue& value) const;
+
+		/// <summary>
+		/// Check if given key exists in the registry
+		/// </summary>
+		/// <param name="key">Key to search, TKey or a key type accepted by transparent functors</param>
+		/// <returns>True if key exists, False otherwise</returns>
+		template <typename TLookupKey>
+		bool ContainsKey(const TLookupKey& key) const;
+
+		/// <summary>
+		/// Get number of pairs in current snapshot
+		/// </summary>
+		/// <returns>Number of pairs</returns>
+		size_t Size() const;
+
+		/// <summary>
+		/// Modify the registry. Given function receives a private copy of current snapshot, which is published after the function returns.
+		/// If the function throws, nothing is published. This call blocks until no reader can see the old snapshot anymore
+		/// </summary>
+		/// <param name="function">Function that takes MapType&amp; and modifies it</param>
+		template <typename Function>
+		void Update(Function&& function);
+
+		/// <summary>
+		/// Remove all pairs from the registry
+		/// </summary>
+		void Clear();
+
+	private:
+		/// <summary>
+		/// Counts readers inside the registry on one side of the epoch, padded so that two counters never share a cache line
+		/// </summary>
+		struct ReaderCount
+		{
+			std::atomic<size_t> mCount = 0;
+			char mPadding[64 - sizeof(std::atomic<size_t>)];
+		};
+
+		/// <summary>
+		/// Register a reader for its lifetime
+		/// </summary>
+		class ReadGuard final
+		{
+		public:
+			explicit ReadGuard(const ConcurrentRegistry& owner);
+			ReadGuard(const ReadGuard&) = delete;
+			ReadGuard& operator=(const ReadGuard&) = delete;
+			~ReadGuard();
+
+		private:
+			ReaderCount& mReaderCount;
+		};
+
+		/// <summary>
+		/// Replace current snapshot and free the old one once every reader that may see it has left
+		/// </summary>
+		/// <param name="snapshot">New snapshot, nullptr for an empty registry</param>
+		void Publish(std::unique_ptr<MapType> snapshot);
+
+		/// <summary>
+		/// Current snapshot, nullptr if registry is empty
+		/// </summary>
+		std::atomic<const MapType*> mSnapshot = nullptr;
+
+		/// <summary>
+		/// Index of the reader counter new readers register on
+		/// </summary>
+		std::atomic<size_t> mEpoch = 0;
+
+		/// <summary>
+		/// Reader counters of both epochs. Writers flip the epoch and wait for the other counter to drain, so a steady stream of readers can't starve them
+		/// </summary>
+		mutable ReaderCount mReaders[2];
+
+		/// <summary>
+		/// Serialize writers
+		/// </summary>
+		std::mutex mWriteMutex;
+	};
+}
+
+#include "ConcurrentRegistry.inl"
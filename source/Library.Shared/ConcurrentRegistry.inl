@@ -0,0 +1,117 @@
+#pragma once
+
+namespace GameEngine
+{
+#pragma region ConcurrentRegistry
+	template <typename TKey, typename TValue, typename HashFunctor, typename KeyEqualityFunctor>
+	ConcurrentRegistry<TKey, TValue, HashFunctor, KeyEqualityFunctor>::~ConcurrentRegistry()
+	{
+		delete mSnapshot.load();
+	}
+
+	template <typename TKey, typename TValue, typename HashFunctor, typename KeyEqualityFunctor>
+	template <typename Function>
+	decltype(auto) ConcurrentRegistry<TKey, TValue, HashFunctor, KeyEqualityFunctor>::Read(Function&& function) const
+	{
+		ReadGuard guard(*this);
+		return function(mSnapshot.load());
+	}
+
+	template <typename TKey, typename TValue, typename HashFunctor, typename KeyEqualityFunctor>
+	template <typename TLookupKey>
+	bool ConcurrentRegistry<TKey, TValue, HashFunctor, KeyEqualityFunctor>::TryGet(const TLookupKey& key, TValue& value) const
+	{
+		return Read([&key, &value](const MapType* map)
+		{
+			if (map != nullptr)
+			{
+				auto it = map->Find(key);
+				if (it != map->end())
+				{
+					value = it->second;
+					return true;
+				}
+			}
+			return false;
+		});
+	}
+
+	template <typename TKey, typename TValue, typename HashFunctor, typename KeyEqualityFunctor>
+	template <typename TLookupKey>
+	bool ConcurrentRegistry<TKey, TValue, HashFunctor, KeyEqualityFunctor>::ContainsKey(const TLookupKey& key) const
+	{
+		return Read([&key](const MapType* map)
+		{
+			return map != nullptr && map->Find(key) != map->end();
+		});
+	}
+
+	template <typename TKey, typename TValue, typename HashFunctor, typename KeyEqualityFunctor>
+	size_t ConcurrentRegistry<TKey, TValue, HashFunctor, KeyEqualityFunctor>::Size() const
+	{
+		return Read([](const MapType* map)
+		{
+			return map != nullptr ? map->Size() : size_t(0);
+		});
+	}
+
+	template <typename TKey, typename TValue, typename HashFunctor, typename KeyEqualityFunctor>
+	template <typename Function>
+	void ConcurrentRegistry<TKey, TValue, HashFunctor, KeyEqualityFunctor>::Update(Function&& function)
+	{
+		std::lock_guard<std::mutex> lock(mWriteMutex);
+		const MapType* current = mSnapshot.load();
+		std::unique_ptr<MapType> next = current != nullptr ? std::make_unique<MapType>(*current) : std::make_unique<MapType>();
+		function(*next);
+		if (next->IsEmpty())
+		{
+			next.reset();
+		}
+		Publish(std::move(next));
+	}
+
+	template <typename TKey, typename TValue, typename HashFunctor, typename KeyEqualityFunctor>
+	void ConcurrentRegistry<TKey, TValue, HashFunctor, KeyEqualityFunctor>::Clear()
+	{
+		std::lock_guard<std::mutex> lock(mWriteMutex);
+		Publish(nullptr);
+	}
+
+	template <typename TKey, typename TValue, typename HashFunctor, typename KeyEqualityFunctor>
+	void ConcurrentRegistry<TKey, TValue, HashFunctor, KeyEqualityFunctor>::Publish(std::unique_ptr<MapType> snapshot)
+	{
+		const MapType* old = mSnapshot.exchange(snapshot.release());
+		if (old == nullptr)
+		{
+			return;
+		}
+
+		// Flip twice, a reader that read the epoch before a flip but registered after it may sit on either counter
+		for (int i = 0; i < 2; ++i)
+		{
+			const size_t epoch = mEpoch.load();
+			mEpoch.store(epoch ^ 1);
+			while (mReaders[epoch].mCount.load() != 0)
+			{
+				std::this_thread::yield();
+			}
+		}
+		delete old;
+	}
+#pragma endregion
+
+#pragma region ReadGuard
+	template <typename TKey, typename TValue, typename HashFunctor, typename KeyEqualityFunctor>
+	ConcurrentRegistry<TKey, TValue, HashFunctor, KeyEqualityFunctor>::ReadGuard::ReadGuard(const ConcurrentRegistry& owner) :
+		mReaderCount(owner.mReaders[owner.mEpoch.load()])
+	{
+		mReaderCount.mCount.fetch_add(1);
+	}
+
+	template <typename TKey, typename TValue, typename HashFunctor, typename KeyEqualityFunctor>
+	ConcurrentRegistry<TKey, TValue, HashFunctor, KeyEqualityFunctor>::ReadGuard::~ReadGuard()
+	{
+		mReaderCount.mCount.fetch_sub(1);
+	}
+#pragma endregion
+}
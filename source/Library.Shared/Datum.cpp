@@ -1,13 +1,18 @@
 #include "pch.h"
 #include "Datum.h"
 #include "RTTI.h"
+#include "Scope.h"
+#include "ScopeColumns.h"
+#include "DefaultHashFunction.h"
 #pragma warning(push)
 #pragma warning(disable : 4201)
-#define GLM_ENABLE_EXPERIMENTAL
 #include "glm/glm.hpp"
-#include "glm/gtx/string_cast.hpp"
 #pragma warning(pop)
 #include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <iterator>
+#include <type_traits>
 
 using namespace std;
 using namespace glm;
@@ -47,6 +52,8 @@ if (mType == DatumType::_type)                                          \
 	{                                                                   \
 		throw std::exception("Index out of range");                     \
 	}                                                                   \
+	Detach();                                                           \
+	MarkChanged();                                                      \
 	mData._type[_index] = _value;                                       \
 }                                                                       \
 else                                                                    \
@@ -82,6 +89,8 @@ else if (mType != DatumType::_enumType)						\
 }															\
 															\
 CheckIsInternal();											\
+Detach();													\
+MarkChanged();												\
 EnsureCapacity();											\
 new(mData._enumType + mSize) _constructType(_value);        \
 ++mSize;
@@ -163,12 +172,293 @@ ResetSelf();														   \
 mIsInternal = false;												   \
 mData._type = _value;												   \
 mSize = _size;														   \
-mCapacity = _size;
+mCapacity = _size;													   \
+MarkChanged();
 #pragma endregion
 
 namespace GameEngine
 {
-	Vector<size_t> Datum::sTypeSizeTable =
+	namespace
+	{
+		/// <summary>
+		/// Number of elements converted at a time when int and float operands are mixed, a multiple of 4 so patterns stay aligned
+		/// </summary>
+		constexpr size_t ConversionChunkSize = 64;
+
+		/// <summary>
+		/// An int or float operand of Datum::Compute seen as an array of T, converted chunk by chunk into a stack buffer if its type differs
+		/// </summary>
+		template <typename T>
+		class NumberOperand final
+		{
+		public:
+			NumberOperand(const Datum& datum, bool repeat) :
+				mRepeat(repeat)
+			{
+				const bool isInteger = datum.Type() == Datum::DatumType::Integer;
+				if (repeat)
+				{
+					const T value = isInteger ? static_cast<T>(datum.AsInt()) : static_cast<T>(datum.AsFloat());
+					std::fill(std::begin(mPattern), std::end(mPattern), value);
+				}
+				else if (isInteger)
+				{
+					mIntegers = &datum.AsInt();
+				}
+				else
+				{
+					mFloats = &datum.AsFloat();
+				}
+			}
+
+			bool NeedsConversion() const
+			{
+				if constexpr (std::is_same_v<T, int32_t>)
+				{
+					return mFloats != nullptr;
+				}
+				else
+				{
+					return mIntegers != nullptr;
+				}
+			}
+
+			const T* Get(size_t start, size_t size)
+			{
+				if (mRepeat)
+				{
+					return mPattern;
+				}
+				if constexpr (std::is_same_v<T, int32_t>)
+				{
+					if (mIntegers != nullptr)
+					{
+						return mIntegers + start;
+					}
+					std::transform(mFloats + start, mFloats + start + size, mBuffer, [](float value) { return static_cast<int32_t>(value); });
+				}
+				else
+				{
+					if (mFloats != nullptr)
+					{
+						return mFloats + start;
+					}
+					std::transform(mIntegers + start, mIntegers + start + size, mBuffer, [](int32_t value) { return static_cast<float>(value); });
+				}
+				return mBuffer;
+			}
+
+		private:
+			bool mRepeat;
+			const int32_t* mIntegers = nullptr;
+			const float* mFloats = nullptr;
+			T mPattern[4] = {};
+			T mBuffer[ConversionChunkSize];
+		};
+
+		template <typename T>
+		void ComputeNumbers(ArrayMath::Operation operation, const Datum& left, const Datum& right, T* destination, size_t count)
+		{
+			NumberOperand<T> leftOperand(left, left.Size() != count);
+			NumberOperand<T> rightOperand(right, right.Size() != count);
+			const ArrayMath::Broadcast broadcast = left.Size() != count ? ArrayMath::Broadcast::Left : (right.Size() != count ? ArrayMath::Broadcast::Right : ArrayMath::Broadcast::None);
+			const size_t chunk = leftOperand.NeedsConversion() || rightOperand.NeedsConversion() ? ConversionChunkSize : count;
+			for (size_t start = 0; start < count; start += chunk)
+			{
+				const size_t size = std::min(chunk, count - start);
+				ArrayMath::Compute(operation, leftOperand.Get(start, size), rightOperand.Get(start, size), destination + start, size, broadcast);
+			}
+		}
+
+		void SkipSpaces(const char*& current, const char* end)
+		{
+			while (current != end && std::isspace(static_cast<unsigned char>(*current)))
+			{
+				++current;
+			}
+		}
+
+		/// <summary>
+		/// Match a literal, where a space matches any amount of whitespace, including none
+		/// </summary>
+		bool ScanLiteral(const char*& current, const char* end, std::string_view literal)
+		{
+			for (char c : literal)
+			{
+				if (c == ' ')
+				{
+					SkipSpaces(current, end);
+				}
+				else if (current != end && *current == c)
+				{
+					++current;
+				}
+				else
+				{
+					return false;
+				}
+			}
+			return true;
+		}
+
+		template <typename T>
+		bool ScanNumber(const char*& current, const char* end, T& value)
+		{
+			SkipSpaces(current, end);
+			if (current != end && *current == '+')
+			{
+				++current;
+			}
+			auto [next, error] = std::from_chars(current, end, value);
+			current = next;
+			return error == std::errc();
+		}
+
+		bool ParseValue(const char*& current, const char* end, int32_t& value)
+		{
+			return ScanNumber(current, end, value);
+		}
+
+		bool ParseValue(const char*& current, const char* end, float& value)
+		{
+			return ScanNumber(current, end, value);
+		}
+
+		bool ParseValue(const char*& current, const char* end, vec4& value)
+		{
+			if (!ScanLiteral(current, end, " vec4("))
+			{
+				return false;
+			}
+			for (glm::length_t i = 0; i < 4; ++i)
+			{
+				if (!ScanNumber(current, end, value[i]) || !ScanLiteral(current, end, i < 3 ? " , " : " )"))
+				{
+					return false;
+				}
+			}
+			return true;
+		}
+
+		bool ParseValue(const char*& current, const char* end, mat4& value)
+		{
+			if (!ScanLiteral(current, end, " mat4x4("))
+			{
+				return false;
+			}
+			for (glm::length_t column = 0; column < 4; ++column)
+			{
+				if (!ScanLiteral(current, end, " ("))
+				{
+					return false;
+				}
+				for (glm::length_t row = 0; row < 4; ++row)
+				{
+					if (!ScanNumber(current, end, value[column][row]) || !ScanLiteral(current, end, row < 3 ? " , " : " )"))
+					{
+						return false;
+					}
+				}
+				if (!ScanLiteral(current, end, column < 3 ? " , " : " )"))
+				{
+					return false;
+				}
+			}
+			return true;
+		}
+
+		/// <summary>
+		/// Parse a string that holds exactly one value, with optional whitespace around it
+		/// </summary>
+		template <typename T>
+		bool ParseWhole(std::string_view str, T& value)
+		{
+			const char* current = str.data();
+			const char* end = current + str.size();
+			if (!ParseValue(current, end, value))
+			{
+				return false;
+			}
+			SkipSpaces(current, end);
+			return current == end;
+		}
+
+		template <typename T>
+		size_t ParseList(Datum& datum, std::string_view str, size_t index)
+		{
+			const char* current = str.data();
+			const char* end = current + str.size();
+			size_t count = 0;
+			SkipSpaces(current, end);
+			while (current != end)
+			{
+				if (count > 0 && !ScanLiteral(current, end, ","))
+				{
+					break;
+				}
+
+				T value;
+				if (!ParseValue(current, end, value))
+				{
+					break;
+				}
+
+				const size_t position = index + count;
+				if (position >= datum.Size())
+				{
+					if (!datum.IsInternal())
+					{
+						break;
+					}
+					if (position >= datum.Capacity())
+					{
+						datum.Reserve(std::max<size_t>(position + 1, 2 * datum.Capacity()));
+					}
+					datum.SetSize(position + 1);
+				}
+				datum.Set(value, position);
+				++count;
+				SkipSpaces(current, end);
+			}
+			return count;
+		}
+
+		void AppendNumber(std::string& result, int32_t value)
+		{
+			char buffer[16];
+			[[maybe_unused]] auto [end, error] = std::to_chars(std::begin(buffer), std::end(buffer), value);
+			assert(error == std::errc());
+			result.append(buffer, end);
+		}
+
+		void AppendNumber(std::string& result, float value, bool exact)
+		{
+			// Large enough for the longest fixed notation of a float with 6 decimals
+			char buffer[64];
+			[[maybe_unused]] auto [end, error] = exact ? std::to_chars(std::begin(buffer), std::end(buffer), value)
+				: std::to_chars(std::begin(buffer), std::end(buffer), value, std::chars_format::fixed, 6);
+			assert(error == std::errc());
+			result.append(buffer, end);
+		}
+
+		void AppendNumbers(std::string& result, const float* values, bool exact)
+		{
+			result.push_back('(');
+			for (size_t i = 0; i < 4; ++i)
+			{
+				if (i > 0)
+				{
+					result.append(", ");
+				}
+				AppendNumber(result, values[i], exact);
+			}
+			result.push_back(')');
+		}
+	}
+
+	thread_local bool Datum::sCopyOnWrite = false;
+
+	const size_t Datum::sTypeSizeTable[] =
 	{
 		0,                         // Unknown
 		sizeof(int32_t),           // Integer
@@ -180,7 +470,7 @@ namespace GameEngine
 		sizeof(RTTI*)              // Pointer
 	};
 
-	Vector<Datum::CompareFunction> Datum::sCompareFunctions =
+	const Datum::CompareFunction Datum::sCompareFunctions[] =
 	{
 		nullptr,                   // Unknown
 		&Datum::ComparePrimitive,  // Integer
@@ -192,7 +482,7 @@ namespace GameEngine
 		&Datum::ComparePointer     // Pointer
 	};
 
-	Vector<Datum::CreateDefaultFunction> Datum::sCreateDefaultFunctions =
+	const Datum::CreateDefaultFunction Datum::sCreateDefaultFunctions[] =
 	{
 		nullptr,
 		&Datum::CreateDefaultPrimitive,    // Integer
@@ -204,7 +494,7 @@ namespace GameEngine
 		&Datum::CreateDefaultPrimitive     // Pointer
 	};
 
-	Vector<Datum::CopyFunction> Datum::sCopyFunctions =
+	const Datum::CopyFunction Datum::sCopyFunctions[] =
 	{
 		&Datum::CopyPrimitive,             // Unknown
 		&Datum::CopyPrimitive,             // Integer
@@ -229,11 +519,15 @@ namespace GameEngine
 		mType(other.mType),
 		mSize(other.mSize),
 		mCapacity(other.mCapacity),
-		mData(other.mData),
-		mIsInternal(other.mIsInternal)
+		mIsInternal(other.mIsInternal),
+		mInColumn(other.mInColumn),
+		mInOwner(other.mInOwner),
+		mHashValid(other.mHashValid),
+		mHash(other.mHash),
+		mArena(other.mArena),
+		mColumns(std::move(other.mColumns))
 	{
-		other.mSize = 0;
-		other.mData.Integer = nullptr;
+		StealData(other);
 	}
 
 	Datum::Datum(const int32_t& value) :
@@ -320,6 +614,7 @@ namespace GameEngine
 		{
 			ResetSelf();
 			DeepCopy(other);
+			MarkChanged();
 		}
 		return *this;
 	}
@@ -332,10 +627,13 @@ namespace GameEngine
 			mType = other.mType;
 			mSize = other.mSize;
 			mCapacity = other.mCapacity;
-			mData = other.mData;
 			mIsInternal = other.mIsInternal;
-			other.mSize = 0;
-			other.mData.Integer = nullptr;
+			mInColumn = other.mInColumn;
+			mInOwner = other.mInOwner;
+			mArena = other.mArena;
+			mColumns = std::move(other.mColumns);
+			StealData(other);
+			MarkChanged();
 		}
 		return *this;
 	}
@@ -377,7 +675,7 @@ namespace GameEngine
 
 	bool Datum::operator==(const Datum& other) const
 	{
-		if (mType != other.mType || mSize != other.mSize)
+		if (mType != other.mType || mSize != other.mSize || (mHashValid && other.mHashValid && mHash != other.mHash))
 		{
 			return false;
 		}
@@ -666,6 +964,131 @@ namespace GameEngine
 		return result;
 	}
 
+	void Datum::Compute(ArithmeticOperation operation, const Datum& left, const Datum& right, Datum& destination)
+	{
+		size_t count = left.mSize;
+		if (left.mSize != right.mSize && right.mSize != 1)
+		{
+			if (left.mSize != 1)
+			{
+				throw std::exception("Datum sizes don't match for element-wise arithmetic");
+			}
+			count = right.mSize;
+		}
+
+		// A single operand repeated over its own storage would be resized and overwritten by the first result, so it's read from a copy
+		const bool leftRepeat = left.mSize != count;
+		const bool rightRepeat = right.mSize != count;
+		if ((leftRepeat && &left == &destination) || (rightRepeat && &right == &destination))
+		{
+			const Datum repeated(destination);
+			Compute(operation, leftRepeat ? repeated : left, rightRepeat ? repeated : right, destination);
+			return;
+		}
+
+		// Work out result type, vector and matrix accept a single int or float on the other side
+		const bool leftIsNumber = left.mType == DatumType::Integer || left.mType == DatumType::Float;
+		const bool rightIsNumber = right.mType == DatumType::Integer || right.mType == DatumType::Float;
+		DatumType resultType = DatumType::Unknown;
+		if (leftIsNumber && rightIsNumber)
+		{
+			const bool integers = left.mType == DatumType::Integer && right.mType == DatumType::Integer;
+			resultType = integers || operation == ArithmeticOperation::Modulus ? DatumType::Integer : DatumType::Float;
+		}
+		else if (operation != ArithmeticOperation::Modulus)
+		{
+			for (DatumType type : { DatumType::Vector, DatumType::Matrix })
+			{
+				const bool leftMatches = left.mType == type || (leftIsNumber && left.mSize == 1);
+				const bool rightMatches = right.mType == type || (rightIsNumber && right.mSize == 1);
+				if ((left.mType == type || right.mType == type) && leftMatches && rightMatches)
+				{
+					resultType = type;
+				}
+			}
+		}
+		if (resultType == DatumType::Unknown)
+		{
+			throw std::exception("Unsupported datum types for element-wise arithmetic");
+		}
+
+		// Prepare destination first, an operand of the full size may be the destination itself so its data is only read after this
+		destination.SetType(resultType);
+		if (destination.mSize != count)
+		{
+			if (!destination.mIsInternal)
+			{
+				throw std::exception("External destination has a different size");
+			}
+			destination.SetSize(count);
+		}
+		destination.Detach();
+		destination.MarkChanged();
+		if (count == 0)
+		{
+			return;
+		}
+
+		if (resultType == DatumType::Integer)
+		{
+			ComputeNumbers(operation, left, right, destination.mData.Integer, count);
+		}
+		else if (resultType == DatumType::Float)
+		{
+			ComputeNumbers(operation, left, right, destination.mData.Float, count);
+		}
+		else if (left.mType == DatumType::Matrix && right.mType == DatumType::Matrix
+			&& (leftRepeat || rightRepeat || operation == ArithmeticOperation::Multiply || operation == ArithmeticOperation::Divide))
+		{
+			// Matrix products, or a single matrix applied to every element, go one matrix at a time
+			const mat4 leftValue = left.mData.Matrix[0];
+			const mat4 rightValue = right.mData.Matrix[0];
+			for (size_t i = 0; i < count; ++i)
+			{
+				const mat4& a = leftRepeat ? leftValue : left.mData.Matrix[i];
+				const mat4& b = rightRepeat ? rightValue : right.mData.Matrix[i];
+				if (operation == ArithmeticOperation::Multiply)
+				{
+					destination.mData.Matrix[i] = a * b;
+				}
+				else if (operation == ArithmeticOperation::Divide)
+				{
+					destination.mData.Matrix[i] = a / b;
+				}
+				else
+				{
+					ArrayMath::Compute(operation, &a[0][0], &b[0][0], &destination.mData.Matrix[i][0][0], 16);
+				}
+			}
+		}
+		else
+		{
+			// Everything else is component-wise over the floats, a single int, float or vector repeats as a pattern of 4 components
+			auto operand = [](const Datum& datum, bool repeat, float* pattern) -> const float*
+			{
+				if (datum.mType == DatumType::Integer || datum.mType == DatumType::Float)
+				{
+					std::fill(pattern, pattern + 4, datum.mType == DatumType::Integer ? static_cast<float>(datum.mData.Integer[0]) : datum.mData.Float[0]);
+					return pattern;
+				}
+				if (repeat)
+				{
+					std::copy(&datum.mData.Vector[0][0], &datum.mData.Vector[0][0] + 4, pattern);
+					return pattern;
+				}
+				return datum.mType == DatumType::Vector ? &datum.mData.Vector[0][0] : &datum.mData.Matrix[0][0][0];
+			};
+
+			float leftPattern[4];
+			float rightPattern[4];
+			const float* a = operand(left, leftRepeat, leftPattern);
+			const float* b = operand(right, rightRepeat, rightPattern);
+			const ArrayMath::Broadcast broadcast = a == leftPattern ? ArrayMath::Broadcast::Left : (b == rightPattern ? ArrayMath::Broadcast::Right : ArrayMath::Broadcast::None);
+			float* result = resultType == DatumType::Vector ? &destination.mData.Vector[0][0] : &destination.mData.Matrix[0][0][0];
+			ArrayMath::Compute(operation, a, b, result, count * (resultType == DatumType::Vector ? 4 : 16), broadcast);
+		}
+	}
+
 	Datum::operator bool() const
 	{
 		if (mType == DatumType::Integer)
@@ -819,6 +1242,8 @@ namespace GameEngine
 
 	Datum::~Datum()
 	{
+		// Destroying a Datum isn't a change, its scope is going away or reports the removal itself
+		mScope = nullptr;
 		ResetSelf();
 	}
 
@@ -827,6 +1252,8 @@ namespace GameEngine
 		if (mType == other.Type() && mType != DatumType::Unknown)
 		{
 			SetSize(other.mSize);
+			Detach();
+			MarkChanged();
 			if (mType == DatumType::String)
 			{
 				for (size_t i = 0; i < mSize; ++i)
@@ -879,31 +1306,37 @@ namespace GameEngine
 
 	int32_t& Datum::AsInt(size_t index)
 	{
+		Detach();
 		GET_BODY(index, Integer);
 	}
 
 	float& Datum::AsFloat(size_t index)
 	{
+		Detach();
 		GET_BODY(index, Float);
 	}
 
 	glm::vec4& Datum::AsVector(size_t index)
 	{
+		Detach();
 		GET_BODY(index, Vector);
 	}
 
 	glm::mat4& Datum::AsMatrix(size_t index)
 	{
+		Detach();
 		GET_BODY(index, Matrix);
 	}
 
 	std::string& Datum::AsString(size_t index)
 	{
+		Detach();
 		GET_BODY(index, String);
 	}
 
 	RTTI*& Datum::AsPointer(size_t index)
 	{
+		Detach();
 		GET_BODY(index, Pointer);
 	}
 
@@ -975,7 +1408,7 @@ namespace GameEngine
 		return RemoveAt(Find(value));
 	}
 
-	bool Datum::Remove(const std::string& value)
+	bool Datum::Remove(std::string_view value)
 	{
 		return RemoveAt(Find(value));
 	}
@@ -990,6 +1423,8 @@ namespace GameEngine
 		CheckIsInternal();
 		if (index < mSize)
 		{
+			Detach();
+			MarkChanged();
 			if (mType == DatumType::String)
 			{
 				mData.String[index].~string();
@@ -1015,37 +1450,44 @@ namespace GameEngine
 
 	Datum::Iterator Datum::Find(const int32_t& value)
 	{
+		Detach();
 		FIND_BODY(value, Integer);
 	}
 
 	Datum::Iterator Datum::Find(const float& value)
 	{
+		Detach();
 		FIND_BODY(value, Float);
 	}
 
 	Datum::Iterator Datum::Find(const glm::vec4& value)
 	{
+		Detach();
 		FIND_BODY(value, Vector);
 	}
 
 	Datum::Iterator Datum::Find(const glm::mat4& value)
 	{
+		Detach();
 		FIND_BODY(value, Matrix);
 	}
 
-	Datum::Iterator Datum::Find(const std::string& value)
+	Datum::Iterator Datum::Find(std::string_view value)
 	{
+		Detach();
 		FIND_BODY(value, String);
 	}
 
 	Datum::Iterator Datum::Find(const Scope& value)
 	{
+		Detach();
 		Scope* pointer = const_cast<Scope*>(&value);
 		return Find(reinterpret_cast<RTTI*>(pointer));
 	}
 
 	Datum::Iterator Datum::Find(const RTTI* const& value)
 	{
+		Detach();
 		if (mType != DatumType::Pointer && mType != DatumType::Table)							
 		{														
 			throw std::exception("Datum has incompatible type");
@@ -1080,7 +1522,7 @@ namespace GameEngine
 		FIND_BODY(value, Matrix);
 	}
 
-	Datum::ConstIterator Datum::Find(const std::string& value) const
+	Datum::ConstIterator Datum::Find(std::string_view value) const
 	{
 		FIND_BODY(value, String);
 	}
@@ -1104,6 +1546,10 @@ namespace GameEngine
 	{
 		if (mType == DatumType::Unknown || mType == type)
 		{
+			if (mType != type)
+			{
+				InvalidateHash();
+			}
 			mType = type;
 		}
 		else
@@ -1127,9 +1573,92 @@ namespace GameEngine
 		return mIsInternal;
 	}
 
+	bool Datum::IsShared() const
+	{
+		ReferenceCount* shared = mShared.load(std::memory_order_acquire);
+		return shared != nullptr && (shared->mCount.load(std::memory_order_acquire) > 1 || shared->mRelease != nullptr);
+	}
+
+	ScopeColumns* Datum::Columns()
+	{
+		return mColumns.get();
+	}
+
+	const ScopeColumns* Datum::Columns() const
+	{
+		return mColumns.get();
+	}
+
+	bool Datum::IsChanged() const
+	{
+		return mChanged;
+	}
+
+	void Datum::MarkChanged()
+	{
+		InvalidateHash();
+		if (mType == DatumType::Table && mScope != nullptr)
+		{
+			mScope->MarkStructureChanged();
+		}
+
+		// Scopes above are already flagged once this Datum is
+		if (mScope != nullptr && !mChanged && mScope->IsTrackingChanges())
+		{
+			mChanged = true;
+			mScope->MarkChanged();
+		}
+	}
+
+	size_t Datum::Hash() const
+	{
+		if (mHashValid)
+		{
+			return mHash;
+		}
+
+		size_t hash = HashInteger((static_cast<std::uint64_t>(mType) << 56) ^ mSize);
+		switch (mType)
+		{
+		case DatumType::Integer:
+		case DatumType::Float:
+		case DatumType::Vector:
+		case DatumType::Matrix:
+			hash = HashInteger(hash ^ GameEngine::Hash(reinterpret_cast<const char*>(mData.Universe), mSize * sTypeSizeTable[static_cast<size_t>(mType)]));
+			break;
+		case DatumType::String:
+			for (size_t i = 0; i < mSize; ++i)
+			{
+				hash = HashInteger(hash ^ GameEngine::Hash(mData.String[i].data(), mData.String[i].size()));
+			}
+			break;
+		case DatumType::Table:
+			for (size_t i = 0; i < mSize; ++i)
+			{
+				hash = HashInteger(hash ^ mData.Table[i]->Hash());
+			}
+			break;
+		default:
+			break;
+		}
+
+		// Other external storage can be written without the Datum knowing, nested scopes cache their own hash
+		if ((mIsInternal || mInOwner) && mType != DatumType::Table)
+		{
+			mHash = hash;
+			mHashValid = true;
+		}
+		return hash;
+	}
+
 	void Datum::SetSize(size_t size)
 	{
 		CheckHasType();
+		if (size != mSize)
+		{
+			Detach();
+			MarkChanged();
+		}
 
 		if (size < mSize)
 		{
@@ -1161,6 +1690,14 @@ namespace GameEngine
 	void Datum::Clear()
 	{
 		CheckIsInternal();
+		if (mSize > 0)
+		{
+			MarkChanged();
+		}
+		if (!ReleaseShared())
+		{
+			return;  // Other Datums keep the elements
+		}
 		if (mType == DatumType::String)
 		{
 			for (size_t i = 0; i < mSize; ++i)
@@ -1176,6 +1713,8 @@ namespace GameEngine
 		CheckIsInternal();
 		if (mSize > 0)
 		{
+			Detach();
+			MarkChanged();
 			if (mType == DatumType::String)
 			{
 				mData.String[mSize - 1].~string();
@@ -1191,6 +1730,7 @@ namespace GameEngine
 
 		if (capacity > mCapacity)
 		{
+			Detach();
 			AllocateMemory(capacity);
 		}
 	}
@@ -1202,6 +1742,7 @@ namespace GameEngine
 
 		if (mSize < mCapacity)
 		{
+			Detach();
 			AllocateMemory(mSize);
 		}
 	}
@@ -1244,31 +1785,37 @@ namespace GameEngine
 
 	template<> int32_t& Datum::Front<int32_t>()
 	{
+		Detach();
 		FRONT_BODY(Integer);
 	}
 
 	template<> float& Datum::Front<float>()
 	{
+		Detach();
 		FRONT_BODY(Float);
 	}
 
 	template<> glm::vec4& Datum::Front<glm::vec4>()
 	{
+		Detach();
 		FRONT_BODY(Vector);
 	}
 
 	template<> glm::mat4& Datum::Front<glm::mat4>()
 	{
+		Detach();
 		FRONT_BODY(Matrix);
 	}
 
 	template<> std::string& Datum::Front<std::string>()
 	{
+		Detach();
 		FRONT_BODY(String);
 	}
 
 	template<> RTTI*& Datum::Front<RTTI*>()
 	{
+		Detach();
 		FRONT_BODY(Pointer);
 	}
 
@@ -1304,31 +1851,37 @@ namespace GameEngine
 
 	template<> int32_t& Datum::Back()
 	{
+		Detach();
 		BACK_BODY(Integer);
 	}
 
 	template<> float& Datum::Back()
 	{
+		Detach();
 		BACK_BODY(Float);
 	}
 
 	template<> glm::vec4& Datum::Back()
 	{
+		Detach();
 		BACK_BODY(Vector);
 	}
 
 	template<> glm::mat4& Datum::Back()
 	{
+		Detach();
 		BACK_BODY(Matrix);
 	}
 
 	template<> std::string& Datum::Back()
 	{
+		Detach();
 		BACK_BODY(String);
 	}
 
 	template<> RTTI*& Datum::Back()
 	{
+		Detach();
 		BACK_BODY(Pointer);
 	}
 
@@ -1362,7 +1915,7 @@ namespace GameEngine
 		BACK_BODY(Pointer);
 	}
 
-	bool Datum::SetFromString(const std::string& str, size_t index)
+	bool Datum::SetFromString(std::string_view str, size_t index)
 	{
 		switch (mType)
 		{
@@ -1381,39 +1934,74 @@ namespace GameEngine
 		}
 	}
 
-	std::string Datum::ToString(size_t index) const
+	size_t Datum::SetFromStrings(std::string_view str, size_t index)
+	{
+		switch (mType)
+		{
+		case DatumType::Integer:
+			return ParseList<int32_t>(*this, str, index);
+		case DatumType::Float:
+			return ParseList<float>(*this, str, index);
+		case DatumType::Vector:
+			return ParseList<vec4>(*this, str, index);
+		case DatumType::Matrix:
+			return ParseList<mat4>(*this, str, index);
+		default:
+			throw std::exception("Set from strings invalid type");
+		}
+	}
+
+	std::string Datum::ToString(size_t index, bool exact) const
 	{
-		CheckHasType();
 		std::string result;
+		AppendString(result, index, exact);
+		return result;
+	}
+
+	void Datum::AppendString(std::string& result, size_t index, bool exact) const
+	{
+		CheckHasType();
 		switch (mType)
 		{
 		case DatumType::Integer:
-			result = std::to_string(AsInt(index));
+			AppendNumber(result, AsInt(index));
 			break;
 		case DatumType::Float:
-			result = std::to_string(AsFloat(index));
+			AppendNumber(result, AsFloat(index), exact);
 			break;
 		case DatumType::Vector:
-			result = glm::to_string(AsVector(index));
+			result.append("vec4");
+			AppendNumbers(result, &AsVector(index)[0], exact);
 			break;
 		case DatumType::Matrix:
-			result = glm::to_string(AsMatrix(index));
+		{
+			const mat4& matrix = AsMatrix(index);
+			result.append("mat4x4(");
+			for (glm::length_t column = 0; column < 4; ++column)
+			{
+				if (column > 0)
+				{
+					result.append(", ");
+				}
+				AppendNumbers(result, &matrix[column][0], exact);
+			}
+			result.push_back(')');
 			break;
+		}
 		case DatumType::String:
 			result.append("\"");
 			result.append(AsString(index));
 			result.append("\"");
 			break;
 		case DatumType::Pointer:
-			result = AsPointer(index)->ToString();
+			result.append(AsPointer(index)->ToString());
 			break;
 		case DatumType::Table:
-			result = reinterpret_cast<RTTI*>(const_cast<Scope*>(&AsTable(index)))->ToString();
+			result.append(reinterpret_cast<RTTI*>(const_cast<Scope*>(&AsTable(index)))->ToString());
 			break;
 		default:
 			break;
 		}
-		return result;
 	}
 
 	void Datum::SetStorage(void* address, size_t size)
@@ -1435,6 +2023,7 @@ namespace GameEngine
 		mData.Universe = address;
 		mSize = size;
 		mCapacity = size;
+		InvalidateHash();
 	}
 
 	void Datum::SetStorage(int32_t* value, size_t size)
@@ -1467,8 +2056,30 @@ namespace GameEngine
 		SET_STORAGE_BODY(value, Pointer, size);
 	}
 
+	void Datum::ShareStorage(void* data, size_t size, ReferenceCount& references)
+	{
+		if (data == nullptr || size == 0)
+		{
+			throw std::exception("Share empty storage");
+		}
+		else if (mType != DatumType::Integer && mType != DatumType::Float && mType != DatumType::Vector && mType != DatumType::Matrix)
+		{
+			throw std::exception("Share storage on incompatible type");
+		}
+		CheckIsInternal();
+
+		ResetSelf();
+		references.mCount.fetch_add(1, std::memory_order_relaxed);
+		mShared.store(&references, std::memory_order_relaxed);
+		mData.Universe = data;
+		mSize = size;
+		mCapacity = size;
+		MarkChanged();
+	}
+
 	Datum::Iterator Datum::begin()
 	{
+		Detach();
 		return Iterator(*this, 0);
 	}
 
@@ -1498,10 +2109,10 @@ namespace GameEngine
 	}
 	
 #pragma region Private
-	bool Datum::SetFromStringInt(const std::string& str, size_t index)
+	bool Datum::SetFromStringInt(std::string_view str, size_t index)
 	{
-		int value;
-		if (sscanf_s(str.c_str(), "%d", &value) == 1)
+		int32_t value;
+		if (ParseWhole(str, value))
 		{
 			Set(value, index);
 			return true;
@@ -1509,10 +2120,10 @@ namespace GameEngine
 		return false;
 	}
 
-	bool Datum::SetFromStringFloat(const std::string& str, size_t index)
+	bool Datum::SetFromStringFloat(std::string_view str, size_t index)
 	{
 		float value;
-		if (sscanf_s(str.c_str(), "%f", &value) == 1)
+		if (ParseWhole(str, value))
 		{
 			Set(value, index);
 			return true;
@@ -1520,38 +2131,31 @@ namespace GameEngine
 		return false;
 	}
 
-	bool Datum::SetFromStringVector(const std::string& str, size_t index)
+	bool Datum::SetFromStringVector(std::string_view str, size_t index)
 	{
-		float v[4];
-		if (sscanf_s(str.c_str(), "vec4(%f, %f, %f, %f)", &v[0], &v[1], &v[2], &v[3]) == 4)
+		vec4 value;
+		if (ParseWhole(str, value))
 		{
-			Set(glm::vec4(v[0], v[1], v[2], v[3]), index);
+			Set(value, index);
 			return true;
 		}
 		return false;
 	}
 
-	bool Datum::SetFromStringMatrix(const std::string& str, size_t index)
+	bool Datum::SetFromStringMatrix(std::string_view str, size_t index)
 	{
-		float v[16];
-		if (sscanf_s(str.c_str(), "mat4x4((%f, %f, %f, %f), (%f, %f, %f, %f), (%f, %f, %f, %f), (%f, %f, %f, %f))",
-					 &v[0], &v[1], &v[2], &v[3],
-					 &v[4], &v[5], &v[6], &v[7],
-					 &v[8], &v[9], &v[10], &v[11],
-					 &v[12], &v[13], &v[14], &v[15]) == 16)
+		mat4 value;
+		if (ParseWhole(str, value))
 		{
-			Set(glm::mat4(v[0], v[1], v[2], v[3],
-						  v[4], v[5], v[6], v[7],
-						  v[8], v[9], v[10], v[11],
-						  v[12], v[13], v[14], v[15]), index);
+			Set(value, index);
 			return true;
 		}
 		return false;
 	}
 
-	bool Datum::SetFromStringString(const std::string& str, size_t index)
+	bool Datum::SetFromStringString(std::string_view str, size_t index)
 	{
-		Set(str, index);
+		Set(std::string(str), index);
 		return true;
 	}
 
@@ -1560,10 +2164,34 @@ namespace GameEngine
 		mSize = other.mSize;
 		mCapacity = other.mCapacity;
 		mType = other.mType;
-		mIsInternal = other.mIsInternal;
+		mIsInternal = other.mIsInternal || other.mInColumn;
+		mHashValid = other.mHashValid;
+		mHash = other.mHash;
 
-		if (other.mIsInternal)
+		// A slot in a column is copied like internal storage, it can't be shared since the column isn't reference counted
+		if (mIsInternal)
 		{
+			if (sCopyOnWrite && other.mIsInternal && CanShare(other))
+			{
+				// Both Datums hold one reference, the source gets its count on first share
+				ReferenceCount* shared = other.mShared.load(std::memory_order_acquire);
+				if (shared == nullptr)
+				{
+					ReferenceCount* created = new ReferenceCount();
+					if (other.mShared.compare_exchange_strong(shared, created, std::memory_order_acq_rel))
+					{
+						shared = created;
+					}
+					else
+					{
+						delete created;
+					}
+				}
+				shared->mCount.fetch_add(1, std::memory_order_relaxed);
+				mShared.store(shared, std::memory_order_relaxed);
+				mData = other.mData;
+				return;
+			}
 			AllocateMemory(mCapacity);
 			auto func = sCopyFunctions[static_cast<size_t>(mType)];
 			assert(func != nullptr);
@@ -1601,14 +2229,50 @@ namespace GameEngine
 
 	void Datum::AllocateMemory(size_t capacity)
 	{
-		if (capacity > 0)
+		assert(mShared.load(std::memory_order_relaxed) == nullptr);
+		const size_t typeSize = sTypeSizeTable[static_cast<size_t>(mType)];
+		if (capacity == 0)
+		{
+			if (!IsInline())
+			{
+				FreeBlock(mData.Universe, mCapacity * typeSize);
+			}
+			mData.Universe = nullptr;
+		}
+		else if (capacity == 1 && CanStoreInline(mType))
+		{
+			// Capacity never drops below size, so at most one element moves in
+			if (!IsInline())
+			{
+				if (mData.Universe != nullptr)
+				{
+					memcpy(&mInline, mData.Universe, mSize * typeSize);
+					FreeBlock(mData.Universe, mCapacity * typeSize);
+				}
+				mData.Universe = &mInline;
+			}
+		}
+		else if (IsInline())
 		{
-			mData.Universe = realloc(mData.Universe, capacity * sTypeSizeTable[static_cast<size_t>(mType)]);
+			// Spill to the heap
+			void* memory = AllocateBlock(capacity * typeSize);
+			memcpy(memory, &mInline, mSize * typeSize);
+			mData.Universe = memory;
+		}
+		else if (mArena == nullptr)
+		{
+			mData.Universe = realloc(mData.Universe, capacity * typeSize);
 		}
 		else
 		{
-			free(mData.Integer);
-			mData.Integer = nullptr;
+			// Arenas can't grow a block in place
+			void* memory = AllocateBlock(capacity * typeSize);
+			if (mData.Universe != nullptr)
+			{
+				memcpy(memory, mData.Universe, std::min(mSize, capacity) * typeSize);
+				FreeBlock(mData.Universe, mCapacity * typeSize);
+			}
+			mData.Universe = memory;
 		}
 		mCapacity = capacity;
 	}
@@ -1618,9 +2282,142 @@ namespace GameEngine
 		if (mIsInternal)
 		{
 			Clear();
-			free(mData.Integer);
+			if (!IsInline())
+			{
+				FreeBlock(mData.Universe, mCapacity * sTypeSizeTable[static_cast<size_t>(mType)]);
+			}
 		}
 		mData.Integer = nullptr;
+		mInColumn = false;
+		mInOwner = false;
+		mColumns.reset();
+	}
+
+	void* Datum::AllocateBlock(size_t size)
+	{
+		void* block = mArena != nullptr ? mArena->Allocate(size) : malloc(size);
+		if (block == nullptr)
+		{
+			throw std::bad_alloc();
+		}
+		return block;
+	}
+
+	void Datum::FreeBlock(void* block, size_t size)
+	{
+		if (mArena != nullptr)
+		{
+			mArena->Deallocate(block, size);
+		}
+		else
+		{
+			free(block);
+		}
+	}
+
+	inline bool Datum::IsInline() const
+	{
+		return mData.Universe == &mInline;
+	}
+
+	void Datum::StealData(Datum& other)
+	{
+		if (other.IsInline())
+		{
+			mInline = other.mInline;
+			mData.Universe = &mInline;
+		}
+		else
+		{
+			mData = other.mData;
+		}
+		mShared.store(other.mShared.exchange(nullptr, std::memory_order_relaxed), std::memory_order_relaxed);
+		other.mSize = 0;
+		other.mData.Integer = nullptr;
+	}
+
+	bool Datum::CanStoreInline(DatumType type)
+	{
+		static_assert(sizeof(glm::vec4) <= sizeof(InlineStorage) && alignof(glm::vec4) <= alignof(InlineStorage), "vec4 must fit inline storage");
+		return type != DatumType::String && type != DatumType::Unknown && sTypeSizeTable[static_cast<size_t>(type)] <= sizeof(InlineStorage);
+	}
+
+	bool Datum::CanShare(const Datum& other) const
+	{
+		return other.mSize > 0 && other.mType != DatumType::Table && !other.IsInline() && mArena == other.mArena;
+	}
+
+	void Datum::Detach()
+	{
+		InvalidateHash();
+		ReferenceCount* shared = mShared.load(std::memory_order_acquire);
+		if (shared == nullptr)
+		{
+			return;
+		}
+		mShared.store(nullptr, std::memory_order_relaxed);
+
+		// The last owner simply keeps storage of Datums, storage of someone else is always copied
+		if (shared->mCount.load(std::memory_order_acquire) > 1 || shared->mRelease != nullptr)
+		{
+			const size_t bytes = mCapacity * sTypeSizeTable[static_cast<size_t>(mType)];
+			void* data = mData.Universe;
+			mData.Universe = AllocateBlock(bytes);
+			auto func = sCopyFunctions[static_cast<size_t>(mType)];
+			assert(func != nullptr);
+			(this->*func)(data);
+			if (shared->mCount.fetch_sub(1, std::memory_order_acq_rel) > 1)
+			{
+				return;
+			}
+			if (shared->mRelease != nullptr)
+			{
+				shared->mRelease(*shared);
+				return;
+			}
+
+			// Every other owner let go while copying, so the old storage is left to this Datum
+			if (mType == DatumType::String)
+			{
+				for (size_t i = 0; i < mSize; ++i)
+				{
+					reinterpret_cast<std::string*>(data)[i].~string();
+				}
+			}
+			FreeBlock(data, bytes);
+		}
+		delete shared;
+	}
+
+	void Datum::InvalidateHash()
+	{
+		mHashValid = false;
+		if (mScope != nullptr)
+		{
+			mScope->InvalidateHash();
+		}
+	}
+
+	bool Datum::ReleaseShared()
+	{
+		ReferenceCount* shared = mShared.exchange(nullptr, std::memory_order_relaxed);
+		if (shared == nullptr)
+		{
+			return true;
+		}
+		if (shared->mCount.fetch_sub(1, std::memory_order_acq_rel) == 1)
+		{
+			if (shared->mRelease == nullptr)
+			{
+				delete shared;
+				return true;
+			}
+			shared->mRelease(*shared);
+		}
+		mData.Universe = nullptr;
+		mSize = 0;
+		mCapacity = 0;
+		return false;
 	}
 
 	void Datum::DummyFunction() const
@@ -2017,5 +2814,16 @@ namespace GameEngine
 
 #pragma endregion
 
+#pragma region CopyOnWriteGuard
+	CopyOnWriteGuard::CopyOnWriteGuard(bool enabled) :
+		mPrevious(Datum::sCopyOnWrite)
+	{
+		Datum::sCopyOnWrite = enabled;
+	}
 
+	CopyOnWriteGuard::~CopyOnWriteGuard()
+	{
+		Datum::sCopyOnWrite = mPrevious;
+	}
+#pragma endregion
 }
@@ -1,16 +1,24 @@
 #pragma once
+#include <atomic>
 #include <string>
+#include <string_view>
 #include <cstddef>
 #include <cstdint>
 #include <initializer_list>
+#include <memory>
 #include "glm/fwd.hpp"
 #include "vector.h"
+#include "Arena.h"
+#include "ArrayMath.h"
 #include "Macro.h"
 
 namespace GameEngine
 {
 	class RTTI;
 	class Scope;
+	class CopyOnWriteGuard;
+	class ScopeColumns;
+	class Attributed;
 
 	CLASS();
 	/// <summary>
@@ -18,11 +26,16 @@ namespace GameEngine
 	/// Datum suppor int32_t, float, OpenGL vec4, OpenGL mat4, and RTTI*
 	/// Datum can be regarded as a scalar or a homogeneous vector of supported data type
 	/// Once type is set, datum can't change its type and will throw exception if user tries to use it as different data type.
-	/// Datum can also serve as a wrapper for external storage
+	/// Datum can also serve as a wrapper for external storage.
+	/// Internal storage comes from the arena that was current when the Datum was constructed, or from the heap if there was none.
+	/// Copies made while a CopyOnWriteGuard is alive share internal storage with the source until either side is modified
 	/// </summary>
 	class Datum final
 	{
 		friend Scope;
+		friend CopyOnWriteGuard;
+		friend ScopeColumns;
+		friend Attributed;
 
 	public:
 		/// <summary>
@@ -846,6 +859,26 @@ namespace GameEngine
 			/// <returns>This datum after negating</returns>
 			Datum operator-() const;
 
+			/// <summary>
+			/// Operations supported by Compute
+			/// </summary>
+			using ArithmeticOperation = ArrayMath::Operation;
+
+			/// <summary>
+			/// Apply an arithmetic operation to every element of two datums and write the results into destination, without temporary datums.
+			/// Sizes must match, or one side has a single element that is applied to every element of the other side.
+			/// Works for int and float (mixing them gives float), vector and matrix with the same type or a single int or float.
+			/// Modulus works for int and float and gives int, matrix multiply and divide are matrix products, everything else is component-wise.
+			/// Destination gets the result type and size. It may be one of the operands, or an external Datum wrapping an array of the right size
+			/// </summary>
+			/// <param name="operation">The operation</param>
+			/// <param name="left">Left operand</param>
+			/// <param name="right">Right operand</param>
+			/// <param name="destination">Datum to write the results into</param>
+			/// <exception cref="std::exception">Types are not supported or sizes don't match</exception>
+			/// <exception cref="std::exception">Destination has a different type, or external storage of a different size</exception>
+			static void Compute(ArithmeticOperation operation, const Datum& left, const Datum& right, Datum& destination);
+
 			/// <summary>
 			/// Get the bool representation of this datum
 			/// Works only if this datum is int or float. 0 is false, other values are true
@@ -951,6 +984,47 @@ namespace GameEngine
 			/// <returns>True if Datum has internal storage, False otherwise</returns>
 			bool IsInternal() const;
 
+			/// <summary>
+			/// Check if internal storage is currently shared with other Datums by copy-on-write, or owned by someone else, see ShareStorage.
+			/// Any non-const access, including non-const AsXXX, Front, Back, begin and Find, gives this Datum its own copy first
+			/// </summary>
+			/// <returns>True if storage is shared</returns>
+			bool IsShared() const;
+
+			/// <summary>
+			/// Get the columns of a table Datum made columnar by Scope::MakeColumnar
+			/// </summary>
+			/// <returns>The columns, nullptr if this Datum isn't columnar</returns>
+			ScopeColumns* Columns();
+
+			/// <summary>
+			/// Get the columns of a table Datum made columnar by Scope::MakeColumnar
+			/// </summary>
+			/// <returns>The columns, nullptr if this Datum isn't columnar</returns>
+			const ScopeColumns* Columns() const;
+
+			/// <summary>
+			/// Check if this Datum changed since its scope last cleared changes. Always false unless the scope tracks changes, see Scope::TrackChanges
+			/// </summary>
+			/// <returns>True if Datum changed</returns>
+			bool IsChanged() const;
+
+			/// <summary>
+			/// Flag this Datum and every scope above it as changed, if its scope tracks changes.
+			/// Assignment, Set, PushBack, RemoveAt and every other modifying method do this already,
+			/// call it after writing through a reference returned by AsXXX, Front, Back or an Iterator. Also drops the cached hash of this Datum and every scope above it
+			/// </summary>
+			void MarkChanged();
+
+			/// <summary>
+			/// Get a hash of type and elements, equal for equal Datums, so different hashes prove Datums differ.
+			/// Elements are hashed by bytes, strings by characters, nested scopes by Scope::Hash and pointers only by count, since what they point to can change unseen.
+			/// Cached for internal storage, other than nested scopes, and for prescribed attributes stored in members, until the next non-const access or MarkChanged.
+			/// After writing a member variable behind a prescribed attribute directly, call MarkChanged
+			/// </summary>
+			/// <returns>Hash value</returns>
+			size_t Hash() const;
+
 			/// <summary>
 			/// Set number of elements for Datum.
 			/// If size is smaller than current size, remaining elements will be desctructed.
@@ -1312,7 +1386,7 @@ namespace GameEngine
 			/// <param name="value">The value to remove</param>
 			/// <returns>True if remove succeeds, False otherwise</returns>
 			/// <exception cref="std::exception">Datum has external storage</exception>
-			bool Remove(const std::string& value);
+			bool Remove(std::string_view value);
 
 			/// <summary>
 			/// Remove the first element equal to value
@@ -1377,7 +1451,7 @@ namespace GameEngine
 			/// <param name="value">The value to search</param>
 			/// <returns>Iterator pointing to the found element, or end() if not found</returns>
 			/// <exception cref="std::exception">Type mismatch</exception>
-			Iterator Find(const std::string& value);
+			Iterator Find(std::string_view value);
 
 			/// <summary>
 			/// Search for the element matching given value
@@ -1433,7 +1507,7 @@ namespace GameEngine
 			/// <param name="value">The value to search</param>
 			/// <returns>Iterator pointing to the found element, or end() if not found</returns>
 			/// <exception cref="std::exception">Type mismatch</exception>
-			ConstIterator Find(const std::string& value) const;
+			ConstIterator Find(std::string_view value) const;
 
 			/// <summary>
 			/// Search for the element matching given value
@@ -1452,22 +1526,46 @@ namespace GameEngine
 			ConstIterator Find(const Scope& value) const;
 
 			/// <summary>
-			/// Convert a string to certain data type and set the value to given position
+			/// Convert a string to certain data type and set the value to given position.
+			/// Numbers are parsed with std::from_chars, vectors and matrices in the form written by ToString, such as "vec4(1, 2, 3, 4)".
+			/// Whitespace between tokens is allowed, anything else makes the string invalid
 			/// </summary>
 			/// <param name="str">The string representing the value</param>
 			/// <param name="index">Position</param>
 			/// <returns>True if the value is set, False otherwise</returns>
 			/// <exception cref="std::exception">Datum has no type</exception>
-			bool SetFromString(const std::string& str, size_t index = 0);
+			bool SetFromString(std::string_view str, size_t index = 0);
+
+			/// <summary>
+			/// Parse a list of values separated by commas, such as "1, 2, 3" or "vec4(1, 2, 3, 4), vec4(5, 6, 7, 8)", in one pass
+			/// and set them starting at given position. Internal storage grows to fit, external storage stops at its size.
+			/// Parsing stops at the first value that is invalid. Works for int, float, vector and matrix
+			/// </summary>
+			/// <param name="str">The string representing the values</param>
+			/// <param name="index">Position of the first value</param>
+			/// <returns>Number of values set</returns>
+			/// <exception cref="std::exception">Datum type is not int, float, vector or matrix</exception>
+			size_t SetFromStrings(std::string_view str, size_t index = 0);
 
 			/// <summary>
 			/// Convert an element at given position to string
 			/// </summary>
 			/// <param name="index">Position</param>
+			/// <param name="exact">Write floats in the shortest form that parses back to the same value, instead of 6 decimals</param>
 			/// <returns>String representation of that element</returns>
 			/// <exception cref="std::exception">Datum has no type</exception>
 			/// <exception cref="std::exception">Index larger than size</exception>
-			std::string ToString(size_t index = 0) const;
+			std::string ToString(size_t index = 0, bool exact = false) const;
+
+			/// <summary>
+			/// Append the string representation of an element to a string, same as ToString without creating a temporary string
+			/// </summary>
+			/// <param name="result">The string to append to</param>
+			/// <param name="index">Position</param>
+			/// <param name="exact">Write floats in the shortest form that parses back to the same value, instead of 6 decimals</param>
+			/// <exception cref="std::exception">Datum has no type</exception>
+			/// <exception cref="std::exception">Index larger than size</exception>
+			void AppendString(std::string& result, size_t index = 0, bool exact = false) const;
 
 			void SetStorage(void* address, size_t size);
 
@@ -1525,6 +1623,36 @@ namespace GameEngine
 			/// <exception cref="std::exception">Type mismatch</exception>
 			void SetStorage(RTTI** value, size_t size);
 
+			/// <summary>
+			/// Reference count of internal storage shared by copy-on-write
+			/// </summary>
+			struct ReferenceCount
+			{
+				/// <summary>
+				/// Number of references, the creator of the count holds the first one
+				/// </summary>
+				std::atomic<size_t> mCount = 1;
+
+				/// <summary>
+				/// Called instead of freeing the elements when the last reference is dropped, for storage owned by someone else.
+				/// nullptr for storage of Datums, which the last Datum keeps as its own
+				/// </summary>
+				void (*mRelease)(ReferenceCount& references) = nullptr;
+			};
+
+			/// <summary>
+			/// Use integers, floats, vectors or matrices owned by someone else as internal storage, shared by copy-on-write.
+			/// The Datum never frees the elements, it gives itself its own copy on first modification, like a copy made under CopyOnWriteGuard,
+			/// and the elements are never written. The owner holds one reference while it lives, whoever drops the last one calls the release function of the count
+			/// </summary>
+			/// <param name="data">Address of the elements, aligned for the Datum type</param>
+			/// <param name="size">Number of elements at the address</param>
+			/// <param name="references">Reference count of the owner, with a release function</param>
+			/// <exception cref="std::exception">Address is nullptr or size is 0</exception>
+			/// <exception cref="std::exception">Datum type isn't integer, float, vector or matrix</exception>
+			/// <exception cref="std::exception">Datum has external storage</exception>
+			void ShareStorage(void* data, size_t size, ReferenceCount& references);
+
 			/// <summary>
 			/// Return the Iterator pointing the first element
 			/// </summary>
@@ -1604,13 +1732,77 @@ namespace GameEngine
 			/// </summary>
 			bool mIsInternal = true;
 
+			/// <summary>
+			/// Whether this Datum changed since changes were last cleared, only set while its scope tracks changes
+			/// </summary>
+			bool mChanged = false;
+
+			/// <summary>
+			/// Whether the external storage is a slot in a column of ScopeColumns. Copies get internal storage, since the slot belongs to the row
+			/// </summary>
+			bool mInColumn = false;
+
+			/// <summary>
+			/// Whether the external storage is a member variable of the Attributed object owning this Datum, a prescribed attribute.
+			/// Its hash is cached like internal storage, so the owner calls MarkChanged after writing the member
+			/// </summary>
+			bool mInOwner = false;
+
+			/// <summary>
+			/// Whether mHash is up to date
+			/// </summary>
+			mutable bool mHashValid = false;
+
+			/// <summary>
+			/// Hash of the content computed last, see Hash
+			/// </summary>
+			mutable size_t mHash = 0;
+
+			/// <summary>
+			/// Scope containing this Datum, nullptr for a Datum outside of any scope. Never copied or moved with the Datum
+			/// </summary>
+			Scope* mScope = nullptr;
+
+			/// <summary>
+			/// Storage for a single element of a type that fits, so that the common single value Datum doesn't allocate
+			/// </summary>
+			union InlineStorage
+			{
+				int32_t Integer;
+				float Float;
+				float Vector[4];
+				RTTI* Pointer;
+				Scope* Table;
+			};
+
+			/// <summary>
+			/// Inline storage, mData points here while capacity is 1 and type fits
+			/// </summary>
+			InlineStorage mInline;
+
+			/// <summary>
+			/// Arena that internal storage is allocated from, nullptr for the heap. Moves with the storage
+			/// </summary>
+			Arena* mArena = Arena::Current();
+
+			/// <summary>
+			/// Reference count shared by all Datums using the same internal storage, nullptr if storage isn't shared.
+			/// Mutable since copying from a const Datum starts sharing its storage
+			/// </summary>
+			mutable std::atomic<ReferenceCount*> mShared = nullptr;
+
+			/// <summary>
+			/// Columns of a columnar table Datum, nullptr otherwise. Moves with the Datum but is never copied
+			/// </summary>
+			std::unique_ptr<ScopeColumns> mColumns;
+
 			/// <summary>
 			/// Convert a string to int32_t and store it
 			/// </summary>
 			/// <param name="str">String representing int32_t</param>
 			/// <param name="index">Position</param>
 			/// <returns>Whether or not set is successful</returns>
-			bool SetFromStringInt(const std::string& str, size_t index);
+			bool SetFromStringInt(std::string_view str, size_t index);
 
 			/// <summary>
 			/// Convert a string to float and store it
@@ -1618,7 +1810,7 @@ namespace GameEngine
 			/// <param name="str">String representing float</param>
 			/// <param name="index">Position</param>
 			/// <returns>Whether or not set is successful</returns>
-			bool SetFromStringFloat(const std::string& str, size_t index);
+			bool SetFromStringFloat(std::string_view str, size_t index);
 
 			/// <summary>
 			/// Convert a string to vec4 and store it
@@ -1626,7 +1818,7 @@ namespace GameEngine
 			/// <param name="str">String representing vec4</param>
 			/// <param name="index">Position</param>
 			/// <returns>Whether or not set is successful</returns>
-			bool SetFromStringVector(const std::string& str, size_t index);
+			bool SetFromStringVector(std::string_view str, size_t index);
 
 			/// <summary>
 			/// Convert a string to mat4 and store it
@@ -1634,7 +1826,7 @@ namespace GameEngine
 			/// <param name="str">String representing mat4</param>
 			/// <param name="index">Position</param>
 			/// <returns>Whether or not set is successful</returns>
-			bool SetFromStringMatrix(const std::string& str, size_t index);
+			bool SetFromStringMatrix(std::string_view str, size_t index);
 
 			/// <summary>
 			/// Store a string
@@ -1642,7 +1834,7 @@ namespace GameEngine
 			/// <param name="str">String</param>
 			/// <param name="index">Position</param>
 			/// <returns>Whether or not set is successful</returns>
-			bool SetFromStringString(const std::string& str, size_t index);
+			bool SetFromStringString(std::string_view str, size_t index);
 
 			/// <summary>
 			/// Copy the content in another Datum to this one.
@@ -1680,13 +1872,80 @@ namespace GameEngine
 			/// </summary>
 			void ResetSelf();
 
+			/// <summary>
+			/// Allocate a block of internal storage from the arena of this Datum or the heap
+			/// </summary>
+			/// <param name="size">Size in bytes</param>
+			/// <returns>Address of the block</returns>
+			void* AllocateBlock(size_t size);
+
+			/// <summary>
+			/// Free a block of internal storage
+			/// </summary>
+			/// <param name="block">Address of the block, nullptr is ignored</param>
+			/// <param name="size">Size in bytes passed to AllocateBlock</param>
+			void FreeBlock(void* block, size_t size);
+
+			/// <summary>
+			/// Check if data lives in the inline storage of this Datum
+			/// </summary>
+			/// <returns>True if data is inline</returns>
+			bool IsInline() const;
+
+			/// <summary>
+			/// Take over data of another Datum that is being moved from. Inline data is copied since it can't be stolen
+			/// </summary>
+			/// <param name="other">The other Datum to move from</param>
+			void StealData(Datum& other);
+
+			/// <summary>
+			/// Check if a single element of given type fits the inline storage. Strings aren't trivially relocatable and matrices are too big
+			/// </summary>
+			/// <param name="type">Datum type</param>
+			/// <returns>True if the type can be stored inline</returns>
+			static bool CanStoreInline(DatumType type);
+
+			/// <summary>
+			/// Check if copying from another Datum can share its storage instead of copying every element.
+			/// Only non-empty heap or arena blocks of the same arena can be shared, tables always own their nested scopes
+			/// </summary>
+			/// <param name="other">The other Datum to copy from</param>
+			/// <returns>True if storage can be shared</returns>
+			bool CanShare(const Datum& other) const;
+
+			/// <summary>
+			/// Give this Datum its own copy of shared storage before it is modified. Does nothing if storage isn't shared.
+			/// Every possible write goes through here, so it also drops the cached hash of this Datum and the scopes above it
+			/// </summary>
+			void Detach();
+
+			/// <summary>
+			/// Drop the cached hash of this Datum and of every scope above it
+			/// </summary>
+			void InvalidateHash();
+
+			/// <summary>
+			/// Stop sharing storage without copying it. If other Datums still use it, this Datum becomes empty without capacity
+			/// </summary>
+			/// <returns>True if this Datum still owns its storage afterwards, false if it was left to others or belongs to someone else</returns>
+			bool ReleaseShared();
+
+			/// <summary>
+			/// Whether copies made on this thread share storage, see CopyOnWriteGuard
+			/// </summary>
+			static thread_local bool sCopyOnWrite;
+
 			/// <summary>
 			/// Invoke template specializations, to let compiler generate those code.
 			/// This function should NEVER be invoked.
 			/// </summary>
 			void DummyFunction() const;
 
-			static Vector<size_t> sTypeSizeTable;
+			/// <summary>
+			/// Size of each element of every type. This and the function tables below are plain arrays, initialized at compile time and never destroyed,
+			/// so Datums in other static objects, such as registered prototypes, can still be destroyed after them
+			/// </summary>
+			static const size_t sTypeSizeTable[];
 
 	#pragma region CompareFunction
 			using CompareFunction = bool(Datum::*)(void* data) const;
@@ -1695,7 +1954,7 @@ namespace GameEngine
 			bool CompareString(void* data) const;
 			bool ComparePointer(void* data) const;
 
-			static Vector<CompareFunction> sCompareFunctions;
+			static const CompareFunction sCompareFunctions[];
 	#pragma endregion
 
 	#pragma region CreateDefaultFunction
@@ -1704,7 +1963,7 @@ namespace GameEngine
 			void CreateDefaultPrimitive(size_t size);
 			void CreateDefaultString(size_t size);
 
-			static Vector<CreateDefaultFunction> sCreateDefaultFunctions;
+			static const CreateDefaultFunction sCreateDefaultFunctions[];
 	#pragma endregion
 
 	#pragma region CopyFunction
@@ -1713,13 +1972,39 @@ namespace GameEngine
 			void CopyPrimitive(void* data);
 			void CopyString(void* data);
 
-			static Vector<CopyFunction> sCopyFunctions;
+			static const CopyFunction sCopyFunctions[];
 	#pragma endregion
 
 
 #pragma endregion
 	};
 
+	/// <summary>
+	/// Make Datum copies on this thread share internal storage with their source for the lifetime of the guard, then restore the previous mode.
+	/// Each copy detaches on its first modification, so cloning a large prototype only pays for the data that is later changed.
+	/// References and iterators obtained before the copy still point to the shared storage, writing through them affects every copy
+	/// </summary>
+	class CopyOnWriteGuard final
+	{
+	public:
+		/// <summary>
+		/// Turn copy-on-write on or off
+		/// </summary>
+		/// <param name="enabled">Whether copies share storage</param>
+		explicit CopyOnWriteGuard(bool enabled = true);
+
+		CopyOnWriteGuard(const CopyOnWriteGuard&) = delete;
+		CopyOnWriteGuard& operator=(const CopyOnWriteGuard&) = delete;
+
+		/// <summary>
+		/// Restore the mode that was active before
+		/// </summary>
+		~CopyOnWriteGuard();
+
+	private:
+		bool mPrevious;
+	};
+
 	template<> int32_t& Datum::Front<int32_t>();
 	template<> float& Datum::Front<float>();
 	template<> glm::vec4& Datum::Front<glm::vec4>();
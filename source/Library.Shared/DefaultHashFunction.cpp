@@ -1,17 +1,140 @@
 #include "pch.h"
 #include "DefaultHashFunction.h"
+#include <cstring>
+#if defined(_MSC_VER) && defined(_M_X64)
+#include <intrin.h>
+#endif
 
 namespace GameEngine
 {
+	namespace
+	{
+		/// <summary>
+		/// Default secret of wyhash, four odd 64-bit constants with balanced bits
+		/// </summary>
+		constexpr std::uint64_t sSecret[4] = { 0xa0761d6478bd642fULL, 0xe7037ed1a0b428dbULL, 0x8ebc6af09c88c6e3ULL, 0x589965cc75374cc3ULL };
+
+		/// <summary>
+		/// Multiply two 64-bit values into 128 bits, store the low half in a and the high half in b
+		/// </summary>
+		inline void Multiply(std::uint64_t& a, std::uint64_t& b)
+		{
+#if defined(_MSC_VER) && defined(_M_X64)
+			a = _umul128(a, b, &b);
+#elif defined(__SIZEOF_INT128__)
+			const __uint128_t product = static_cast<__uint128_t>(a) * b;
+			a = static_cast<std::uint64_t>(product);
+			b = static_cast<std::uint64_t>(product >> 64);
+#else
+			// 32-bit targets, build the 128-bit product from four 32x32 products
+			const std::uint64_t aHigh = a >> 32, aLow = static_cast<std::uint32_t>(a);
+			const std::uint64_t bHigh = b >> 32, bLow = static_cast<std::uint32_t>(b);
+			const std::uint64_t highHigh = aHigh * bHigh, highLow = aHigh * bLow, lowHigh = aLow * bHigh, lowLow = aLow * bLow;
+			const std::uint64_t middle = highLow + (lowLow >> 32) + static_cast<std::uint32_t>(lowHigh);
+			a = (middle << 32) | static_cast<std::uint32_t>(lowLow);
+			b = highHigh + (middle >> 32) + (lowHigh >> 32);
+#endif
+		}
+
+		/// <summary>
+		/// Fold the 128-bit product of two values into 64 bits
+		/// </summary>
+		inline std::uint64_t Mix(std::uint64_t a, std::uint64_t b)
+		{
+			Multiply(a, b);
+			return a ^ b;
+		}
+
+		/// <summary>
+		/// Read 8 bytes as a little-endian word, data doesn't need to be aligned
+		/// </summary>
+		inline std::uint64_t Read8(const std::uint8_t* data)
+		{
+			std::uint64_t value;
+			std::memcpy(&value, data, sizeof(value));
+			return value;
+		}
+
+		/// <summary>
+		/// Read 4 bytes as a little-endian word, data doesn't need to be aligned
+		/// </summary>
+		inline std::uint64_t Read4(const std::uint8_t* data)
+		{
+			std::uint32_t value;
+			std::memcpy(&value, data, sizeof(value));
+			return value;
+		}
+
+		/// <summary>
+		/// Read 1 to 3 bytes, every byte is used at least once
+		/// </summary>
+		inline std::uint64_t Read3(const std::uint8_t* data, size_t size)
+		{
+			return (static_cast<std::uint64_t>(data[0]) << 16) | (static_cast<std::uint64_t>(data[size >> 1]) << 8) | data[size - 1];
+		}
+	}
+
 	size_t Hash(const char* data, size_t size)
 	{
-		size_t hash = 0;
-		for (size_t i = 0; i < size; ++i)
+		const std::uint8_t* bytes = reinterpret_cast<const std::uint8_t*>(data);
+		std::uint64_t seed = Mix(sSecret[0], sSecret[1]);
+		std::uint64_t a;
+		std::uint64_t b;
+
+		if (size <= 16)
+		{
+			// Short keys, which are most scope keys, take two overlapping reads
+			if (size >= 4)
+			{
+				const size_t offset = (size >> 3) << 2;
+				a = (Read4(bytes) << 32) | Read4(bytes + offset);
+				b = (Read4(bytes + size - 4) << 32) | Read4(bytes + size - 4 - offset);
+			}
+			else if (size > 0)
+			{
+				a = Read3(bytes, size);
+				b = 0;
+			}
+			else
+			{
+				a = b = 0;
+			}
+		}
+		else
 		{
-			hash += 13 * *data;
-			++data;
+			size_t remaining = size;
+			if (remaining > 48)
+			{
+				// Three independent lanes so the multiplies can overlap
+				std::uint64_t lane1 = seed;
+				std::uint64_t lane2 = seed;
+				do
+				{
+					seed = Mix(Read8(bytes) ^ sSecret[1], Read8(bytes + 8) ^ seed);
+					lane1 = Mix(Read8(bytes + 16) ^ sSecret[2], Read8(bytes + 24) ^ lane1);
+					lane2 = Mix(Read8(bytes + 32) ^ sSecret[3], Read8(bytes + 40) ^ lane2);
+					bytes += 48;
+					remaining -= 48;
+				} while (remaining > 48);
+				seed ^= lane1 ^ lane2;
+			}
+
+			while (remaining > 16)
+			{
+				seed = Mix(Read8(bytes) ^ sSecret[1], Read8(bytes + 8) ^ seed);
+				bytes += 16;
+				remaining -= 16;
+			}
+
+			// Last 16 bytes, may overlap with bytes already consumed
+			a = Read8(bytes + remaining - 16);
+			b = Read8(bytes + remaining - 8);
 		}
-		return hash;
+
+		a ^= sSecret[1];
+		b ^= seed;
+		Multiply(a, b);
+		return static_cast<size_t>(Mix(a ^ sSecret[0] ^ size, b ^ sSecret[1]));
 	}
 
 	size_t DefaultHash<char*>::operator()(const char* key) const
@@ -23,14 +146,14 @@ namespace GameEngine
 		return Hash(key, strlen(key));
 	}
 
-	size_t DefaultHash<std::string>::operator()(const std::string& key) const
+	size_t DefaultHash<std::string>::operator()(std::string_view key) const
 	{
-		return Hash(key.c_str(), key.length());
+		return Hash(key.data(), key.length());
 	}
 
-	size_t DefaultHash<const std::string>::operator()(const std::string& key) const
+	size_t DefaultHash<const std::string>::operator()(std::string_view key) const
 	{
-		return Hash(key.c_str(), key.length());
+		return Hash(key.data(), key.length());
 	}
 
 	bool DefaultKeyEquality<char*>::operator()(const char* one, const char* two) const
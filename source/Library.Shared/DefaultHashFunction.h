@@ -1,15 +1,31 @@
 #pragma once
 #include <string>
+#include <string_view>
+#include <cstdint>
+#include <type_traits>
 
 namespace GameEngine
 {
 	/// <summary>
-	/// Generic hash function to handle byte stream
+	/// Generic hash function to handle byte stream. Reads the stream 8 bytes at a time and folds each word with a 64x64->128 bit multiply (wyhash),
+	/// so the result depends on byte order and all bits are mixed
 	/// </summary>
+	/// <param name="data">Start of byte stream</param>
+	/// <param name="size">Number of bytes</param>
+	/// <returns>Hash value</returns>
 	size_t Hash(const char* data, size_t size);
 
 	/// <summary>
-	/// Default hash functor for generic types. Converts any object to byte stream and use additive hash to all byte values
+	/// Hash function for a single 64-bit integer, such as a pointer or RTTI::IdType.
+	/// Uses the MurmurHash3 finalizer so every input bit affects every output bit, including the low bits used to pick a bucket
+	/// </summary>
+	/// <param name="key">Integer to hash</param>
+	/// <returns>Hash value</returns>
+	size_t HashInteger(std::uint64_t key);
+
+	/// <summary>
+	/// Default hash functor for generic types. Integers, enums and pointers are mixed with HashInteger().
+	/// Any other object is converted to byte stream and hashed with Hash()
 	/// </summary>
 	template <typename TKey>
 	struct DefaultHash
@@ -18,7 +34,7 @@ namespace GameEngine
 	};
 
 	/// <summary>
-	/// Specialization of DefaulHash for char* type, will use additive hash on all characters in the string, string should be null-terminated
+	/// Specialization of DefaulHash for char* type, will hash all characters in the string, string should be null-terminated
 	/// </summary>
 	/// <exception cref="std::exception">char* is nullptr</exception>
 	template<>
@@ -28,21 +44,25 @@ namespace GameEngine
 	};
 
 	/// <summary>
-	/// Specialization of DefaulHash for std::string type, will use additive hash on all characters in the string
+	/// Specialization of DefaulHash for std::string type, will hash all characters in the string.
+	/// Transparent, std::string_view and string literals hash to the same value as the equal std::string
 	/// </summary>
 	template<>
 	struct DefaultHash<std::string>
 	{
-		size_t operator()(const std::string& key) const;
+		using is_transparent = void;
+		size_t operator()(std::string_view key) const;
 	};
 
 	/// <summary>
-	/// Specialization of DefaulHash for std::string type, will use additive hash on all characters in the string
+	/// Specialization of DefaulHash for std::string type, will hash all characters in the string.
+	/// Transparent, std::string_view and string literals hash to the same value as the equal std::string
 	/// </summary>
 	template<>
 	struct DefaultHash<const std::string>
 	{
-		size_t operator()(const std::string& key) const;
+		using is_transparent = void;
+		size_t operator()(std::string_view key) const;
 	};
 
 	/// <summary>
@@ -62,6 +82,26 @@ namespace GameEngine
 	{
 		bool operator()(const char* one, const char* two) const;
 	};
+
+	/// <summary>
+	/// Specialization of DefaultKeyEquality for std::string type. Transparent, so std::string_view keys compare without building a std::string
+	/// </summary>
+	template<>
+	struct DefaultKeyEquality<std::string>
+	{
+		using is_transparent = void;
+		bool operator()(std::string_view one, std::string_view two) const;
+	};
+
+	/// <summary>
+	/// Check if a hash or key equality functor accepts other key types than the map key type, which is marked by a nested is_transparent type.
+	/// HashMap and FlatHashMap only enable heterogeneous lookup when both functors are transparent
+	/// </summary>
+	template <typename TFunctor, typename = void>
+	struct IsTransparent : std::false_type {};
+
+	template <typename TFunctor>
+	struct IsTransparent<TFunctor, std::void_t<typename TFunctor::is_transparent>> : std::true_type {};
 }
 
 #include "DefaultHashFunction.inl"
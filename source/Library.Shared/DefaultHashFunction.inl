@@ -2,11 +2,32 @@
 
 namespace GameEngine
 {
+	inline size_t HashInteger(std::uint64_t key)
+	{
+		key ^= key >> 33;
+		key *= 0xff51afd7ed558ccdULL;
+		key ^= key >> 33;
+		key *= 0xc4ceb9fe1a85ec53ULL;
+		key ^= key >> 33;
+		return static_cast<size_t>(key);
+	}
+
 	template <typename TKey>
 	size_t DefaultHash<TKey>::operator()(const TKey& key) const
 	{
-		const char* address = reinterpret_cast<const char*>(&key);
-		return Hash(address, sizeof(key));
+		if constexpr (std::is_pointer_v<TKey>)
+		{
+			return HashInteger(reinterpret_cast<std::uintptr_t>(key));
+		}
+		else if constexpr (std::is_integral_v<TKey> || std::is_enum_v<TKey>)
+		{
+			return HashInteger(static_cast<std::uint64_t>(key));
+		}
+		else
+		{
+			const char* address = reinterpret_cast<const char*>(&key);
+			return Hash(address, sizeof(key));
+		}
 	}
 
 	template <typename TKey>
@@ -14,4 +35,9 @@ namespace GameEngine
 	{
 		return one == two;
 	}
+
+	inline bool DefaultKeyEquality<std::string>::operator()(std::string_view one, std::string_view two) const
+	{
+		return one == two;
+	}
 }
\ No newline at end of file
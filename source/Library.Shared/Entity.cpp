@@ -20,9 +20,10 @@ Entity::Entity(RTTI::IdType type) : Attributed(type)
 
 Entity::~Entity()
 {
-	for (auto& child : mChildren)
+	// Each child removes itself from mChildren when it is handed over
+	while (!mChildren.IsEmpty())
 	{
-		child->SetTransformParent(mTransformParent);
+		mChildren.Back()->SetTransformParent(mTransformParent);
 	}
 }
 
@@ -34,6 +35,7 @@ const std::string& Entity::Name() const
 void Entity::SetName(const std::string& name)
 {
 	mName = name;
+	MarkAttributeChanged("Name");
 }
 
 void Entity::SetSector(Sector& sector)
@@ -127,10 +129,12 @@ bool Entity::IsActive() const
 void Entity::SetActive(bool active)
 {
 	mActive = active ? 1 : 0;
+	MarkAttributeChanged("Active");
 }
 
 Action* Entity::CreateAction(std::string className, std::string instanceName)
 {
+	ArenaGuard guard(GetArena());
 	Scope* product = Factory<Scope>::Create(className);
 	assert(product != nullptr && product->Is(Action::TypeIdClass()));
 	Action* action = static_cast<Action*>(product);
@@ -157,14 +161,13 @@ void Entity::SetTransformParent(Entity* parent)
 	{
 		if (mTransformParent != nullptr)
 		{
-			auto it = std::find(mChildren.begin(), mChildren.end(), this);
-			mChildren.erase(it);
+			mTransformParent->mChildren.Remove(this);
 		}
 
 		mTransformParent = parent;
 		if (mTransformParent != nullptr)
 		{
-			mTransformParent->mChildren.push_back(this);
+			mTransformParent->mChildren.PushBack(this);
 			mTransform.SetParent(&mTransformParent->mTransform);
 		}
 		else
@@ -185,7 +185,7 @@ namespace GameEngine
 		int mActive = 1;
 
 		Entity* mTransformParent = nullptr;
-		std::vector<Entity*> mChildren;
+		SmallVector<Entity*, 4> mChildren;
 	};
 
 	DECLARE_FACTORY(Entity, Scope);
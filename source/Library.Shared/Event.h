@@ -1,6 +1,6 @@
 #pragma once
 #include "RTTI.h"
-#include "vector.h"
+#include "SmallVector.h"
 #include <chrono>
 
 namespace GameEngine
@@ -64,13 +64,13 @@ namespace GameEngine
 			/// <summary>
 			/// Current working list of subscribers
 			/// </summary>
-			Vector<IEventSubscriber*> mSubscribers;
+			SmallVector<IEventSubscriber*, 4> mSubscribers;
 
 			/// <summary>
 			/// If Subscribe/Unsubscribe method is invoked by some subscribers' Notify method, the subscriber goes in here
 			/// True indicates pending add, false indicates pending remove
 			/// </summary>
-			Vector<std::tuple<IEventSubscriber*, bool>> mPendingList;
+			SmallVector<std::tuple<IEventSubscriber*, bool>, 4> mPendingList;
 
 			/// <summary>
 			/// Whether the event is iterating through all subscribers.
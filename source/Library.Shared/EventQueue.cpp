@@ -44,7 +44,7 @@ void EventQueue::Update()
 	// if there is a pointer to an item in the queue, that pointer might point to a different event after partition!
 	// So never expose the queue item pointer to outside world.
 	auto now = mTime->CurrentTime();
-	auto bound = partition(mQueue.begin(), mQueue.end(), [&now](shared_ptr<BaseEvent> event)
+	auto bound = partition(mQueue.begin(), mQueue.end(), [&now](const shared_ptr<BaseEvent>& event)
 	{
 		return !event->IsExpired(now);
 	});
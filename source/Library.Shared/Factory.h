@@ -2,7 +2,7 @@
 #include <string>
 #include <exception>
 #include "gsl/gsl"
-#include "HashMap.h"
+#include "ConcurrentRegistry.h"
 #include "RTTI.h"
 
 namespace GameEngine
@@ -11,6 +11,7 @@ namespace GameEngine
 	/// The factory abstruct class.
 	/// Expose necessary methods for users to create objects with name.
 	/// Before using this, must use DECLARE_FACTORY macro to create concrete factory and instantiate one (and only one) concrete factory instance.
+	/// Find() and Create() are lock-free and can be called from any thread, adding and removing factories blocks until no lookup sees the old table.
 	/// </summary>
 	/// <example>
 	/// DECLARE_FACTORY(Foo, BaseType);              // Define concrete factory type
@@ -73,7 +74,7 @@ namespace GameEngine
 		/// <summary>
 		/// The map from class name to corresponding concrete factory instance
 		/// </summary>
-		static HashMap<std::string, const Factory<T>*> sFactoryMap;
+		static ConcurrentRegistry<std::string, const Factory<T>*> sFactoryMap;
 	};
 
 	#define DECLARE_FACTORY(_type, _baseType)													 \
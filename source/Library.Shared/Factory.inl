@@ -3,22 +3,23 @@
 namespace GameEngine
 {
 	template <typename T>
-	HashMap<std::string, const Factory<T>*> Factory<T>::sFactoryMap;
+	ConcurrentRegistry<std::string, const Factory<T>*> Factory<T>::sFactoryMap;
 
 	template <typename T>
 	const Factory<T>* Factory<T>::Find(const std::string& name)
 	{
-		auto it = sFactoryMap.Find(name);
-		return it == sFactoryMap.end() ? nullptr : (it->second);
+		const Factory<T>* factory = nullptr;
+		sFactoryMap.TryGet(name, factory);
+		return factory;
 	}
 
 	template <typename T>
 	gsl::owner<T*> Factory<T>::Create(const std::string& name)
 	{
-		auto it = sFactoryMap.Find(name);
-		if (it != sFactoryMap.end())
+		const Factory<T>* factory = Find(name);
+		if (factory != nullptr)
 		{
-			return it->second->Create();
+			return factory->Create();
 		}
 
 		return nullptr;
@@ -27,16 +28,22 @@ namespace GameEngine
 	template <typename T>
 	void Factory<T>::Add(const Factory<T>& factory)
 	{
-		if (sFactoryMap.ContainsKey(factory.ClassName()))
+		sFactoryMap.Update([&factory](auto& map)
 		{
-			throw std::exception("Add factory with existing name");
-		}
-		sFactoryMap[factory.ClassName()] = &factory;
+			if (map.ContainsKey(factory.ClassName()))
+			{
+				throw std::exception("Add factory with existing name");
+			}
+			map[factory.ClassName()] = &factory;
+		});
 	}
 
 	template <typename T>
 	void Factory<T>::Remove(const Factory<T>& factory)
 	{
-		sFactoryMap.Remove(factory.ClassName());
+		sFactoryMap.Update([&factory](auto& map)
+		{
+			map.Remove(factory.ClassName());
+		});
 	}
 }
\ No newline at end of file
@@ -0,0 +1,668 @@
+#pragma once
+
+#include <utility>
+#include <exception>
+#include <algorithm>
+#include <cstdint>
+#include <new>
+#include "DefaultHashFunction.h"
+#include "vector.h"
+
+namespace GameEngine
+{
+	/// <summary>
+	/// FlatHashMap is an open-addressing associative container with the same interface as HashMap.
+	/// Slots are grouped by 16 and every slot owns one control byte holding 7 bits of the key hash, so a lookup scans a whole group of control bytes at once (with SSE2 when available)
+	/// and only touches a pair when those 7 bits match. A miss usually ends in the first group without dereferencing anything.
+	/// Pairs live in pooled blocks that never move, so references and pointers to pairs stay valid until the pair is removed, even across Resize().
+	/// Iterators are invalidated by Insert() and Resize(), same as HashMap.
+	/// </summary>
+	template <typename TKey, typename TValue, typename HashFunctor = DefaultHash<TKey>, typename KeyEqualityFunctor = DefaultKeyEquality<TKey>>
+	class FlatHashMap
+	{
+	public:
+		using PairType = std::pair<const TKey, TValue>;
+
+	private:
+		using ControlType = int8_t;
+
+		/// <summary>
+		/// Enable heterogeneous lookup with key types other than TKey, only when both functors are transparent
+		/// </summary>
+		template <typename TLookupKey>
+		using EnableIfTransparent = std::enable_if_t<IsTransparent<HashFunctor>::value && IsTransparent<KeyEqualityFunctor>::value && !std::is_same_v<TLookupKey, TKey>>;
+
+	public:
+		/// <summary>
+		/// An iterator is a container that points to one pair in the FlatHashMap.
+		/// Generally it is used to traverse FlatHashMap, or specify a "position" in the FlatHashMap so that user can remove / modify based on that position.
+		/// It can be compared with another iterator by evaluating the pair they are pointing to.
+		/// It can also be incremented to point to next pair in FlatHashMap.
+		/// </summary>
+		class Iterator final
+		{
+			friend FlatHashMap;
+			friend class ConstIterator;
+
+		public:
+			/// <summary>
+			/// Default constructor, create an Iterator without parent and without a item to point to
+			/// </summary>
+			Iterator() = default;
+
+			/// <summary>
+			/// Copy constructor. Shallow copy the content in other Iterator to this one
+			/// </summary>
+			/// <param name="other">The other Iterator to copy from</param>
+			Iterator(const Iterator& other) = default;
+
+			/// <summary>
+			/// Move constructor. Shallow copy the content in other Iterator to this one
+			/// </summary>
+			/// <param name="other">The other Iterator to move from</param>
+			Iterator(Iterator&& other) = default;
+
+			/// <summary>
+			/// Copy assignment, shallow copy the content of another Iterator to this one.
+			/// </summary>
+			/// <param name="other">The other Iterator to copy from</param>
+			/// <returns>This Iterator after copy</returns>
+			Iterator& operator=(const Iterator& other) = default;
+
+			/// <summary>
+			/// Move assignment, shallow copy the content of another Iterator to this one.
+			/// </summary>
+			/// <param name="other">The other Iterator to move from</param>
+			/// <returns>This Iterator after move</returns>
+			Iterator& operator=(Iterator&& other) = default;
+
+			/// <summary>
+			/// Destructor
+			/// </summary>
+			~Iterator() = default;
+
+			/// <summary>
+			/// Check if two Iterators are the equal. Two Iterators are equal if they belong to the same container and they point to the same slot.
+			/// </summary>
+			/// <param name="other">The other Iterator to compare with</param>
+			/// <returns>True if two Iterators are equal, False otherwise</returns>
+			bool operator==(const Iterator& other) const;
+
+			/// <summary>
+			/// Check if two Iterators are the equal. Two Iterators are equal if they belong to the same container and they point to the same slot.
+			/// </summary>
+			/// <param name="other">The other Iterator to compare with</param>
+			/// <returns>True if two Iterators are not equal, False otherwise</returns>
+			bool operator!=(const Iterator& other) const;
+
+			/// <summary>
+			/// Get the reference of pair pointed by the Iterator
+			/// </summary>
+			/// <returns>The reference of pair pointed by the Iterator</returns>
+			/// <exception cref="std::exception">The Iterator points to nothing</exception>
+			PairType& operator*();
+
+			/// <summary>
+			/// Get the reference of pair pointed by the Iterator
+			/// </summary>
+			/// <returns>The reference of pair pointed by the Iterator</returns>
+			/// <exception cref="std::exception">The Iterator points to nothing</exception>
+			const PairType& operator*() const;
+
+			/// <summary>
+			/// Get the pointer to pair pointed by the Iterator
+			/// </summary>
+			/// <returns>The pointer to pair pointed by the Iterator</returns>
+			/// <exception cref="std::exception">The Iterator points to nothing</exception>
+			PairType* operator->();
+
+			/// <summary>
+			/// Get the pointer to pair pointed by the Iterator
+			/// </summary>
+			/// <returns>The pointer to pair pointed by the Iterator</returns>
+			/// <exception cref="std::exception">The Iterator points to nothing</exception>
+			const PairType* operator->() const;
+
+			/// <summary>
+			/// Pre-increment operator. Increment the Iterator to point to next pair in the FlatHashMap and return it
+			/// </summary>
+			/// <returns>The Iterator after increment</returns>
+			/// <exception cref="std::exception">The Iterator has no parent</exception>
+			Iterator& operator++();
+
+			/// <summary>
+			/// Post-increment operator. Increment the Iterator to point to next pair in the FlatHashMap and return the copy of the original Iterator before copying
+			/// </summary>
+			/// <param name="">A signature parameter to tell this is a post increment</param>
+			/// <returns>The copy of Iterator before increment</returns>
+			/// <exception cref="std::exception">The Iterator has no parent</exception>
+			Iterator operator++(int);
+
+		private:
+			/// <summary>
+			/// Construct Iterator with given FlatHashMap and slot index
+			/// </summary>
+			/// <param name="owner">Parent FlatHashMap</param>
+			/// <param name="index">Index of slot</param>
+			Iterator(const FlatHashMap& owner, size_t index);
+
+			/// <summary>
+			/// Parent FlatHashMap
+			/// </summary>
+			const FlatHashMap* mOwner = nullptr;
+
+			/// <summary>
+			/// Index of slot, equals to slot count when pointing to end
+			/// </summary>
+			size_t mIndex = 0;
+		};
+
+		/// <summary>
+		/// A ConstIterator is same as Iterator except that its operator*() only returns const reference, which disallows end-user to change the content
+		/// </summary>
+		class ConstIterator final
+		{
+			friend FlatHashMap;
+
+		public:
+			/// <summary>
+			/// Default constructor, create an ConstIterator without parent and without a item to point to
+			/// </summary>
+			ConstIterator() = default;
+
+			/// <summary>
+			/// Copy constructor. Shallow copy the content in other ConstIterator to this one
+			/// </summary>
+			/// <param name="other">The other ConstIterator to copy from</param>
+			ConstIterator(const ConstIterator& other) = default;
+
+			/// <summary>
+			/// Move constructor. Shallow copy the content in other ConstIterator to this one
+			/// </summary>
+			/// <param name="other">The other ConstIterator to move from</param>
+			ConstIterator(ConstIterator&& other) = default;
+
+			/// <summary>
+			/// Copy constructor. Shallow copy the content in other Iterator to this one. Promote Iterator to ConstIterator
+			/// </summary>
+			/// <param name="other">The other Iterator to copy from</param>
+			ConstIterator(const Iterator& other);
+
+			/// <summary>
+			/// Copy assignment, shallow copy the content of another ConstIterator to this one.
+			/// </summary>
+			/// <param name="other">The other ConstIterator to copy from</param>
+			/// <returns>This ConstIterator after copy</returns>
+			ConstIterator& operator=(const ConstIterator& other) = default;
+
+			/// <summary>
+			/// Move assignment, shallow copy the content of another ConstIterator to this one.
+			/// </summary>
+			/// <param name="other">The other ConstIterator to move from</param>
+			/// <returns>This ConstIterator after move</returns>
+			ConstIterator& operator=(ConstIterator&& other) = default;
+
+			/// <summary>
+			/// Copy assignment, copy the contents from other Iterator to this ConstIterator. Promote Iterator to ConstIterator
+			/// </summary>
+			/// <param name="other">The other Iterator to copy from</param>
+			/// <returns>This ConstIterator after copy</returns>
+			ConstIterator& operator=(const Iterator& other);
+
+			/// <summary>
+			/// Destructor
+			/// </summary>
+			~ConstIterator() = default;
+
+			/// <summary>
+			/// Check if two ConstIterators are the equal. Two ConstIterators are equal if they belong to the same container and they point to the same slot.
+			/// </summary>
+			/// <param name="other">The other ConstIterator to compare with</param>
+			/// <returns>True if two ConstIterators are equal, False otherwise</returns>
+			bool operator==(const ConstIterator& other) const;
+
+			/// <summary>
+			/// Check if two ConstIterators are the equal. Two ConstIterators are equal if they belong to the same container and they point to the same slot.
+			/// </summary>
+			/// <param name="other">The other ConstIterator to compare with</param>
+			/// <returns>True if two ConstIterators are not equal, False otherwise</returns>
+			bool operator!=(const ConstIterator& other) const;
+
+			/// <summary>
+			/// Get the reference of pair pointed by the ConstIterator in const form
+			/// </summary>
+			/// <returns>The reference of pair pointed by the ConstIterator</returns>
+			/// <exception cref="std::exception">The ConstIterator points to nothing</exception>
+			const PairType& operator*() const;
+
+			/// <summary>
+			/// Get the pointer to pair pointed by the ConstIterator in const form
+			/// </summary>
+			/// <returns>The pointer to pair pointed by the ConstIterator</returns>
+			/// <exception cref="std::exception">The ConstIterator points to nothing</exception>
+			const PairType* operator->() const;
+
+			/// <summary>
+			/// Pre-increment operator. Increment the ConstIterator to point to next item in the FlatHashMap and return it
+			/// </summary>
+			/// <returns>The ConstIterator after increment</returns>
+			/// <exception cref="std::exception">The ConstIterator has no parent</exception>
+			ConstIterator& operator++();
+
+			/// <summary>
+			/// Post-increment operator. Increment the ConstIterator to point to next item in the FlatHashMap and return the copy of the original ConstIterator before copying
+			/// </summary>
+			/// <param name="">A signature parameter to tell this is a post increment</param>
+			/// <returns>The copy of ConstIterator before increment</returns>
+			/// <exception cref="std::exception">The ConstIterator has no parent</exception>
+			ConstIterator operator++(int);
+
+		private:
+			/// <summary>
+			/// Construct ConstIterator with given FlatHashMap and slot index
+			/// </summary>
+			/// <param name="owner">Parent FlatHashMap</param>
+			/// <param name="index">Index of slot</param>
+			ConstIterator(const FlatHashMap& owner, size_t index);
+
+			/// <summary>
+			/// Parent FlatHashMap
+			/// </summary>
+			const FlatHashMap* mOwner = nullptr;
+
+			/// <summary>
+			/// Index of slot, equals to slot count when pointing to end
+			/// </summary>
+			size_t mIndex = 0;
+		};
+
+		/// <summary>
+		/// Default constructor, construct FlatHashMap that can hold given number of pairs without growing
+		/// </summary>
+		/// <param name="capacity">Number of pairs to reserve for</param>
+		explicit FlatHashMap(size_t capacity = 32);
+
+		/// <summary>
+		/// Constructor that takes a list of initial pairs and capacity
+		/// </summary>
+		/// <param name="list">Initial list of pairs</param>
+		/// <param name="capacity">Number of pairs to reserve for</param>
+		FlatHashMap(const std::initializer_list<PairType>& list, size_t capacity = 32);
+
+		/// <summary>
+		/// Copy constructor
+		/// </summary>
+		/// <param name="other">The other FlatHashMap to copy from</param>
+		FlatHashMap(const FlatHashMap& other);
+
+		/// <summary>
+		/// Move constructor
+		/// </summary>
+		/// <param name="other">The other FlatHashMap to move from</param>
+		FlatHashMap(FlatHashMap&& other);
+
+		/// <summary>
+		/// Destructor, release all memory
+		/// </summary>
+		~FlatHashMap();
+
+		/// <summary>
+		/// Copy assignment, clear current FlatHashMap and deep copy contents in other to this one
+		/// </summary>
+		/// <param name="other">The other FlatHashMap to copy from</param>
+		/// <returns>This FlatHashMap</returns>
+		FlatHashMap& operator=(const FlatHashMap& other);
+
+		/// <summary>
+		/// Move assignment, clear current FlatHashMap and move contents in other to this one
+		/// </summary>
+		/// <param name="other">The other FlatHashMap to move from</param>
+		/// <returns>This FlatHashMap</returns>
+		FlatHashMap& operator=(FlatHashMap&& other);
+
+		/// <summary>
+		/// Get the reference to mapped value with given key. If key doesn't exist, one such pair will be default-constructed
+		/// </summary>
+		/// <param name="key">Key value to look for</param>
+		/// <returns>Reference to mapped value at key position</returns>
+		TValue& operator[](const TKey& key);
+
+		/// <summary>
+		/// Equivalent to calling "At()", get the pair at position specified by key
+		/// </summary>
+		/// <param name="key">Key value to look for</param>
+		/// <returns>Reference to mapped value at key position, if exists</returns>
+		/// <exception cref="std::exception">The given key doesn't exist</exception>
+		const TValue& operator[](const TKey& key) const;
+
+		/// <summary>
+		/// Get reference to mapped value with given key
+		/// </summary>
+		/// <param name="key">Key value to look for</param>
+		/// <returns>Reference to mapped value at key position, if exists</returns>
+		/// <exception cref="std::exception">The given key doesn't exist</exception>
+		TValue& At(const TKey& key);
+
+		/// <summary>
+		/// Get reference to mapped value with given key
+		/// </summary>
+		/// <param name="key">Key value to look for</param>
+		/// <returns>Reference to mapped value at key position, if exists</returns>
+		/// <exception cref="std::exception">The given key doesn't exist</exception>
+		const TValue& At(const TKey& key) const;
+
+		/// <summary>
+		/// Destroy all pairs in FlatHashMap and free their memory. The slot array is kept
+		/// </summary>
+		void Clear();
+
+		/// <summary>
+		/// Get the number of pairs
+		/// </summary>
+		/// <returns>Number of pairs</returns>
+		size_t Size() const;
+
+		/// <summary>
+		/// Check if FlatHashMap is empty
+		/// </summary>
+		/// <returns>True if empty, False otherwise</returns>
+		bool IsEmpty() const;
+
+		/// <summary>
+		/// Get the number of slots, which is always zero or a power of two no less than 16
+		/// </summary>
+		/// <returns>Number of slots</returns>
+		size_t BucketCount() const;
+
+		/// <summary>
+		/// Check if given key exists in FlatHashMap
+		/// </summary>
+		/// <param name="key">The key value to check</param>
+		/// <returns>True if key exists, False otherwise</returns>
+		bool ContainsKey(const TKey& key) const;
+
+		/// <summary>
+		/// Check if given key exists in FlatHashMap, and set the iterator to point to that pair
+		/// </summary>
+		/// <param name="key">The key value to check</param>
+		/// <param name="iterator">Return paramter, points to the pair with given key, or end() if that key doesn't exist</param>
+		/// <returns>True if key exists, False otherwise</returns>
+		bool ContainsKey(const TKey& key, Iterator& iterator);
+
+		/// <summary>
+		/// Check if given key exists in FlatHashMap, and set the iterator to point to that pair
+		/// </summary>
+		/// <param name="key">The key value to check</param>
+		/// <param name="iterator">Return paramter, points to the pair with given key, or end() if that key doesn't exist</param>
+		/// <returns>True if key exists, False otherwise</returns>
+		bool ContainsKey(const TKey& key, ConstIterator& iterator) const;
+
+		/// <summary>
+		/// Search for the pair with given key and return the iterator pointing that pair
+		/// </summary>
+		/// <param name="key">Key value to search</param>
+		/// <returns>Iterator pointing that pair with given key, or end() if such pair doesn't exist</returns>
+		Iterator Find(const TKey& key);
+
+		/// <summary>
+		/// Search for the pair with given key and return the iterator pointing that pair
+		/// </summary>
+		/// <param name="key">Key value to search</param>
+		/// <returns>Iterator pointing that pair with given key, or end() if such pair doesn't exist</returns>
+		ConstIterator Find(const TKey& key) const;
+
+		/// <summary>
+		/// Search for the pair with a key of another type, e.g. std::string_view or a string literal for std::string keys, without constructing a TKey.
+		/// Only available when both the hash functor and the key equality functor are transparent
+		/// </summary>
+		/// <param name="key">Key value to search</param>
+		/// <returns>Iterator pointing that pair with given key, or end() if such pair doesn't exist</returns>
+		template <typename TLookupKey, typename = EnableIfTransparent<TLookupKey>>
+		Iterator Find(const TLookupKey& key);
+
+		/// <summary>
+		/// Search for the pair with a key of another type, e.g. std::string_view or a string literal for std::string keys, without constructing a TKey.
+		/// Only available when both the hash functor and the key equality functor are transparent
+		/// </summary>
+		/// <param name="key">Key value to search</param>
+		/// <returns>Iterator pointing that pair with given key, or end() if such pair doesn't exist</returns>
+		template <typename TLookupKey, typename = EnableIfTransparent<TLookupKey>>
+		ConstIterator Find(const TLookupKey& key) const;
+
+		/// <summary>
+		/// Check if given key of another type exists, without constructing a TKey.
+		/// Only available when both the hash functor and the key equality functor are transparent
+		/// </summary>
+		/// <param name="key">The key value to check</param>
+		/// <returns>True if key exists, False otherwise</returns>
+		template <typename TLookupKey, typename = EnableIfTransparent<TLookupKey>>
+		bool ContainsKey(const TLookupKey& key) const;
+
+		/// <summary>
+		/// Insert the pair to FlatHashMap. If there is a pair with same key already, insertion will not happen.
+		/// Grows the slot array when it is 7/8 full, which invalidates all iterators but not references to pairs
+		/// </summary>
+		/// <param name="pair">The pair to be inserted</param>
+		/// <returns>Iterator to inserted pair, or an existing pair with same key if such pair exists</returns>
+		std::pair<Iterator, bool> Insert(const PairType& pair);
+
+		/// <summary>
+		/// Remove the pair with given key
+		/// </summary>
+		/// <param name="key">The key value to search for</param>
+		void Remove(const TKey& key);
+
+		/// <summary>
+		/// Remove the pair pointed by iterator
+		/// </summary>
+		/// <param name="position">The iterator pointing to the pair to be deleted</param>
+		/// <exception cref="std::exception">The iterator has no parent</exception>
+		void Remove(const Iterator& position);
+
+		/// <summary>
+		/// Change the number of slots so that given number of pairs fit without growing, and rehash the entire map.
+		/// The map never shrinks below its current size. Pairs are not moved, only the slots pointing to them
+		/// </summary>
+		/// <param name="capacity">Number of pairs to reserve for</param>
+		void Resize(size_t capacity);
+
+		/// <summary>
+		/// Return the Iterator pointing to first pair, or pointing to nothing if FlatHashMap is empty
+		/// </summary>
+		/// <returns>Iterator pointing to first pair</returns>
+		Iterator begin();
+
+		/// <summary>
+		/// Return the ConstIterator pointing to first pair, or pointing to nothing if FlatHashMap is empty
+		/// </summary>
+		/// <returns>ConstIterator pointing to first pair</returns>
+		ConstIterator begin() const;
+
+		/// <summary>
+		/// Return the Iterator pointing to nothing in the FlatHashMap
+		/// </summary>
+		/// <returns>Iterator pointing to nothing in the FlatHashMap</returns>
+		Iterator end();
+
+		/// <summary>
+		/// Return the ConstIterator pointing to nothing in the FlatHashMap
+		/// </summary>
+		/// <returns>ConstIterator pointing to nothing in the FlatHashMap</returns>
+		ConstIterator end() const;
+
+		/// <summary>
+		/// Return the ConstIterator pointing to first pair, or pointing to nothing if FlatHashMap is empty
+		/// </summary>
+		/// <returns>ConstIterator pointing to first pair</returns>
+		ConstIterator cbegin() const;
+
+		/// <summary>
+		/// Return the ConstIterator pointing to nothing in the FlatHashMap
+		/// </summary>
+		/// <returns>ConstIterator pointing to nothing in the FlatHashMap</returns>
+		ConstIterator cend() const;
+
+	private:
+		/// <summary>
+		/// Number of slots whose control bytes are matched together
+		/// </summary>
+		static constexpr size_t GROUP_WIDTH = 16;
+
+		/// <summary>
+		/// Control byte of a slot that has never been used since last rehash. Stops the probe
+		/// </summary>
+		static constexpr ControlType EMPTY = -128;
+
+		/// <summary>
+		/// Control byte of a slot whose pair was removed. The probe continues past it
+		/// </summary>
+		static constexpr ControlType DELETED = -2;
+
+		/// <summary>
+		/// Deep copy contents from another FlatHashMap to this one, keeping the same slot layout
+		/// </summary>
+		/// <param name="other">The other FlatHashMap to copy from</param>
+		void DeepCopy(const FlatHashMap& other);
+
+		/// <summary>
+		/// Destroy all pairs, release all memory and leave the map with no slot
+		/// </summary>
+		void Destroy();
+
+		/// <summary>
+		/// Scramble the user hash so that both the group index and the 7 control bits are well distributed
+		/// </summary>
+		/// <param name="key">Key to hash, TKey or a key type accepted by transparent functors</param>
+		/// <returns>Mixed hash value</returns>
+		template <typename TLookupKey>
+		size_t HashKey(const TLookupKey& key) const;
+
+		/// <summary>
+		/// Find the slot holding given key
+		/// </summary>
+		/// <param name="key">Key to search, TKey or a key type accepted by transparent functors</param>
+		/// <param name="hash">Mixed hash of the key</param>
+		/// <returns>Slot index, or slot count if not found</returns>
+		template <typename TLookupKey>
+		size_t FindIndex(const TLookupKey& key, size_t hash) const;
+
+		/// <summary>
+		/// Find the first empty or deleted slot along the probe sequence of given hash
+		/// </summary>
+		/// <param name="hash">Mixed hash of the key</param>
+		/// <returns>Slot index</returns>
+		size_t FindInsertIndex(size_t hash) const;
+
+		/// <summary>
+		/// Allocate new slot arrays and re-point every pair into them
+		/// </summary>
+		/// <param name="slotCount">New number of slots, must be zero or a power of two no less than GROUP_WIDTH</param>
+		void Rehash(size_t slotCount);
+
+		/// <summary>
+		/// Make room for one more pair, either by purging deleted slots or by doubling the slot array
+		/// </summary>
+		void Grow();
+
+		/// <summary>
+		/// Construct a pair in the entry pool
+		/// </summary>
+		/// <param name="pair">Pair to copy from</param>
+		/// <returns>Address of the new pair, stable until it is freed</returns>
+		PairType* AllocateEntry(const PairType& pair);
+
+		/// <summary>
+		/// Destroy a pair and return its memory to the entry pool
+		/// </summary>
+		/// <param name="entry">Pair to free</param>
+		void FreeEntry(PairType* entry);
+
+		/// <summary>
+		/// Destroy all pairs and release all pool blocks
+		/// </summary>
+		void ReleaseEntries();
+
+		/// <summary>
+		/// Get the smallest valid slot count that holds given number of pairs under the 7/8 load factor
+		/// </summary>
+		/// <param name="capacity">Number of pairs</param>
+		/// <returns>Slot count</returns>
+		static size_t SlotCountFor(size_t capacity);
+
+		/// <summary>
+		/// Get the number of pairs that fit in given slot count under the 7/8 load factor
+		/// </summary>
+		/// <param name="slotCount">Number of slots</param>
+		/// <returns>Maximum number of pairs</returns>
+		static size_t MaxLoadFor(size_t slotCount);
+
+		/// <summary>
+		/// Compare one byte against a group of control bytes
+		/// </summary>
+		/// <param name="group">First control byte of the group</param>
+		/// <param name="value">Byte to look for</param>
+		/// <returns>Bit mask, bit i is set if group[i] equals to value</returns>
+		static uint32_t MatchGroup(const ControlType* group, ControlType value);
+
+		/// <summary>
+		/// Find empty or deleted slots in a group of control bytes
+		/// </summary>
+		/// <param name="group">First control byte of the group</param>
+		/// <returns>Bit mask, bit i is set if group[i] is empty or deleted</returns>
+		static uint32_t MatchGroupFree(const ControlType* group);
+
+		/// <summary>
+		/// Get the index of lowest set bit
+		/// </summary>
+		/// <param name="mask">Non-zero bit mask</param>
+		/// <returns>Bit index</returns>
+		static size_t LowestBit(uint32_t mask);
+
+		/// <summary>
+		/// One control byte per slot. Non-negative value means the slot is full and holds the low 7 bits of the mixed hash
+		/// </summary>
+		ControlType* mControl = nullptr;
+
+		/// <summary>
+		/// One pair address per slot, only meaningful when the slot is full
+		/// </summary>
+		PairType** mSlots = nullptr;
+
+		/// <summary>
+		/// Number of slots
+		/// </summary>
+		size_t mSlotCount = 0;
+
+		/// <summary>
+		/// Number of empty slots that can still be filled before the map needs to grow
+		/// </summary>
+		size_t mGrowthLeft = 0;
+
+		/// <summary>
+		/// Total number of pairs in FlatHashMap
+		/// </summary>
+		size_t mSize = 0;
+
+		/// <summary>
+		/// Memory blocks of the entry pool
+		/// </summary>
+		Vector<void*> mEntryBlocks;
+
+		/// <summary>
+		/// Unused pair storage in the entry pool
+		/// </summary>
+		Vector<PairType*> mFreeEntries;
+
+		/// <summary>
+		/// Function to use when calculating hash value
+		/// </summary>
+		HashFunctor mHashFunction = HashFunctor();
+
+		/// <summary>
+		/// Function to use when comparing two key values
+		/// </summary>
+		KeyEqualityFunctor mKeyEqualityFunction = KeyEqualityFunctor();
+	};
+}
+
+#include "FlatHashMap.inl"
@@ -0,0 +1,752 @@
+#pragma once
+
+#include <cstring>
+#include <cstdlib>
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__)
+#define FLAT_HASH_MAP_SSE2
+#include <emmintrin.h>
+#endif
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace GameEngine
+{
+#pragma region Public
+	template <typename TKey, typename TValue, typename HashFunctor, typename KeyEqualityFunctor>
+	FlatHashMap<TKey, TValue, HashFunctor, KeyEqualityFunctor>::FlatHashMap(size_t capacity)
+	{
+		Rehash(SlotCountFor(capacity));
+	}
+
+	template <typename TKey, typename TValue, typename HashFunctor, typename KeyEqualityFunctor>
+	FlatHashMap<TKey, TValue, HashFunctor, KeyEqualityFunctor>::FlatHashMap(const std::initializer_list<PairType>& list, size_t capacity)
+	{
+		Rehash(SlotCountFor(std::max(capacity, list.size())));
+		for (const auto& pair : list)
+		{
+			Insert(pair);
+		}
+	}
+
+	template <typename TKey, typename TValue, typename HashFunctor, typename KeyEqualityFunctor>
+	FlatHashMap<TKey, TValue, HashFunctor, KeyEqualityFunctor>::FlatHashMap(const FlatHashMap& other)
+	{
+		DeepCopy(other);
+	}
+
+	template <typename TKey, typename TValue, typename HashFunctor, typename KeyEqualityFunctor>
+	FlatHashMap<TKey, TValue, HashFunctor, KeyEqualityFunctor>::FlatHashMap(FlatHashMap&& other) :
+		mControl(other.mControl),
+		mSlots(other.mSlots),
+		mSlotCount(other.mSlotCount),
+		mGrowthLeft(other.mGrowthLeft),
+		mSize(other.mSize),
+		mEntryBlocks(std::move(other.mEntryBlocks)),
+		mFreeEntries(std::move(other.mFreeEntries)),
+		mHashFunction(other.mHashFunction),
+		mKeyEqualityFunction(other.mKeyEqualityFunction)
+	{
+		other.mControl = nullptr;
+		other.mSlots = nullptr;
+		other.mSlotCount = 0;
+		other.mGrowthLeft = 0;
+		other.mSize = 0;
+	}
+
+	template <typename TKey, typename TValue, typename HashFunctor, typename KeyEqualityFunctor>
+	FlatHashMap<TKey, TValue, HashFunctor, KeyEqualityFunctor>::~FlatHashMap()
+	{
+		Destroy();
+	}
+
+	template <typename TKey, typename TValue, typename HashFunctor, typename KeyEqualityFunctor>
+	FlatHashMap<TKey, TValue, HashFunctor, KeyEqualityFunctor>& FlatHashMap<TKey, TValue, HashFunctor, KeyEqualityFunctor>::operator=(const FlatHashMap& other)
+	{
+		if (this != &other)
+		{
+			Destroy();
+			DeepCopy(other);
+		}
+		return *this;
+	}
+
+	template <typename TKey, typename TValue, typename HashFunctor, typename KeyEqualityFunctor>
+	FlatHashMap<TKey, TValue, HashFunctor, KeyEqualityFunctor>& FlatHashMap<TKey, TValue, HashFunctor, KeyEqualityFunctor>::operator=(FlatHashMap&& other)
+	{
+		if (this != &other)
+		{
+			Destroy();
+			mControl = other.mControl;
+			mSlots = other.mSlots;
+			mSlotCount = other.mSlotCount;
+			mGrowthLeft = other.mGrowthLeft;
+			mSize = other.mSize;
+			mEntryBlocks = std::move(other.mEntryBlocks);
+			mFreeEntries = std::move(other.mFreeEntries);
+			mHashFunction = other.mHashFunction;
+			mKeyEqualityFunction = other.mKeyEqualityFunction;
+
+			other.mControl = nullptr;
+			other.mSlots = nullptr;
+			other.mSlotCount = 0;
+			other.mGrowthLeft = 0;
+			other.mSize = 0;
+		}
+		return *this;
+	}
+
+	template <typename TKey, typename TValue, typename HashFunctor, typename KeyEqualityFunctor>
+	TValue& FlatHashMap<TKey, TValue, HashFunctor, KeyEqualityFunctor>::operator[](const TKey& key)
+	{
+		// Find existing entry, only construct default value when missing
+		const size_t index = FindIndex(key, HashKey(key));
+		if (index < mSlotCount)
+		{
+			return mSlots[index]->second;
+		}
+
+		return Insert(std::make_pair(key, TValue())).first->second;
+	}
+
+	template <typename TKey, typename TValue, typename HashFunctor, typename KeyEqualityFunctor>
+	const TValue& FlatHashMap<TKey, TValue, HashFunctor, KeyEqualityFunctor>::operator[](const TKey& key) const
+	{
+		return At(key);
+	}
+
+	template <typename TKey, typename TValue, typename HashFunctor, typename KeyEqualityFunctor>
+	TValue& FlatHashMap<TKey, TValue, HashFunctor, KeyEqualityFunctor>::At(const TKey& key)
+	{
+		const size_t index = FindIndex(key, HashKey(key));
+		if (index < mSlotCount)
+		{
+			return mSlots[index]->second;
+		}
+		else
+		{
+			throw std::exception("Entry with given key does not exist");
+		}
+	}
+
+	template <typename TKey, typename TValue, typename HashFunctor, typename KeyEqualityFunctor>
+	const TValue& FlatHashMap<TKey, TValue, HashFunctor, KeyEqualityFunctor>::At(const TKey& key) const
+	{
+		return const_cast<FlatHashMap<TKey, TValue, HashFunctor, KeyEqualityFunctor>*>(this)->At(key);
+	}
+
+	template <typename TKey, typename TValue, typename HashFunctor, typename KeyEqualityFunctor>
+	void FlatHashMap<TKey, TValue, HashFunctor, KeyEqualityFunctor>::Clear()
+	{
+		ReleaseEntries();
+		if (mSlotCount > 0)
+		{
+			memset(mControl, EMPTY, mSlotCount);
+		}
+		mGrowthLeft = MaxLoadFor(mSlotCount);
+		mSize = 0;
+	}
+
+	template <typename TKey, typename TValue, typename HashFunctor, typename KeyEqualityFunctor>
+	inline size_t FlatHashMap<TKey, TValue, HashFunctor, KeyEqualityFunctor>::Size() const
+	{
+		return mSize;
+	}
+
+	template <typename TKey, typename TValue, typename HashFunctor, typename KeyEqualityFunctor>
+	inline bool FlatHashMap<TKey, TValue, HashFunctor, KeyEqualityFunctor>::IsEmpty() const
+	{
+		return mSize == 0;
+	}
+
+	template <typename TKey, typename TValue, typename HashFunctor, typename KeyEqualityFunctor>
+	inline size_t FlatHashMap<TKey, TValue, HashFunctor, KeyEqualityFunctor>::BucketCount() const
+	{
+		return mSlotCount;
+	}
+
+	template <typename TKey, typename TValue, typename HashFunctor, typename KeyEqualityFunctor>
+	bool FlatHashMap<TKey, TValue, HashFunctor, KeyEqualityFunctor>::ContainsKey(const TKey& key) const
+	{
+		return FindIndex(key, HashKey(key)) < mSlotCount;
+	}
+
+	template <typename TKey, typename TValue, typename HashFunctor, typename KeyEqualityFunctor>
+	bool FlatHashMap<TKey, TValue, HashFunctor, KeyEqualityFunctor>::ContainsKey(const TKey& key, Iterator& iterator)
+	{
+		iterator = Find(key);
+		return iterator != end();
+	}
+
+	template <typename TKey, typename TValue, typename HashFunctor, typename KeyEqualityFunctor>
+	bool FlatHashMap<TKey, TValue, HashFunctor, KeyEqualityFunctor>::ContainsKey(const TKey& key, ConstIterator& iterator) const
+	{
+		iterator = Find(key);
+		return iterator != end();
+	}
+
+	template <typename TKey, typename TValue, typename HashFunctor, typename KeyEqualityFunctor>
+	typename FlatHashMap<TKey, TValue, HashFunctor, KeyEqualityFunctor>::Iterator FlatHashMap<TKey, TValue, HashFunctor, KeyEqualityFunctor>::Find(const TKey& key)
+	{
+		return Iterator(*this, FindIndex(key, HashKey(key)));
+	}
+
+	template <typename TKey, typename TValue, typename HashFunctor, typename KeyEqualityFunctor>
+	typename FlatHashMap<TKey, TValue, HashFunctor, KeyEqualityFunctor>::ConstIterator FlatHashMap<TKey, TValue, HashFunctor, KeyEqualityFunctor>::Find(const TKey& key) const
+	{
+		return ConstIterator(*this, FindIndex(key, HashKey(key)));
+	}
+
+	template <typename TKey, typename TValue, typename HashFunctor, typename KeyEqualityFunctor>
+	template <typename TLookupKey, typename>
+	typename FlatHashMap<TKey, TValue, HashFunctor, KeyEqualityFunctor>::Iterator FlatHashMap<TKey, TValue, HashFunctor, KeyEqualityFunctor>::Find(const TLookupKey& key)
+	{
+		return Iterator(*this, FindIndex(key, HashKey(key)));
+	}
+
+	template <typename TKey, typename TValue, typename HashFunctor, typename KeyEqualityFunctor>
+	template <typename TLookupKey, typename>
+	typename FlatHashMap<TKey, TValue, HashFunctor, KeyEqualityFunctor>::ConstIterator FlatHashMap<TKey, TValue, HashFunctor, KeyEqualityFunctor>::Find(const TLookupKey& key) const
+	{
+		return ConstIterator(*this, FindIndex(key, HashKey(key)));
+	}
+
+	template <typename TKey, typename TValue, typename HashFunctor, typename KeyEqualityFunctor>
+	template <typename TLookupKey, typename>
+	bool FlatHashMap<TKey, TValue, HashFunctor, KeyEqualityFunctor>::ContainsKey(const TLookupKey& key) const
+	{
+		return FindIndex(key, HashKey(key)) < mSlotCount;
+	}
+
+	template <typename TKey, typename TValue, typename HashFunctor, typename KeyEqualityFunctor>
+	std::pair<typename FlatHashMap<TKey, TValue, HashFunctor, KeyEqualityFunctor>::Iterator, bool> FlatHashMap<TKey, TValue, HashFunctor, KeyEqualityFunctor>::Insert(const PairType& pair)
+	{
+		// Check if there exists same key
+		const size_t hash = HashKey(pair.first);
+		const size_t existing = FindIndex(pair.first, hash);
+		if (existing < mSlotCount)
+		{
+			return std::make_pair(Iterator(*this, existing), false);
+		}
+
+		// Reusing a deleted slot doesn't consume growth, only taking an empty one does
+		size_t index = mSlotCount > 0 ? FindInsertIndex(hash) : mSlotCount;
+		if (index == mSlotCount || (mGrowthLeft == 0 && mControl[index] == EMPTY))
+		{
+			Grow();
+			index = FindInsertIndex(hash);
+		}
+
+		if (mControl[index] == EMPTY)
+		{
+			--mGrowthLeft;
+		}
+		mSlots[index] = AllocateEntry(pair);
+		mControl[index] = static_cast<ControlType>(hash & 0x7F);
+		++mSize;
+		return std::make_pair(Iterator(*this, index), true);
+	}
+
+	template <typename TKey, typename TValue, typename HashFunctor, typename KeyEqualityFunctor>
+	void FlatHashMap<TKey, TValue, HashFunctor, KeyEqualityFunctor>::Remove(const TKey& key)
+	{
+		Remove(Find(key));
+	}
+
+	template <typename TKey, typename TValue, typename HashFunctor, typename KeyEqualityFunctor>
+	void FlatHashMap<TKey, TValue, HashFunctor, KeyEqualityFunctor>::Remove(const Iterator& position)
+	{
+		if (position.mOwner != this)
+		{
+			throw std::exception("Iterator doesn't belong to the container");
+		}
+
+		if (position.mIndex < mSlotCount && mControl[position.mIndex] >= 0)
+		{
+			const size_t index = position.mIndex;
+			FreeEntry(mSlots[index]);
+			--mSize;
+
+			// If the group still has an empty slot, it has never been full since last rehash, so no probe ever walked past it.
+			// The slot can then go back to empty instead of leaving a tombstone behind
+			if (MatchGroup(mControl + (index & ~(GROUP_WIDTH - 1)), EMPTY) != 0)
+			{
+				mControl[index] = EMPTY;
+				++mGrowthLeft;
+			}
+			else
+			{
+				mControl[index] = DELETED;
+			}
+		}
+	}
+
+	template <typename TKey, typename TValue, typename HashFunctor, typename KeyEqualityFunctor>
+	void FlatHashMap<TKey, TValue, HashFunctor, KeyEqualityFunctor>::Resize(size_t capacity)
+	{
+		Rehash(SlotCountFor(std::max(capacity, mSize)));
+	}
+
+	template <typename TKey, typename TValue, typename HashFunctor, typename KeyEqualityFunctor>
+	typename FlatHashMap<TKey, TValue, HashFunctor, KeyEqualityFunctor>::Iterator FlatHashMap<TKey, TValue, HashFunctor, KeyEqualityFunctor>::begin()
+	{
+		size_t index = 0;
+		while (index < mSlotCount && mControl[index] < 0)
+		{
+			++index;
+		}
+		return Iterator(*this, index);
+	}
+
+	template <typename TKey, typename TValue, typename HashFunctor, typename KeyEqualityFunctor>
+	typename FlatHashMap<TKey, TValue, HashFunctor, KeyEqualityFunctor>::ConstIterator FlatHashMap<TKey, TValue, HashFunctor, KeyEqualityFunctor>::begin() const
+	{
+		return ConstIterator(const_cast<FlatHashMap<TKey, TValue, HashFunctor, KeyEqualityFunctor>*>(this)->begin());
+	}
+
+	template <typename TKey, typename TValue, typename HashFunctor, typename KeyEqualityFunctor>
+	typename FlatHashMap<TKey, TValue, HashFunctor, KeyEqualityFunctor>::Iterator FlatHashMap<TKey, TValue, HashFunctor, KeyEqualityFunctor>::end()
+	{
+		return Iterator(*this, mSlotCount);
+	}
+
+	template <typename TKey, typename TValue, typename HashFunctor, typename KeyEqualityFunctor>
+	typename FlatHashMap<TKey, TValue, HashFunctor, KeyEqualityFunctor>::ConstIterator FlatHashMap<TKey, TValue, HashFunctor, KeyEqualityFunctor>::end() const
+	{
+		return ConstIterator(*this, mSlotCount);
+	}
+
+	template <typename TKey, typename TValue, typename HashFunctor, typename KeyEqualityFunctor>
+	typename FlatHashMap<TKey, TValue, HashFunctor, KeyEqualityFunctor>::ConstIterator FlatHashMap<TKey, TValue, HashFunctor, KeyEqualityFunctor>::cbegin() const
+	{
+		return begin();
+	}
+
+	template <typename TKey, typename TValue, typename HashFunctor, typename KeyEqualityFunctor>
+	typename FlatHashMap<TKey, TValue, HashFunctor, KeyEqualityFunctor>::ConstIterator FlatHashMap<TKey, TValue, HashFunctor, KeyEqualityFunctor>::cend() const
+	{
+		return end();
+	}
+#pragma endregion
+
+#pragma region Private
+	template <typename TKey, typename TValue, typename HashFunctor, typename KeyEqualityFunctor>
+	void FlatHashMap<TKey, TValue, HashFunctor, KeyEqualityFunctor>::DeepCopy(const FlatHashMap& other)
+	{
+		mHashFunction = other.mHashFunction;
+		mKeyEqualityFunction = other.mKeyEqualityFunction;
+		mSlotCount = other.mSlotCount;
+		mGrowthLeft = other.mGrowthLeft;
+		mSize = 0;
+		if (mSlotCount > 0)
+		{
+			// Same hash function gives the same layout, so control bytes can be copied as they are
+			mControl = new ControlType[mSlotCount];
+			mSlots = new PairType*[mSlotCount];
+			memcpy(mControl, other.mControl, mSlotCount);
+			for (size_t i = 0; i < mSlotCount; ++i)
+			{
+				if (mControl[i] >= 0)
+				{
+					mSlots[i] = AllocateEntry(*other.mSlots[i]);
+					++mSize;
+				}
+			}
+		}
+	}
+
+	template <typename TKey, typename TValue, typename HashFunctor, typename KeyEqualityFunctor>
+	void FlatHashMap<TKey, TValue, HashFunctor, KeyEqualityFunctor>::Destroy()
+	{
+		ReleaseEntries();
+		delete[] mControl;
+		delete[] mSlots;
+		mControl = nullptr;
+		mSlots = nullptr;
+		mSlotCount = 0;
+		mGrowthLeft = 0;
+		mSize = 0;
+	}
+
+	template <typename TKey, typename TValue, typename HashFunctor, typename KeyEqualityFunctor>
+	template <typename TLookupKey>
+	inline size_t FlatHashMap<TKey, TValue, HashFunctor, KeyEqualityFunctor>::HashKey(const TLookupKey& key) const
+	{
+		// Fibonacci multiply then fold the high half down, the low 7 bits go to the control byte and the rest pick the group
+		uint64_t hash = static_cast<uint64_t>(mHashFunction(key)) * 0x9E3779B97F4A7C15ull;
+		hash ^= hash >> 32;
+		return static_cast<size_t>(hash);
+	}
+
+	template <typename TKey, typename TValue, typename HashFunctor, typename KeyEqualityFunctor>
+	template <typename TLookupKey>
+	size_t FlatHashMap<TKey, TValue, HashFunctor, KeyEqualityFunctor>::FindIndex(const TLookupKey& key, size_t hash) const
+	{
+		if (mSlotCount == 0)
+		{
+			return mSlotCount;
+		}
+
+		// Visit groups in triangular order, which covers every group when the group count is power of two
+		const size_t groupMask = mSlotCount / GROUP_WIDTH - 1;
+		const ControlType tag = static_cast<ControlType>(hash & 0x7F);
+		size_t group = (hash >> 7) & groupMask;
+		for (size_t step = 1; step <= groupMask + 1; ++step)
+		{
+			const ControlType* control = mControl + group * GROUP_WIDTH;
+			for (uint32_t match = MatchGroup(control, tag); match != 0; match &= match - 1)
+			{
+				const size_t index = group * GROUP_WIDTH + LowestBit(match);
+				if (mKeyEqualityFunction(mSlots[index]->first, key))
+				{
+					return index;
+				}
+			}
+
+			if (MatchGroup(control, EMPTY) != 0)
+			{
+				break;
+			}
+			group = (group + step) & groupMask;
+		}
+
+		return mSlotCount;
+	}
+
+	template <typename TKey, typename TValue, typename HashFunctor, typename KeyEqualityFunctor>
+	size_t FlatHashMap<TKey, TValue, HashFunctor, KeyEqualityFunctor>::FindInsertIndex(size_t hash) const
+	{
+		const size_t groupMask = mSlotCount / GROUP_WIDTH - 1;
+		size_t group = (hash >> 7) & groupMask;
+		for (size_t step = 1; step <= groupMask + 1; ++step)
+		{
+			const uint32_t match = MatchGroupFree(mControl + group * GROUP_WIDTH);
+			if (match != 0)
+			{
+				return group * GROUP_WIDTH + LowestBit(match);
+			}
+			group = (group + step) & groupMask;
+		}
+
+		return mSlotCount;
+	}
+
+	template <typename TKey, typename TValue, typename HashFunctor, typename KeyEqualityFunctor>
+	void FlatHashMap<TKey, TValue, HashFunctor, KeyEqualityFunctor>::Rehash(size_t slotCount)
+	{
+		ControlType* oldControl = mControl;
+		PairType** oldSlots = mSlots;
+		const size_t oldSlotCount = mSlotCount;
+
+		mSlotCount = slotCount;
+		mControl = slotCount > 0 ? new ControlType[slotCount] : nullptr;
+		mSlots = slotCount > 0 ? new PairType*[slotCount] : nullptr;
+		if (slotCount > 0)
+		{
+			memset(mControl, EMPTY, slotCount);
+		}
+
+		// Only slot pointers move, keys are known to be unique so no comparison is needed
+		for (size_t i = 0; i < oldSlotCount; ++i)
+		{
+			if (oldControl[i] >= 0)
+			{
+				const size_t hash = HashKey(oldSlots[i]->first);
+				const size_t index = FindInsertIndex(hash);
+				mControl[index] = static_cast<ControlType>(hash & 0x7F);
+				mSlots[index] = oldSlots[i];
+			}
+		}
+		mGrowthLeft = MaxLoadFor(mSlotCount) - mSize;
+
+		delete[] oldControl;
+		delete[] oldSlots;
+	}
+
+	template <typename TKey, typename TValue, typename HashFunctor, typename KeyEqualityFunctor>
+	void FlatHashMap<TKey, TValue, HashFunctor, KeyEqualityFunctor>::Grow()
+	{
+		// If tombstones take most of the room, purging them in place is enough
+		if (mSlotCount > 0 && mSize * 2 < MaxLoadFor(mSlotCount))
+		{
+			Rehash(mSlotCount);
+		}
+		else
+		{
+			Rehash(std::max(GROUP_WIDTH, mSlotCount * 2));
+		}
+	}
+
+	template <typename TKey, typename TValue, typename HashFunctor, typename KeyEqualityFunctor>
+	typename FlatHashMap<TKey, TValue, HashFunctor, KeyEqualityFunctor>::PairType* FlatHashMap<TKey, TValue, HashFunctor, KeyEqualityFunctor>::AllocateEntry(const PairType& pair)
+	{
+		// All pooled storage is in use, so the pool holds exactly mSize entries. Double it
+		if (mFreeEntries.IsEmpty())
+		{
+			const size_t count = std::max(size_t(8), mSize);
+			PairType* block = static_cast<PairType*>(malloc(count * sizeof(PairType)));
+			if (block == nullptr)
+			{
+				throw std::exception("Memory allocation failed");
+			}
+			mEntryBlocks.PushBack(block);
+			mFreeEntries.Reserve(count);
+			for (size_t i = count; i > 0; --i)
+			{
+				mFreeEntries.PushBack(block + i - 1);
+			}
+		}
+
+		PairType* entry = mFreeEntries.Back();
+		new (entry) PairType(pair);
+		mFreeEntries.PopBack();
+		return entry;
+	}
+
+	template <typename TKey, typename TValue, typename HashFunctor, typename KeyEqualityFunctor>
+	void FlatHashMap<TKey, TValue, HashFunctor, KeyEqualityFunctor>::FreeEntry(PairType* entry)
+	{
+		entry->~PairType();
+		mFreeEntries.PushBack(entry);
+	}
+
+	template <typename TKey, typename TValue, typename HashFunctor, typename KeyEqualityFunctor>
+	void FlatHashMap<TKey, TValue, HashFunctor, KeyEqualityFunctor>::ReleaseEntries()
+	{
+		for (size_t i = 0; i < mSlotCount; ++i)
+		{
+			if (mControl[i] >= 0)
+			{
+				mSlots[i]->~PairType();
+			}
+		}
+
+		for (void* block : mEntryBlocks)
+		{
+			free(block);
+		}
+		mEntryBlocks.Clear();
+		mFreeEntries.Clear();
+	}
+
+	template <typename TKey, typename TValue, typename HashFunctor, typename KeyEqualityFunctor>
+	inline size_t FlatHashMap<TKey, TValue, HashFunctor, KeyEqualityFunctor>::SlotCountFor(size_t capacity)
+	{
+		size_t slotCount = GROUP_WIDTH;
+		while (MaxLoadFor(slotCount) < capacity)
+		{
+			slotCount *= 2;
+		}
+		return slotCount;
+	}
+
+	template <typename TKey, typename TValue, typename HashFunctor, typename KeyEqualityFunctor>
+	inline size_t FlatHashMap<TKey, TValue, HashFunctor, KeyEqualityFunctor>::MaxLoadFor(size_t slotCount)
+	{
+		return slotCount - slotCount / 8;
+	}
+
+	template <typename TKey, typename TValue, typename HashFunctor, typename KeyEqualityFunctor>
+	inline uint32_t FlatHashMap<TKey, TValue, HashFunctor, KeyEqualityFunctor>::MatchGroup(const ControlType* group, ControlType value)
+	{
+#ifdef FLAT_HASH_MAP_SSE2
+		const __m128i control = _mm_loadu_si128(reinterpret_cast<const __m128i*>(group));
+		return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(control, _mm_set1_epi8(value))));
+#else
+		uint32_t mask = 0;
+		for (size_t i = 0; i < GROUP_WIDTH; ++i)
+		{
+			mask |= static_cast<uint32_t>(group[i] == value) << i;
+		}
+		return mask;
+#endif
+	}
+
+	template <typename TKey, typename TValue, typename HashFunctor, typename KeyEqualityFunctor>
+	inline uint32_t FlatHashMap<TKey, TValue, HashFunctor, KeyEqualityFunctor>::MatchGroupFree(const ControlType* group)
+	{
+		// Both EMPTY and DELETED are negative, while full slots are not
+#ifdef FLAT_HASH_MAP_SSE2
+		const __m128i control = _mm_loadu_si128(reinterpret_cast<const __m128i*>(group));
+		return static_cast<uint32_t>(_mm_movemask_epi8(control));
+#else
+		uint32_t mask = 0;
+		for (size_t i = 0; i < GROUP_WIDTH; ++i)
+		{
+			mask |= static_cast<uint32_t>(group[i] < 0) << i;
+		}
+		return mask;
+#endif
+	}
+
+	template <typename TKey, typename TValue, typename HashFunctor, typename KeyEqualityFunctor>
+	inline size_t FlatHashMap<TKey, TValue, HashFunctor, KeyEqualityFunctor>::LowestBit(uint32_t mask)
+	{
+#if defined(_MSC_VER)
+		unsigned long index;
+		_BitScanForward(&index, mask);
+		return static_cast<size_t>(index);
+#else
+		return static_cast<size_t>(__builtin_ctz(mask));
+#endif
+	}
+#pragma endregion
+
+#pragma region Iterator
+	template <typename TKey, typename TValue, typename HashFunctor, typename KeyEqualityFunctor>
+	FlatHashMap<TKey, TValue, HashFunctor, KeyEqualityFunctor>::Iterator::Iterator(const FlatHashMap& owner, size_t index) :
+		mOwner(&owner),
+		mIndex(index)
+	{}
+
+	template <typename TKey, typename TValue, typename HashFunctor, typename KeyEqualityFunctor>
+	inline bool FlatHashMap<TKey, TValue, HashFunctor, KeyEqualityFunctor>::Iterator::operator==(const Iterator& other) const
+	{
+		return mOwner == other.mOwner && mIndex == other.mIndex;
+	}
+
+	template <typename TKey, typename TValue, typename HashFunctor, typename KeyEqualityFunctor>
+	inline bool FlatHashMap<TKey, TValue, HashFunctor, KeyEqualityFunctor>::Iterator::operator!=(const Iterator& other) const
+	{
+		return !operator==(other);
+	}
+
+	template <typename TKey, typename TValue, typename HashFunctor, typename KeyEqualityFunctor>
+	typename FlatHashMap<TKey, TValue, HashFunctor, KeyEqualityFunctor>::PairType& FlatHashMap<TKey, TValue, HashFunctor, KeyEqualityFunctor>::Iterator::operator*()
+	{
+		if (mOwner == nullptr)
+		{
+			throw std::exception("Iterator doesn't belong to any hashmap");
+		}
+
+		if (mIndex >= mOwner->mSlotCount || mOwner->mControl[mIndex] < 0)
+		{
+			throw std::exception("Iterator doesn't point to any item in hashmap");
+		}
+
+		return *mOwner->mSlots[mIndex];
+	}
+
+	template <typename TKey, typename TValue, typename HashFunctor, typename KeyEqualityFunctor>
+	typename const FlatHashMap<TKey, TValue, HashFunctor, KeyEqualityFunctor>::PairType& FlatHashMap<TKey, TValue, HashFunctor, KeyEqualityFunctor>::Iterator::operator*() const
+	{
+		return const_cast<Iterator*>(this)->operator*();
+	}
+
+	template <typename TKey, typename TValue, typename HashFunctor, typename KeyEqualityFunctor>
+	typename FlatHashMap<TKey, TValue, HashFunctor, KeyEqualityFunctor>::PairType* FlatHashMap<TKey, TValue, HashFunctor, KeyEqualityFunctor>::Iterator::operator->()
+	{
+		return &operator*();
+	}
+
+	template <typename TKey, typename TValue, typename HashFunctor, typename KeyEqualityFunctor>
+	typename const FlatHashMap<TKey, TValue, HashFunctor, KeyEqualityFunctor>::PairType* FlatHashMap<TKey, TValue, HashFunctor, KeyEqualityFunctor>::Iterator::operator->() const
+	{
+		return &operator*();
+	}
+
+	template <typename TKey, typename TValue, typename HashFunctor, typename KeyEqualityFunctor>
+	typename FlatHashMap<TKey, TValue, HashFunctor, KeyEqualityFunctor>::Iterator& FlatHashMap<TKey, TValue, HashFunctor, KeyEqualityFunctor>::Iterator::operator++()
+	{
+		if (mOwner == nullptr)
+		{
+			throw std::exception("Iterator does not belong to any hashmap");
+		}
+
+		if (mIndex < mOwner->mSlotCount)
+		{
+			while (++mIndex < mOwner->mSlotCount && mOwner->mControl[mIndex] < 0);
+		}
+
+		return *this;
+	}
+
+	template <typename TKey, typename TValue, typename HashFunctor, typename KeyEqualityFunctor>
+	typename FlatHashMap<TKey, TValue, HashFunctor, KeyEqualityFunctor>::Iterator FlatHashMap<TKey, TValue, HashFunctor, KeyEqualityFunctor>::Iterator::operator++(int)
+	{
+		Iterator copy = *this;
+		operator++();
+		return copy;
+	}
+#pragma endregion
+
+#pragma region ConstIterator
+	template <typename TKey, typename TValue, typename HashFunctor, typename KeyEqualityFunctor>
+	FlatHashMap<TKey, TValue, HashFunctor, KeyEqualityFunctor>::ConstIterator::ConstIterator(const FlatHashMap& owner, size_t index) :
+		mOwner(&owner),
+		mIndex(index)
+	{}
+
+	template <typename TKey, typename TValue, typename HashFunctor, typename KeyEqualityFunctor>
+	FlatHashMap<TKey, TValue, HashFunctor, KeyEqualityFunctor>::ConstIterator::ConstIterator(const Iterator& other) :
+		mOwner(other.mOwner),
+		mIndex(other.mIndex)
+	{}
+
+	template <typename TKey, typename TValue, typename HashFunctor, typename KeyEqualityFunctor>
+	typename FlatHashMap<TKey, TValue, HashFunctor, KeyEqualityFunctor>::ConstIterator& FlatHashMap<TKey, TValue, HashFunctor, KeyEqualityFunctor>::ConstIterator::operator=(const Iterator& other)
+	{
+		mOwner = other.mOwner;
+		mIndex = other.mIndex;
+		return *this;
+	}
+
+	template <typename TKey, typename TValue, typename HashFunctor, typename KeyEqualityFunctor>
+	inline bool FlatHashMap<TKey, TValue, HashFunctor, KeyEqualityFunctor>::ConstIterator::operator==(const ConstIterator& other) const
+	{
+		return mOwner == other.mOwner && mIndex == other.mIndex;
+	}
+
+	template <typename TKey, typename TValue, typename HashFunctor, typename KeyEqualityFunctor>
+	inline bool FlatHashMap<TKey, TValue, HashFunctor, KeyEqualityFunctor>::ConstIterator::operator!=(const ConstIterator& other) const
+	{
+		return !operator==(other);
+	}
+
+	template <typename TKey, typename TValue, typename HashFunctor, typename KeyEqualityFunctor>
+	const typename FlatHashMap<TKey, TValue, HashFunctor, KeyEqualityFunctor>::PairType& FlatHashMap<TKey, TValue, HashFunctor, KeyEqualityFunctor>::ConstIterator::operator*() const
+	{
+		if (mOwner == nullptr)
+		{
+			throw std::exception("Iterator doesn't belong to any hashmap");
+		}
+
+		if (mIndex >= mOwner->mSlotCount || mOwner->mControl[mIndex] < 0)
+		{
+			throw std::exception("Iterator doesn't point to any item in hashmap");
+		}
+
+		return *mOwner->mSlots[mIndex];
+	}
+
+	template <typename TKey, typename TValue, typename HashFunctor, typename KeyEqualityFunctor>
+	const typename FlatHashMap<TKey, TValue, HashFunctor, KeyEqualityFunctor>::PairType* FlatHashMap<TKey, TValue, HashFunctor, KeyEqualityFunctor>::ConstIterator::operator->() const
+	{
+		return &operator*();
+	}
+
+	template <typename TKey, typename TValue, typename HashFunctor, typename KeyEqualityFunctor>
+	typename FlatHashMap<TKey, TValue, HashFunctor, KeyEqualityFunctor>::ConstIterator& FlatHashMap<TKey, TValue, HashFunctor, KeyEqualityFunctor>::ConstIterator::operator++()
+	{
+		if (mOwner == nullptr)
+		{
+			throw std::exception("Iterator does not belong to any hashmap");
+		}
+
+		if (mIndex < mOwner->mSlotCount)
+		{
+			while (++mIndex < mOwner->mSlotCount && mOwner->mControl[mIndex] < 0);
+		}
+
+		return *this;
+	}
+
+	template <typename TKey, typename TValue, typename HashFunctor, typename KeyEqualityFunctor>
+	typename FlatHashMap<TKey, TValue, HashFunctor, KeyEqualityFunctor>::ConstIterator FlatHashMap<TKey, TValue, HashFunctor, KeyEqualityFunctor>::ConstIterator::operator++(int)
+	{
+		ConstIterator copy = *this;
+		operator++();
+		return copy;
+	}
+#pragma endregion
+}
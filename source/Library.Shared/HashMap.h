@@ -24,6 +24,12 @@ namespace GameEngine
 		using ChainType = SList<PairType>;
 		using BucketType = Vector<ChainType>;
 
+		/// <summary>
+		/// Enable heterogeneous lookup with key types other than TKey, only when both functors are transparent
+		/// </summary>
+		template <typename TLookupKey>
+		using EnableIfTransparent = std::enable_if_t<IsTransparent<HashFunctor>::value && IsTransparent<KeyEqualityFunctor>::value && !std::is_same_v<TLookupKey, TKey>>;
+
 	public:
 		/// <summary>
 		/// An iterator is a container that points to one pair in the HashMap.
@@ -298,10 +304,10 @@ namespace GameEngine
 		HashMap(const std::initializer_list<PairType>& list, size_t capacity = 32);
 
 		/// <summary>
-		/// Copy constructor
+		/// Copy constructor, the copied pairs are allocated from a node pool of its own
 		/// </summary>
 		/// <param name="other">The other HashMap to copy from</param>
-		HashMap(const HashMap& other) = default;
+		HashMap(const HashMap& other);
 
 		/// <summary>
 		/// Move constructor
@@ -329,7 +335,8 @@ namespace GameEngine
 		HashMap& operator=(HashMap&& other);
 
 		/// <summary>
-		/// Get the reference to mapped value with given key. If key doesn't exist, one such pair will be default-constructed
+		/// Get the reference to mapped value with given key. If key doesn't exist, one such pair will be default-constructed.
+		/// Creating a new pair may grow the bucket list, same as Insert()
 		/// </summary>
 		/// <param name="key">Key value to look for</param>
 		/// <returns>Reference to mapped value at key position</returns>
@@ -414,7 +421,35 @@ namespace GameEngine
 		ConstIterator Find(const TKey& key) const;
 
 		/// <summary>
-		/// Insert the pair to HashMap. If there is a pair with same key already, insertion will not happen
+		/// Search for the pair with a key of another type, e.g. std::string_view or a string literal for std::string keys, without constructing a TKey.
+		/// Only available when both the hash functor and the key equality functor are transparent
+		/// </summary>
+		/// <param name="key">Key value to search</param>
+		/// <returns>Iterator pointing that pair with given key, or end() if such pair doesn't exist</returns>
+		template <typename TLookupKey, typename = EnableIfTransparent<TLookupKey>>
+		Iterator Find(const TLookupKey& key);
+
+		/// <summary>
+		/// Search for the pair with a key of another type, e.g. std::string_view or a string literal for std::string keys, without constructing a TKey.
+		/// Only available when both the hash functor and the key equality functor are transparent
+		/// </summary>
+		/// <param name="key">Key value to search</param>
+		/// <returns>Iterator pointing that pair with given key, or end() if such pair doesn't exist</returns>
+		template <typename TLookupKey, typename = EnableIfTransparent<TLookupKey>>
+		ConstIterator Find(const TLookupKey& key) const;
+
+		/// <summary>
+		/// Check if given key of another type exists, without constructing a TKey.
+		/// Only available when both the hash functor and the key equality functor are transparent
+		/// </summary>
+		/// <param name="key">The key value to check</param>
+		/// <returns>True if key exists, False otherwise</returns>
+		template <typename TLookupKey, typename = EnableIfTransparent<TLookupKey>>
+		bool ContainsKey(const TLookupKey& key) const;
+
+		/// <summary>
+		/// Insert the pair to HashMap. If there is a pair with same key already, insertion will not happen.
+		/// If the insertion would exceed the max load factor, the bucket list doubles in size, which invalidates existing iterators
 		/// </summary>
 		/// <param name="pair">The pair to be inserted</param>
 		/// <returns>Iterator to inserted pair, or an existing pair with same key if such pair exists</returns>
@@ -427,18 +462,63 @@ namespace GameEngine
 		void Remove(const TKey& key);
 
 		/// <summary>
-		/// Remove the pair pointed by iterator
+		/// Remove the pair pointed by iterator. Only iterators to the removed pair are invalidated, even while rehashing
 		/// </summary>
 		/// <param name="position">The iterator pointing to the pair to be deleted</param>
 		/// <exception cref="std::exception">The iterator has no parent</exception>
 		void Remove(const Iterator& position);
 
 		/// <summary>
-		/// Change the size of buckets and rehash the entire map. The new size can be greater of less than current size
+		/// Change the size of buckets and rehash the entire map. The new size can be greater of less than current size.
+		/// Any incremental rehash in progress is finished first, and the pairs are relinked rather than copied
 		/// </summary>
 		/// <param name="capacity">New size of buckets</param>
 		void Resize(size_t capacity);
 
+		/// <summary>
+		/// Get the number of buckets in the current bucket list
+		/// </summary>
+		/// <returns>Number of buckets</returns>
+		size_t BucketCount() const;
+
+		/// <summary>
+		/// Get the average number of pairs per bucket
+		/// </summary>
+		/// <returns>Current load factor</returns>
+		float LoadFactor() const;
+
+		/// <summary>
+		/// Get the load factor above which the bucket list grows
+		/// </summary>
+		/// <returns>Max load factor</returns>
+		float MaxLoadFactor() const;
+
+		/// <summary>
+		/// Set the load factor above which the bucket list grows. Takes effect on the next insertion
+		/// </summary>
+		/// <param name="maxLoadFactor">New max load factor</param>
+		/// <exception cref="std::exception">Max load factor is not positive</exception>
+		void SetMaxLoadFactor(float maxLoadFactor);
+
+		/// <summary>
+		/// Get the number of old buckets migrated by each mutating operation while rehashing
+		/// </summary>
+		/// <returns>Buckets migrated per operation, 0 if the map rehashes all at once</returns>
+		size_t RehashStep() const;
+
+		/// <summary>
+		/// Set the number of old buckets migrated by each Insert() and operator[]() while rehashing.
+		/// 0 makes growth rehash the entire map at once, and also finishes any rehash in progress
+		/// </summary>
+		/// <param name="bucketsPerOperation">Buckets migrated per operation</param>
+		void SetRehashStep(size_t bucketsPerOperation);
+
+		/// <summary>
+		/// Check if an incremental rehash is in progress, i.e. some pairs still live in the old bucket list
+		/// </summary>
+		/// <returns>True if rehashing, False otherwise</returns>
+		bool IsRehashing() const;
+
 		/// <summary>
 		/// Return the Iterator pointing to first pair, or pointing to nothing if HashMap is empty
 		/// </summary>
@@ -482,16 +562,96 @@ namespace GameEngine
 		/// <param name="other">The other HashMap to copy from</param>
 		void DeepCopy(const HashMap& other);
 
+		/// <summary>
+		/// Replace given bucket list with a copy of another one, allocating nodes from the node pool of this HashMap
+		/// </summary>
+		/// <param name="buckets">Bucket list to copy to</param>
+		/// <param name="otherBuckets">Bucket list to copy from</param>
+		void CopyBuckets(BucketType& buckets, const BucketType& otherBuckets);
+
+		/// <summary>
+		/// Get the allocator shared by all chains, create its node pool if there isn't one yet
+		/// </summary>
+		/// <returns>Allocator shared by all chains</returns>
+		const PoolAllocator& NodeAllocator();
+
+		/// <summary>
+		/// Search both bucket lists for the pair with given key, using an already computed hash value
+		/// </summary>
+		/// <param name="key">Key value to search, TKey or a key type accepted by transparent functors</param>
+		/// <param name="hash">Hash value of the key</param>
+		/// <returns>Iterator pointing that pair with given key, or end() if such pair doesn't exist</returns>
+		template <typename TLookupKey>
+		Iterator Find(const TLookupKey& key, size_t hash);
+
+		/// <summary>
+		/// Double the bucket list if inserting one more pair would exceed the max load factor
+		/// </summary>
+		void GrowIfNeeded();
+
+		/// <summary>
+		/// Move current buckets to the old bucket list and start a rehash into a new bucket list of given size.
+		/// Any rehash in progress is finished first. If rehash step is 0, the rehash finishes immediately
+		/// </summary>
+		/// <param name="capacity">Size of new bucket list</param>
+		void BeginRehash(size_t capacity);
+
+		/// <summary>
+		/// Relink all pairs of up to count old buckets into the current bucket list. Do nothing if not rehashing
+		/// </summary>
+		/// <param name="count">Max number of old buckets to migrate</param>
+		void MigrateBuckets(size_t count);
+
+		/// <summary>
+		/// Get the number of buckets visited by iterators. Iterator indexes cover the current buckets first, then the old buckets
+		/// </summary>
+		/// <returns>Number of current and old buckets</returns>
+		size_t IteratorBucketCount() const;
+
+		/// <summary>
+		/// Get the bucket at given iterator index
+		/// </summary>
+		/// <param name="index">Iterator index of bucket</param>
+		/// <returns>The bucket in current or old bucket list</returns>
+		ChainType& IteratorBucket(size_t index);
+
+		/// <summary>
+		/// Get the bucket at given iterator index
+		/// </summary>
+		/// <param name="index">Iterator index of bucket</param>
+		/// <returns>The bucket in current or old bucket list</returns>
+		const ChainType& IteratorBucket(size_t index) const;
+
 		/// <summary>
 		/// List of bucket
 		/// </summary>
 		BucketType mBuckets;
 
+		/// <summary>
+		/// Buckets left over from before the last growth, empty unless an incremental rehash is in progress
+		/// </summary>
+		BucketType mOldBuckets;
+
+		/// <summary>
+		/// Index of next old bucket to migrate. Old buckets before this index are empty
+		/// </summary>
+		size_t mMigrateIndex = 0;
+
 		/// <summary>
 		/// Total number of pairs in HashMap
 		/// </summary>
 		size_t mSize = 0;
 
+		/// <summary>
+		/// Load factor above which the bucket list grows
+		/// </summary>
+		float mMaxLoadFactor = 1.0f;
+
+		/// <summary>
+		/// Number of old buckets migrated per mutating operation, 0 means rehash all at once
+		/// </summary>
+		size_t mRehashStep = 0;
+
 		/// <summary>
 		/// Function to use when calculating hash value
 		/// </summary>
@@ -501,6 +661,11 @@ namespace GameEngine
 		/// Function to use when comparing two key values
 		/// </summary>
 		KeyEqualityFunctor mKeyEqualityFunction = KeyEqualityFunctor();
+
+		/// <summary>
+		/// Allocator shared by all chains, so that nodes can be relinked between buckets during rehash without allocation
+		/// </summary>
+		PoolAllocator mNodeAllocator;
 	};
 }
 
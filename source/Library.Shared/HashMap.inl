@@ -4,27 +4,40 @@ namespace GameEngine
 	template <typename TKey, typename TValue, typename HashFunctor, typename KeyEqualityFunctor>
 	HashMap<TKey, TValue, HashFunctor, KeyEqualityFunctor>::HashMap(size_t capacity)
 	{
-		mBuckets.Resize(std::max(size_t(1), capacity));
+		mBuckets.Resize(std::max(size_t(1), capacity), ChainType(NodeAllocator()));
 	}
 
 	template <typename TKey, typename TValue, typename HashFunctor, typename KeyEqualityFunctor>
 	HashMap<TKey, TValue, HashFunctor, KeyEqualityFunctor>::HashMap(const std::initializer_list<PairType>& list, size_t capacity)
 	{
-		mBuckets.Resize(std::max(size_t(1), capacity));
+		mBuckets.Resize(std::max(size_t(1), capacity), ChainType(NodeAllocator()));
 		for (const auto& pair : list)
 		{
 			Insert(pair);
 		}
 	}
 
+	template <typename TKey, typename TValue, typename HashFunctor, typename KeyEqualityFunctor>
+	HashMap<TKey, TValue, HashFunctor, KeyEqualityFunctor>::HashMap(const HashMap& other)
+	{
+		DeepCopy(other);
+	}
+
 	template <typename TKey, typename TValue, typename HashFunctor, typename KeyEqualityFunctor>
 	HashMap<TKey, TValue, HashFunctor, KeyEqualityFunctor>::HashMap(HashMap&& other) :
+		mMigrateIndex(other.mMigrateIndex),
 		mSize(other.mSize),
+		mMaxLoadFactor(other.mMaxLoadFactor),
+		mRehashStep(other.mRehashStep),
 		mHashFunction(other.mHashFunction),
-		mKeyEqualityFunction(other.mKeyEqualityFunction)
+		mKeyEqualityFunction(other.mKeyEqualityFunction),
+		mNodeAllocator(other.mNodeAllocator)
 	{
 		mBuckets = std::move(other.mBuckets);
+		mOldBuckets = std::move(other.mOldBuckets);
+		other.mMigrateIndex = 0;
 		other.mSize = 0;
+		other.mNodeAllocator = PoolAllocator();
 	}
 
 	template <typename TKey, typename TValue, typename HashFunctor, typename KeyEqualityFunctor>
@@ -45,10 +58,17 @@ namespace GameEngine
 		{
 			// Don't need to Clear() here, because Vector operator=() will clear itself before moving
 			mBuckets = std::move(other.mBuckets);
+			mOldBuckets = std::move(other.mOldBuckets);
+			mMigrateIndex = other.mMigrateIndex;
 			mSize = other.mSize;
+			mMaxLoadFactor = other.mMaxLoadFactor;
+			mRehashStep = other.mRehashStep;
 			mHashFunction = other.mHashFunction;
 			mKeyEqualityFunction = other.mKeyEqualityFunction;
+			mNodeAllocator = other.mNodeAllocator;
+			other.mMigrateIndex = 0;
 			other.mSize = 0;
+			other.mNodeAllocator = PoolAllocator();
 		}
 		return *this;
 	}
@@ -56,20 +76,21 @@ namespace GameEngine
 	template <typename TKey, typename TValue, typename HashFunctor, typename KeyEqualityFunctor>
 	TValue& HashMap<TKey, TValue, HashFunctor, KeyEqualityFunctor>::operator[](const TKey& key)
 	{
+		MigrateBuckets(mRehashStep);
+
 		// Find existing entry
-		ChainType& chain = mBuckets[mHashFunction(key) % mBuckets.Size()];
-		for (auto& pair : chain)
+		const size_t hash = mHashFunction(key);
+		Iterator it = Find(key, hash);
+		if (it != end())
 		{
-			if (mKeyEqualityFunction(pair.first, key))
-			{
-				return pair.second;
-			}
+			return (*it).second;
 		}
 
 		// Create new entry
-		auto it = chain.PushBack(std::make_pair(key, TValue()));
+		GrowIfNeeded();
+		auto chainIterator = mBuckets[hash % mBuckets.Size()].PushBack(std::make_pair(key, TValue()));
 		++mSize;
-		return (*it).second;
+		return (*chainIterator).second;
 	}
 
 	template <typename TKey, typename TValue, typename HashFunctor, typename KeyEqualityFunctor>
@@ -85,6 +106,8 @@ namespace GameEngine
 		{
 			chain.Clear();
 		}
+		mOldBuckets.Destroy();
+		mMigrateIndex = 0;
 		mSize = 0;
 	}
 
@@ -143,47 +166,53 @@ namespace GameEngine
 	template <typename TKey, typename TValue, typename HashFunctor, typename KeyEqualityFunctor>
 	typename HashMap<TKey, TValue, HashFunctor, KeyEqualityFunctor>::Iterator HashMap<TKey, TValue, HashFunctor, KeyEqualityFunctor>::Find(const TKey& key)
 	{
-		// Find bucket
-		const size_t hash = mHashFunction(key);
-		const size_t index = hash % mBuckets.Size();
-		ChainType& chain = mBuckets[index];
+		return Find(key, mHashFunction(key));
+	}
 
-		for (auto it = chain.begin(); it != chain.end(); ++it)
-		{
-			if (mKeyEqualityFunction((*it).first, key))
-			{
-				return Iterator(*this, index, it);
-			}
-		}
+	template <typename TKey, typename TValue, typename HashFunctor, typename KeyEqualityFunctor>
+	typename HashMap<TKey, TValue, HashFunctor, KeyEqualityFunctor>::ConstIterator HashMap<TKey, TValue, HashFunctor, KeyEqualityFunctor>::Find(const TKey& key) const
+	{
+		return ConstIterator(const_cast<HashMap<TKey, TValue, HashFunctor, KeyEqualityFunctor>*>(this)->Find(key));
+	}
 
-		return end();
+	template <typename TKey, typename TValue, typename HashFunctor, typename KeyEqualityFunctor>
+	template <typename TLookupKey, typename>
+	typename HashMap<TKey, TValue, HashFunctor, KeyEqualityFunctor>::Iterator HashMap<TKey, TValue, HashFunctor, KeyEqualityFunctor>::Find(const TLookupKey& key)
+	{
+		return Find(key, mHashFunction(key));
 	}
 
 	template <typename TKey, typename TValue, typename HashFunctor, typename KeyEqualityFunctor>
-	typename HashMap<TKey, TValue, HashFunctor, KeyEqualityFunctor>::ConstIterator HashMap<TKey, TValue, HashFunctor, KeyEqualityFunctor>::Find(const TKey& key) const
+	template <typename TLookupKey, typename>
+	typename HashMap<TKey, TValue, HashFunctor, KeyEqualityFunctor>::ConstIterator HashMap<TKey, TValue, HashFunctor, KeyEqualityFunctor>::Find(const TLookupKey& key) const
 	{
 		return ConstIterator(const_cast<HashMap<TKey, TValue, HashFunctor, KeyEqualityFunctor>*>(this)->Find(key));
 	}
 
+	template <typename TKey, typename TValue, typename HashFunctor, typename KeyEqualityFunctor>
+	template <typename TLookupKey, typename>
+	bool HashMap<TKey, TValue, HashFunctor, KeyEqualityFunctor>::ContainsKey(const TLookupKey& key) const
+	{
+		return Find(key) != end();
+	}
+
 	template <typename TKey, typename TValue, typename HashFunctor, typename KeyEqualityFunctor>
 	std::pair<typename HashMap<TKey, TValue, HashFunctor, KeyEqualityFunctor>::Iterator, bool> HashMap<TKey, TValue, HashFunctor, KeyEqualityFunctor>::Insert(const PairType& pair)
 	{
-		// Find bucket
-		const size_t hash = mHashFunction(pair.first);
-		const size_t index = hash % mBuckets.Size();
-		ChainType& chain = mBuckets[index];
+		MigrateBuckets(mRehashStep);
 
 		// Check if there exists same key
-		for (auto it = chain.begin(); it != chain.end(); ++it)
+		const size_t hash = mHashFunction(pair.first);
+		Iterator it = Find(pair.first, hash);
+		if (it != end())
 		{
-			if (mKeyEqualityFunction((*it).first, pair.first))
-			{
-				return std::make_pair(Iterator(*this, index, it), false);
-			}
+			return std::make_pair(it, false);
 		}
 
-		// Insert to bucket
-		ChainIterator chainIterator = chain.PushBack(pair);
+		// Insert to bucket, the bucket list may grow first
+		GrowIfNeeded();
+		const size_t index = hash % mBuckets.Size();
+		ChainIterator chainIterator = mBuckets[index].PushBack(pair);
 		++mSize;
 		return std::make_pair(Iterator(*this, index, chainIterator), true);
 	}
@@ -202,39 +231,82 @@ namespace GameEngine
 			throw std::exception("Iterator doesn't belong to the container");
 		}
 
-		if (position.mIndex < mBuckets.Size())
+		if (position.mIndex < IteratorBucketCount())
 		{
-			ChainType& chain = mBuckets[position.mIndex];
+			ChainType& chain = IteratorBucket(position.mIndex);
 			if (position.mChainIterator != chain.end())
 			{
 				chain.Remove(position.mChainIterator);
 				--mSize;
 			}
 		}
+
+		// No migration here, so removing while iterating only invalidates the removed position
 	}
 
 	template <typename TKey, typename TValue, typename HashFunctor, typename KeyEqualityFunctor>
 	void HashMap<TKey, TValue, HashFunctor, KeyEqualityFunctor>::Resize(size_t capacity)
 	{
-		capacity = std::max(size_t(1), capacity);
-		BucketType temp = std::move(mBuckets);
-		mSize = 0;
-		mBuckets.Resize(capacity);
-		for (const auto& chain : temp)
+		BeginRehash(capacity);
+		MigrateBuckets(mOldBuckets.Size());
+	}
+
+	template <typename TKey, typename TValue, typename HashFunctor, typename KeyEqualityFunctor>
+	inline size_t HashMap<TKey, TValue, HashFunctor, KeyEqualityFunctor>::BucketCount() const
+	{
+		return mBuckets.Size();
+	}
+
+	template <typename TKey, typename TValue, typename HashFunctor, typename KeyEqualityFunctor>
+	inline float HashMap<TKey, TValue, HashFunctor, KeyEqualityFunctor>::LoadFactor() const
+	{
+		return static_cast<float>(mSize) / static_cast<float>(mBuckets.Size());
+	}
+
+	template <typename TKey, typename TValue, typename HashFunctor, typename KeyEqualityFunctor>
+	inline float HashMap<TKey, TValue, HashFunctor, KeyEqualityFunctor>::MaxLoadFactor() const
+	{
+		return mMaxLoadFactor;
+	}
+
+	template <typename TKey, typename TValue, typename HashFunctor, typename KeyEqualityFunctor>
+	void HashMap<TKey, TValue, HashFunctor, KeyEqualityFunctor>::SetMaxLoadFactor(float maxLoadFactor)
+	{
+		if (!(maxLoadFactor > 0.0f))
 		{
-			for (const auto& pair : chain)
-			{
-				Insert(pair);
-			}
+			throw std::exception("Max load factor must be positive");
 		}
+		mMaxLoadFactor = maxLoadFactor;
+	}
+
+	template <typename TKey, typename TValue, typename HashFunctor, typename KeyEqualityFunctor>
+	inline size_t HashMap<TKey, TValue, HashFunctor, KeyEqualityFunctor>::RehashStep() const
+	{
+		return mRehashStep;
+	}
+
+	template <typename TKey, typename TValue, typename HashFunctor, typename KeyEqualityFunctor>
+	void HashMap<TKey, TValue, HashFunctor, KeyEqualityFunctor>::SetRehashStep(size_t bucketsPerOperation)
+	{
+		mRehashStep = bucketsPerOperation;
+		if (mRehashStep == 0)
+		{
+			MigrateBuckets(mOldBuckets.Size());
+		}
+	}
+
+	template <typename TKey, typename TValue, typename HashFunctor, typename KeyEqualityFunctor>
+	inline bool HashMap<TKey, TValue, HashFunctor, KeyEqualityFunctor>::IsRehashing() const
+	{
+		return !mOldBuckets.IsEmpty();
 	}
 
 	template <typename TKey, typename TValue, typename HashFunctor, typename KeyEqualityFunctor>
 	typename HashMap<TKey, TValue, HashFunctor, KeyEqualityFunctor>::Iterator HashMap<TKey, TValue, HashFunctor, KeyEqualityFunctor>::begin()
 	{
-		for (size_t i = 0; i < mBuckets.Size(); ++i)
+		for (size_t i = 0; i < IteratorBucketCount(); ++i)
 		{
-			ChainType& chain = mBuckets[i];
+			ChainType& chain = IteratorBucket(i);
 			if (chain.Size() > 0)
 			{
 				return Iterator(*this, i, chain.begin());
@@ -253,13 +325,13 @@ namespace GameEngine
 	template <typename TKey, typename TValue, typename HashFunctor, typename KeyEqualityFunctor>
 	typename HashMap<TKey, TValue, HashFunctor, KeyEqualityFunctor>::Iterator HashMap<TKey, TValue, HashFunctor, KeyEqualityFunctor>::end()
 	{
-		return Iterator(*this, mBuckets.Size(), ChainIterator());
+		return Iterator(*this, IteratorBucketCount(), ChainIterator());
 	}
 
 	template <typename TKey, typename TValue, typename HashFunctor, typename KeyEqualityFunctor>
 	typename HashMap<TKey, TValue, HashFunctor, KeyEqualityFunctor>::ConstIterator HashMap<TKey, TValue, HashFunctor, KeyEqualityFunctor>::end() const
 	{
-		return ConstIterator(*this, mBuckets.Size(), ChainIterator());
+		return ConstIterator(*this, IteratorBucketCount(), ChainIterator());
 	}
 
 	template <typename TKey, typename TValue, typename HashFunctor, typename KeyEqualityFunctor>
@@ -279,11 +351,139 @@ namespace GameEngine
 	template <typename TKey, typename TValue, typename HashFunctor, typename KeyEqualityFunctor>
 	void HashMap<TKey, TValue, HashFunctor, KeyEqualityFunctor>::DeepCopy(const HashMap& other)
 	{
-		mBuckets = other.mBuckets;
+		CopyBuckets(mBuckets, other.mBuckets);
+		CopyBuckets(mOldBuckets, other.mOldBuckets);
+		mMigrateIndex = other.mMigrateIndex;
 		mSize = other.mSize;
+		mMaxLoadFactor = other.mMaxLoadFactor;
+		mRehashStep = other.mRehashStep;
 		mHashFunction = other.mHashFunction;
 		mKeyEqualityFunction = other.mKeyEqualityFunction;
 	}
+
+	template <typename TKey, typename TValue, typename HashFunctor, typename KeyEqualityFunctor>
+	template <typename TLookupKey>
+	typename HashMap<TKey, TValue, HashFunctor, KeyEqualityFunctor>::Iterator HashMap<TKey, TValue, HashFunctor, KeyEqualityFunctor>::Find(const TLookupKey& key, size_t hash)
+	{
+		// Find bucket
+		const size_t index = hash % mBuckets.Size();
+		ChainType& chain = mBuckets[index];
+
+		for (auto it = chain.begin(); it != chain.end(); ++it)
+		{
+			if (mKeyEqualityFunction((*it).first, key))
+			{
+				return Iterator(*this, index, it);
+			}
+		}
+
+		// Pair may not be migrated yet. Migrated old buckets are empty, so no need to check mMigrateIndex
+		if (IsRehashing())
+		{
+			const size_t oldIndex = hash % mOldBuckets.Size();
+			ChainType& oldChain = mOldBuckets[oldIndex];
+
+			for (auto it = oldChain.begin(); it != oldChain.end(); ++it)
+			{
+				if (mKeyEqualityFunction((*it).first, key))
+				{
+					return Iterator(*this, mBuckets.Size() + oldIndex, it);
+				}
+			}
+		}
+
+		return end();
+	}
+
+	template <typename TKey, typename TValue, typename HashFunctor, typename KeyEqualityFunctor>
+	void HashMap<TKey, TValue, HashFunctor, KeyEqualityFunctor>::GrowIfNeeded()
+	{
+		if (static_cast<float>(mSize + 1) > mMaxLoadFactor * static_cast<float>(mBuckets.Size()))
+		{
+			BeginRehash(mBuckets.Size() * 2);
+		}
+	}
+
+	template <typename TKey, typename TValue, typename HashFunctor, typename KeyEqualityFunctor>
+	void HashMap<TKey, TValue, HashFunctor, KeyEqualityFunctor>::CopyBuckets(BucketType& buckets, const BucketType& otherBuckets)
+	{
+		// Copy chain by chain, so that copied nodes come from the pool of this map instead of the other one
+		buckets.Clear();
+		buckets.Resize(otherBuckets.Size(), ChainType(NodeAllocator()));
+		for (size_t i = 0; i < otherBuckets.Size(); ++i)
+		{
+			buckets[i] = otherBuckets[i];
+		}
+	}
+
+	template <typename TKey, typename TValue, typename HashFunctor, typename KeyEqualityFunctor>
+	const PoolAllocator& HashMap<TKey, TValue, HashFunctor, KeyEqualityFunctor>::NodeAllocator()
+	{
+		if (mNodeAllocator.Pool() == nullptr)
+		{
+			mNodeAllocator = PoolAllocator::Create();
+		}
+		return mNodeAllocator;
+	}
+
+	template <typename TKey, typename TValue, typename HashFunctor, typename KeyEqualityFunctor>
+	void HashMap<TKey, TValue, HashFunctor, KeyEqualityFunctor>::BeginRehash(size_t capacity)
+	{
+		// Keep at most two bucket lists alive
+		MigrateBuckets(mOldBuckets.Size());
+
+		mOldBuckets = std::move(mBuckets);
+		mBuckets.Resize(std::max(size_t(1), capacity), ChainType(NodeAllocator()));
+		mMigrateIndex = 0;
+
+		if (mRehashStep == 0)
+		{
+			MigrateBuckets(mOldBuckets.Size());
+		}
+	}
+
+	template <typename TKey, typename TValue, typename HashFunctor, typename KeyEqualityFunctor>
+	void HashMap<TKey, TValue, HashFunctor, KeyEqualityFunctor>::MigrateBuckets(size_t count)
+	{
+		if (!IsRehashing())
+		{
+			return;
+		}
+
+		for (; count > 0 && mMigrateIndex < mOldBuckets.Size(); --count, ++mMigrateIndex)
+		{
+			// Relink nodes instead of copying, so pairs keep their addresses
+			ChainType& chain = mOldBuckets[mMigrateIndex];
+			while (!chain.IsEmpty())
+			{
+				mBuckets[mHashFunction(chain.Front().first) % mBuckets.Size()].SpliceFront(chain);
+			}
+		}
+
+		if (mMigrateIndex == mOldBuckets.Size())
+		{
+			mOldBuckets.Destroy();
+			mMigrateIndex = 0;
+		}
+	}
+
+	template <typename TKey, typename TValue, typename HashFunctor, typename KeyEqualityFunctor>
+	inline size_t HashMap<TKey, TValue, HashFunctor, KeyEqualityFunctor>::IteratorBucketCount() const
+	{
+		return mBuckets.Size() + mOldBuckets.Size();
+	}
+
+	template <typename TKey, typename TValue, typename HashFunctor, typename KeyEqualityFunctor>
+	inline typename HashMap<TKey, TValue, HashFunctor, KeyEqualityFunctor>::ChainType& HashMap<TKey, TValue, HashFunctor, KeyEqualityFunctor>::IteratorBucket(size_t index)
+	{
+		return index < mBuckets.Size() ? mBuckets[index] : mOldBuckets[index - mBuckets.Size()];
+	}
+
+	template <typename TKey, typename TValue, typename HashFunctor, typename KeyEqualityFunctor>
+	inline const typename HashMap<TKey, TValue, HashFunctor, KeyEqualityFunctor>::ChainType& HashMap<TKey, TValue, HashFunctor, KeyEqualityFunctor>::IteratorBucket(size_t index) const
+	{
+		return index < mBuckets.Size() ? mBuckets[index] : mOldBuckets[index - mBuckets.Size()];
+	}
 #pragma endregion
 
 #pragma region Iterator
@@ -297,7 +497,7 @@ namespace GameEngine
 	template <typename TKey, typename TValue, typename HashFunctor, typename KeyEqualityFunctor>
 	inline bool HashMap<TKey, TValue, HashFunctor, KeyEqualityFunctor>::Iterator::operator==(const Iterator& other) const
 	{
-		return mOwner == other.mOwner && mIndex == other.mIndex && (mChainIterator == other.mChainIterator || mIndex == mOwner->mBuckets.Size());
+		return mOwner == other.mOwner && mIndex == other.mIndex && (mChainIterator == other.mChainIterator || mIndex == mOwner->IteratorBucketCount());
 	}
 
 	template <typename TKey, typename TValue, typename HashFunctor, typename KeyEqualityFunctor>
@@ -314,7 +514,7 @@ namespace GameEngine
 			throw std::exception("Iterator doesn't belong to any hashmap");
 		}
 
-		if (mIndex >= mOwner->mBuckets.Size() || mChainIterator == mOwner->mBuckets[mIndex].end())
+		if (mIndex >= mOwner->IteratorBucketCount() || mChainIterator == mOwner->IteratorBucket(mIndex).end())
 		{
 			throw std::exception("Iterator doesn't point to any item in hashmap");
 		}
@@ -348,14 +548,14 @@ namespace GameEngine
 			throw std::exception("Iterator does not belong to any hashmap");
 		}
 
-		if (mIndex < mOwner->mBuckets.Size())
+		if (mIndex < mOwner->IteratorBucketCount())
 		{
-			++mChainIterator;                                        // Move to next list node
-			if (mChainIterator == mOwner->mBuckets[mIndex].end())    // If no more nodes, move to next bucket
+			++mChainIterator;                                             // Move to next list node
+			if (mChainIterator == mOwner->IteratorBucket(mIndex).end())   // If no more nodes, move to next bucket
 			{
-				while (++mIndex < mOwner->mBuckets.Size())
+				while (++mIndex < mOwner->IteratorBucketCount())
 				{
-					ChainType& chain = const_cast<HashMap*>(mOwner)->mBuckets[mIndex];
+					ChainType& chain = const_cast<HashMap*>(mOwner)->IteratorBucket(mIndex);
 					if (chain.Size() > 0)
 					{
 						mChainIterator = chain.begin();
@@ -404,7 +604,7 @@ namespace GameEngine
 	template <typename TKey, typename TValue, typename HashFunctor, typename KeyEqualityFunctor>
 	inline bool HashMap<TKey, TValue, HashFunctor, KeyEqualityFunctor>::ConstIterator::operator==(const ConstIterator& other) const
 	{
-		return mOwner == other.mOwner && mIndex == other.mIndex && (mChainIterator == other.mChainIterator || mIndex == mOwner->mBuckets.Size());
+		return mOwner == other.mOwner && mIndex == other.mIndex && (mChainIterator == other.mChainIterator || mIndex == mOwner->IteratorBucketCount());
 	}
 
 	template <typename TKey, typename TValue, typename HashFunctor, typename KeyEqualityFunctor>
@@ -421,7 +621,7 @@ namespace GameEngine
 			throw std::exception("Iterator doesn't belong to any hashmap");
 		}
 
-		if (mIndex >= mOwner->mBuckets.Size() || mChainIterator == mOwner->mBuckets[mIndex].end())
+		if (mIndex >= mOwner->IteratorBucketCount() || mChainIterator == mOwner->IteratorBucket(mIndex).end())
 		{
 			throw std::exception("Iterator doesn't point to any item in hashmap");
 		}
@@ -443,14 +643,14 @@ namespace GameEngine
 			throw std::exception("Iterator does not belong to any hashmap");
 		}
 
-		if (mIndex < mOwner->mBuckets.Size())
+		if (mIndex < mOwner->IteratorBucketCount())
 		{
-			++mChainIterator;                                        // Move to next list node
-			if (mChainIterator == mOwner->mBuckets[mIndex].end())    // If no more nodes, move to next bucket
+			++mChainIterator;                                             // Move to next list node
+			if (mChainIterator == mOwner->IteratorBucket(mIndex).end())   // If no more nodes, move to next bucket
 			{
-				while (++mIndex < mOwner->mBuckets.Size())
+				while (++mIndex < mOwner->IteratorBucketCount())
 				{
-					const ChainType& chain = mOwner->mBuckets[mIndex];
+					const ChainType& chain = mOwner->IteratorBucket(mIndex);
 					if (chain.Size() > 0)
 					{
 						mChainIterator = chain.begin();
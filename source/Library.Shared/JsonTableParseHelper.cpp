@@ -188,6 +188,7 @@ bool JsonTableParseHelper::StartValueHandler(SharedData& data, Json::Value& valu
 			else if (value.isMember(SharedData::JSON_CLASS_KEY))
 			{
 				string className = value[SharedData::JSON_CLASS_KEY].asString();
+				ArenaGuard guard(frame.mScope->GetArena());
 				childScope = Factory<Scope>::Create(className);
 				assert(childScope != nullptr);
 				frame.mScope->Adopt(*childScope, frame.mKey);
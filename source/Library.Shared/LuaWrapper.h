@@ -1,5 +1,8 @@
 #pragma once
 #include "Macro.h"
+#include "SmallVector.h"
+#include "ConcurrentRegistry.h"
+#include <memory>
 #include <vector>
 #include <map>
 #include <set>
@@ -62,13 +65,18 @@ namespace GameEngine::Lua
 	class Registry final
 	{
 	public:
+		struct TypeNode;
+
+		// Nodes are immutable once published and link to each other by name, so readers on other threads always walk one consistent snapshot
+		using TypeMap = ConcurrentRegistry<std::string, std::shared_ptr<const TypeNode>>;
+
 		struct TypeNode
 		{
-			using Link = Vector<TypeNode*>;
+			using Link = SmallVector<std::string, 4>;
 
 			inline TypeNode(const std::string& name, uint64_t id);
-			inline bool IsAncestor(uint64_t expectType);
-			inline bool IsDescedant(uint64_t expectType);
+			inline bool IsAncestor(const TypeMap::MapType& registry, uint64_t expectType) const;
+			inline bool IsDescedant(const TypeMap::MapType& registry, uint64_t expectType) const;
 
 			const std::string mName;
 			const uint64_t mTypeId = 0;
@@ -76,10 +84,10 @@ namespace GameEngine::Lua
 			Link mDownLink;
 
 		private:
-			inline bool BFS(std::function<Link*(TypeNode*)> getLinkFunc, uint64_t expectType);
+			inline bool BFS(const TypeMap::MapType& registry, std::function<const Link*(const TypeNode*)> getLinkFunc, uint64_t expectType) const;
 		};
 
-		static inline std::map<std::string, TypeNode> sTypeRegistry;
+		static inline TypeMap sTypeRegistry;
 		static inline bool Is(lua_State* L, int index, uint64_t expectType);
 
 		static inline void IncrementObjectCounter(void* address);
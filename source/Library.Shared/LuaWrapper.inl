@@ -256,7 +256,10 @@ namespace GameEngine::Lua
 
 		// Add type info to registry
 		const std::string& name = LuaWrapper<T>::sName;
-		Registry::sTypeRegistry.insert(std::make_pair(name, Registry::TypeNode(name, LuaWrapper<T>::sTypeId)));
+		Registry::sTypeRegistry.Update([&name](auto& registry)
+		{
+			registry.Insert(std::make_pair(name, std::make_shared<const Registry::TypeNode>(name, LuaWrapper<T>::sTypeId)));
+		});
 	}
 
 	template <typename T>
@@ -276,11 +279,18 @@ namespace GameEngine::Lua
 		lua_rawset(L, -3);
 		lua_pop(L, 1);
 
-		// Build type link in registry
-		Registry::TypeNode& node = Registry::sTypeRegistry.find(LuaWrapper<T>::sName)->second;
-		Registry::TypeNode& parentNode = Registry::sTypeRegistry.find(LuaWrapper<Parent>::sName)->second;
-		node.mUpLink.PushBack(&parentNode);
-		parentNode.mDownLink.PushBack(&node);
+		// Build type link in registry, published nodes are shared with readers so link copies of them
+		Registry::sTypeRegistry.Update([](auto& registry)
+		{
+			auto& node = registry.At(LuaWrapper<T>::sName);
+			auto& parentNode = registry.At(LuaWrapper<Parent>::sName);
+			auto newNode = std::make_shared<Registry::TypeNode>(*node);
+			auto newParentNode = std::make_shared<Registry::TypeNode>(*parentNode);
+			newNode->mUpLink.PushBack(LuaWrapper<Parent>::sName);
+			newParentNode->mDownLink.PushBack(LuaWrapper<T>::sName);
+			node = std::move(newNode);
+			parentNode = std::move(newParentNode);
+		});
 	}
 
 	template <typename T>
@@ -300,30 +310,45 @@ namespace GameEngine::Lua
 			lua_setglobal(L, LuaWrapper<T>::sName.c_str());
 		}
 
-		// Fix type link in registry
-		auto it = Registry::sTypeRegistry.find(LuaWrapper<T>::sName)->second;
-		auto& node = it->second;
-		for (const auto* parentNode : node.mUpLink)
+		// Fix type link in registry, connect parents of this type to its children directly
+		Registry::sTypeRegistry.Update([](auto& registry)
 		{
-			for (const auto* childNode : node.mDownLink)
+			auto it = registry.Find(LuaWrapper<T>::sName);
+			if (it == registry.end())
+			{
+				return;
+			}
+			const auto node = it->second;
+			for (const auto& parentName : node->mUpLink)
 			{
-				if (parentNode->mDownLink.find(childNode) != parentNode->mDownLink.end())
+				auto& parentNode = registry.At(parentName);
+				auto newParentNode = std::make_shared<Registry::TypeNode>(*parentNode);
+				newParentNode->mDownLink.Remove(node->mName);
+				for (const auto& childName : node->mDownLink)
 				{
-					parentNode->mDownLink.PushBack(childNode);
+					if (newParentNode->mDownLink.Find(childName) == newParentNode->mDownLink.end())
+					{
+						newParentNode->mDownLink.PushBack(childName);
+					}
 				}
+				parentNode = std::move(newParentNode);
 			}
-		}
-		for (const auto* childNode : node.mDownLink)
-		{
-			for (const auto* parentNode : node.mUpLink)
+			for (const auto& childName : node->mDownLink)
 			{
-				if (childNode->mUpLink.find(parentNode) != childNode->mUpLink.end())
+				auto& childNode = registry.At(childName);
+				auto newChildNode = std::make_shared<Registry::TypeNode>(*childNode);
+				newChildNode->mUpLink.Remove(node->mName);
+				for (const auto& parentName : node->mUpLink)
 				{
-					childNode->mUpLink.PushBack(parentNode);
+					if (newChildNode->mUpLink.Find(parentName) == newChildNode->mUpLink.end())
+					{
+						newChildNode->mUpLink.PushBack(parentName);
+					}
 				}
+				childNode = std::move(newChildNode);
 			}
-		}
-		Registry::sTypeRegistry.erase(it);
+			registry.Remove(it);
+		});
 	}
 
 	template <typename T>
@@ -411,23 +436,23 @@ namespace GameEngine::Lua
 		mTypeId(id)
 	{}
 
-	bool Registry::TypeNode::IsAncestor(uint64_t expectType)
+	bool Registry::TypeNode::IsAncestor(const TypeMap::MapType& registry, uint64_t expectType) const
 	{
-		return BFS([](TypeNode* node) { return &node->mDownLink; }, expectType);
+		return BFS(registry, [](const TypeNode* node) { return &node->mDownLink; }, expectType);
 	}
 
-	bool Registry::TypeNode::IsDescedant(uint64_t expectType)
+	bool Registry::TypeNode::IsDescedant(const TypeMap::MapType& registry, uint64_t expectType) const
 	{
-		return BFS([](TypeNode* node) { return &node->mUpLink; }, expectType);
+		return BFS(registry, [](const TypeNode* node) { return &node->mUpLink; }, expectType);
 	}
 
-	bool Registry::TypeNode::BFS(std::function<Link*(TypeNode*)> getLinkFunc, uint64_t expectType)
+	bool Registry::TypeNode::BFS(const TypeMap::MapType& registry, std::function<const Link*(const TypeNode*)> getLinkFunc, uint64_t expectType) const
 	{
-		SList<TypeNode*> queue = { this };
+		SList<const TypeNode*> queue = { this };
 		while (!queue.IsEmpty())
 		{
 			// Check the first item in queue
-			TypeNode* node = queue.Front();
+			const TypeNode* node = queue.Front();
 			queue.PopFront();
 			if (node->mTypeId == expectType)
 			{
@@ -435,10 +460,14 @@ namespace GameEngine::Lua
 			}
 
 			// Push this node's next list to queue
-			Link& nextLink = *getLinkFunc(node);
-			for (TypeNode* childNode : nextLink)
+			const Link& nextLink = *getLinkFunc(node);
+			for (const std::string& name : nextLink)
 			{
-				queue.PushBack(childNode);
+				auto it = registry.Find(name);
+				if (it != registry.end())
+				{
+					queue.PushBack(it->second.get());
+				}
 			}
 		}
 
@@ -456,14 +485,22 @@ namespace GameEngine::Lua
 			if (type == LUA_TSTRING)
 			{
 				std::string name = lua_tostring(L, -1);
-				auto it = sTypeRegistry.find(name);
-				if (it != sTypeRegistry.end())
+				bool isType = sTypeRegistry.Read([&name, expectType](const TypeMap::MapType* registry)
 				{
-					if (it->second.IsDescedant(expectType) || it->second.IsAncestor(expectType))
+					if (registry != nullptr)
 					{
-						lua_pop(L, 2);  // Remove string and metatable
-						return true;
+						auto it = registry->Find(name);
+						if (it != registry->end())
+						{
+							return it->second->IsDescedant(*registry, expectType) || it->second->IsAncestor(*registry, expectType);
+						}
 					}
+					return false;
+				});
+				if (isType)
+				{
+					lua_pop(L, 2);  // Remove string and metatable
+					return true;
 				}
 			}
 		}
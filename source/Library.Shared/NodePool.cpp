@@ -0,0 +1,132 @@
+#include "pch.h"
+#include "NodePool.h"
+#include <algorithm>
+#include <cstdlib>
+
+namespace GameEngine
+{
+#pragma region NodePool
+	NodePool::~NodePool()
+	{
+		while (mSlabs != nullptr)
+		{
+			Slab* next = mSlabs->mNext;
+			free(mSlabs);
+			mSlabs = next;
+		}
+	}
+
+	void* NodePool::Allocate(size_t size)
+	{
+		if (mBlockSize == 0)
+		{
+			// Round up so that every block in a slab stays aligned
+			mBlockSize = (std::max(size, sizeof(FreeBlock)) + Alignment - 1) / Alignment * Alignment;
+		}
+		else if (size > mBlockSize)
+		{
+			throw std::exception("Size is larger than block size of the pool!");
+		}
+
+		if (mFreeList == nullptr)
+		{
+			Grow();
+		}
+
+		FreeBlock* block = mFreeList;
+		mFreeList = block->mNext;
+		++mLiveCount;
+		return block;
+	}
+
+	void NodePool::Deallocate(void* block)
+	{
+		if (block != nullptr)
+		{
+			FreeBlock* freeBlock = static_cast<FreeBlock*>(block);
+			freeBlock->mNext = mFreeList;
+			mFreeList = freeBlock;
+			--mLiveCount;
+		}
+	}
+
+	size_t NodePool::BlockSize() const
+	{
+		return mBlockSize;
+	}
+
+	size_t NodePool::SlabCount() const
+	{
+		return mSlabCount;
+	}
+
+	size_t NodePool::LiveCount() const
+	{
+		return mLiveCount;
+	}
+
+	void NodePool::Grow()
+	{
+		const size_t blockCount = mNextSlabBlockCount;
+		Slab* slab = reinterpret_cast<Slab*>(malloc(sizeof(Slab) + mBlockSize * blockCount));
+		if (slab == nullptr)
+		{
+			throw std::bad_alloc();
+		}
+		slab->mNext = mSlabs;
+		mSlabs = slab;
+		++mSlabCount;
+		mNextSlabBlockCount = std::min(blockCount * 2, MaxSlabBlockCount);
+
+		// Push blocks backward so that they are handed out in address order
+		char* blocks = reinterpret_cast<char*>(slab + 1);
+		for (size_t i = blockCount; i > 0; --i)
+		{
+			FreeBlock* block = reinterpret_cast<FreeBlock*>(blocks + (i - 1) * mBlockSize);
+			block->mNext = mFreeList;
+			mFreeList = block;
+		}
+	}
+#pragma endregion
+
+#pragma region PoolAllocator
+	PoolAllocator::PoolAllocator(std::shared_ptr<NodePool> pool) :
+		mPool(std::move(pool))
+	{
+	}
+
+	PoolAllocator PoolAllocator::Create()
+	{
+		return PoolAllocator(std::make_shared<NodePool>());
+	}
+
+	void* PoolAllocator::Allocate(size_t size)
+	{
+		if (mPool == nullptr)
+		{
+			mPool = std::make_shared<NodePool>();
+		}
+		return mPool->Allocate(size);
+	}
+
+	void PoolAllocator::Deallocate(void* block, size_t)
+	{
+		mPool->Deallocate(block);
+	}
+
+	NodePool* PoolAllocator::Pool() const
+	{
+		return mPool.get();
+	}
+
+	bool PoolAllocator::operator==(const PoolAllocator& other) const
+	{
+		return mPool == other.mPool;
+	}
+
+	bool PoolAllocator::operator!=(const PoolAllocator& other) const
+	{
+		return !operator==(other);
+	}
+#pragma endregion
+}
@@ -0,0 +1,222 @@
+#pragma once
+
+/// \file NodePool.h
+/// \brief Contains the declaration of NodePool and the node allocators used by SList
+
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+
+namespace GameEngine
+{
+	/// <summary>
+	/// A pool of fixed-size memory blocks carved out of slabs. Freed blocks go to a free list and are handed out again before a new slab is allocated.
+	/// Block size is decided by the first allocation. Slabs start small and double in size, and are only released when the pool is destroyed.
+	/// A pool is not thread-safe, all containers sharing one pool must be used from the same thread
+	/// </summary>
+	class NodePool final
+	{
+	public:
+		/// <summary>
+		/// Alignment of every block
+		/// </summary>
+		static constexpr size_t Alignment = 16;
+
+		/// <summary>
+		/// Number of blocks in the first slab
+		/// </summary>
+		static constexpr size_t MinSlabBlockCount = 4;
+
+		/// <summary>
+		/// Max number of blocks in one slab
+		/// </summary>
+		static constexpr size_t MaxSlabBlockCount = 256;
+
+		/// <summary>
+		/// Default constructor, create an empty pool without any slab
+		/// </summary>
+		NodePool() = default;
+
+		NodePool(const NodePool&) = delete;
+		NodePool& operator=(const NodePool&) = delete;
+
+		/// <summary>
+		/// Destructor, free all slabs. Blocks still in use become invalid
+		/// </summary>
+		~NodePool();
+
+		/// <summary>
+		/// Get a block of at least given size. Allocate a new slab if free list is empty
+		/// </summary>
+		/// <param name="size">Size of block, must not exceed the size of the first allocation</param>
+		/// <returns>Address of the block</returns>
+		/// <exception cref="std::exception">Size is larger than block size of this pool</exception>
+		void* Allocate(size_t size);
+
+		/// <summary>
+		/// Return a block to the free list
+		/// </summary>
+		/// <param name="block">Address of block allocated by this pool</param>
+		void Deallocate(void* block);
+
+		/// <summary>
+		/// Get the size of each block, 0 if nothing has been allocated yet
+		/// </summary>
+		/// <returns>Size of each block in bytes</returns>
+		size_t BlockSize() const;
+
+		/// <summary>
+		/// Get the number of slabs allocated from heap
+		/// </summary>
+		/// <returns>Number of slabs</returns>
+		size_t SlabCount() const;
+
+		/// <summary>
+		/// Get the number of blocks currently handed out
+		/// </summary>
+		/// <returns>Number of blocks in use</returns>
+		size_t LiveCount() const;
+
+	private:
+		/// <summary>
+		/// An unused block, links to next unused block
+		/// </summary>
+		struct FreeBlock
+		{
+			FreeBlock* mNext;
+		};
+
+		/// <summary>
+		/// Header at the start of each slab, blocks follow right after it
+		/// </summary>
+		struct alignas(Alignment) Slab
+		{
+			Slab* mNext;
+		};
+
+		/// <summary>
+		/// Allocate a new slab and push all its blocks to the free list
+		/// </summary>
+		void Grow();
+
+		/// <summary>
+		/// Head of free list
+		/// </summary>
+		FreeBlock* mFreeList = nullptr;
+
+		/// <summary>
+		/// Head of slab list
+		/// </summary>
+		Slab* mSlabs = nullptr;
+
+		/// <summary>
+		/// Size of each block
+		/// </summary>
+		size_t mBlockSize = 0;
+
+		/// <summary>
+		/// Number of blocks in the next slab
+		/// </summary>
+		size_t mNextSlabBlockCount = MinSlabBlockCount;
+
+		/// <summary>
+		/// Number of slabs
+		/// </summary>
+		size_t mSlabCount = 0;
+
+		/// <summary>
+		/// Number of blocks in use
+		/// </summary>
+		size_t mLiveCount = 0;
+	};
+
+	/// <summary>
+	/// Node allocator backed by a shared NodePool. Copies of an allocator share the same pool, so nodes can be relinked between lists that use them.
+	/// A default-constructed allocator creates its own pool on first allocation
+	/// </summary>
+	class PoolAllocator final
+	{
+	public:
+		/// <summary>
+		/// Default constructor, the pool is created on first allocation
+		/// </summary>
+		PoolAllocator() = default;
+
+		/// <summary>
+		/// Create an allocator that uses given pool
+		/// </summary>
+		/// <param name="pool">Pool to allocate from</param>
+		explicit PoolAllocator(std::shared_ptr<NodePool> pool);
+
+		/// <summary>
+		/// Create an allocator with a new pool, so that its copies share the pool right from the start
+		/// </summary>
+		/// <returns>An allocator with its own pool</returns>
+		static PoolAllocator Create();
+
+		/// <summary>
+		/// Allocate memory for one node
+		/// </summary>
+		/// <param name="size">Size of node</param>
+		/// <returns>Address of memory</returns>
+		void* Allocate(size_t size);
+
+		/// <summary>
+		/// Free the memory of one node
+		/// </summary>
+		/// <param name="block">Address of memory returned by Allocate</param>
+		/// <param name="size">Size of node</param>
+		void Deallocate(void* block, size_t size);
+
+		/// <summary>
+		/// Get the pool used by this allocator
+		/// </summary>
+		/// <returns>Pool used by this allocator, nullptr if nothing has been allocated yet</returns>
+		NodePool* Pool() const;
+
+		/// <summary>
+		/// Two allocators are equal if memory allocated by one can be freed by the other
+		/// </summary>
+		/// <param name="other">The other allocator to compare with</param>
+		/// <returns>True if two allocators use the same pool, False otherwise</returns>
+		bool operator==(const PoolAllocator& other) const;
+
+		/// <summary>
+		/// Two allocators are equal if memory allocated by one can be freed by the other
+		/// </summary>
+		/// <param name="other">The other allocator to compare with</param>
+		/// <returns>True if two allocators use different pools, False otherwise</returns>
+		bool operator!=(const PoolAllocator& other) const;
+
+	private:
+		/// <summary>
+		/// Shared pool
+		/// </summary>
+		std::shared_ptr<NodePool> mPool;
+	};
+
+	/// <summary>
+	/// Node allocator that calls global new and delete for every node
+	/// </summary>
+	struct HeapAllocator final
+	{
+		inline void* Allocate(size_t size);
+		inline void Deallocate(void* block, size_t size);
+		inline bool operator==(const HeapAllocator& other) const;
+		inline bool operator!=(const HeapAllocator& other) const;
+	};
+
+	template <typename T>
+	struct IsTriviallyRelocatable;
+
+	/// <summary>
+	/// PoolAllocator only holds a shared_ptr, which can be relocated with a memory copy
+	/// </summary>
+	template <>
+	struct IsTriviallyRelocatable<PoolAllocator> : std::true_type {};
+
+	template <>
+	struct IsTriviallyRelocatable<HeapAllocator> : std::true_type {};
+}
+
+#include "NodePool.inl"
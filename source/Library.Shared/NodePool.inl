@@ -0,0 +1,24 @@
+#pragma once
+
+namespace GameEngine
+{
+	void* HeapAllocator::Allocate(size_t size)
+	{
+		return ::operator new(size);
+	}
+
+	void HeapAllocator::Deallocate(void* block, size_t)
+	{
+		::operator delete(block);
+	}
+
+	bool HeapAllocator::operator==(const HeapAllocator&) const
+	{
+		return true;
+	}
+
+	bool HeapAllocator::operator!=(const HeapAllocator&) const
+	{
+		return false;
+	}
+}
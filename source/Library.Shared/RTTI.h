@@ -18,6 +18,11 @@ namespace GameEngine
 
 		static IdType TypeIdClass() { return 0; }
 
+		virtual std::string TypeNameInstance() const
+		{
+			return "RTTI";
+		}
+
 		virtual RTTI* QueryInterface(const IdType)
 		{
 			return nullptr;
@@ -55,6 +60,7 @@ namespace GameEngine
 			static std::string TypeName() { return std::string(#Type); }												 \
 			static IdType TypeIdClass() { return sRunTimeTypeId; }												 \
 			virtual IdType TypeIdInstance() const override { return Type::TypeIdClass(); }						 \
+			virtual std::string TypeNameInstance() const override { return Type::TypeName(); }					 \
 			virtual GameEngine::RTTI* QueryInterface(const IdType id) override										 \
             {																											 \
 				return (id == sRunTimeTypeId ? reinterpret_cast<GameEngine::RTTI*>(this) : ParentType::QueryInterface(id)); \
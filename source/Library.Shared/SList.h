@@ -5,6 +5,8 @@
 
 #include <initializer_list>
 #include <cstddef>
+#include <type_traits>
+#include "NodePool.h"
 
 /// <summary>
 /// All game-related code goes in here
@@ -16,8 +18,10 @@ namespace GameEngine
 	/// The list supports push to front, push to back, pop front, pop back and clear manipunation.
 	/// It allows user to query the size, emptiness, the first item and the last item.
 	/// To create a SList, provide a specification such as "SList<int> list".
+	/// Nodes are allocated by Allocator. By default each list has its own pool so nodes come from contiguous slabs and are recycled after removal.
+	/// Copies of a list share its pool, so nodes can be spliced between them without allocation.
 	/// </summary>
-	template <typename T>
+	template <typename T, typename Allocator = PoolAllocator>
 	class SList
 	{
 	private:
@@ -83,6 +87,25 @@ namespace GameEngine
 		/// </summary>
 		size_t mSize = 0;
 
+		/// <summary>
+		/// Allocator that provides memory of nodes
+		/// </summary>
+		Allocator mAllocator;
+
+		/// <summary>
+		/// Allocate a node from allocator and construct it
+		/// </summary>
+		/// <param name="data">The data of new node</param>
+		/// <param name="next">The pointer to next node</param>
+		/// <returns>The new node</returns>
+		Node* CreateNode(const T & data, Node* next);
+
+		/// <summary>
+		/// Destruct a node and return its memory to allocator
+		/// </summary>
+		/// <param name="node">The node to destroy</param>
+		void DestroyNode(Node* node);
+
 		/// <summary>
 		/// Copy the data in each node in other list to this one
 		/// </summary>
@@ -178,7 +201,13 @@ namespace GameEngine
 		SList() = default;
 
 		/// <summary>
-		/// Copy constructor. Deep copy the contents from the other list into this one
+		/// Create an empty linked list that allocates nodes from given allocator
+		/// </summary>
+		/// <param name="allocator">The allocator to use, lists with equal allocators can splice nodes between each other</param>
+		explicit SList(const Allocator & allocator);
+
+		/// <summary>
+		/// Copy constructor. Deep copy the contents from the other list into this one, the copy shares the allocator of other list
 		/// </summary>
 		/// <param name="other">The other list to copy from</param>
 		SList(const SList & other);
@@ -196,7 +225,7 @@ namespace GameEngine
 		SList(std::initializer_list<T> list);
 
 		/// <summary>
-		/// Clear current list (release memory) and deep copy the contents from the other list into this one
+		/// Clear current list (release memory) and deep copy the contents from the other list into this one. This list keeps its own allocator
 		/// </summary>
 		/// <param name="other">The other list to copy from</param>
 		SList & operator=(const SList & other);
@@ -322,6 +351,16 @@ namespace GameEngine
 		/// <returns>The iterator of newly inserted item, if insertion is invalid, it will be end()</returns>
 		Iterator InsertAfter(const Iterator & iterator, const T & data);
 
+		/// <summary>
+		/// Unlink the front node of other list and append it after the back of this list.
+		/// If both lists use equal allocators, the data item is not copied, so references to it stay valid.
+		/// Otherwise the item is copied into this list and removed from other list
+		/// </summary>
+		/// <param name="other">The list to take the front node from</param>
+		/// <returns>The iterator to the moved item in this list</returns>
+		/// <exception cref="std::exception">Other list is empty</exception>
+		Iterator SpliceFront(SList & other);
+
 		/// <summary>
 		/// Search for the given data in the list and return the iterator to the item if such item is found.
 		/// This method will invoke operator==() of given data type, so such method must exist.
@@ -350,7 +389,19 @@ namespace GameEngine
 		/// </summary>
 		/// <param name="iterator">The iterator pointing to the data to be removed</param>
 		void Remove(const Iterator & iterator);
+
+		/// <summary>
+		/// Get the allocator of this list
+		/// </summary>
+		/// <returns>The allocator that provides memory of nodes</returns>
+		const Allocator & GetAllocator() const;
 	};
+
+	/// <summary>
+	/// Nodes never point back to the list, so a SList can be relocated by copying its front, back and size, as long as its allocator can
+	/// </summary>
+	template <typename T, typename Allocator>
+	struct IsTriviallyRelocatable<SList<T, Allocator>> : IsTriviallyRelocatable<Allocator> {};
 }
 
 #include "SList.inl"
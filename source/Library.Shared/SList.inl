@@ -3,25 +3,33 @@
 namespace GameEngine
 {
 #pragma region SList
-	template <typename T>
-	SList<T>::SList(const SList<T> & other)
+	template <typename T, typename Allocator>
+	SList<T, Allocator>::SList(const Allocator & allocator) :
+		mAllocator(allocator)
+	{
+	}
+
+	template <typename T, typename Allocator>
+	SList<T, Allocator>::SList(const SList<T, Allocator> & other) :
+		mAllocator(other.mAllocator)
 	{
 		DeepCopy(other);
 	}
 
-	template <typename T>
-	SList<T>::SList(SList<T> && other) :
+	template <typename T, typename Allocator>
+	SList<T, Allocator>::SList(SList<T, Allocator> && other) :
 		mFront(other.mFront),
 		mBack(other.mBack),
-		mSize(other.mSize)
+		mSize(other.mSize),
+		mAllocator(other.mAllocator)
 	{
 		other.mFront = nullptr;
 		other.mBack = nullptr;
 		other.mSize = 0;
 	}
 
-	template <typename T>
-	SList<T>::SList(std::initializer_list<T> list)
+	template <typename T, typename Allocator>
+	SList<T, Allocator>::SList(std::initializer_list<T> list)
 	{
 		for (const auto data : list)
 		{
@@ -29,8 +37,8 @@ namespace GameEngine
 		}
 	}
 
-	template <typename T>
-	SList<T> & SList<T>::operator=(const SList<T> & other)
+	template <typename T, typename Allocator>
+	SList<T, Allocator> & SList<T, Allocator>::operator=(const SList<T, Allocator> & other)
 	{
 		if (this != &other)
 		{
@@ -41,12 +49,13 @@ namespace GameEngine
 		return *this;
 	}
 
-	template <typename T>
-	SList<T> & SList<T>::operator=(SList<T> && other)
+	template <typename T, typename Allocator>
+	SList<T, Allocator> & SList<T, Allocator>::operator=(SList<T, Allocator> && other)
 	{
 		if (this != &other)
 		{
 			Clear();
+			mAllocator = other.mAllocator;  // Nodes are owned by the allocator of other list
 			mFront = other.mFront;
 			mBack = other.mBack;
 			mSize = other.mSize;
@@ -58,16 +67,16 @@ namespace GameEngine
 		return *this;
 	}
 
-	template <typename T>
-	SList<T>::~SList()
+	template <typename T, typename Allocator>
+	SList<T, Allocator>::~SList()
 	{
 		Clear();
 	}
 
-	template <typename T>
-	typename SList<T>::Iterator SList<T>::PushFront(const T & data)
+	template <typename T, typename Allocator>
+	typename SList<T, Allocator>::Iterator SList<T, Allocator>::PushFront(const T & data)
 	{
-		Node* front = new Node(data, mFront);
+		Node* front = CreateNode(data, mFront);
 
 		// List is empty, point back to front too
 		if (mSize == 0)
@@ -81,8 +90,8 @@ namespace GameEngine
 		return begin();
 	}
 
-	template <typename T>
-	typename SList<T>::Iterator SList<T>::PushBack(const T & data)
+	template <typename T, typename Allocator>
+	typename SList<T, Allocator>::Iterator SList<T, Allocator>::PushBack(const T & data)
 	{
 		if (mSize == 0)  // List is empty
 		{
@@ -90,7 +99,7 @@ namespace GameEngine
 		}
 		else  // List has a back already
 		{
-			Node* newBack = new Node(data);
+			Node* newBack = CreateNode(data, nullptr);
 			mBack->mNext = newBack;
 			mBack = newBack;
 			mSize++;
@@ -99,14 +108,14 @@ namespace GameEngine
 		return Iterator(*this, mBack);
 	}
 
-	template <typename T>
-	void SList<T>::PopFront()
+	template <typename T, typename Allocator>
+	void SList<T, Allocator>::PopFront()
 	{
 		if (mFront != nullptr)
 		{
 			// Delete old front and point to new front
 			Node* newFront = mFront->mNext;
-			delete mFront;
+			DestroyNode(mFront);
 			mFront = newFront;
 
 			// Decrement list size
@@ -120,8 +129,8 @@ namespace GameEngine
 		}
 	}
 
-	template <typename T>
-	void SList<T>::PopBack()
+	template <typename T, typename Allocator>
+	void SList<T, Allocator>::PopBack()
 	{
 		if (mSize == 1)
 		{
@@ -134,15 +143,15 @@ namespace GameEngine
 			{
 				current = current->mNext;
 			}
-			delete mBack;
+			DestroyNode(mBack);
 			current->mNext = nullptr;
 			mBack = current;
 			mSize--;
 		}
 	}
 
-	template <typename T>
-	T & SList<T>::Front()
+	template <typename T, typename Allocator>
+	T & SList<T, Allocator>::Front()
 	{
 		if (mFront != nullptr)
 		{
@@ -154,14 +163,14 @@ namespace GameEngine
 		}
 	}
 
-	template <typename T>
-	const T & SList<T>::Front() const
+	template <typename T, typename Allocator>
+	const T & SList<T, Allocator>::Front() const
 	{
 		return const_cast<SList*>(this)->Front();
 	}
 
-	template <typename T>
-	T & SList<T>::Back()
+	template <typename T, typename Allocator>
+	T & SList<T, Allocator>::Back()
 	{
 		if (mBack != nullptr)
 		{
@@ -173,26 +182,26 @@ namespace GameEngine
 		}
 	}
 
-	template <typename T>
-	const T & SList<T>::Back() const
+	template <typename T, typename Allocator>
+	const T & SList<T, Allocator>::Back() const
 	{
 		return const_cast<SList*>(this)->Back();
 	}
 
-	template <typename T>
-	bool SList<T>::IsEmpty() const
+	template <typename T, typename Allocator>
+	bool SList<T, Allocator>::IsEmpty() const
 	{
 		return mSize == 0;
 	}
 
-	template <typename T>
-	size_t SList<T>::Size() const
+	template <typename T, typename Allocator>
+	size_t SList<T, Allocator>::Size() const
 	{
 		return mSize;
 	}
 
-	template <typename T>
-	void SList<T>::Clear()
+	template <typename T, typename Allocator>
+	void SList<T, Allocator>::Clear()
 	{
 		while (mSize > 0)
 		{
@@ -200,32 +209,32 @@ namespace GameEngine
 		}
 	}
 
-	template <typename T>
-	typename SList<T>::Iterator SList<T>::begin()
+	template <typename T, typename Allocator>
+	typename SList<T, Allocator>::Iterator SList<T, Allocator>::begin()
 	{
 		return Iterator(*this, mFront);
 	}
 
-	template <typename T>
-	typename SList<T>::Iterator SList<T>::begin() const
+	template <typename T, typename Allocator>
+	typename SList<T, Allocator>::Iterator SList<T, Allocator>::begin() const
 	{
 		return Iterator(*this, mFront);
 	}
 
-	template <typename T>
-	typename SList<T>::Iterator SList<T>::end()
+	template <typename T, typename Allocator>
+	typename SList<T, Allocator>::Iterator SList<T, Allocator>::end()
 	{
 		return Iterator(*this);
 	}
 
-	template <typename T>
-	typename SList<T>::Iterator SList<T>::end() const
+	template <typename T, typename Allocator>
+	typename SList<T, Allocator>::Iterator SList<T, Allocator>::end() const
 	{
 		return Iterator(*this);
 	}
 
-	template <typename T>
-	typename SList<T>::Iterator SList<T>::InsertAfter(const SList<T>::Iterator & iterator, const T & data)
+	template <typename T, typename Allocator>
+	typename SList<T, Allocator>::Iterator SList<T, Allocator>::InsertAfter(const SList<T, Allocator>::Iterator & iterator, const T & data)
 	{
 		if (iterator.mOwner == this)
 		{
@@ -238,7 +247,7 @@ namespace GameEngine
 				// Insert node
 				Node* node = iterator.mNode;
 				Node* next = node->mNext;
-				Node* newNode = new Node(data, next);
+				Node* newNode = CreateNode(data, next);
 				node->mNext = newNode;
 				mSize++;
 
@@ -257,10 +266,51 @@ namespace GameEngine
 		}
 	}
 
-	template <typename T>
-	typename SList<T>::Iterator SList<T>::Find(const T & data)
+	template <typename T, typename Allocator>
+	typename SList<T, Allocator>::Iterator SList<T, Allocator>::SpliceFront(SList<T, Allocator> & other)
 	{
-		SList<T>::Iterator it = begin();
+		if (other.mFront == nullptr)
+		{
+			throw std::exception("List is empty!");
+		}
+
+		// Nodes from a different pool cannot be freed by this list, copy the data instead
+		if (mAllocator != other.mAllocator)
+		{
+			Iterator it = PushBack(other.mFront->mData);
+			other.PopFront();
+			return it;
+		}
+
+		// Unlink from other list
+		Node* node = other.mFront;
+		other.mFront = node->mNext;
+		other.mSize--;
+		if (other.mSize == 0)
+		{
+			other.mBack = nullptr;
+		}
+
+		// Link to the back of this list
+		node->mNext = nullptr;
+		if (mBack == nullptr)
+		{
+			mFront = node;
+		}
+		else
+		{
+			mBack->mNext = node;
+		}
+		mBack = node;
+		mSize++;
+
+		return Iterator(*this, node);
+	}
+
+	template <typename T, typename Allocator>
+	typename SList<T, Allocator>::Iterator SList<T, Allocator>::Find(const T & data)
+	{
+		SList<T, Allocator>::Iterator it = begin();
 		while (it.mNode != nullptr)
 		{
 			if (it.mNode->mData == data)
@@ -273,20 +323,20 @@ namespace GameEngine
 		return end();
 	}
 
-	template <typename T>
-	typename SList<T>::Iterator SList<T>::Find(const T & data) const
+	template <typename T, typename Allocator>
+	typename SList<T, Allocator>::Iterator SList<T, Allocator>::Find(const T & data) const
 	{
-		return const_cast<SList<T>*>(this)->Find(data);
+		return const_cast<SList<T, Allocator>*>(this)->Find(data);
 	}
 
-	template <typename T>
-	void SList<T>::Remove(const T & data)
+	template <typename T, typename Allocator>
+	void SList<T, Allocator>::Remove(const T & data)
 	{
 		Remove(Find(data));
 	}
 
-	template <typename T>
-	void SList<T>::Remove(const Iterator & iterator)
+	template <typename T, typename Allocator>
+	void SList<T, Allocator>::Remove(const Iterator & iterator)
 	{
 		if (iterator.mOwner == this && iterator.mNode != nullptr)
 		{
@@ -305,7 +355,7 @@ namespace GameEngine
 				node->mData.~T();
 				new(&node->mData) T(std::move(next->mData));
 				node->mNext = next->mNext;
-				delete next;
+				DestroyNode(next);
 				mSize--;
 				if (node->mNext == nullptr)
 				{
@@ -315,8 +365,37 @@ namespace GameEngine
 		}
 	}
 
-	template <typename T>
-	void SList<T>::DeepCopy(const SList & other)
+	template <typename T, typename Allocator>
+	const Allocator & SList<T, Allocator>::GetAllocator() const
+	{
+		return mAllocator;
+	}
+
+	template <typename T, typename Allocator>
+	typename SList<T, Allocator>::Node* SList<T, Allocator>::CreateNode(const T & data, Node* next)
+	{
+		static_assert(alignof(Node) <= NodePool::Alignment, "Node is over-aligned for NodePool!");
+		void* memory = mAllocator.Allocate(sizeof(Node));
+		try
+		{
+			return new(memory) Node(data, next);
+		}
+		catch (...)
+		{
+			mAllocator.Deallocate(memory, sizeof(Node));
+			throw;
+		}
+	}
+
+	template <typename T, typename Allocator>
+	void SList<T, Allocator>::DestroyNode(Node* node)
+	{
+		node->~Node();
+		mAllocator.Deallocate(node, sizeof(Node));
+	}
+
+	template <typename T, typename Allocator>
+	void SList<T, Allocator>::DeepCopy(const SList & other)
 	{
 		for (auto & data : other)
 		{
@@ -326,15 +405,15 @@ namespace GameEngine
 #pragma endregion
 
 #pragma region SListIterator
-	template <typename T>
-	SList<T>::Iterator::Iterator(const SList & owner, Node* node) :
+	template <typename T, typename Allocator>
+	SList<T, Allocator>::Iterator::Iterator(const SList & owner, Node* node) :
 		mOwner(&owner),
 		mNode(node)
 	{
 	}
 
-	template <typename T>
-	typename SList<T>::Iterator & SList<T>::Iterator::operator++()
+	template <typename T, typename Allocator>
+	typename SList<T, Allocator>::Iterator & SList<T, Allocator>::Iterator::operator++()
 	{
 		if (mNode != nullptr)
 		{
@@ -344,28 +423,28 @@ namespace GameEngine
 		return *this;
 	}
 
-	template <typename T>
-	typename SList<T>::Iterator SList<T>::Iterator::operator++(int)
+	template <typename T, typename Allocator>
+	typename SList<T, Allocator>::Iterator SList<T, Allocator>::Iterator::operator++(int)
 	{
 		Iterator copy = *this;
 		operator++();
 		return copy;
 	}
 
-	template <typename T>
-	bool SList<T>::Iterator::operator==(const Iterator & other) const
+	template <typename T, typename Allocator>
+	bool SList<T, Allocator>::Iterator::operator==(const Iterator & other) const
 	{
 		return (mOwner == other.mOwner && mNode == other.mNode);
 	}
 
-	template <typename T>
-	bool SList<T>::Iterator::operator!=(const Iterator & other) const
+	template <typename T, typename Allocator>
+	bool SList<T, Allocator>::Iterator::operator!=(const Iterator & other) const
 	{
 		return !operator==(other);
 	}
 
-	template <typename T>
-	T & SList<T>::Iterator::operator*() const
+	template <typename T, typename Allocator>
+	T & SList<T, Allocator>::Iterator::operator*() const
 	{
 		if (mNode == nullptr)
 		{
@@ -379,8 +458,8 @@ namespace GameEngine
 
 #pragma endregion
 
-	template <typename T>
-	SList<T>::Node::Node(const T & data, Node* next) :
+	template <typename T, typename Allocator>
+	SList<T, Allocator>::Node::Node(const T & data, Node* next) :
 		mData(data),
 		mNext(next)
 	{
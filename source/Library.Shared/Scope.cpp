@@ -1,11 +1,21 @@
 #include "pch.h"
 #include "Scope.h"
+#include "DefaultHashFunction.h"
+#include "ScopeColumns.h"
+#include "ScopeWriter.h"
+#include <algorithm>
 #include <assert.h>
+#include <charconv>
+#include <cstdlib>
+#include <new>
+#include <sstream>
 
 namespace GameEngine
 {
 	RTTI_DEFINITIONS(Scope);
 
+	std::atomic<std::uint64_t> Scope::sLastStructureEpoch = 0;
+
 	Scope::Scope(size_t capacity) :
 		mTable(capacity),
 		mDatumPointers(capacity)
@@ -27,6 +37,7 @@ namespace GameEngine
 		{
 			_Clear();
 			DeepCopy(other);
+			RetrackAssigned();
 		}
 		return *this;
 	}
@@ -35,18 +46,21 @@ namespace GameEngine
 	{
 		if (this != &other)
 		{
+			const bool tracking = mTrackChanges;
 			_Clear();
 			MoveFrom(std::move(other));
+			mTrackChanges = mTrackChanges || tracking;
+			RetrackAssigned();
 		}
 		return *this;
 	}
 
-	Datum& Scope::operator[](const std::string& key)
+	Datum& Scope::operator[](std::string_view key)
 	{
 		return Append(key).first;
 	}
 
-	const Datum& Scope::operator[](const std::string& key) const
+	const Datum& Scope::operator[](std::string_view key) const
 	{
 		const Datum* datum = Find(key);
 		if (datum != nullptr)
@@ -73,13 +87,40 @@ namespace GameEngine
 		return const_cast<Scope*>(this)->operator[](index);
 	}
 
+	const Atom& Scope::KeyAt(size_t index) const
+	{
+		if (index < mDatumPointers.Size())
+		{
+			return mDatumPointers[index]->first;
+		}
+		throw std::exception("Index out of range");
+	}
+
+	Datum& Scope::operator[](const Atom& key)
+	{
+		return Append(key).first;
+	}
+
+	const Datum& Scope::operator[](const Atom& key) const
+	{
+		const Datum* datum = Find(key);
+		if (datum != nullptr)
+		{
+			return *datum;
+		}
+		else
+		{
+			throw std::exception("Can't find entry with given key");
+		}
+	}
+
 	bool Scope::operator==(const Scope& other) const
 	{
 		if (this == &other)
 		{
 			return true;
 		}
-		else if (mTable.Size() == other.mTable.Size())
+		else if (mTable.Size() == other.mTable.Size() && !HashesDiffer(other))
 		{
 			// Walk through each datum in this table and find a equal one in the other
 			bool equal = true;
@@ -119,38 +160,9 @@ namespace GameEngine
 
 	std::string Scope::ToString() const
 	{
-		std::string str;
-		str.append("{\n");
-		for (size_t i = 0; i < mDatumPointers.Size(); ++i)
-		{
-			auto pair = mDatumPointers[i];
-			str.append("\"");
-			str.append(pair->first);
-			str.append("\": [");
-			for (size_t j = 0; j < pair->second.Size(); ++j)
-			{
-				if (pair->second.Type() == Datum::DatumType::Pointer && pair->second == this)
-				{
-					str.append("this");
-				}
-				else
-				{
-					str.append(pair->second.ToString(j));
-				}
-				if (j < pair->second.Size() - 1)
-				{
-					str.append(", ");
-				}
-			}
-			str.append("]");
-			if (i < mDatumPointers.Size() - 1)
-			{
-				str.append(",");
-			}
-			str.append("\n");
-		}
-		str.append("}");
-		return str;
+		std::ostringstream stream;
+		ScopeWriter(stream, ScopeWriter::Format::Text).Write(*this);
+		return stream.str();
 	}
 
 	bool Scope::Equals(const RTTI* rhs) const
@@ -164,6 +176,12 @@ namespace GameEngine
 		return new Scope(*this);
 	}
 
+	gsl::owner<Scope*> Scope::CloneShared() const
+	{
+		CopyOnWriteGuard guard;
+		return Clone();
+	}
+
 	Datum* Scope::Find(const std::string& key)
 	{
 		auto it = mTable.Find(key);
@@ -175,10 +193,42 @@ namespace GameEngine
 		return const_cast<Scope*>(this)->Find(key);
 	}
 
-	std::pair<Datum*, Scope*> Scope::Search(const std::string& path)
+	Datum* Scope::Find(std::string_view key)
+	{
+		auto it = mTable.Find(key);
+		return it == mTable.end() ? nullptr : &it->second;
+	}
+
+	const Datum* Scope::Find(std::string_view key) const
+	{
+		return const_cast<Scope*>(this)->Find(key);
+	}
+
+	Datum* Scope::Find(const char* key)
+	{
+		return Find(std::string_view(key));
+	}
+
+	const Datum* Scope::Find(const char* key) const
+	{
+		return const_cast<Scope*>(this)->Find(std::string_view(key));
+	}
+
+	Datum* Scope::Find(const Atom& key)
+	{
+		auto it = mTable.Find(key);
+		return it == mTable.end() ? nullptr : &it->second;
+	}
+
+	const Datum* Scope::Find(const Atom& key) const
+	{
+		return const_cast<Scope*>(this)->Find(key);
+	}
+
+	std::pair<Datum*, Scope*> Scope::Search(std::string_view path)
 	{
 		// Default search behavior for path with only one entry
-		if (path.find("/") == std::string::npos)
+		if (path.find('/') == std::string_view::npos)
 		{
 			TableIteratorType it = mTable.Find(path);
 			if (it != mTable.end())
@@ -194,22 +244,20 @@ namespace GameEngine
 		// Absolute path starts from the root
 		Datum* resultDatum = nullptr;
 		Scope* currentScope = this;
-		if (path._Starts_with("/"))
+		if (path[0] == '/')
 		{
 			currentScope = GetRoot();
 		}
 
-		// Recursively get to the target datum
+		// Recursively get to the target datum, tokens are views into path so nothing is copied
 		size_t start = 0;
-		std::string token;
 		for (size_t i = 0; i < path.size(); ++i)
 		{
 			if (path[i] == '/')
 			{
 				if (start != i)  // At least one char between two slashes
 				{
-					token = path.substr(start, i - start);
-					if (!ParseSearchToken(token, resultDatum, currentScope))
+					if (!ParseSearchToken(path.substr(start, i - start), resultDatum, currentScope))
 					{
 						return { nullptr, nullptr };
 					}
@@ -221,8 +269,7 @@ namespace GameEngine
 		// Last element can't be handled in the loop
 		if (start != path.size())
 		{
-			token = path.substr(start, path.size() - start);
-			if (!ParseSearchToken(token, resultDatum, currentScope))
+			if (!ParseSearchToken(path.substr(start), resultDatum, currentScope))
 			{
 				return { nullptr, nullptr };
 			}
@@ -231,7 +278,7 @@ namespace GameEngine
 		return { resultDatum, currentScope };
 	}
 
-	std::pair<const Datum*, const Scope*> Scope::Search(const std::string& path) const
+	std::pair<const Datum*, const Scope*> Scope::Search(std::string_view path) const
 	{
 		return const_cast<Scope*>(this)->Search(path);
 	}
@@ -251,22 +298,46 @@ namespace GameEngine
 		return const_cast<Scope*>(this)->GetRoot();
 	}
 
-	std::pair<Datum&, bool> Scope::Append(const std::string& key)
+	std::pair<Datum&, bool> Scope::Append(std::string_view key)
 	{
 		if (key.empty())
 		{
 			throw std::exception("No empty key is allowed");
 		}
 
+		// Look up first so an existing key is never interned
+		auto existing = mTable.Find(key);
+		if (existing != mTable.end())
+		{
+			return std::pair<Datum&, bool>(existing->second, false);
+		}
+		return Append(Atom(key));
+	}
+
+	std::pair<Datum&, bool> Scope::Append(const Atom& key)
+	{
+		if (key.IsEmpty())
+		{
+			throw std::exception("No empty key is allowed");
+		}
+
+		ArenaGuard guard(mArena);
 		auto [it, inserted] = mTable.Insert(std::make_pair(key, Datum()));
 		if (inserted)
 		{
 			mDatumPointers.PushBack(&*it);
+			MarkStructureChanged();
+			it->second.mScope = this;
+			InvalidateHash();
+			if (mTrackChanges)
+			{
+				it->second.MarkChanged();
+			}
 		}
 		return std::pair<Datum&, bool>(it->second, inserted);
 	}
 	
-	Scope& Scope::AppendScope(const std::string& key)
+	Scope& Scope::AppendScope(std::string_view key)
 	{
 		// Insert new datum or get existing one
 		auto [datum, inserted] = Append(key);
@@ -274,11 +345,21 @@ namespace GameEngine
 		{
 			throw std::exception("Try to append scope to a existing datum with different type");
 		}
+		if (datum.mColumns != nullptr)
+		{
+			throw std::exception("Try to append plain scope to a columnar datum");
+		}
 
 		// Append new scope to datum
+		ArenaGuard guard(mArena);
 		Scope* child = new Scope();
-		child->mParent = this;
 		datum.PushBack(*child);
+		child->SetParent(this, &datum, datum.Size() - 1);
+		if (mTrackChanges)
+		{
+			child->TrackChanges();
+		}
+		MarkStructureChanged();
 		return *child;
 	}
 
@@ -289,6 +370,10 @@ namespace GameEngine
 		{
 			throw std::exception("Can't adopt self or ancestor as child, will form a cycle");
 		}
+		if (child.mArena != nullptr && child.mArena != mArena && child.mArena != child.mOwnedArena.get())
+		{
+			throw std::exception("Can't adopt a scope allocated from another arena");
+		}
 
 		// Check if key is valid and create one if there is no entry with key.
 		// If there exists one, no matter what its type is, no datum will be created
@@ -298,6 +383,10 @@ namespace GameEngine
 		{
 			throw std::exception("Given key has an entry with different type");
 		}
+		if (datum.mColumns != nullptr)
+		{
+			datum.mColumns->CheckRow(child);
+		}
 
 		// Notify child's old parent, if has one
 		if (child.mParent != nullptr)
@@ -306,8 +395,53 @@ namespace GameEngine
 		}
 
 		// Finally can adopt
-		child.mParent = this;
 		datum.PushBack(child);
+		child.SetParent(this, &datum, datum.Size() - 1);
+		if (datum.mColumns != nullptr)
+		{
+			datum.mColumns->Attach(datum, datum.Size() - 1);
+		}
+		if (mTrackChanges && !child.mTrackChanges)
+		{
+			child.TrackChanges();
+		}
+		MarkStructureChanged();
+	}
+
+	ScopeColumns& Scope::MakeColumnar(std::string_view key, RTTI::IdType type)
+	{
+		Datum& datum = Append(key).first;
+		if (datum.Type() == Datum::DatumType::Unknown)
+		{
+			datum.SetType(Datum::DatumType::Table);
+		}
+		else if (datum.Type() != Datum::DatumType::Table)
+		{
+			throw std::exception("Given key has an entry with different type");
+		}
+
+		if (datum.mColumns != nullptr)
+		{
+			if (datum.mColumns->RowType() != type)
+			{
+				throw std::exception("Datum is columnar for another class");
+			}
+			return *datum.mColumns;
+		}
+
+		// Check every scope first, so nothing changes on failure
+		ArenaGuard guard(mArena);
+		auto columns = std::make_unique<ScopeColumns>(type);
+		for (size_t i = 0; i < datum.Size(); ++i)
+		{
+			columns->CheckRow(datum.AsTable(i));
+		}
+		for (size_t i = 0; i < datum.Size(); ++i)
+		{
+			columns->Attach(datum, i);
+		}
+		datum.mColumns = std::move(columns);
+		return *datum.mColumns;
 	}
 
 	Scope* Scope::GetParent() const
@@ -324,7 +458,12 @@ namespace GameEngine
 	{
 		std::string key;
 		Datum* result = nullptr;
-		if (scope != nullptr)
+		if (scope != nullptr && scope->mParent == this && scope->IsParentDatumValid())
+		{
+			key = FindKey(*scope->mParentDatum);
+			result = scope->mParentDatum;
+		}
+		else if (scope != nullptr)
 		{
 			ForEachChildScope([&key, &result](const std::string& constKey, Datum& datum, size_t, Scope&)
 			{
@@ -347,7 +486,7 @@ namespace GameEngine
 		{
 			if (&pair.second == &datum)
 			{
-				return pair.first;
+				return pair.first.Name();
 			}
 		}
 
@@ -369,46 +508,353 @@ namespace GameEngine
 		return false;
 	}
 
+	std::uint64_t Scope::StructureEpoch() const
+	{
+		// Only take a new epoch when asked for, so changes in a row cost nothing more than the first
+		const Scope* root = GetRoot();
+		if (root->mStructureEpoch == 0)
+		{
+			root->mStructureEpoch = sLastStructureEpoch.fetch_add(1, std::memory_order_relaxed) + 1;
+		}
+		return root->mStructureEpoch;
+	}
+
+	void Scope::MarkStructureChanged()
+	{
+		GetRoot()->mStructureEpoch = 0;
+	}
+
+	Arena& Scope::CreateArena(size_t chunkSize)
+	{
+		if (mParent != nullptr)
+		{
+			throw std::exception("Only a root scope can own an arena");
+		}
+		if (mOwnedArena != nullptr)
+		{
+			throw std::exception("Scope already owns an arena");
+		}
+		mOwnedArena = std::make_unique<Arena>(chunkSize);
+		SetArena(mOwnedArena.get());
+		return *mOwnedArena;
+	}
+
+	Arena* Scope::GetArena() const
+	{
+		return mArena;
+	}
+
+	void Scope::TrackChanges(bool enabled)
+	{
+		mTrackChanges = enabled;
+		mChanged = false;
+		for (auto& pair : mTable)
+		{
+			pair.second.mChanged = false;
+		}
+		ForEachChildScope([enabled](const std::string&, Datum&, size_t, Scope& child)
+		{
+			child.TrackChanges(enabled);
+		});
+	}
+
+	bool Scope::IsTrackingChanges() const
+	{
+		return mTrackChanges;
+	}
+
+	bool Scope::IsChanged() const
+	{
+		return mChanged;
+	}
+
+	void Scope::MarkChanged()
+	{
+		// A changed scope always has changed ancestors, so stop at the first one
+		for (Scope* scope = this; scope != nullptr && scope->mTrackChanges && !scope->mChanged; scope = scope->mParent)
+		{
+			scope->mChanged = true;
+		}
+	}
+
+	Vector<std::string> Scope::ChangedPaths() const
+	{
+		Vector<std::string> paths;
+		if (mChanged)
+		{
+			CollectChangedPaths(std::string(), paths);
+		}
+		return paths;
+	}
+
+	void Scope::ClearChanges()
+	{
+		if (!mChanged)
+		{
+			return;
+		}
+		mChanged = false;
+		for (auto& pair : mTable)
+		{
+			pair.second.mChanged = false;
+		}
+		ForEachChildScope([](const std::string&, Datum&, size_t, Scope& child)
+		{
+			child.ClearChanges();
+		});
+	}
+
+	size_t Scope::Hash() const
+	{
+		if (mHashValid)
+		{
+			return mHash;
+		}
+
+		// Sum of entries doesn't depend on their order, like operator==
+		size_t hash = HashInteger(mTable.Size());
+		bool cacheable = true;
+		for (const auto& pair : mTable)
+		{
+			const Datum& datum = pair.second;
+			hash += HashInteger(pair.first.Hash() ^ datum.Hash());
+			cacheable = cacheable && (datum.IsInternal() || datum.mInOwner);
+			if (datum.Type() == Datum::DatumType::Table)
+			{
+				for (size_t i = 0; i < datum.Size() && cacheable; ++i)
+				{
+					cacheable = datum.AsTable(i).mHashValid;
+				}
+			}
+		}
+
+		if (cacheable)
+		{
+			mHash = hash;
+			mHashValid = true;
+		}
+		return hash;
+	}
+
+	bool Scope::HashesDiffer(const Scope& other) const
+	{
+		return mHashValid && other.mHashValid && mHash != other.mHash;
+	}
+
+	void Scope::InvalidateHash()
+	{
+		// A scope with a cached hash never has a scope without one below it, so stop at the first one
+		for (Scope* scope = this; scope != nullptr && scope->mHashValid; scope = scope->mParent)
+		{
+			scope->mHashValid = false;
+		}
+	}
+
+	void Scope::MarkEntriesRemoved()
+	{
+		InvalidateHash();
+		MarkStructureChanged();
+		if (mTrackChanges && mParent != nullptr && IsParentDatumValid())
+		{
+			mParentDatum->MarkChanged();
+		}
+		MarkChanged();
+	}
+
+	void* Scope::operator new(size_t size)
+	{
+		static_assert(sizeof(AllocationHeader) <= AllocationHeaderSize, "Allocation header must fit in one alignment unit");
+		Arena* arena = Arena::Current();
+		const size_t total = size + AllocationHeaderSize;
+		void* block = arena != nullptr ? arena->Allocate(total) : malloc(total);
+		if (block == nullptr)
+		{
+			throw std::bad_alloc();
+		}
+
+		AllocationHeader* header = static_cast<AllocationHeader*>(block);
+		header->mArena = arena;
+		header->mSize = total;
+		return static_cast<char*>(block) + AllocationHeaderSize;
+	}
+
+	void* Scope::operator new(size_t, void* place) noexcept
+	{
+		return place;
+	}
+
+	void Scope::operator delete(void* pointer)
+	{
+		if (pointer != nullptr)
+		{
+			AllocationHeader* header = reinterpret_cast<AllocationHeader*>(static_cast<char*>(pointer) - AllocationHeaderSize);
+			if (header->mArena != nullptr)
+			{
+				header->mArena->Deallocate(header, header->mSize);
+			}
+			else
+			{
+				free(header);
+			}
+		}
+	}
+
+	void Scope::operator delete(void*, void*) noexcept
+	{
+	}
+
 	void Scope::Orphan(Scope& child)
 	{
-		ForEachChildScope([](const std::string&, Datum& datum, size_t index, Scope&)
+		Datum* datum = child.mParentDatum;
+		size_t index = child.mParentIndex;
+		if (child.mParent != this || !child.IsParentDatumValid())
+		{
+			// Only happens if the Datum was changed directly, fall back to search all nested scopes
+			datum = nullptr;
+			ForEachChildScope([&datum, &index](const std::string&, Datum& found, size_t foundIndex, Scope&)
+			{
+				datum = &found;
+				index = foundIndex;
+			}, &child, true);
+		}
+
+		if (datum != nullptr)
+		{
+			if (datum->mColumns != nullptr)
+			{
+				datum->mColumns->Detach(*datum, index);
+			}
+			datum->RemoveAt(index);
+			for (size_t i = index; i < datum->Size(); ++i)
+			{
+				datum->AsTable(i).mParentIndex = i;
+			}
+		}
+		child.SetParent(nullptr, nullptr, 0);
+		child.mStructureEpoch = 0;  // May still have the epoch it had as a root before
+		MarkStructureChanged();
+	}
+
+	void Scope::OrphanAll(const Vector<Scope*>& scopes)
+	{
+		// Take every scope out first and remember the Datums they were in, scopes left in a Datum are the ones still having a parent
+		Vector<Datum*> tables(scopes.Size());
+		for (Scope* scope : scopes)
 		{
-			datum.RemoveAt(index);
-		}, &child, true);
-		child.mParent = nullptr;
+			Scope* parent = scope->mParent;
+			if (parent == nullptr)
+			{
+				continue;
+			}
+			if (scope->IsParentDatumValid())
+			{
+				tables.PushBack(scope->mParentDatum);
+			}
+			else
+			{
+				// Only happens if the Datum was changed directly, fall back to search all nested scopes
+				parent->ForEachChildScope([&tables](const std::string&, Datum& found, size_t, Scope&)
+				{
+					tables.PushBack(&found);
+				}, scope, true);
+			}
+			scope->SetParent(nullptr, nullptr, 0);
+			scope->mStructureEpoch = 0;
+			parent->MarkStructureChanged();
+		}
+
+		std::sort(tables.begin(), tables.end());
+		const auto end = std::unique(tables.begin(), tables.end());
+		for (auto it = tables.begin(); it != end; ++it)
+		{
+			Datum& table = **it;
+			if (table.mColumns != nullptr)
+			{
+				table.mColumns->DetachOrphans(table);
+			}
+			table.MarkChanged();
+			size_t kept = 0;
+			for (size_t i = 0; i < table.mSize; ++i)
+			{
+				Scope* child = table.mData.Table[i];
+				if (child->mParent != nullptr)
+				{
+					table.mData.Table[kept] = child;
+					child->mParentIndex = kept;
+					++kept;
+				}
+			}
+			table.mSize = kept;
+		}
 	}
 
 	void Scope::Clear()
 	{
+		if (Size() > 0)
+		{
+			MarkEntriesRemoved();
+		}
 		_Clear();
 	}
 
 	void Scope::DeepCopy(const Scope& other)
 	{
+		ArenaGuard guard(mArena);
 		mTable = other.mTable;
 		mDatumPointers = other.mDatumPointers;
 
 		// Reset pointers
 		for (size_t i = 0; i < mDatumPointers.Size(); ++i)
 		{
-			const std::string& key = mDatumPointers[i]->first;
+			const Atom& key = mDatumPointers[i]->first;
 			auto& pair = *mTable.Find(key);
 			mDatumPointers[i] = &pair;
+			pair.second.mScope = this;
 		}
 
 		// Duplicate children
 		ForEachChildScope([this](const std::string&, Datum& datum, size_t index, Scope& scope)
 		{
 			Scope* dupChild = scope.Clone();
-			dupChild->mParent = this;
 			datum.Set(*dupChild, index);
+			dupChild->SetParent(this, &datum, index);
 		});
+
+		// Columns aren't copied with the Datum, the copied scopes got internal storage and move into new columns
+		for (size_t i = 0; i < mDatumPointers.Size(); ++i)
+		{
+			const ScopeColumns* columns = other.mDatumPointers[i]->second.mColumns.get();
+			if (columns != nullptr)
+			{
+				MakeColumnar(mDatumPointers[i]->first.Name(), columns->RowType());
+			}
+		}
+
+		// Same content, and nested scopes copied their hashes too
+		mHashValid = other.mHashValid;
+		mHash = other.mHash;
+		MarkStructureChanged();
 	}
 
 	void Scope::MoveFrom(Scope&& other)
 	{
+		// Storage that moves over stays in its arena, so keep that arena alive and allocating for this scope
+		if (other.mOwnedArena != nullptr)
+		{
+			mOwnedArena = std::move(other.mOwnedArena);
+		}
+		mArena = other.mArena;
 		mTable = std::move(other.mTable);
 		mDatumPointers = std::move(other.mDatumPointers);
+		mTrackChanges = other.mTrackChanges;
+		mChanged = other.mChanged;
+		mHashValid = other.mHashValid;
+		mHash = other.mHash;
+		for (auto& pair : mTable)
+		{
+			pair.second.mScope = this;
+		}
+		other.InvalidateHash();
 
 		// Fix other Scope so it's still valid and usable if it still can be referenced by parent
 		// Kinda weird situation, should be an error already if someone tries to move a non-transient scope to another and still uses the moved one
@@ -417,10 +863,77 @@ namespace GameEngine
 			other.mTable.Resize(mTable.Size());
 		}
 
-		// Adopt children
-		ForEachChildScope([this](const std::string&, Datum&, size_t, Scope& scope)
+		// Adopt children, table pairs moved over without moving in memory so their Datum stays the same
+		ForEachChildScope([this](const std::string&, Datum& datum, size_t index, Scope& scope)
 		{
-			scope.mParent = this;
+			scope.SetParent(this, &datum, index);
+		});
+		MarkStructureChanged();
+	}
+
+	void Scope::RetrackAssigned()
+	{
+		if (!mTrackChanges)
+		{
+			return;
+		}
+		for (auto& pair : mTable)
+		{
+			pair.second.mChanged = false;
+			pair.second.MarkChanged();
+		}
+		ForEachChildScope([](const std::string&, Datum&, size_t, Scope& child)
+		{
+			if (!child.mTrackChanges)
+			{
+				child.TrackChanges();
+			}
+		});
+	}
+
+	void Scope::CollectChangedPaths(const std::string& prefix, Vector<std::string>& paths) const
+	{
+		for (size_t i = 0; i < mDatumPointers.Size(); ++i)
+		{
+			const std::string path = prefix + mDatumPointers[i]->first.Name();
+			const Datum& datum = mDatumPointers[i]->second;
+			if (datum.mChanged)
+			{
+				paths.PushBack(path);
+			}
+			if (datum.Type() == Datum::DatumType::Table)
+			{
+				for (size_t j = 0; j < datum.Size(); ++j)
+				{
+					const Scope& child = datum.AsTable(j);
+					if (child.mChanged)
+					{
+						child.CollectChangedPaths(path + "[" + std::to_string(j) + "]/", paths);
+					}
+				}
+			}
+		}
+	}
+
+	void Scope::SetParent(Scope* parent, Datum* datum, size_t index)
+	{
+		mParent = parent;
+		mParentDatum = datum;
+		mParentIndex = index;
+	}
+
+	bool Scope::IsParentDatumValid() const
+	{
+		return mParentDatum != nullptr && mParentDatum->Type() == Datum::DatumType::Table && mParentIndex < mParentDatum->Size()
+			&& &mParentDatum->AsTable(mParentIndex) == this;
+	}
+
+	void Scope::SetArena(Arena* arena)
+	{
+		mArena = arena;
+		ForEachChildScope([arena](const std::string&, Datum&, size_t, Scope& child)
+		{
+			child.SetArena(arena);
 		});
 	}
 
@@ -436,7 +949,7 @@ namespace GameEngine
 					Scope& scope = datum.AsTable(i);
 					if (address == nullptr || address == &scope)
 					{
-						action(pair.first, datum, i, scope);
+						action(pair.first.Name(), datum, i, scope);
 						if (oneShot)
 						{
 							return;
@@ -460,9 +973,11 @@ namespace GameEngine
 		// Clear table, don't free memory now
 		mDatumPointers.Clear();
 		mTable.Clear();
+		InvalidateHash();
+		MarkStructureChanged();
 	}
 
-	bool Scope::ParseSearchToken(std::string& token, Datum*& outDatum, Scope*& outScope)
+	bool Scope::ParseSearchToken(std::string_view token, Datum*& outDatum, Scope*& outScope)
 	{
 		if (token == "..")
 		{
@@ -477,17 +992,13 @@ namespace GameEngine
 			// Break token up in case it contains []
 			size_t bracketStart = 0;
 			size_t bracketEnd = 0;
-			std::string key;
-			std::string bracket;
-			if ((bracketStart = token.find("[")) != std::string::npos && (bracketEnd = token.find("]")) != std::string::npos)
+			std::string_view key = token;
+			std::string_view bracket;
+			if ((bracketStart = token.find('[')) != std::string_view::npos && (bracketEnd = token.find(']')) != std::string_view::npos)
 			{
 				key = token.substr(0, bracketStart);
 				bracket = token.substr(bracketStart + 1, bracketEnd - bracketStart - 1);
 			}
-			else
-			{
-				key = move(token);
-			}
 
 			// Try to find the datum with given key
 			outDatum = outScope->Find(key);
@@ -499,10 +1010,10 @@ namespace GameEngine
 			// Change current scope
 			if (outDatum->Type() == Datum::DatumType::Table && !bracket.empty())
 			{
-				try
+				int index = 0;
+				if (std::from_chars(bracket.data(), bracket.data() + bracket.size(), index).ec == std::errc())
 				{
-					size_t index = std::stoi(bracket);
-					if (outDatum->Size() > index)
+					if (index >= 0 && outDatum->Size() > static_cast<size_t>(index))
 					{
 						outScope = &outDatum->AsTable(index);
 					}
@@ -511,15 +1022,16 @@ namespace GameEngine
 						return false;
 					}
 				}
-				catch (std::invalid_argument e)
+				else
 				{
 					bool found = false;
-					for (size_t index = 0; index < outDatum->Size(); ++index)
+					for (size_t i = 0; i < outDatum->Size(); ++i)
 					{
-						Scope& scope = outDatum->AsTable(index);
-						if (scope.Find("Name") != nullptr && scope["Name"].AsString() == bracket)
+						Scope& scope = outDatum->AsTable(i);
+						const Datum* name = scope.Find("Name");
+						if (name != nullptr && name->AsString() == bracket)
 						{
-							outScope = &outDatum->AsTable(index);
+							outScope = &scope;
 							found = true;
 							break;
 						}
@@ -1,10 +1,16 @@
 #pragma once
 #include "RTTI.h"
 #include "vector.h"
-#include "HashMap.h"
+#include "FlatHashMap.h"
 #include "Datum.h"
+#include "Atom.h"
+#include "Arena.h"
 #include <string>
+#include <string_view>
 #include <functional>
+#include <atomic>
+#include <cstdint>
+#include <memory>
 #include <gsl/gsl>
 
 namespace GameEngine
@@ -12,12 +18,16 @@ namespace GameEngine
 	/// <summary>
 	/// Scope is a data table that stores string -> datum pair, it also maintains the order of insertion of each entry.
 	/// Scope can have child scopes stored in datum entry and therefore form a hierarchical structure.
-	/// User can retreive scope entry by passing std::string as key or by passing unsigned int as index
+	/// User can retreive scope entry by passing std::string as key or by passing unsigned int as index.
+	/// Keys are stored as interned Atoms, looking up with an Atom compares pointers and reuses the hash stored in the Atom.
+	/// A Scope allocated with new comes from the arena current at that time (see ArenaGuard), and nested scopes and Datum storage it creates come from the same arena.
+	/// A root Scope can own an arena, so a whole tree is kept together in memory and released at once with the root
 	/// </summary>
 	CLASS(NoLuaAuthority)
 	class Scope : public RTTI
 	{
 		RTTI_DECLARATIONS(Scope, RTTI);
+		friend Datum;
 
 	public:
 		/// <summary>
@@ -61,7 +71,7 @@ namespace GameEngine
 		/// <param name="key">The key of table pair</param>
 		/// <returns>The Datum reference at given key</returns>
 		/// <exception cref="std::exception">key is empty string</exception>
-		Datum& operator[](const std::string& key);
+		Datum& operator[](std::string_view key);
 
 		/// <summary>
 		/// Try to get the Datum with given key.
@@ -69,7 +79,23 @@ namespace GameEngine
 		/// <param name="key">The key of table pair</param>
 		/// <returns>The Datum reference at given key</returns>
 		/// <exception cref="std::exception">The key doesn't exist in scope</exception>
-		const Datum& operator[](const std::string& key) const;
+		const Datum& operator[](std::string_view key) const;
+
+		/// <summary>
+		/// Try to get the Datum with given key. If the entry doesn't exist, a new entry will be appended. Equivalent to append()
+		/// </summary>
+		/// <param name="key">The key of table pair</param>
+		/// <returns>The Datum reference at given key</returns>
+		/// <exception cref="std::exception">key is empty atom</exception>
+		Datum& operator[](const Atom& key);
+
+		/// <summary>
+		/// Try to get the Datum with given key.
+		/// </summary>
+		/// <param name="key">The key of table pair</param>
+		/// <returns>The Datum reference at given key</returns>
+		/// <exception cref="std::exception">The key doesn't exist in scope</exception>
+		const Datum& operator[](const Atom& key) const;
 
 		/// <summary>
 		/// Try to get the Datum with given insertion order. e.g. if index = 3, will return the third inserted Datum
@@ -87,6 +113,14 @@ namespace GameEngine
 		/// <exception cref="std::exception">Index equal or greater than table size</exception>
 		const Datum& operator[](size_t index) const;
 
+		/// <summary>
+		/// Get the key of the Datum with given insertion order, the one returned by operator[](index)
+		/// </summary>
+		/// <param name="index">The order of insertion of the Datum</param>
+		/// <returns>The key at given insertion index</returns>
+		/// <exception cref="std::exception">Index equal or greater than table size</exception>
+		const Atom& KeyAt(size_t index) const;
+
 		/// <summary>
 		/// Check if two scopes are equal. This method will invoke operator== on Datum and therefore recursively compare all nested scopes.
 		/// Note that the insertion order is not considered in comparison, only the contents in table are compared.
@@ -129,6 +163,13 @@ namespace GameEngine
 		/// <returns>Pointer to the new clone</returns>
 		virtual gsl::owner<Scope*> Clone() const;
 
+		/// <summary>
+		/// Create a clone of this scope whose Datums share internal storage with this scope until either side modifies them, see CopyOnWriteGuard.
+		/// Nested scopes are still cloned one by one, but their Datums share storage too. Caller is responsible to delete the object
+		/// </summary>
+		/// <returns>Pointer to the new clone</returns>
+		gsl::owner<Scope*> CloneShared() const;
+
 		FUNCTION();
 		/// <summary>
 		/// Search for the table and find the pair with given key, return the corresponding Datum pointer
@@ -144,6 +185,50 @@ namespace GameEngine
 		/// <returns>The Datum pointer to the found item, or nullptr if no such key exists</returns>
 		const Datum* Find(const std::string& key) const;
 
+		/// <summary>
+		/// Search for the table and find the pair with given key, return the corresponding Datum pointer. Doesn't allocate a temporary std::string
+		/// </summary>
+		/// <param name="key">The key to search for</param>
+		/// <returns>The Datum pointer to the found item, or nullptr if no such key exists</returns>
+		Datum* Find(std::string_view key);
+
+		/// <summary>
+		/// Search for the table and find the pair with given key, return the corresponding Datum pointer. Doesn't allocate a temporary std::string
+		/// </summary>
+		/// <param name="key">The key to search for</param>
+		/// <returns>The Datum pointer to the found item, or nullptr if no such key exists</returns>
+		const Datum* Find(std::string_view key) const;
+
+		/// <summary>
+		/// Search for the table and find the pair with given key, return the corresponding Datum pointer.
+		/// Resolves string literals, which would be ambiguous between the std::string and std::string_view overloads
+		/// </summary>
+		/// <param name="key">The key to search for, must be null-terminated</param>
+		/// <returns>The Datum pointer to the found item, or nullptr if no such key exists</returns>
+		Datum* Find(const char* key);
+
+		/// <summary>
+		/// Search for the table and find the pair with given key, return the corresponding Datum pointer.
+		/// Resolves string literals, which would be ambiguous between the std::string and std::string_view overloads
+		/// </summary>
+		/// <param name="key">The key to search for, must be null-terminated</param>
+		/// <returns>The Datum pointer to the found item, or nullptr if no such key exists</returns>
+		const Datum* Find(const char* key) const;
+
+		/// <summary>
+		/// Search for the table and find the pair with given key, return the corresponding Datum pointer. Compares keys by pointer
+		/// </summary>
+		/// <param name="key">The key to search for</param>
+		/// <returns>The Datum pointer to the found item, or nullptr if no such key exists</returns>
+		Datum* Find(const Atom& key);
+
+		/// <summary>
+		/// Search for the table and find the pair with given key, return the corresponding Datum pointer. Compares keys by pointer
+		/// </summary>
+		/// <param name="key">The key to search for</param>
+		/// <returns>The Datum pointer to the found item, or nullptr if no such key exists</returns>
+		const Datum* Find(const Atom& key) const;
+
 		/// <summary>
 		/// Search for a path in current scope and all ancestor scopes, and return the corresponding Datum pointer and the Scope pointer which contains it.
 		/// If the path contains "/", it will be treated similar to how file system works.
@@ -153,8 +238,8 @@ namespace GameEngine
 		/// </summary>
 		/// <param name="path">The path to search for</param>
 		/// <returns>Pair of Datum pointer and Scope pointer which contains the Datum. If not found, both will be nullptr</returns>
-		std::pair<Datum*, Scope*> Search(const std::string& path);
-		std::pair<const Datum*, const Scope*> Search(const std::string& path) const;
+		std::pair<Datum*, Scope*> Search(std::string_view path);
+		std::pair<const Datum*, const Scope*> Search(std::string_view path) const;
 
 		/// <summary>
 		/// Find the root scope in the ancestor tree, if this scope has no parent, will return itself
@@ -164,12 +249,20 @@ namespace GameEngine
 		const Scope* GetRoot() const;
 
 		/// <summary>
-		/// Insert a new entry to table, if there doesn't exist one with same key
+		/// Insert a new entry to table, if there doesn't exist one with same key. The key is only interned when a new entry is inserted
 		/// </summary>
 		/// <param name="key">The key of table pair</param>
 		/// <returns>The Datum reference at given key, and whether or not a new pair is inserted</returns>
 		/// <exception cref="std::excpetion">Key is empty string</exception>
-		std::pair<Datum&, bool> Append(const std::string& key);
+		std::pair<Datum&, bool> Append(std::string_view key);
+
+		/// <summary>
+		/// Insert a new entry to table, if there doesn't exist one with same key
+		/// </summary>
+		/// <param name="key">The key of table pair</param>
+		/// <returns>The Datum reference at given key, and whether or not a new pair is inserted</returns>
+		/// <exception cref="std::excpetion">Key is empty atom</exception>
+		std::pair<Datum&, bool> Append(const Atom& key);
 
 		/// <summary>
 		/// Create a new nested scope and push it back to the Datum at given key
@@ -178,7 +271,8 @@ namespace GameEngine
 		/// <returns>The created nested Scope</returns>
 		/// <exception cref="std::exception">The key is empty string</exception>
 		/// <exception cref="std::exception">The Datum with same exists and it's not table type</exception>
-		Scope& AppendScope(const std::string& key);
+		/// <exception cref="std::exception">The Datum is columnar</exception>
+		Scope& AppendScope(std::string_view key);
 
 		FUNCTION();
 		/// <summary>
@@ -189,15 +283,38 @@ namespace GameEngine
 		/// <exception cref="std::exception">Key is empty string</exception>
 		/// <exception cref="std::exception">The Datum with same exists and it's not table type</exception>
 		/// <exception cref="std::exception">Adopt self or ancestor</exception>
+		/// <exception cref="std::exception">The Datum is columnar for another class</exception>
 		void Adopt(Scope& child, const std::string& key);
 
+		/// <summary>
+		/// Store the nested scopes at given key in columns, one for each prescribed attribute of their class, see ScopeColumns.
+		/// The nested scopes there now and adopted later must all be of that class. Copies of this scope are columnar too
+		/// </summary>
+		/// <param name="key">The key of Datum, created if it doesn't exist</param>
+		/// <param name="type">Class of the nested scopes, a registered Attributed type</param>
+		/// <returns>The columns, owned by the Datum</returns>
+		/// <exception cref="std::exception">Key is empty string</exception>
+		/// <exception cref="std::exception">The Datum with same key exists and it's not table type</exception>
+		/// <exception cref="std::exception">The Datum is columnar for another class, or holds a scope of another class</exception>
+		/// <exception cref="std::exception">Class has no signatures in AttributedTypeManager</exception>
+		ScopeColumns& MakeColumnar(std::string_view key, RTTI::IdType type);
+
 		FUNCTION();
 		/// <summary>
-		/// Remove a nested Scope from parent scope
+		/// Remove a nested Scope from parent scope. The child knows where it is stored, so this doesn't search the table.
+		/// Later siblings in the same Datum move down by one, keeping their order, so removing many scopes this way is quadratic. Use OrphanAll for that
 		/// </summary>
 		/// <param name="child">The child Scope to remove</param>
 		void Orphan(Scope& child);
 
+		/// <summary>
+		/// Remove many scopes from their parents at once. Each table Datum holding some of them is compacted in one pass,
+		/// so this is linear in the number of scopes and the size of those Datums, in whatever order the scopes are given.
+		/// Remaining siblings keep their order, scopes without a parent are skipped
+		/// </summary>
+		/// <param name="scopes">The scopes to remove, may have different parents</param>
+		static void OrphanAll(const Vector<Scope*>& scopes);
+
 		FUNCTION();
 		/// <summary>
 		/// Get the parent Scope of this Scope
@@ -248,6 +365,92 @@ namespace GameEngine
 		/// <returns>True if passed in scope is ancestor of this one, false otherwise</returns>
 		bool IsDescendentOf(Scope& other);
 
+		/// <summary>
+		/// Get the structure epoch of the tree this scope is in. The tree gets a new epoch whenever anywhere in it an entry is inserted or removed,
+		/// a nested scope is added or removed, a table Datum is changed, or a scope is cleared, copied or moved into.
+		/// Epochs are never reused by another tree, so anything that caches the result of a lookup can compare epochs to know if the cache is stale
+		/// </summary>
+		/// <returns>Current structure epoch of the tree</returns>
+		std::uint64_t StructureEpoch() const;
+
+		/// <summary>
+		/// Create an arena owned by this scope. This scope, all nested scopes and everything they create afterwards allocate from it.
+		/// The arena is released after this scope is destroyed, so no scope or Datum allocated from it may outlive this scope
+		/// </summary>
+		/// <param name="chunkSize">Size of each chunk of the arena in bytes</param>
+		/// <returns>The created arena</returns>
+		/// <exception cref="std::exception">This scope has a parent or already owns an arena</exception>
+		Arena& CreateArena(size_t chunkSize = Arena::DefaultChunkSize);
+
+		/// <summary>
+		/// Get the arena nested scopes and Datum storage of this scope are allocated from
+		/// </summary>
+		/// <returns>The arena, nullptr for the heap</returns>
+		Arena* GetArena() const;
+
+		/// <summary>
+		/// Start or stop tracking changes of this scope and every scope nested in it, now or later. Starting clears all changes.
+		/// A tracked Datum is flagged as changed by any modifying method, and flags every tracked scope above it, so finding changes only visits changed scopes.
+		/// A table Datum is changed when nested scopes are added, removed or cleared. Entries appended to a scope are changed.
+		/// Writes through references returned by Datum::AsXXX aren't seen unless followed by Datum::MarkChanged. Copies of a scope aren't tracked
+		/// </summary>
+		/// <param name="enabled">Whether to track changes</param>
+		void TrackChanges(bool enabled = true);
+
+		/// <summary>
+		/// Check if changes of this scope are tracked
+		/// </summary>
+		/// <returns>True if changes are tracked</returns>
+		bool IsTrackingChanges() const;
+
+		/// <summary>
+		/// Check if this scope or any scope nested in it changed since changes were last cleared
+		/// </summary>
+		/// <returns>True if something changed</returns>
+		bool IsChanged() const;
+
+		/// <summary>
+		/// Flag this scope and every tracked scope above it as changed. Does nothing if changes aren't tracked
+		/// </summary>
+		void MarkChanged();
+
+		/// <summary>
+		/// Get the path of every changed Datum of this scope and scopes nested in it, relative to this scope and in the syntax of Search,
+		/// such as "Sectors[0]/Entities[1]/Health". Unchanged nested scopes are skipped without being visited
+		/// </summary>
+		/// <returns>Paths of changed Datums in order of insertion, parents before their nested scopes</returns>
+		Vector<std::string> ChangedPaths() const;
+
+		/// <summary>
+		/// Clear the changes of this scope and every scope nested in it. Scopes above stay changed
+		/// </summary>
+		void ClearChanges();
+
+		/// <summary>
+		/// Get a hash of the content, combined Merkle-style from the hash of every entry and nested scope, regardless of order of entries.
+		/// Equal scopes have equal hashes, so different hashes prove scopes differ, and equal hashes make a cheap checksum of the same build.
+		/// Cached until something below changes, so after the first call only changed parts are hashed again.
+		/// Non-const access to a Datum drops the cached hashes above it, writing a member variable behind a prescribed attribute directly must be followed by Datum::MarkChanged.
+		/// Scopes with other external storage, or with attributes in columns, are hashed again every time since it can be written without the scope knowing
+		/// </summary>
+		/// <returns>Hash value</returns>
+		size_t Hash() const;
+
+		/// <summary>
+		/// Allocate a Scope from the current arena, or from the heap if there is none. The block remembers where it came from
+		/// </summary>
+		/// <param name="size">Size of the object</param>
+		/// <returns>Address of the object</returns>
+		static void* operator new(size_t size);
+		static void* operator new(size_t size, void* place) noexcept;
+
+		/// <summary>
+		/// Free a Scope to the arena or heap it was allocated from
+		/// </summary>
+		/// <param name="pointer">Address of the object</param>
+		static void operator delete(void* pointer);
+		static void operator delete(void* pointer, void* place) noexcept;
+
 		FUNCTION();
 		/// <summary>
 		/// Destroy all table entries, delete all nested scopes. Don't necessarily free all memory allocated by container
@@ -255,26 +458,123 @@ namespace GameEngine
 		virtual void Clear();
 
 	protected:
-		using TablePairType = std::pair<const std::string, Datum>;
-		using TableType = HashMap<std::string, Datum>;
+		using TablePairType = std::pair<const Atom, Datum>;
+		using TableType = FlatHashMap<Atom, Datum>;
 		using TableIteratorType = TableType::Iterator;
 
 		/// <summary>
-		/// HashMap of string->Datum pair, used to store actual table pairs
+		/// FlatHashMap of Atom->Datum pair, used to store actual table pairs. Pairs never move, so the pointers below stay valid
 		/// </summary>
 		TableType mTable;
 
 		/// <summary>
-		/// Store the pointers to HashMap pairs, use to maintain the insertion order
+		/// Store the pointers to table pairs, use to maintain the insertion order
 		/// </summary>
 		Vector<TablePairType*> mDatumPointers;
 
+		/// <summary>
+		/// Check if both scopes have a cached hash and they differ, which proves the scopes aren't equal without comparing them
+		/// </summary>
+		/// <param name="other">The scope to compare with</param>
+		/// <returns>True if the scopes are known to differ</returns>
+		bool HashesDiffer(const Scope& other) const;
+
+		/// <summary>
+		/// Report entries removed from this scope, which have no path anymore, as a change of the table Datum holding this scope, or of this scope if it has no parent
+		/// </summary>
+		void MarkEntriesRemoved();
+
 	private:
 		/// <summary>
 		/// Pointer to parent scope
 		/// </summary>
 		Scope* mParent = nullptr;
 
+		/// <summary>
+		/// Table Datum of parent scope that stores this scope, nullptr if there is no parent
+		/// </summary>
+		Datum* mParentDatum = nullptr;
+
+		/// <summary>
+		/// Index of this scope in mParentDatum
+		/// </summary>
+		size_t mParentIndex = 0;
+
+		/// <summary>
+		/// Arena that nested scopes and Datum storage are allocated from, nullptr for the heap
+		/// </summary>
+		Arena* mArena = Arena::Current();
+
+		/// <summary>
+		/// Arena owned by this scope, released after all nested scopes are destroyed
+		/// </summary>
+		std::unique_ptr<Arena> mOwnedArena;
+
+		/// <summary>
+		/// Whether Datums and nested scopes of this scope track changes
+		/// </summary>
+		bool mTrackChanges = false;
+
+		/// <summary>
+		/// Whether this scope or any scope nested in it changed since changes were last cleared
+		/// </summary>
+		bool mChanged = false;
+
+		/// <summary>
+		/// Whether mHash is up to date. Only ever true if the hashes of all nested scopes are too
+		/// </summary>
+		mutable bool mHashValid = false;
+
+		/// <summary>
+		/// Hash of the content computed last, see Hash
+		/// </summary>
+		mutable size_t mHash = 0;
+
+		/// <summary>
+		/// Structure epoch of the tree, only used on the root. 0 after a change until a new one is asked for
+		/// </summary>
+		mutable std::uint64_t mStructureEpoch = 0;
+
+		/// <summary>
+		/// Header in front of every Scope allocated with new, remembering where the block came from
+		/// </summary>
+		struct AllocationHeader
+		{
+			Arena* mArena;
+			size_t mSize;
+		};
+		static constexpr size_t AllocationHeaderSize = Arena::Alignment;
+
+		/// <summary>
+		/// Last structure epoch given to a tree
+		/// </summary>
+		static std::atomic<std::uint64_t> sLastStructureEpoch;
+
+		/// <summary>
+		/// Drop the structure epoch of the tree this scope is in, called on every structural change
+		/// </summary>
+		void MarkStructureChanged();
+
+		/// <summary>
+		/// Make this scope a child of given parent, stored in given Datum of parent at given index
+		/// </summary>
+		/// <param name="parent">The parent scope</param>
+		/// <param name="datum">The table Datum of parent storing this scope</param>
+		/// <param name="index">Index of this scope in the Datum</param>
+		void SetParent(Scope* parent, Datum* datum, size_t index);
+
+		/// <summary>
+		/// Check if the Datum and index this scope remembers still store it. They go stale only if the Datum of parent is changed directly
+		/// </summary>
+		/// <returns>True if the back reference to parent Datum is valid</returns>
+		bool IsParentDatumValid() const;
+
+		/// <summary>
+		/// Set the arena of this scope and all nested scopes
+		/// </summary>
+		/// <param name="arena">The arena</param>
+		void SetArena(Arena* arena);
+
 		/// <summary>
 		/// Deep copy the contents from another Scope
 		/// </summary>
@@ -287,6 +587,23 @@ namespace GameEngine
 		/// <param name="other">The other Scope to move from</param>
 		void MoveFrom(Scope&& other);
 
+		/// <summary>
+		/// Drop the cached hash of this scope and every scope above it
+		/// </summary>
+		void InvalidateHash();
+
+		/// <summary>
+		/// Track changes of all Datums again after the table was replaced by assignment, and flag them all as changed
+		/// </summary>
+		void RetrackAssigned();
+
+		/// <summary>
+		/// Append the paths of changed Datums of this scope and its changed nested scopes
+		/// </summary>
+		/// <param name="prefix">Path of this scope followed by "/", empty for the scope the search started from</param>
+		/// <param name="paths">Where to append the paths</param>
+		void CollectChangedPaths(const std::string& prefix, Vector<std::string>& paths) const;
+
 		/// <summary>
 		/// Helper function to iterate through all nested scopes, and do some actions on matching scope(s)
 		/// </summary>
@@ -300,7 +617,14 @@ namespace GameEngine
 		/// </summary>
 		void _Clear();
 
-		bool ParseSearchToken(std::string& token, Datum*& outDatum, Scope*& outScope);
+		/// <summary>
+		/// Resolve one segment of a search path, such as "..", "Entities[1]" or "Actions[Increment]", starting from outScope
+		/// </summary>
+		/// <param name="token">The path segment, a view into the searched path</param>
+		/// <param name="outDatum">The Datum found by the segment</param>
+		/// <param name="outScope">The Scope to start from, changed to the Scope selected by the segment</param>
+		/// <returns>True if the segment is resolved, False otherwise</returns>
+		bool ParseSearchToken(std::string_view token, Datum*& outDatum, Scope*& outScope);
 	};
 
 	template <typename T>
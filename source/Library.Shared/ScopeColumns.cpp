@@ -0,0 +1,266 @@
+#include "pch.h"
+#include "ScopeColumns.h"
+#include "Attributed.h"
+#include "Scope.h"
+#include <algorithm>
+#include <assert.h>
+
+namespace GameEngine
+{
+	ScopeColumns::ScopeColumns(RTTI::IdType type) :
+		mType(type)
+	{
+		const auto signatures = AttributedTypeManager::GetSignature(type);
+		if (signatures == nullptr)
+		{
+			throw std::exception("Columnar table row class has no signatures");
+		}
+
+		// Attributes stored in member variables already live in the object, nested tables stay in the rows
+		mColumns.Reserve(signatures->Size());
+		for (const Attributed::Signature& signature : *signatures)
+		{
+			if (signature.mOffset == 0 && signature.mSize > 0 && signature.mType != Datum::DatumType::Table && signature.mType != Datum::DatumType::Unknown)
+			{
+				mColumns.EmplaceBack(Column{ signature.mName, signature.mSize, Datum(signature.mType) });
+			}
+		}
+	}
+
+	RTTI::IdType ScopeColumns::RowType() const
+	{
+		return mType;
+	}
+
+	size_t ScopeColumns::RowCount() const
+	{
+		return mRowCount;
+	}
+
+	size_t ScopeColumns::ColumnCount() const
+	{
+		return mColumns.Size();
+	}
+
+	Datum* ScopeColumns::Find(std::string_view name)
+	{
+		for (Column& column : mColumns)
+		{
+			if (column.mName.Name() == name)
+			{
+				return &column.mData;
+			}
+		}
+		return nullptr;
+	}
+
+	const Datum* ScopeColumns::Find(std::string_view name) const
+	{
+		return const_cast<ScopeColumns*>(this)->Find(name);
+	}
+
+	Datum& ScopeColumns::operator[](size_t index)
+	{
+		return mColumns[index].mData;
+	}
+
+	const Datum& ScopeColumns::operator[](size_t index) const
+	{
+		return mColumns[index].mData;
+	}
+
+	const Atom& ScopeColumns::NameAt(size_t index) const
+	{
+		return mColumns[index].mName;
+	}
+
+	size_t ScopeColumns::WidthAt(size_t index) const
+	{
+		return mColumns[index].mWidth;
+	}
+
+	void ScopeColumns::CheckRow(const Scope& row) const
+	{
+		if (row.TypeIdInstance() != mType)
+		{
+			throw std::exception("Columnar table rows must be of one class");
+		}
+	}
+
+	void ScopeColumns::Attach(Datum& table, size_t index)
+	{
+		assert(index == mRowCount && index < table.Size());
+		Scope& row = table.AsTable(index);
+
+		// Grow geometrically, every row is pointed at the new storage when a column moves
+		bool moved = false;
+		for (Column& column : mColumns)
+		{
+			const size_t size = (mRowCount + 1) * column.mWidth;
+			if (size > column.mData.Capacity())
+			{
+				column.mData.Reserve(std::max(size, column.mData.Capacity() * 2));
+				moved = true;
+			}
+			column.mData.SetSize(size);
+		}
+		++mRowCount;
+		if (moved)
+		{
+			for (size_t i = 0; i < index; ++i)
+			{
+				PointRow(table.AsTable(i), i);
+			}
+		}
+
+		for (Column& column : mColumns)
+		{
+			Datum* attribute = row.Find(column.mName);
+			if (attribute == nullptr || attribute->Type() != column.mData.Type())
+			{
+				continue;
+			}
+			const size_t count = std::min(attribute->Size(), column.mWidth);
+			for (size_t i = 0; i < count; ++i)
+			{
+				CopyElement(column.mData, index * column.mWidth + i, *attribute, i);
+			}
+			attribute->SetStorage(SlotAddress(column, index), column.mWidth);
+			attribute->mInColumn = true;
+			attribute->InvalidateHash();
+		}
+	}
+
+	void ScopeColumns::Detach(Datum& table, size_t index)
+	{
+		assert(index < mRowCount && mRowCount == table.Size());
+		ReleaseRow(table.AsTable(index), index);
+		for (Column& column : mColumns)
+		{
+			for (size_t i = 0; i < column.mWidth; ++i)
+			{
+				column.mData.RemoveAt(index * column.mWidth);
+			}
+		}
+
+		--mRowCount;
+		for (size_t i = index + 1; i < table.Size(); ++i)
+		{
+			PointRow(table.AsTable(i), i - 1);
+		}
+	}
+
+	void ScopeColumns::DetachOrphans(Datum& table)
+	{
+		assert(mRowCount == table.Size());
+
+		// Rows that stay move down over the ones that leave, so every slot moves at most once
+		size_t kept = 0;
+		for (size_t row = 0; row < mRowCount; ++row)
+		{
+			Scope& scope = table.AsTable(row);
+			if (scope.GetParent() == nullptr)
+			{
+				ReleaseRow(scope, row);
+				continue;
+			}
+			if (kept != row)
+			{
+				for (Column& column : mColumns)
+				{
+					for (size_t i = 0; i < column.mWidth; ++i)
+					{
+						CopyElement(column.mData, kept * column.mWidth + i, column.mData, row * column.mWidth + i);
+					}
+				}
+			}
+			++kept;
+		}
+
+		// Shrinking never moves the columns, only rows that changed slot need pointing again
+		for (Column& column : mColumns)
+		{
+			column.mData.SetSize(kept * column.mWidth);
+		}
+		mRowCount = kept;
+		kept = 0;
+		for (size_t row = 0; row < table.Size(); ++row)
+		{
+			Scope& scope = table.AsTable(row);
+			if (scope.GetParent() != nullptr)
+			{
+				if (kept != row)
+				{
+					PointRow(scope, kept);
+				}
+				++kept;
+			}
+		}
+	}
+
+	void ScopeColumns::ReleaseRow(Scope& row, size_t slot)
+	{
+		// A row being destroyed has no attributes left
+		ArenaGuard guard(row.GetArena());
+		for (Column& column : mColumns)
+		{
+			Datum* attribute = row.Find(column.mName);
+			if (attribute != nullptr && attribute->mInColumn)
+			{
+				Datum values(column.mData.Type());
+				values.SetSize(column.mWidth);
+				for (size_t i = 0; i < column.mWidth; ++i)
+				{
+					CopyElement(values, i, column.mData, slot * column.mWidth + i);
+				}
+				*attribute = std::move(values);
+			}
+		}
+	}
+
+	void ScopeColumns::PointRow(Scope& row, size_t slot)
+	{
+		for (Column& column : mColumns)
+		{
+			Datum* attribute = row.Find(column.mName);
+			if (attribute != nullptr && attribute->mInColumn)
+			{
+				attribute->mData.Universe = SlotAddress(column, slot);
+			}
+		}
+	}
+
+	void* ScopeColumns::SlotAddress(Column& column, size_t slot)
+	{
+		const size_t typeSize = Datum::sTypeSizeTable[static_cast<size_t>(column.mData.Type())];
+		return static_cast<char*>(column.mData.mData.Universe) + slot * column.mWidth * typeSize;
+	}
+
+	void ScopeColumns::CopyElement(Datum& to, size_t toIndex, const Datum& from, size_t fromIndex)
+	{
+		switch (from.Type())
+		{
+		case Datum::DatumType::Integer:
+			to.Set(from.AsInt(fromIndex), toIndex);
+			break;
+		case Datum::DatumType::Float:
+			to.Set(from.AsFloat(fromIndex), toIndex);
+			break;
+		case Datum::DatumType::Vector:
+			to.Set(from.AsVector(fromIndex), toIndex);
+			break;
+		case Datum::DatumType::Matrix:
+			to.Set(from.AsMatrix(fromIndex), toIndex);
+			break;
+		case Datum::DatumType::String:
+			to.Set(from.AsString(fromIndex), toIndex);
+			break;
+		case Datum::DatumType::Pointer:
+			to.Set(from.AsPointer(fromIndex), toIndex);
+			break;
+		default:
+			// Tables and Unknown never have a column
+			break;
+		}
+	}
+}
@@ -0,0 +1,203 @@
+#pragma once
+
+/// \file ScopeColumns.h
+/// \brief Contains the declaration of ScopeColumns
+
+#include "Atom.h"
+#include "Datum.h"
+#include "RTTI.h"
+#include "vector.h"
+#include <cstddef>
+#include <string_view>
+
+namespace GameEngine
+{
+	class Scope;
+
+	/// <summary>
+	/// Columns of a table Datum whose nested scopes are all Attributed of one class, created by Scope::MakeColumnar and owned by the Datum.
+	/// Every prescribed attribute with internal storage, other than nested tables, gets one column holding that attribute of all rows one after another.
+	/// The attribute Datum of each row is external storage pointing at its slot, so batch systems can run through one attribute of every row contiguously,
+	/// while each row still works as a normal Scope. Rows must be added and removed through Scope: adopting, orphaning or destroying a row keeps the columns in sync.
+	/// A row leaving the table, or copied, gets internal storage for its attributes again.
+	/// Writing through a column doesn't mark rows as changed, see Scope::TrackChanges
+	/// </summary>
+	class ScopeColumns final
+	{
+		friend Scope;
+
+	public:
+		/// <summary>
+		/// Constructor, one column for each prescribed attribute of a class, without rows
+		/// </summary>
+		/// <param name="type">Class of the rows, a registered Attributed type</param>
+		/// <exception cref="std::exception">Class has no signatures in AttributedTypeManager</exception>
+		explicit ScopeColumns(RTTI::IdType type);
+
+		ScopeColumns(const ScopeColumns&) = delete;
+		ScopeColumns& operator=(const ScopeColumns&) = delete;
+
+		~ScopeColumns() = default;
+
+		/// <summary>
+		/// Get the class of the rows
+		/// </summary>
+		/// <returns>Type id of the row class</returns>
+		RTTI::IdType RowType() const;
+
+		/// <summary>
+		/// Get the number of rows
+		/// </summary>
+		/// <returns>Number of rows</returns>
+		size_t RowCount() const;
+
+		/// <summary>
+		/// Get the number of columns
+		/// </summary>
+		/// <returns>Number of columns</returns>
+		size_t ColumnCount() const;
+
+		/// <summary>
+		/// Get the column of an attribute. Element i * Width + j is element j of the attribute in row i.
+		/// Values can be read and set, but the size of the column must not be changed
+		/// </summary>
+		/// <param name="name">Name of the attribute</param>
+		/// <returns>The column, nullptr if the attribute has no column</returns>
+		Datum* Find(std::string_view name);
+
+		/// <summary>
+		/// Get the column of an attribute. Element i * Width + j is element j of the attribute in row i
+		/// </summary>
+		/// <param name="name">Name of the attribute</param>
+		/// <returns>The column, nullptr if the attribute has no column</returns>
+		const Datum* Find(std::string_view name) const;
+
+		/// <summary>
+		/// Get a column by index, in the order of the signatures
+		/// </summary>
+		/// <param name="index">Index of the column</param>
+		/// <returns>The column</returns>
+		/// <exception cref="std::exception">Index out of bound</exception>
+		Datum& operator[](size_t index);
+
+		/// <summary>
+		/// Get a column by index, in the order of the signatures
+		/// </summary>
+		/// <param name="index">Index of the column</param>
+		/// <returns>The column</returns>
+		/// <exception cref="std::exception">Index out of bound</exception>
+		const Datum& operator[](size_t index) const;
+
+		/// <summary>
+		/// Get the attribute name of a column
+		/// </summary>
+		/// <param name="index">Index of the column</param>
+		/// <returns>Name of the attribute</returns>
+		/// <exception cref="std::exception">Index out of bound</exception>
+		const Atom& NameAt(size_t index) const;
+
+		/// <summary>
+		/// Get the number of elements each row has in a column, the size of the attribute in its signature
+		/// </summary>
+		/// <param name="index">Index of the column</param>
+		/// <returns>Number of elements per row</returns>
+		/// <exception cref="std::exception">Index out of bound</exception>
+		size_t WidthAt(size_t index) const;
+
+	private:
+		/// <summary>
+		/// One attribute of all rows
+		/// </summary>
+		struct Column final
+		{
+			/// <summary>
+			/// Name of the attribute
+			/// </summary>
+			Atom mName;
+
+			/// <summary>
+			/// Number of elements of the attribute in each row
+			/// </summary>
+			size_t mWidth;
+
+			/// <summary>
+			/// Elements of all rows, always internal storage
+			/// </summary>
+			Datum mData;
+		};
+
+		/// <summary>
+		/// Check a scope can be a row
+		/// </summary>
+		/// <param name="row">The scope</param>
+		/// <exception cref="std::exception">Scope isn't of the row class</exception>
+		void CheckRow(const Scope& row) const;
+
+		/// <summary>
+		/// Add the last nested scope of a table as a row. Its attribute values are copied into the columns and its attributes pointed at them
+		/// </summary>
+		/// <param name="table">The table Datum owning these columns</param>
+		/// <param name="index">Index of the row in the table, the current row count</param>
+		void Attach(Datum& table, size_t index);
+
+		/// <summary>
+		/// Remove a row before it's removed from the table. The row gets its values back as internal storage, the rows after it move up in the columns
+		/// </summary>
+		/// <param name="table">The table Datum owning these columns</param>
+		/// <param name="index">Index of the row in the table</param>
+		void Detach(Datum& table, size_t index);
+
+		/// <summary>
+		/// Remove every row whose scope has no parent anymore, in one pass, before they are removed from the table.
+		/// Those rows get their values back as internal storage, the other rows move up in the columns keeping their order
+		/// </summary>
+		/// <param name="table">The table Datum owning these columns</param>
+		void DetachOrphans(Datum& table);
+
+		/// <summary>
+		/// Give a row leaving the columns its values back as internal storage
+		/// </summary>
+		/// <param name="row">The row</param>
+		/// <param name="slot">Index of the row in the columns</param>
+		void ReleaseRow(Scope& row, size_t slot);
+
+		/// <summary>
+		/// Point the attributes of a row, which are still in the columns, at given slot
+		/// </summary>
+		/// <param name="row">The row</param>
+		/// <param name="slot">Index of the slot in each column</param>
+		void PointRow(Scope& row, size_t slot);
+
+		/// <summary>
+		/// Get the address of the elements of a row in a column
+		/// </summary>
+		/// <param name="column">The column</param>
+		/// <param name="slot">Index of the row</param>
+		/// <returns>Address of the first element</returns>
+		static void* SlotAddress(Column& column, size_t slot);
+
+		/// <summary>
+		/// Copy one element between two Datums of the same type
+		/// </summary>
+		/// <param name="to">Datum to copy to</param>
+		/// <param name="toIndex">Index of the element to set</param>
+		/// <param name="from">Datum to copy from</param>
+		/// <param name="fromIndex">Index of the element to copy</param>
+		static void CopyElement(Datum& to, size_t toIndex, const Datum& from, size_t fromIndex);
+
+		/// <summary>
+		/// Class of the rows
+		/// </summary>
+		RTTI::IdType mType;
+
+		/// <summary>
+		/// The columns, in the order of the signatures. Never grows after construction, so Datums in it don't move
+		/// </summary>
+		Vector<Column> mColumns;
+
+		/// <summary>
+		/// Number of rows
+		/// </summary>
+		size_t mRowCount = 0;
+	};
+}
@@ -0,0 +1,179 @@
+#include "pch.h"
+#include "ScopePath.h"
+#include "Scope.h"
+#include <charconv>
+
+namespace GameEngine
+{
+	ScopePath::ScopePath(std::string_view path, bool cache) :
+		mText(path), mCache(cache)
+	{
+		// Same as Scope::Search, a path without "/" is one key searched in all ancestors
+		if (path.find('/') == std::string_view::npos)
+		{
+			mSingleKey = true;
+			Step& step = *mSteps.EmplaceBack();
+			step.mKey = Atom(path);
+			return;
+		}
+
+		mAbsolute = path[0] == '/';
+		size_t start = 0;
+		while (start <= path.size())
+		{
+			size_t end = path.find('/', start);
+			if (end == std::string_view::npos)
+			{
+				end = path.size();
+			}
+
+			std::string_view token = path.substr(start, end - start);
+			start = end + 1;
+			if (token.empty() || token == ".")
+			{
+				continue;
+			}
+
+			Step& step = *mSteps.EmplaceBack();
+			if (token == "..")
+			{
+				step.mParent = true;
+				continue;
+			}
+
+			// Break token up in case it contains []
+			size_t bracketStart = token.find('[');
+			size_t bracketEnd = token.find(']');
+			std::string_view key = token;
+			std::string_view bracket;
+			if (bracketStart != std::string_view::npos && bracketEnd != std::string_view::npos)
+			{
+				key = token.substr(0, bracketStart);
+				bracket = token.substr(bracketStart + 1, bracketEnd - bracketStart - 1);
+			}
+			step.mKey = Atom(key);
+
+			if (!bracket.empty())
+			{
+				int index = 0;
+				if (std::from_chars(bracket.data(), bracket.data() + bracket.size(), index).ec == std::errc())
+				{
+					// A negative index never matches, keep it negative but distinct from "no index"
+					step.mIndex = index >= 0 ? index : -2;
+				}
+				else
+				{
+					step.mName = bracket;
+					mCache = false;
+				}
+			}
+		}
+	}
+
+	std::pair<Datum*, Scope*> ScopePath::Resolve(Scope& scope) const
+	{
+		if (!mCache)
+		{
+			return Walk(scope);
+		}
+
+		const std::uint64_t epoch = scope.StructureEpoch();
+		if (mCachedStart != &scope || mCachedEpoch != epoch)
+		{
+			mCachedResult = Walk(scope);
+			mCachedStart = &scope;
+			mCachedEpoch = epoch;
+		}
+		return mCachedResult;
+	}
+
+	std::pair<const Datum*, const Scope*> ScopePath::Resolve(const Scope& scope) const
+	{
+		return Resolve(const_cast<Scope&>(scope));
+	}
+
+	const std::string& ScopePath::Text() const
+	{
+		return mText;
+	}
+
+	bool ScopePath::IsCached() const
+	{
+		return mCache;
+	}
+
+	std::pair<Datum*, Scope*> ScopePath::Walk(Scope& scope) const
+	{
+		if (mSingleKey)
+		{
+			const Atom& key = mSteps[0].mKey;
+			if (!key.IsEmpty())
+			{
+				for (Scope* current = &scope; current != nullptr; current = current->GetParent())
+				{
+					Datum* datum = current->Find(key);
+					if (datum != nullptr)
+					{
+						return { datum, current };
+					}
+				}
+			}
+			return { nullptr, nullptr };
+		}
+
+		Datum* resultDatum = nullptr;
+		Scope* currentScope = mAbsolute ? scope.GetRoot() : &scope;
+		for (const Step& step : mSteps)
+		{
+			if (step.mParent)
+			{
+				currentScope = currentScope->GetParent();
+				if (currentScope == nullptr)
+				{
+					return { nullptr, nullptr };
+				}
+				continue;
+			}
+
+			resultDatum = step.mKey.IsEmpty() ? nullptr : currentScope->Find(step.mKey);
+			if (resultDatum == nullptr)
+			{
+				return { nullptr, nullptr };
+			}
+
+			// Change current scope
+			if (resultDatum->Type() == Datum::DatumType::Table)
+			{
+				if (step.mIndex != -1)
+				{
+					if (step.mIndex < 0 || resultDatum->Size() <= static_cast<size_t>(step.mIndex))
+					{
+						return { nullptr, nullptr };
+					}
+					currentScope = &resultDatum->AsTable(static_cast<size_t>(step.mIndex));
+				}
+				else if (!step.mName.empty())
+				{
+					bool found = false;
+					for (size_t i = 0; i < resultDatum->Size(); ++i)
+					{
+						Scope& child = resultDatum->AsTable(i);
+						const Datum* name = child.Find(NAME_KEY);
+						if (name != nullptr && name->AsString() == step.mName)
+						{
+							currentScope = &child;
+							found = true;
+							break;
+						}
+					}
+					if (!found)
+					{
+						return { nullptr, nullptr };
+					}
+				}
+			}
+		}
+
+		return { resultDatum, currentScope };
+	}
+}
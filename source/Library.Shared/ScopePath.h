@@ -0,0 +1,134 @@
+#pragma once
+
+/// \file ScopePath.h
+/// \brief Contains the declaration of ScopePath
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include "Atom.h"
+#include "vector.h"
+
+namespace GameEngine
+{
+	class Datum;
+	class Scope;
+
+	/// <summary>
+	/// A search path compiled once, so it can be resolved many times without reparsing it.
+	/// Accepts the same syntax as Scope::Search, such as "/Sectors[0]/Entities[1]/Actions[Increment]/Target".
+	/// Each segment is turned into an atom key plus an optional index or name selector, so resolving a path doesn't allocate.
+	/// With caching enabled, the result is reused as long as the starting scope and the structure epoch of its tree are unchanged.
+	/// Name selectors depend on the value of "Name" rather than on structure, so paths containing them are never cached.
+	/// A caching ScopePath must not be resolved from multiple threads at the same time
+	/// </summary>
+	class ScopePath final
+	{
+	public:
+		/// <summary>
+		/// Compile a search path
+		/// </summary>
+		/// <param name="path">The path, in the same syntax as Scope::Search</param>
+		/// <param name="cache">Whether to cache the result of last resolve</param>
+		explicit ScopePath(std::string_view path, bool cache = false);
+
+		/// <summary>
+		/// Resolve the path starting from given scope, same result as Scope::Search with the original text
+		/// </summary>
+		/// <param name="scope">The scope to start from</param>
+		/// <returns>Pair of Datum pointer and Scope pointer which contains the Datum. If not found, both will be nullptr</returns>
+		std::pair<Datum*, Scope*> Resolve(Scope& scope) const;
+		std::pair<const Datum*, const Scope*> Resolve(const Scope& scope) const;
+
+		/// <summary>
+		/// Get the original text of the path
+		/// </summary>
+		/// <returns>The path text</returns>
+		const std::string& Text() const;
+
+		/// <summary>
+		/// Check if this path caches its result
+		/// </summary>
+		/// <returns>True if resolving caches the result</returns>
+		bool IsCached() const;
+
+	private:
+		/// <summary>
+		/// One compiled path segment
+		/// </summary>
+		struct Step final
+		{
+			/// <summary>
+			/// Go to the parent scope, for ".."
+			/// </summary>
+			bool mParent = false;
+
+			/// <summary>
+			/// Key of the Datum to find
+			/// </summary>
+			Atom mKey;
+
+			/// <summary>
+			/// Index of the nested scope inside a table Datum, -1 if there is no index
+			/// </summary>
+			std::int64_t mIndex = -1;
+
+			/// <summary>
+			/// Value of "Name" of the nested scope inside a table Datum, empty if there is no name selector
+			/// </summary>
+			std::string mName;
+		};
+
+		/// <summary>
+		/// Walk all steps starting from given scope
+		/// </summary>
+		/// <param name="scope">The scope to start from</param>
+		/// <returns>Pair of Datum pointer and Scope pointer which contains the Datum. If not found, both will be nullptr</returns>
+		std::pair<Datum*, Scope*> Walk(Scope& scope) const;
+
+		/// <summary>
+		/// Key of the Datum that name selectors compare against
+		/// </summary>
+		inline static const Atom NAME_KEY = Atom("Name");
+
+		/// <summary>
+		/// Original text of the path
+		/// </summary>
+		std::string mText;
+
+		/// <summary>
+		/// Compiled segments
+		/// </summary>
+		Vector<Step> mSteps;
+
+		/// <summary>
+		/// Whether the path starts at the root scope
+		/// </summary>
+		bool mAbsolute = false;
+
+		/// <summary>
+		/// Whether the path is a single key without "/", which is searched in the starting scope and all its ancestors
+		/// </summary>
+		bool mSingleKey = false;
+
+		/// <summary>
+		/// Whether caching is enabled
+		/// </summary>
+		bool mCache = false;
+
+		/// <summary>
+		/// Scope the cached result was resolved from, nullptr if nothing is cached
+		/// </summary>
+		mutable Scope* mCachedStart = nullptr;
+
+		/// <summary>
+		/// Structure epoch when the result was cached
+		/// </summary>
+		mutable std::uint64_t mCachedEpoch = 0;
+
+		/// <summary>
+		/// Cached result
+		/// </summary>
+		mutable std::pair<Datum*, Scope*> mCachedResult = { nullptr, nullptr };
+	};
+}
@@ -0,0 +1,414 @@
+#include "pch.h"
+#include "ScopeSerializer.h"
+#include "Scope.h"
+#include "Factory.h"
+#include "JsonParseMaster.h"
+#include "JsonTableParseHelper.h"
+#include <cstring>
+#include <fstream>
+#include <memory>
+
+namespace GameEngine
+{
+	namespace
+	{
+		using DatumType = Datum::DatumType;
+
+		/// <summary>
+		/// Class name written for plain nested scopes, which are appended instead of created by a factory
+		/// </summary>
+		const char* const SCOPE_CLASS_NAME = "Scope";
+
+		/// <summary>
+		/// Smallest size of one string or nested scope in a payload, the length prefix of the string or class name
+		/// </summary>
+		constexpr std::uint64_t MinimumElementSize = sizeof(std::uint32_t);
+
+		/// <summary>
+		/// Size in bytes of one element of a Datum type stored as a raw array, 0 for other types
+		/// </summary>
+		size_t ElementSize(DatumType type)
+		{
+			switch (type)
+			{
+			case DatumType::Integer:
+				return sizeof(std::int32_t);
+			case DatumType::Float:
+				return sizeof(float);
+			case DatumType::Vector:
+				return sizeof(glm::vec4);
+			case DatumType::Matrix:
+				return sizeof(glm::mat4);
+			default:
+				return 0;
+			}
+		}
+
+		/// <summary>
+		/// Address of the first element of a non-empty Datum stored as a raw array
+		/// </summary>
+		const void* ElementData(const Datum& datum)
+		{
+			switch (datum.Type())
+			{
+			case DatumType::Integer:
+				return &datum.AsInt();
+			case DatumType::Float:
+				return &datum.AsFloat();
+			case DatumType::Vector:
+				return &datum.AsVector();
+			default:
+				return &datum.AsMatrix();
+			}
+		}
+
+		void* ElementData(Datum& datum)
+		{
+			switch (datum.Type())
+			{
+			case DatumType::Integer:
+				return &datum.AsInt();
+			case DatumType::Float:
+				return &datum.AsFloat();
+			case DatumType::Vector:
+				return &datum.AsVector();
+			default:
+				return &datum.AsMatrix();
+			}
+		}
+
+		template <typename T>
+		void WriteValue(std::string& output, const T& value)
+		{
+			output.append(reinterpret_cast<const char*>(&value), sizeof(T));
+		}
+
+		void WriteText(std::string& output, std::string_view text)
+		{
+			WriteValue(output, static_cast<std::uint32_t>(text.size()));
+			output.append(text);
+		}
+
+		/// <summary>
+		/// Overwrite a value written earlier, once it is known
+		/// </summary>
+		template <typename T>
+		void PatchValue(std::string& output, size_t offset, const T& value)
+		{
+			std::memcpy(output.data() + offset, &value, sizeof(T));
+		}
+
+		/// <summary>
+		/// Number of padding bytes that move given offset from the start of data to the next multiple of PayloadAlignment
+		/// </summary>
+		size_t Padding(size_t offset)
+		{
+			return (ScopeSerializer::PayloadAlignment - offset % ScopeSerializer::PayloadAlignment) % ScopeSerializer::PayloadAlignment;
+		}
+
+		void WriteScope(const Scope& scope, std::string& output, size_t start)
+		{
+			const size_t countOffset = output.size();
+			std::uint32_t count = 0;
+			WriteValue(output, count);
+
+			for (size_t i = 0; i < scope.Size(); ++i)
+			{
+				const Datum& datum = scope[i];
+				const DatumType type = datum.Type();
+				if (type == DatumType::Unknown || type == DatumType::Pointer)
+				{
+					continue;
+				}
+
+				WriteValue(output, static_cast<std::uint8_t>(type));
+				WriteText(output, scope.KeyAt(i).Name());
+				WriteValue(output, static_cast<std::uint32_t>(datum.Size()));
+				const size_t payloadOffset = output.size();
+				WriteValue(output, std::uint64_t(0));
+
+				if (type == DatumType::String)
+				{
+					for (size_t j = 0; j < datum.Size(); ++j)
+					{
+						WriteText(output, datum.AsString(j));
+					}
+				}
+				else if (type == DatumType::Table)
+				{
+					for (size_t j = 0; j < datum.Size(); ++j)
+					{
+						const Scope& child = datum.AsTable(j);
+						WriteText(output, child.TypeNameInstance());
+						WriteScope(child, output, start);
+					}
+				}
+				else if (datum.Size() > 0)
+				{
+					output.append(Padding(output.size() - start), '\0');
+					output.append(static_cast<const char*>(ElementData(datum)), datum.Size() * ElementSize(type));
+				}
+
+				PatchValue(output, payloadOffset, static_cast<std::uint64_t>(output.size() - payloadOffset - sizeof(std::uint64_t)));
+				++count;
+			}
+			PatchValue(output, countOffset, count);
+		}
+
+		/// <summary>
+		/// Walks binary data from the front, every read is checked against the end of data
+		/// </summary>
+		class Reader final
+		{
+		public:
+			Reader(std::string_view input, Datum::ReferenceCount* references) :
+				mInput(input),
+				mReferences(references)
+			{
+			}
+
+			void ReadHeader()
+			{
+				if (ReadValue<std::uint32_t>() != ScopeSerializer::Magic)
+				{
+					throw std::exception("Not binary scope data");
+				}
+				mVersion = ReadValue<std::uint32_t>();
+				if (mVersion > ScopeSerializer::Version)
+				{
+					throw std::exception("Binary scope data has a newer version");
+				}
+			}
+
+			template <typename T>
+			T ReadValue()
+			{
+				T value;
+				std::memcpy(&value, Take(sizeof(T)), sizeof(T));
+				return value;
+			}
+
+			std::string_view ReadText()
+			{
+				const std::uint32_t length = ReadValue<std::uint32_t>();
+				return std::string_view(Take(length), length);
+			}
+
+			const char* Take(std::uint64_t size)
+			{
+				if (mInput.size() - mPosition < size)
+				{
+					throw std::exception("Binary scope data is truncated");
+				}
+				const char* data = mInput.data() + mPosition;
+				mPosition += static_cast<size_t>(size);
+				return data;
+			}
+
+			bool AtEnd() const
+			{
+				return mPosition == mInput.size();
+			}
+
+			void ReadScope(Scope& scope)
+			{
+				const std::uint32_t datumCount = ReadValue<std::uint32_t>();
+				for (std::uint32_t i = 0; i < datumCount; ++i)
+				{
+					const std::uint8_t typeValue = ReadValue<std::uint8_t>();
+					const std::string_view key = ReadText();
+					const std::uint32_t count = ReadValue<std::uint32_t>();
+					const std::uint64_t payloadSize = ReadValue<std::uint64_t>();
+
+					if (payloadSize > mInput.size() - mPosition)
+					{
+						throw std::exception("Binary scope data is truncated");
+					}
+					const size_t payloadEnd = mPosition + static_cast<size_t>(payloadSize);
+
+					// Skip types a newer writer may add, and types that are never written
+					const DatumType type = static_cast<DatumType>(typeValue);
+					if (type < DatumType::Begin || type >= DatumType::End)
+					{
+						mPosition = payloadEnd;
+						continue;
+					}
+
+					// Reject counts the payload can't hold before anything is allocated for them. Version 1 doesn't align arrays
+					const size_t elementSize = ElementSize(type);
+					const size_t padding = elementSize > 0 && count > 0 && mVersion > 1 ? Padding(mPosition) : 0;
+					if (elementSize > 0 ? payloadSize != padding + count * elementSize : payloadSize < count * MinimumElementSize)
+					{
+						throw std::exception("Binary scope datum has wrong payload size");
+					}
+
+					// If this is a prescribed attribute and type doesn't match, will blow up
+					Datum& datum = scope.Append(key).first;
+					datum.SetType(type);
+					if (type == DatumType::Table)
+					{
+						for (std::uint32_t j = 0; j < count; ++j)
+						{
+							ReadScope(NestedScope(scope, datum, key, j));
+						}
+					}
+					else if (type == DatumType::String)
+					{
+						// If this is a prescribed external datum, will blow up if we try to grow the size
+						if (datum.Size() < count)
+						{
+							datum.SetSize(count);
+						}
+						for (std::uint32_t j = 0; j < count; ++j)
+						{
+							datum.AsString(j).assign(ReadText());
+						}
+						datum.MarkChanged();
+					}
+					else if (count > 0)
+					{
+						Take(padding);
+						const size_t bytes = count * elementSize;
+						char* elements = const_cast<char*>(Take(bytes));
+						if (mReferences != nullptr && datum.IsInternal() && reinterpret_cast<std::uintptr_t>(elements) % ScopeSerializer::PayloadAlignment == 0)
+						{
+							datum.ShareStorage(elements, count, *mReferences);
+						}
+						else
+						{
+							if (datum.Size() < count)
+							{
+								datum.SetSize(count);
+							}
+							std::memcpy(ElementData(datum), elements, bytes);
+							datum.MarkChanged();
+						}
+					}
+
+					if (mPosition != payloadEnd)
+					{
+						throw std::exception("Binary scope datum has wrong payload size");
+					}
+				}
+			}
+
+		private:
+			/// <summary>
+			/// Read the class name of a nested scope, then reuse the existing scope at that index or create a new one
+			/// </summary>
+			Scope& NestedScope(Scope& scope, Datum& datum, std::string_view key, size_t index)
+			{
+				const std::string_view className = ReadText();
+				if (index < datum.Size())
+				{
+					return datum.AsTable(index);
+				}
+				if (className == SCOPE_CLASS_NAME)
+				{
+					return scope.AppendScope(key);
+				}
+
+				ArenaGuard guard(scope.GetArena());
+				std::unique_ptr<Scope> child(Factory<Scope>::Create(std::string(className)));
+				if (child == nullptr)
+				{
+					throw std::exception("Binary scope has a class without factory");
+				}
+				scope.Adopt(*child, std::string(key));
+				return *child.release();
+			}
+
+			std::string_view mInput;
+			size_t mPosition = 0;
+			std::uint32_t mVersion = ScopeSerializer::Version;
+
+			/// <summary>
+			/// Owner of the input that arrays are borrowed from, nullptr to copy them
+			/// </summary>
+			Datum::ReferenceCount* mReferences;
+		};
+
+		void ReadAll(std::string_view input, Scope& scope, Datum::ReferenceCount* references)
+		{
+			Reader reader(input, references);
+			reader.ReadHeader();
+			reader.ReadScope(scope);
+			if (!reader.AtEnd())
+			{
+				throw std::exception("Binary scope data has trailing bytes");
+			}
+		}
+	}
+
+	std::string ScopeSerializer::Write(const Scope& scope)
+	{
+		std::string output;
+		Write(scope, output);
+		return output;
+	}
+
+	void ScopeSerializer::Write(const Scope& scope, std::string& output)
+	{
+		const size_t start = output.size();
+		WriteValue(output, Magic);
+		WriteValue(output, Version);
+		WriteScope(scope, output, start);
+	}
+
+	void ScopeSerializer::WriteToFile(const Scope& scope, const std::string& path)
+	{
+		const std::string output = Write(scope);
+		std::ofstream stream(path, std::ios::binary | std::ios::trunc);
+		if (stream.fail())
+		{
+			throw std::exception("Can't open file to write");
+		}
+		stream.write(output.data(), output.size());
+		if (stream.fail())
+		{
+			throw std::exception("Can't write file");
+		}
+	}
+
+	void ScopeSerializer::Read(std::string_view input, Scope& scope)
+	{
+		ReadAll(input, scope, nullptr);
+	}
+
+	void ScopeSerializer::Read(std::string_view input, Scope& scope, Datum::ReferenceCount& references)
+	{
+		ReadAll(input, scope, &references);
+	}
+
+	void ScopeSerializer::ReadFromFile(const std::string& path, Scope& scope)
+	{
+		std::ifstream stream(path, std::ios::binary | std::ios::ate);
+		if (stream.fail())
+		{
+			throw std::exception("File doesn't exist");
+		}
+		std::string input(static_cast<size_t>(stream.tellg()), '\0');
+		stream.seekg(0);
+		stream.read(input.data(), input.size());
+		if (stream.fail())
+		{
+			throw std::exception("Can't read file");
+		}
+		Read(input, scope);
+	}
+
+	bool ScopeSerializer::ConvertJsonFile(const std::string& jsonPath, const std::string& binaryPath)
+	{
+		std::shared_ptr<Scope> scope = std::make_shared<Scope>();
+		JsonTableParseHelper::SharedData data(scope);
+		JsonParseMaster master(data);
+		JsonTableParseHelper helper;
+		master.AddHelper(helper);
+		if (!master.ParseFromFile(jsonPath))
+		{
+			return false;
+		}
+		WriteToFile(*scope, binaryPath);
+		return true;
+	}
+}
@@ -0,0 +1,108 @@
+#pragma once
+
+/// \file ScopeSerializer.h
+/// \brief Contains the declaration of ScopeSerializer
+
+#include "Datum.h"
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace GameEngine
+{
+	class Scope;
+
+	/// <summary>
+	/// Reads and writes Scope trees in a compact versioned binary format, a faster alternative to JSON for shipped levels.
+	/// The data starts with Magic and Version followed by the root scope. A scope is its number of Datums followed by one block per Datum:
+	/// type, key, number of elements and payload size in bytes, then the payload. Integers, floats, vectors and matrices are stored as raw arrays
+	/// padded to start at a multiple of PayloadAlignment from the start of the data, so they can be used in place,
+	/// strings are length-prefixed, and every nested scope is its class name followed by its own scope.
+	/// Pointer Datums, including "this" of Attributed, can't be saved and are skipped. Values are stored in the byte order of the machine that wrote them.
+	/// Reading follows the same rules as JsonTableParseHelper: existing Datums are overwritten element by element and grow if needed,
+	/// existing nested scopes are reused, and new nested scopes of a class other than Scope are created by Factory&lt;Scope&gt;
+	/// </summary>
+	class ScopeSerializer final
+	{
+	public:
+		/// <summary>
+		/// First 4 bytes of the data, "GESB"
+		/// </summary>
+		static constexpr std::uint32_t Magic = 0x42534547;
+
+		/// <summary>
+		/// Version of the format written. Data of a newer version is rejected, Datum types unknown to this version are skipped
+		/// </summary>
+		static constexpr std::uint32_t Version = 2;
+
+		/// <summary>
+		/// Alignment of raw arrays relative to the start of the data, since version 2
+		/// </summary>
+		static constexpr size_t PayloadAlignment = 16;
+
+		ScopeSerializer() = delete;
+
+		/// <summary>
+		/// Serialize a scope and everything nested in it
+		/// </summary>
+		/// <param name="scope">The scope to write</param>
+		/// <returns>Binary data</returns>
+		static std::string Write(const Scope& scope);
+
+		/// <summary>
+		/// Serialize a scope and everything nested in it to the end of a buffer
+		/// </summary>
+		/// <param name="scope">The scope to write</param>
+		/// <param name="output">Buffer to append to</param>
+		static void Write(const Scope& scope, std::string& output);
+
+		/// <summary>
+		/// Serialize a scope and everything nested in it to a file
+		/// </summary>
+		/// <param name="scope">The scope to write</param>
+		/// <param name="path">Path of the file, replaced if it exists</param>
+		/// <exception cref="std::exception">File can't be written</exception>
+		static void WriteToFile(const Scope& scope, const std::string& path);
+
+		/// <summary>
+		/// Fill a scope from binary data
+		/// </summary>
+		/// <param name="input">Binary data produced by Write</param>
+		/// <param name="scope">The scope to fill</param>
+		/// <exception cref="std::exception">Data is malformed, has a newer version or doesn't match prescribed attributes</exception>
+		/// <exception cref="std::exception">A nested scope has a class without factory</exception>
+		static void Read(std::string_view input, Scope& scope);
+
+		/// <summary>
+		/// Fill a scope from binary data owned by a reference count, such as a mapped file.
+		/// Raw arrays of internal Datums point into the data instead of being copied and are shared like copy-on-write copies,
+		/// the first change to a Datum copies its array out, so the data is never written to.
+		/// Arrays of external Datums, strings and nested scopes are copied as in the other overload
+		/// </summary>
+		/// <param name="input">Binary data produced by Write</param>
+		/// <param name="scope">The scope to fill</param>
+		/// <param name="references">Reference count owned by the data, starting at 1 for the owner and incremented for every Datum pointing into it.
+		/// Its release function frees the data once the owner and every Datum let go, see Datum::ShareStorage</param>
+		/// <exception cref="std::exception">Data is malformed, has a newer version or doesn't match prescribed attributes</exception>
+		/// <exception cref="std::exception">A nested scope has a class without factory</exception>
+		static void Read(std::string_view input, Scope& scope, Datum::ReferenceCount& references);
+
+		/// <summary>
+		/// Fill a scope from a binary file
+		/// </summary>
+		/// <param name="path">Path of the file produced by WriteToFile</param>
+		/// <param name="scope">The scope to fill</param>
+		/// <exception cref="std::exception">File doesn't exist or its data can't be read, see Read</exception>
+		static void ReadFromFile(const std::string& path, Scope& scope);
+
+		/// <summary>
+		/// Convert a JSON file in the format of JsonTableParseHelper to a binary file.
+		/// Factories of all classes used in the JSON must be registered, since the JSON is loaded into a Scope first
+		/// </summary>
+		/// <param name="jsonPath">Path of the JSON file</param>
+		/// <param name="binaryPath">Path of the binary file, replaced if it exists</param>
+		/// <returns>True if the JSON was parsed and the binary file written, false if parsing failed</returns>
+		/// <exception cref="std::exception">Either file can't be opened</exception>
+		static bool ConvertJsonFile(const std::string& jsonPath, const std::string& binaryPath);
+	};
+}
@@ -0,0 +1,117 @@
+#include "pch.h"
+#include "ScopeSnapshot.h"
+#include "ScopeSerializer.h"
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace GameEngine
+{
+	ScopeSnapshot::ScopeSnapshot(const std::string& path)
+	{
+		const char* data = nullptr;
+		size_t size = 0;
+#ifdef _WIN32
+		HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+		if (file == INVALID_HANDLE_VALUE)
+		{
+			throw std::exception("File doesn't exist");
+		}
+		LARGE_INTEGER fileSize;
+		if (!GetFileSizeEx(file, &fileSize))
+		{
+			CloseHandle(file);
+			throw std::exception("Can't map file");
+		}
+		size = static_cast<size_t>(fileSize.QuadPart);
+		if (size > 0)
+		{
+			// The view keeps the mapping alive, both handles can be closed once it exists
+			HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+			if (mapping != nullptr)
+			{
+				data = static_cast<const char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+				CloseHandle(mapping);
+			}
+		}
+		CloseHandle(file);
+#else
+		const int file = open(path.c_str(), O_RDONLY);
+		if (file < 0)
+		{
+			throw std::exception("File doesn't exist");
+		}
+		struct stat status;
+		if (fstat(file, &status) != 0)
+		{
+			close(file);
+			throw std::exception("Can't map file");
+		}
+		size = static_cast<size_t>(status.st_size);
+		if (size > 0)
+		{
+			void* address = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, file, 0);
+			data = address == MAP_FAILED ? nullptr : static_cast<const char*>(address);
+		}
+		close(file);
+#endif
+		if (size > 0 && data == nullptr)
+		{
+			throw std::exception("Can't map file");
+		}
+		mMapping = new Mapping(data, size);
+	}
+
+	ScopeSnapshot::~ScopeSnapshot()
+	{
+		// Datums still pointing into the file keep it mapped
+		if (mMapping->mCount.fetch_sub(1, std::memory_order_acq_rel) == 1)
+		{
+			Mapping::Release(*mMapping);
+		}
+	}
+
+	void ScopeSnapshot::Read(Scope& scope)
+	{
+		ScopeSerializer::Read(std::string_view(mMapping->mData, mMapping->mSize), scope, *mMapping);
+	}
+
+	const char* ScopeSnapshot::Data() const
+	{
+		return mMapping->mData;
+	}
+
+	size_t ScopeSnapshot::Size() const
+	{
+		return mMapping->mSize;
+	}
+
+	size_t ScopeSnapshot::SharedCount() const
+	{
+		return mMapping->mCount.load(std::memory_order_acquire) - 1;
+	}
+
+	ScopeSnapshot::Mapping::Mapping(const char* data, size_t size) :
+		mData(data), mSize(size)
+	{
+		mRelease = &Release;
+	}
+
+	void ScopeSnapshot::Mapping::Release(Datum::ReferenceCount& references)
+	{
+		Mapping* mapping = static_cast<Mapping*>(&references);
+		if (mapping->mData != nullptr)
+		{
+#ifdef _WIN32
+			UnmapViewOfFile(mapping->mData);
+#else
+			munmap(const_cast<char*>(mapping->mData), mapping->mSize);
+#endif
+		}
+		delete mapping;
+	}
+}
@@ -0,0 +1,98 @@
+#pragma once
+
+/// \file ScopeSnapshot.h
+/// \brief Contains the declaration of ScopeSnapshot
+
+#include "Datum.h"
+#include <string>
+
+namespace GameEngine
+{
+	class Scope;
+
+	/// <summary>
+	/// A baked binary scope file written by ScopeSerializer, mapped read-only into memory so scopes can be loaded from it without copying their arrays.
+	/// Integers, floats, vectors and matrices of internal Datums point straight into the mapping until they are changed,
+	/// and the operating system shares the pages between every process mapping the same file.
+	/// Scopes read from it, including copies made under CopyOnWriteGuard, may outlive the snapshot: the file stays mapped until the last Datum pointing into it lets go
+	/// </summary>
+	class ScopeSnapshot final
+	{
+	public:
+		/// <summary>
+		/// Constructor, map a file
+		/// </summary>
+		/// <param name="path">Path of the file produced by ScopeSerializer::WriteToFile</param>
+		/// <exception cref="std::exception">File doesn't exist or can't be mapped</exception>
+		explicit ScopeSnapshot(const std::string& path);
+
+		ScopeSnapshot(const ScopeSnapshot&) = delete;
+		ScopeSnapshot& operator=(const ScopeSnapshot&) = delete;
+
+		/// <summary>
+		/// Destructor, unmap the file, or leave that to the last Datum still pointing into it
+		/// </summary>
+		~ScopeSnapshot();
+
+		/// <summary>
+		/// Fill a scope from the mapped file, see ScopeSerializer::Read
+		/// </summary>
+		/// <param name="scope">The scope to fill</param>
+		/// <exception cref="std::exception">Data is malformed, has a newer version or doesn't match prescribed attributes</exception>
+		/// <exception cref="std::exception">A nested scope has a class without factory</exception>
+		void Read(Scope& scope);
+
+		/// <summary>
+		/// Get the mapped data
+		/// </summary>
+		/// <returns>Address of the first byte of the file</returns>
+		const char* Data() const;
+
+		/// <summary>
+		/// Get the size of the mapped data
+		/// </summary>
+		/// <returns>Size of the file in bytes</returns>
+		size_t Size() const;
+
+		/// <summary>
+		/// Get number of Datums still pointing into the mapping
+		/// </summary>
+		/// <returns>Number of Datums sharing the mapped data</returns>
+		size_t SharedCount() const;
+
+	private:
+		/// <summary>
+		/// A mapped file and its reference count, shared by the snapshot and every Datum pointing into it. The last one to let go unmaps it
+		/// </summary>
+		struct Mapping final : Datum::ReferenceCount
+		{
+			/// <summary>
+			/// Constructor, take over a mapped file. The snapshot holds the first reference
+			/// </summary>
+			/// <param name="data">Address of the mapping, nullptr for an empty file</param>
+			/// <param name="size">Size of the mapping in bytes</param>
+			Mapping(const char* data, size_t size);
+
+			/// <summary>
+			/// Unmap the file and delete the mapping, after the last reference is dropped
+			/// </summary>
+			/// <param name="references">The mapping</param>
+			static void Release(Datum::ReferenceCount& references);
+
+			/// <summary>
+			/// Address of the mapping, nullptr for an empty file
+			/// </summary>
+			const char* mData;
+
+			/// <summary>
+			/// Size of the mapping in bytes
+			/// </summary>
+			size_t mSize;
+		};
+
+		/// <summary>
+		/// The mapped file, never nullptr
+		/// </summary>
+		Mapping* mMapping = nullptr;
+	};
+}
@@ -0,0 +1,440 @@
+#include "pch.h"
+#include "ScopeWriter.h"
+#include "Scope.h"
+#include <algorithm>
+#include <charconv>
+#include <fstream>
+#include <ostream>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace GameEngine
+{
+	namespace
+	{
+		using DatumType = Datum::DatumType;
+
+		/// <summary>
+		/// Smallest buffer, large enough for the longest number and some text around it
+		/// </summary>
+		constexpr size_t MinimumBufferSize = 256;
+
+		/// <summary>
+		/// Class name of plain nested scopes, which JsonTableParseHelper appends without a factory
+		/// </summary>
+		const char* const SCOPE_CLASS_NAME = "Scope";
+
+		/// <summary>
+		/// Name of a Datum type in JSON, nullptr for types JsonTableParseHelper can't read
+		/// </summary>
+		const char* JsonTypeName(DatumType type)
+		{
+			switch (type)
+			{
+			case DatumType::Integer:
+				return "integer";
+			case DatumType::Float:
+				return "float";
+			case DatumType::Vector:
+				return "vector";
+			case DatumType::Matrix:
+				return "matrix";
+			case DatumType::String:
+				return "string";
+			case DatumType::Table:
+				return "table";
+			default:
+				return nullptr;
+			}
+		}
+	}
+
+	ScopeWriter::ScopeWriter(std::ostream& stream, Format format, size_t bufferSize) :
+		mStream(&stream),
+		mFormat(format),
+		mBuffer(std::make_unique<char[]>(std::max(bufferSize, MinimumBufferSize))),
+		mCapacity(std::max(bufferSize, MinimumBufferSize))
+	{
+	}
+
+	ScopeWriter::ScopeWriter(int fileDescriptor, Format format, size_t bufferSize) :
+		mFileDescriptor(fileDescriptor),
+		mFormat(format),
+		mBuffer(std::make_unique<char[]>(std::max(bufferSize, MinimumBufferSize))),
+		mCapacity(std::max(bufferSize, MinimumBufferSize))
+	{
+	}
+
+	void ScopeWriter::Write(const Scope& scope)
+	{
+		WriteScope(scope, 0);
+		if (mFormat == Format::Json)
+		{
+			Put('\n');
+		}
+		Flush();
+	}
+
+	void ScopeWriter::WriteToFile(const Scope& scope, const std::string& path, Format format)
+	{
+		std::ofstream stream(path, std::ios::binary | std::ios::trunc);
+		if (stream.fail())
+		{
+			throw std::exception("Can't open file to write");
+		}
+		ScopeWriter(stream, format).Write(scope);
+	}
+
+	void ScopeWriter::WriteScope(const Scope& scope, size_t depth)
+	{
+		Put('{');
+		bool first = true;
+		if (mFormat == Format::Json)
+		{
+			// Only nested scopes can be created by class name
+			const std::string className = scope.TypeNameInstance();
+			if (depth > 0 && className != SCOPE_CLASS_NAME)
+			{
+				WriteLine(depth + 1);
+				Put("\"class\": ");
+				WriteQuoted(className);
+				first = false;
+			}
+
+			for (size_t i = 0; i < scope.Size(); ++i)
+			{
+				const Datum& datum = scope[i];
+				if (JsonTypeName(datum.Type()) == nullptr)
+				{
+					continue;
+				}
+				if (!first)
+				{
+					Put(',');
+				}
+				first = false;
+				WriteLine(depth + 1);
+				WriteQuoted(scope.KeyAt(i).Name());
+				Put(": ");
+				WriteJsonDatum(datum, depth + 1);
+			}
+			WriteLine(depth);
+		}
+		else
+		{
+			Put('\n');
+			for (size_t i = 0; i < scope.Size(); ++i)
+			{
+				if (!first)
+				{
+					Put(",\n");
+				}
+				first = false;
+				Put('"');
+				Put(scope.KeyAt(i).Name());
+				Put("\": ");
+				WriteTextDatum(scope, scope[i]);
+			}
+			if (!first)
+			{
+				Put('\n');
+			}
+		}
+		Put('}');
+	}
+
+	void ScopeWriter::WriteJsonDatum(const Datum& datum, size_t depth)
+	{
+		Put('{');
+		WriteLine(depth + 1);
+		Put("\"type\": \"");
+		Put(JsonTypeName(datum.Type()));
+		Put("\",");
+		WriteLine(depth + 1);
+		Put("\"value\": ");
+
+		const bool array = datum.Size() != 1;
+		if (datum.Type() == DatumType::Table)
+		{
+			if (array)
+			{
+				Put('[');
+			}
+			for (size_t i = 0; i < datum.Size(); ++i)
+			{
+				if (i > 0)
+				{
+					Put(',');
+				}
+				if (array)
+				{
+					WriteLine(depth + 2);
+				}
+				WriteScope(datum.AsTable(i), array ? depth + 2 : depth + 1);
+			}
+			if (array)
+			{
+				WriteLine(depth + 1);
+				Put(']');
+			}
+		}
+		else
+		{
+			if (array)
+			{
+				Put("[ ");
+			}
+			for (size_t i = 0; i < datum.Size(); ++i)
+			{
+				if (i > 0)
+				{
+					Put(", ");
+				}
+				if (datum.Type() == DatumType::String)
+				{
+					WriteQuoted(datum.AsString(i));
+				}
+				else if (datum.Type() == DatumType::Vector || datum.Type() == DatumType::Matrix)
+				{
+					// Loaded through Datum::SetFromString
+					Put('"');
+					WriteNumber(datum, i);
+					Put('"');
+				}
+				else
+				{
+					WriteNumber(datum, i);
+				}
+			}
+			if (array)
+			{
+				Put(" ]");
+			}
+		}
+		WriteLine(depth);
+		Put('}');
+	}
+
+	void ScopeWriter::WriteTextDatum(const Scope& scope, const Datum& datum)
+	{
+		const bool self = datum.Type() == DatumType::Pointer && datum == static_cast<const RTTI*>(&scope);
+		Put('[');
+		for (size_t i = 0; i < datum.Size(); ++i)
+		{
+			if (i > 0)
+			{
+				Put(", ");
+			}
+			switch (datum.Type())
+			{
+			case DatumType::String:
+				Put('"');
+				Put(datum.AsString(i));
+				Put('"');
+				break;
+			case DatumType::Table:
+			case DatumType::Pointer:
+			{
+				// Plain scopes are streamed, anything else may override ToString
+				const RTTI* pointer = datum.Type() == DatumType::Table ? static_cast<const RTTI*>(&datum.AsTable(i)) : datum.AsPointer(i);
+				if (self)
+				{
+					Put("this");
+				}
+				else if (pointer == nullptr)
+				{
+					Put("nullptr");
+				}
+				else if (pointer->TypeIdInstance() == Scope::TypeIdClass())
+				{
+					WriteScope(static_cast<const Scope&>(*pointer), 0);
+				}
+				else
+				{
+					Put(pointer->ToString());
+				}
+				break;
+			}
+			default:
+				WriteNumber(datum, i);
+				break;
+			}
+		}
+		Put(']');
+	}
+
+	void ScopeWriter::WriteNumber(const Datum& datum, size_t index)
+	{
+		switch (datum.Type())
+		{
+		case DatumType::Integer:
+		{
+			char* buffer = Reserve(MaxNumberSize);
+			mSize = static_cast<size_t>(std::to_chars(buffer, buffer + MaxNumberSize, datum.AsInt(index)).ptr - mBuffer.get());
+			break;
+		}
+		case DatumType::Float:
+			WriteFloat(datum.AsFloat(index));
+			break;
+		case DatumType::Vector:
+			Put("vec4");
+			WriteFloats(&datum.AsVector(index)[0]);
+			break;
+		case DatumType::Matrix:
+		{
+			const glm::mat4& matrix = datum.AsMatrix(index);
+			Put("mat4x4(");
+			for (glm::length_t column = 0; column < 4; ++column)
+			{
+				if (column > 0)
+				{
+					Put(", ");
+				}
+				WriteFloats(&matrix[column][0]);
+			}
+			Put(')');
+			break;
+		}
+		default:
+			break;
+		}
+	}
+
+	void ScopeWriter::WriteFloat(float value)
+	{
+		char* buffer = Reserve(MaxNumberSize);
+		const std::to_chars_result result = mFormat == Format::Json ? std::to_chars(buffer, buffer + MaxNumberSize, value)
+			: std::to_chars(buffer, buffer + MaxNumberSize, value, std::chars_format::fixed, 6);
+		assert(result.ec == std::errc());
+		mSize = static_cast<size_t>(result.ptr - mBuffer.get());
+	}
+
+	void ScopeWriter::WriteFloats(const float* values)
+	{
+		Put('(');
+		for (size_t i = 0; i < 4; ++i)
+		{
+			if (i > 0)
+			{
+				Put(", ");
+			}
+			WriteFloat(values[i]);
+		}
+		Put(')');
+	}
+
+	void ScopeWriter::WriteQuoted(std::string_view text)
+	{
+		static const char* const HEX_DIGITS = "0123456789abcdef";
+		Put('"');
+		for (char character : text)
+		{
+			switch (character)
+			{
+			case '"':
+				Put("\\\"");
+				break;
+			case '\\':
+				Put("\\\\");
+				break;
+			case '\n':
+				Put("\\n");
+				break;
+			case '\r':
+				Put("\\r");
+				break;
+			case '\t':
+				Put("\\t");
+				break;
+			default:
+				if (static_cast<unsigned char>(character) < 0x20)
+				{
+					Put("\\u00");
+					Put(HEX_DIGITS[character >> 4]);
+					Put(HEX_DIGITS[character & 0xF]);
+				}
+				else
+				{
+					Put(character);
+				}
+				break;
+			}
+		}
+		Put('"');
+	}
+
+	void ScopeWriter::WriteLine(size_t depth)
+	{
+		Put('\n');
+		for (size_t i = 0; i < depth; ++i)
+		{
+			Put('\t');
+		}
+	}
+
+	void ScopeWriter::Put(char character)
+	{
+		*Reserve(1) = character;
+		++mSize;
+	}
+
+	void ScopeWriter::Put(std::string_view text)
+	{
+		while (!text.empty())
+		{
+			if (mSize == mCapacity)
+			{
+				Flush();
+			}
+			const size_t count = std::min(text.size(), mCapacity - mSize);
+			std::copy_n(text.data(), count, mBuffer.get() + mSize);
+			mSize += count;
+			text.remove_prefix(count);
+		}
+	}
+
+	char* ScopeWriter::Reserve(size_t size)
+	{
+		assert(size <= mCapacity);
+		if (mCapacity - mSize < size)
+		{
+			Flush();
+		}
+		return mBuffer.get() + mSize;
+	}
+
+	void ScopeWriter::Flush()
+	{
+		const char* data = mBuffer.get();
+		size_t remaining = mSize;
+		mSize = 0;
+		if (mStream != nullptr)
+		{
+			mStream->write(data, static_cast<std::streamsize>(remaining));
+			if (mStream->fail())
+			{
+				throw std::exception("Can't write output");
+			}
+			return;
+		}
+
+		while (remaining > 0)
+		{
+#ifdef _WIN32
+			const int written = _write(mFileDescriptor, data, static_cast<unsigned int>(remaining));
+#else
+			const ssize_t written = write(mFileDescriptor, data, remaining);
+#endif
+			if (written <= 0)
+			{
+				throw std::exception("Can't write output");
+			}
+			data += written;
+			remaining -= static_cast<size_t>(written);
+		}
+	}
+}
@@ -0,0 +1,181 @@
+#pragma once
+
+/// \file ScopeWriter.h
+/// \brief Contains the declaration of ScopeWriter
+
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <memory>
+#include <string>
+#include <string_view>
+
+namespace GameEngine
+{
+	class Datum;
+	class Scope;
+
+	/// <summary>
+	/// Writes a Scope tree to a stream or file descriptor through a fixed-size buffer, so dumping a whole world never holds more than the buffer in memory.
+	/// JSON output is in the format read by JsonTableParseHelper: every Datum is an object with "type" and "value", nested scopes of a class other than Scope
+	/// get a "class" for Factory, and pointer Datums, which can't be loaded, are skipped. Text output is the format of Scope::ToString.
+	/// Numbers are formatted with std::to_chars, JSON floats in the shortest form that reads back to the same value
+	/// </summary>
+	class ScopeWriter final
+	{
+	public:
+		/// <summary>
+		/// Supported output formats
+		/// </summary>
+		enum class Format
+		{
+			Json,
+			Text
+		};
+
+		/// <summary>
+		/// Default size of the buffer in bytes
+		/// </summary>
+		static constexpr size_t DefaultBufferSize = 64 * 1024;
+
+		/// <summary>
+		/// Constructor, write to a stream
+		/// </summary>
+		/// <param name="stream">The stream to write to, must outlive the writer</param>
+		/// <param name="format">Output format</param>
+		/// <param name="bufferSize">Size of the buffer in bytes, at least 256 is used</param>
+		explicit ScopeWriter(std::ostream& stream, Format format = Format::Json, size_t bufferSize = DefaultBufferSize);
+
+		/// <summary>
+		/// Constructor, write to a file descriptor, such as one returned by open or 1 for standard output
+		/// </summary>
+		/// <param name="fileDescriptor">The file descriptor to write to, stays open</param>
+		/// <param name="format">Output format</param>
+		/// <param name="bufferSize">Size of the buffer in bytes, at least 256 is used</param>
+		explicit ScopeWriter(int fileDescriptor, Format format = Format::Json, size_t bufferSize = DefaultBufferSize);
+
+		ScopeWriter(const ScopeWriter&) = delete;
+		ScopeWriter& operator=(const ScopeWriter&) = delete;
+
+		~ScopeWriter() = default;
+
+		/// <summary>
+		/// Write a scope and everything nested in it. Everything written is flushed to the output before returning
+		/// </summary>
+		/// <param name="scope">The scope to write</param>
+		/// <exception cref="std::exception">Output can't be written</exception>
+		void Write(const Scope& scope);
+
+		/// <summary>
+		/// Write a scope and everything nested in it to a file
+		/// </summary>
+		/// <param name="scope">The scope to write</param>
+		/// <param name="path">Path of the file, replaced if it exists</param>
+		/// <param name="format">Output format</param>
+		/// <exception cref="std::exception">File can't be written</exception>
+		static void WriteToFile(const Scope& scope, const std::string& path, Format format = Format::Json);
+
+	private:
+		/// <summary>
+		/// Longest text of a single number, the buffer always has room for one after Reserve
+		/// </summary>
+		static constexpr size_t MaxNumberSize = 64;
+
+		/// <summary>
+		/// Write a scope as an object, nested scopes are written recursively
+		/// </summary>
+		/// <param name="scope">The scope to write</param>
+		/// <param name="depth">Nesting depth, used for indentation of JSON</param>
+		void WriteScope(const Scope& scope, size_t depth);
+
+		/// <summary>
+		/// Write the "type" and "value" object of a Datum
+		/// </summary>
+		/// <param name="datum">The Datum to write, of a type JsonTableParseHelper can read</param>
+		/// <param name="depth">Nesting depth of the object</param>
+		void WriteJsonDatum(const Datum& datum, size_t depth);
+
+		/// <summary>
+		/// Write all elements of a Datum as a list, like Scope::ToString
+		/// </summary>
+		/// <param name="scope">The scope containing the Datum, written as "this" when the Datum points to it</param>
+		/// <param name="datum">The Datum to write</param>
+		void WriteTextDatum(const Scope& scope, const Datum& datum);
+
+		/// <summary>
+		/// Write one element of an integer, float, vector or matrix Datum, vectors and matrices in the syntax of Datum::SetFromString
+		/// </summary>
+		/// <param name="datum">The Datum</param>
+		/// <param name="index">Index of the element</param>
+		void WriteNumber(const Datum& datum, size_t index);
+
+		/// <summary>
+		/// Write a float, shortest round trip form for JSON and 6 decimals for text
+		/// </summary>
+		void WriteFloat(float value);
+
+		/// <summary>
+		/// Write 4 floats in parentheses, separated by commas
+		/// </summary>
+		void WriteFloats(const float* values);
+
+		/// <summary>
+		/// Write text in double quotes, escaped for JSON
+		/// </summary>
+		void WriteQuoted(std::string_view text);
+
+		/// <summary>
+		/// Start a new line indented by given depth, JSON only
+		/// </summary>
+		void WriteLine(size_t depth);
+
+		/// <summary>
+		/// Append to the buffer, flushing it whenever it is full
+		/// </summary>
+		void Put(char character);
+		void Put(std::string_view text);
+
+		/// <summary>
+		/// Make sure given number of bytes fit in the buffer, flushing it if needed
+		/// </summary>
+		/// <param name="size">Number of bytes about to be written, no more than the buffer size</param>
+		/// <returns>Where to write them</returns>
+		char* Reserve(size_t size);
+
+		/// <summary>
+		/// Send everything in the buffer to the output
+		/// </summary>
+		/// <exception cref="std::exception">Output can't be written</exception>
+		void Flush();
+
+		/// <summary>
+		/// Stream to write to, nullptr when writing to a file descriptor
+		/// </summary>
+		std::ostream* mStream = nullptr;
+
+		/// <summary>
+		/// File descriptor to write to, -1 when writing to a stream
+		/// </summary>
+		int mFileDescriptor = -1;
+
+		/// <summary>
+		/// Output format
+		/// </summary>
+		Format mFormat;
+
+		/// <summary>
+		/// The buffer, allocated once
+		/// </summary>
+		std::unique_ptr<char[]> mBuffer;
+
+		/// <summary>
+		/// Size of the buffer
+		/// </summary>
+		size_t mCapacity;
+
+		/// <summary>
+		/// Number of bytes in the buffer not yet sent to the output
+		/// </summary>
+		size_t mSize = 0;
+	};
+}
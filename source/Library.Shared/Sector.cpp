@@ -24,11 +24,13 @@ const std::string& Sector::Name() const
 void Sector::SetName(const std::string& name)
 {
 	mName = name;
+	MarkAttributeChanged("Name");
 }
 
 void Sector::SetActive(bool active)
 {
 	mActive = active ? 1 : 0;
+	MarkAttributeChanged("Active");
 }
 
 bool Sector::IsActive() const
@@ -48,6 +50,7 @@ const Datum& Sector::Entities() const
 
 Entity* Sector::CreateEntity(const std::string& className, const std::string& instanceName)
 {
+	ArenaGuard guard(GetArena());
 	Scope* product = Factory<Scope>::Create(className);
 	assert(product != nullptr && product->Is("Entity"));
 	Entity* entity = static_cast<Entity*>(product);
@@ -0,0 +1,466 @@
+#pragma once
+
+/// \file SmallVector.h
+/// \brief Contains the declaration of SmallVector
+
+#include "vector.h"
+
+namespace GameEngine
+{
+	/// <summary>
+	/// SmallVector is a Vector that keeps its first N items inside the object itself and only allocates heap memory once it grows beyond N items.
+	/// Use it for lists that almost always stay short (children, links, callbacks) so that creating the owner costs no extra allocation.
+	/// Capacity is never less than N. Moving a SmallVector whose items are inline relocates the items one by one instead of stealing a pointer
+	/// </summary>
+	template <typename T, size_t N, typename ReserveStrategy = DefaultReserveStrategy>
+	class SmallVector
+	{
+		static_assert(N > 0, "SmallVector needs at least one inline slot, use Vector instead");
+
+	private:
+		/// <summary>
+		/// Base address of container array, either the inline buffer or heap memory
+		/// </summary>
+		T* mArray = InlineBuffer();
+
+		/// <summary>
+		/// Number of existing items in the SmallVector
+		/// </summary>
+		size_t mSize = 0;
+
+		/// <summary>
+		/// Number of possible slots for items in the SmallVector (i.e. length of mArray)
+		/// </summary>
+		size_t mCapacity = N;
+
+		/// <summary>
+		/// Raw storage of the first N items
+		/// </summary>
+		alignas(T) unsigned char mBuffer[sizeof(T) * N];
+
+		/// <summary>
+		/// Get the address of the inline storage
+		/// </summary>
+		/// <returns>Address of the first inline slot</returns>
+		inline T* InlineBuffer();
+
+		/// <summary>
+		/// Deep copy the contents in other SmallVector to this one
+		/// </summary>
+		/// <param name="other">The other SmallVector to copy from</param>
+		void DeepCopy(const SmallVector & other);
+
+		/// <summary>
+		/// Take the contents of other SmallVector, which is left empty and inline. This SmallVector must be empty and inline
+		/// </summary>
+		/// <param name="other">The other SmallVector to move from</param>
+		void MoveFrom(SmallVector & other);
+
+		/// <summary>
+		/// Change the length of mArray to given capacity, which must be no less than size. Switch back to the inline buffer if capacity fits in it
+		/// </summary>
+		/// <param name="capacity">New capacity of the array</param>
+		void Reallocate(size_t capacity);
+
+	public:
+		/// <summary>
+		/// An iterator is a container that points to one data item in the vector.
+		/// Generally it is used to traverse vector, or specify a "position" in the vector so that user can remove based on that position.
+		/// It can be compared with another iterator by evaluating the data they are pointing to.
+		/// It can also be incremented to point to next item in vector.
+		/// </summary>
+		class Iterator
+		{
+		public:
+			using size_type = std::size_t;
+			using value_type = T;
+			using pointer = T*;
+			using reference = T&;
+			using difference_type = std::ptrdiff_t;
+			using iterator_category = std::forward_iterator_tag;
+
+			/// <summary>
+			/// Default constructor, create an Iterator without parent and without a item to point to
+			/// </summary>
+			Iterator() = default;
+
+			/// <summary>
+			/// Pre-increment operator. Increment the Iterator to point to next item in the vector and return it
+			/// </summary>
+			/// <returns>The Iterator after increment</returns>
+			Iterator & operator++();
+
+			/// <summary>
+			/// Post-increment operator. Increment the Iterator to point to next item in the vector and return the copy of the original Iterator before copying
+			/// </summary>
+			/// <param name="">A signature parameter to tell this is a post increment</param>
+			/// <returns>The copy of Iterator before increment</returns>
+			Iterator operator++(int);
+
+			/// <summary>
+			/// Get the Iterator after moving current one by step items forward. This doesn't change original Iterator
+			/// </summary>
+			/// <param name="step">Number of items to move</param>
+			/// <returns>The Iterator after move</returns>
+			Iterator operator+(size_t step) const;
+
+			/// <summary>
+			/// Check if two Iterators are the equal. Two Iterators are equal if they belong to the same container and they point to the same item.
+			/// </summary>
+			/// <param name="other">The other Iterator to compare with</param>
+			/// <returns>True if two Iterators are equal, False otherwise</returns>
+			inline bool operator==(const Iterator & other) const;
+
+			/// <summary>
+			/// Check if two Iterators are the equal. Two Iterators are equal if they belong to the same container and they point to the same item.
+			/// </summary>
+			/// <param name="other">The other Iterator to compare with</param>
+			/// <returns>True if two Iterators are not equal, False otherwise</returns>
+			inline bool operator!=(const Iterator & other) const;
+
+			/// <summary>
+			/// Get the reference of item pointed by the Iterator
+			/// </summary>
+			/// <returns>The reference of item pointed by the Iterator</returns>
+			/// <exception cref="std::exception">The Iterator points to nothing</exception>
+			T & operator*() const;
+
+		private:
+			/// <summary>
+			/// Construct an Iterator with parent vector and spcific index in the vector
+			/// </summary>
+			/// <param name="owner">Parent vector</param>
+			/// <param name="index">Index of item in the vector</param>
+			explicit Iterator(const SmallVector & owner, size_t index = 0);
+
+			/// <summary>
+			/// Parent vector, a free Iterator doesn't have parent so this value will be nullptr
+			/// </summary>
+			const SmallVector* mOwner = nullptr;
+
+			/// <summary>
+			/// The item index of this Iterator
+			/// </summary>
+			size_t mIndex = 0;
+
+			friend SmallVector;
+		};
+
+		/// <summary>
+		/// A ConstIterator is same as Iterator except that its operator*() only returns const reference, which disallows end-user to change the content
+		/// </summary>
+		class ConstIterator
+		{
+		public:
+			using value_type = T;
+			using pointer = const T*;
+			using reference = const T&;
+			using difference_type = std::ptrdiff_t;
+			using iterator_category = std::forward_iterator_tag;
+
+			/// <summary>
+			/// Default constructor, create an ConstIterator without parent and without a item to point to
+			/// </summary>
+			ConstIterator() = default;
+
+			/// <summary>
+			/// Copy constructor. Shallow copy the content in other Iterator to this one. Promote Iterator to ConstIterator
+			/// </summary>
+			/// <param name="other">The other Iterator to copy from</param>
+			ConstIterator(const Iterator & other);
+
+			/// <summary>
+			/// Pre-increment operator. Increment the ConstIterator to point to next item in the vector and return it
+			/// </summary>
+			/// <returns>The ConstIterator after increment</returns>
+			ConstIterator & operator++();
+
+			/// <summary>
+			/// Post-increment operator. Increment the ConstIterator to point to next item in the vector and return the copy of the original ConstIterator before copying
+			/// </summary>
+			/// <param name="">A signature parameter to tell this is a post increment</param>
+			/// <returns>The copy of ConstIterator before increment</returns>
+			ConstIterator operator++(int);
+
+			/// <summary>
+			/// Get the ConstIterator after moving current one by step items forward. This doesn't change original ConstIterator
+			/// </summary>
+			/// <param name="step">Number of items to move</param>
+			/// <returns>The ConstIterator after move</returns>
+			ConstIterator operator+(size_t step) const;
+
+			/// <summary>
+			/// Check if two ConstIterators are the equal. Two ConstIterators are equal if they belong to the same container and they point to the same item.
+			/// </summary>
+			/// <param name="other">The other ConstIterator to compare with</param>
+			/// <returns>True if two ConstIterators are equal, False otherwise</returns>
+			inline bool operator==(const ConstIterator & other) const;
+
+			/// <summary>
+			/// Check if two ConstIterators are the equal. Two ConstIterators are equal if they belong to the same container and they point to the same item.
+			/// </summary>
+			/// <param name="other">The other ConstIterator to compare with</param>
+			/// <returns>True if two ConstIterators are not equal, False otherwise</returns>
+			inline bool operator!=(const ConstIterator & other) const;
+
+			/// <summary>
+			/// Get the reference of item pointed by the ConstIterator in const form
+			/// </summary>
+			/// <returns>The reference of item pointed by the ConstIterator</returns>
+			/// <exception cref="std::exception">The ConstIterator points to nothing</exception>
+			const T & operator*() const;
+
+		private:
+			/// <summary>
+			/// Construct an ConstIterator with parent vector and spcific index in the vector
+			/// </summary>
+			/// <param name="owner">Parent vector</param>
+			/// <param name="index">Index of item in the vector</param>
+			explicit ConstIterator(const SmallVector & owner, size_t index = 0);
+
+			/// <summary>
+			/// Parent vector, a free ConstIterator doesn't have parent so this value will be nullptr
+			/// </summary>
+			const SmallVector* mOwner = nullptr;
+
+			/// <summary>
+			/// The item index of this ConstIterator
+			/// </summary>
+			size_t mIndex = 0;
+
+			friend SmallVector;
+		};
+
+		/// <summary>
+		/// Default constructor. Create an empty SmallVector that uses its inline storage
+		/// </summary>
+		SmallVector() = default;
+
+		/// <summary>
+		/// Copy constructor. Copy the contents from other SmallVector to this one
+		/// </summary>
+		/// <param name="other">The other SmallVector to copy from</param>
+		SmallVector(const SmallVector & other);
+
+		/// <summary>
+		/// Move constructor. Move the contents from other SmallVector to this one and leave other empty
+		/// </summary>
+		/// <param name="other">The other SmallVector to move from</param>
+		SmallVector(SmallVector && other);
+
+		/// <summary>
+		/// Initilizaer list constructor
+		/// </summary>
+		/// <param name="list">List of contents used to initilize SmallVector</param>
+		SmallVector(std::initializer_list<T> list);
+
+		/// <summary>
+		/// Desctructor, destroy all items and free heap memory if there is any
+		/// </summary>
+		~SmallVector();
+
+		/// <summary>
+		/// Copy assignment, copy the contents from other SmallVector to this one, clear any existing contents
+		/// </summary>
+		/// <param name="other">The other SmallVector to copy from</param>
+		/// <returns>This SmallVector after copy</returns>
+		SmallVector & operator=(const SmallVector & other);
+
+		/// <summary>
+		/// Move assignment, move the contents from other SmallVector to this one, clear any existing contents in this one and leave other empty
+		/// </summary>
+		/// <param name="other">The other SmallVector to move from</param>
+		/// <returns>This SmallVector after move</returns>
+		SmallVector & operator=(SmallVector && other);
+
+		/// <summary>
+		/// Get the reference to an item in the SmallVector at given index
+		/// </summary>
+		/// <param name="index">The index of item</param>
+		/// <returns>The reference to the item</returns>
+		/// <exception cref="std::exception">The index is out of range</exception>
+		T & operator[](size_t index);
+
+		/// <summary>
+		/// Get const the reference to an item in the SmallVector at given index
+		/// </summary>
+		/// <param name="index">The index of item</param>
+		/// <returns>The const reference to the item</returns>
+		/// <exception cref="std::exception">The index is out of range</exception>
+		const T & operator[](size_t index) const;
+
+		/// <summary>
+		/// Get the reference to the first item in the SmallVector
+		/// </summary>
+		/// <returns>The reference to the first item</returns>
+		/// <exception cref="std::exception">The SmallVector is empty</exception>
+		T & Front();
+
+		/// <summary>
+		/// Get the const reference to the first item in the SmallVector
+		/// </summary>
+		/// <returns>The const reference to the first item</returns>
+		/// <exception cref="std::exception">The SmallVector is empty</exception>
+		const T & Front() const;
+
+		/// <summary>
+		/// Get the reference to the last item in the SmallVector
+		/// </summary>
+		/// <returns>The reference to the last item</returns>
+		/// <exception cref="std::exception">The SmallVector is empty</exception>
+		T & Back();
+
+		/// <summary>
+		/// Get the const reference to the last item in the SmallVector
+		/// </summary>
+		/// <returns>The const reference to the last item</returns>
+		/// <exception cref="std::exception">The SmallVector is empty</exception>
+		const T & Back() const;
+
+		/// <summary>
+		/// Check is SmallVector is empty
+		/// </summary>
+		/// <returns>True if SmallVector is empty, False otherwise</returns>
+		inline bool IsEmpty() const;
+
+		/// <summary>
+		/// Get the number of items in the SmallVector, not the capacity
+		/// </summary>
+		/// <returns>The number of items in the SmallVector</returns>
+		inline size_t Size() const;
+
+		/// <summary>
+		/// Get the capacity of the SmallVector, which is never less than N
+		/// </summary>
+		/// <returns>The capacity of the SmallVector</returns>
+		inline size_t Capacity() const;
+
+		/// <summary>
+		/// Check if items are stored in the inline buffer rather than on the heap
+		/// </summary>
+		/// <returns>True if no heap memory is used, False otherwise</returns>
+		inline bool IsInline() const;
+
+		/// <summary>
+		/// Append an item to the end of SmallVector. Spill to the heap when inline storage is full
+		/// </summary>
+		/// <param name="data">The data to append</param>
+		/// <returns>The Iterator pointing to the newly appended item</returns>
+		Iterator PushBack(const T & data);
+
+		/// <summary>
+		/// Construct an item in place at the end of SmallVector. Spill to the heap when inline storage is full
+		/// </summary>
+		/// <param name="args">Arguments forwarded to the constructor of T</param>
+		/// <returns>The Iterator pointing to the newly constructed item</returns>
+		template <typename... Args>
+		Iterator EmplaceBack(Args&&... args);
+
+		/// <summary>
+		/// Remove the last item in the SmallVector and keep the capacity unchanged. This does nothing if SmallVector is empty
+		/// </summary>
+		void PopBack();
+
+		/// <summary>
+		/// Make room for given number of items. Do nothing if parameter is not larger than current capacity
+		/// </summary>
+		/// <param name="capacity">New capacity to reserve</param>
+		void Reserve(size_t capacity);
+
+		/// <summary>
+		/// Shrink heap memory so that capacity is same as size, or move items back to inline storage if they fit
+		/// </summary>
+		void ShrinkToFit();
+
+		/// <summary>
+		/// Remove all items in the SmallVector but keep the memory
+		/// </summary>
+		void Clear();
+
+		/// <summary>
+		/// Remove all items in the SmallVector, free heap memory and go back to inline storage
+		/// </summary>
+		void Destroy();
+
+		/// <summary>
+		/// Try to find the item equal to given data and return the Iterator pointing to it. Return end() if item is not found.
+		/// </summary>
+		/// <param name="data">The data to find</param>
+		/// <returns>The Iterator pointing to the found item. Or end() if item is not found</returns>
+		Iterator Find(const T & data);
+
+		/// <summary>
+		/// Try to find the item equal to given data and return the ConstIterator pointing to it. Return end() if item is not found.
+		/// </summary>
+		/// <param name="data">The data to find</param>
+		/// <returns>The ConstIterator pointing to the found item. Or end() if item is not found</returns>
+		ConstIterator Find(const T & data) const;
+
+		/// <summary>
+		/// Remove the first item equal to given data. If no such item is found, this function does nothing
+		/// </summary>
+		/// <param name="data">The data to remove</param>
+		void Remove(const T & data);
+
+		/// <summary>
+		/// Remove the item pointed by the given Iterator. If Iterator is end(), this function does nothing
+		/// </summary>
+		/// <param name="iterator">The Iterator pointing to item to be removed</param>
+		/// <exception cref="std::exception">The Iterator doesn't belong to this SmallVector</exception>
+		void Remove(const Iterator & iterator);
+
+		/// <summary>
+		/// Remove the items starting from begin[inclusive] to end[exclusive]
+		/// </summary>
+		/// <param name="begin">The Iterator pointing to the beginning item</param>
+		/// <param name="end">The Iterator pointing to the item after the last item to be removed</param>
+		/// <exception cref="std::exception">The Iterators don't belong to this SmallVector</exception>
+		void Remove(Iterator begin, Iterator end);
+
+		/// <summary>
+		/// Get the Iterator pointing to the first item of SmallVector
+		/// </summary>
+		/// <returns>Iterator pointing to the first item of SmallVector</returns>
+		Iterator begin();
+
+		/// <summary>
+		/// Get the ConstIterator pointing to the first item of SmallVector
+		/// </summary>
+		/// <returns>ConstIterator pointing to the first item of SmallVector</returns>
+		ConstIterator begin() const;
+
+		/// <summary>
+		/// Get the Iterator pointing to one item after the last item of SmallVector (i.e. not in the SmallVector)
+		/// </summary>
+		/// <returns>Iterator pointing to one item after the last item of SmallVector</returns>
+		Iterator end();
+
+		/// <summary>
+		/// Get the ConstIterator pointing to one item after the last item of SmallVector (i.e. not in the SmallVector)
+		/// </summary>
+		/// <returns>ConstIterator pointing to one item after the last item of SmallVector</returns>
+		ConstIterator end() const;
+
+		/// <summary>
+		/// Get the ConstIterator pointing to the first item of SmallVector
+		/// </summary>
+		/// <returns>ConstIterator pointing to the first item of SmallVector</returns>
+		ConstIterator cbegin() const;
+
+		/// <summary>
+		/// Get the ConstIterator pointing to one item after the last item of SmallVector
+		/// </summary>
+		/// <returns>ConstIterator pointing to one item after the last item of SmallVector</returns>
+		ConstIterator cend() const;
+
+		using value_type = T;
+		using size_type = size_t;
+		using difference_type = std::ptrdiff_t;
+		using reference = T&;
+		using const_reference = const T&;
+		using iterator = Iterator;
+		using const_iterator = ConstIterator;
+	};
+}
+
+#include "SmallVector.inl"
@@ -0,0 +1,500 @@
+#pragma once
+
+namespace GameEngine
+{
+	template <typename T, size_t N, typename ReserveStrategy>
+	SmallVector<T, N, ReserveStrategy>::SmallVector(const SmallVector & other)
+	{
+		DeepCopy(other);
+	}
+
+	template <typename T, size_t N, typename ReserveStrategy>
+	SmallVector<T, N, ReserveStrategy>::SmallVector(SmallVector && other)
+	{
+		MoveFrom(other);
+	}
+
+	template <typename T, size_t N, typename ReserveStrategy>
+	SmallVector<T, N, ReserveStrategy>::SmallVector(std::initializer_list<T> list)
+	{
+		Reserve(list.size());
+		for (const auto& item : list)
+		{
+			PushBack(item);
+		}
+	}
+
+	template <typename T, size_t N, typename ReserveStrategy>
+	SmallVector<T, N, ReserveStrategy>::~SmallVector()
+	{
+		Destroy();
+	}
+
+	template <typename T, size_t N, typename ReserveStrategy>
+	SmallVector<T, N, ReserveStrategy> & SmallVector<T, N, ReserveStrategy>::operator=(const SmallVector & other)
+	{
+		if (this != &other)
+		{
+			Clear();
+			DeepCopy(other);
+		}
+		return *this;
+	}
+
+	template <typename T, size_t N, typename ReserveStrategy>
+	SmallVector<T, N, ReserveStrategy> & SmallVector<T, N, ReserveStrategy>::operator=(SmallVector && other)
+	{
+		if (this != &other)
+		{
+			Destroy();
+			MoveFrom(other);
+		}
+		return *this;
+	}
+
+	template <typename T, size_t N, typename ReserveStrategy>
+	T & SmallVector<T, N, ReserveStrategy>::operator[](size_t index)
+	{
+		if (index < mSize)
+		{
+			return mArray[index];
+		}
+		else
+		{
+			throw std::exception("Index out of range!");
+		}
+	}
+
+	template <typename T, size_t N, typename ReserveStrategy>
+	const T & SmallVector<T, N, ReserveStrategy>::operator[](size_t index) const
+	{
+		return const_cast<SmallVector*>(this)->operator[](index);
+	}
+
+	template <typename T, size_t N, typename ReserveStrategy>
+	T & SmallVector<T, N, ReserveStrategy>::Front()
+	{
+		if (mSize > 0)
+		{
+			return mArray[0];
+		}
+		else
+		{
+			throw std::exception("Vector is empty!");
+		}
+	}
+
+	template <typename T, size_t N, typename ReserveStrategy>
+	const T & SmallVector<T, N, ReserveStrategy>::Front() const
+	{
+		return const_cast<SmallVector*>(this)->Front();
+	}
+
+	template <typename T, size_t N, typename ReserveStrategy>
+	T & SmallVector<T, N, ReserveStrategy>::Back()
+	{
+		if (mSize > 0)
+		{
+			return mArray[mSize - 1];
+		}
+		else
+		{
+			throw std::exception("Vector is empty!");
+		}
+	}
+
+	template <typename T, size_t N, typename ReserveStrategy>
+	const T & SmallVector<T, N, ReserveStrategy>::Back() const
+	{
+		return const_cast<SmallVector*>(this)->Back();
+	}
+
+	template <typename T, size_t N, typename ReserveStrategy>
+	bool SmallVector<T, N, ReserveStrategy>::IsEmpty() const
+	{
+		return mSize == 0;
+	}
+
+	template <typename T, size_t N, typename ReserveStrategy>
+	size_t SmallVector<T, N, ReserveStrategy>::Size() const
+	{
+		return mSize;
+	}
+
+	template <typename T, size_t N, typename ReserveStrategy>
+	size_t SmallVector<T, N, ReserveStrategy>::Capacity() const
+	{
+		return mCapacity;
+	}
+
+	template <typename T, size_t N, typename ReserveStrategy>
+	bool SmallVector<T, N, ReserveStrategy>::IsInline() const
+	{
+		return mArray == reinterpret_cast<const T*>(mBuffer);
+	}
+
+	template <typename T, size_t N, typename ReserveStrategy>
+	typename SmallVector<T, N, ReserveStrategy>::Iterator SmallVector<T, N, ReserveStrategy>::PushBack(const T & data)
+	{
+		return EmplaceBack(data);
+	}
+
+	template <typename T, size_t N, typename ReserveStrategy>
+	template <typename... Args>
+	typename SmallVector<T, N, ReserveStrategy>::Iterator SmallVector<T, N, ReserveStrategy>::EmplaceBack(Args&&... args)
+	{
+		// Spill to heap if necessary
+		if (mSize == mCapacity)
+		{
+			Reserve(std::max(mCapacity + 1, ReserveStrategy()(mSize, mCapacity)));
+		}
+
+		new(mArray + mSize) T(std::forward<Args>(args)...);
+		++mSize;
+
+		return Iterator(*this, mSize - 1);
+	}
+
+	template <typename T, size_t N, typename ReserveStrategy>
+	void SmallVector<T, N, ReserveStrategy>::PopBack()
+	{
+		if (mSize > 0)
+		{
+			mArray[mSize - 1].~T();
+			--mSize;
+		}
+	}
+
+	template <typename T, size_t N, typename ReserveStrategy>
+	void SmallVector<T, N, ReserveStrategy>::Reserve(size_t capacity)
+	{
+		if (capacity > mCapacity)
+		{
+			Reallocate(capacity);
+		}
+	}
+
+	template <typename T, size_t N, typename ReserveStrategy>
+	void SmallVector<T, N, ReserveStrategy>::ShrinkToFit()
+	{
+		if (!IsInline() && mSize < mCapacity)
+		{
+			Reallocate(mSize);
+		}
+	}
+
+	template <typename T, size_t N, typename ReserveStrategy>
+	void SmallVector<T, N, ReserveStrategy>::Clear()
+	{
+		while (mSize > 0)
+		{
+			PopBack();
+		}
+	}
+
+	template <typename T, size_t N, typename ReserveStrategy>
+	void SmallVector<T, N, ReserveStrategy>::Destroy()
+	{
+		Clear();
+		if (!IsInline())
+		{
+			free(mArray);
+			mArray = InlineBuffer();
+			mCapacity = N;
+		}
+	}
+
+	template <typename T, size_t N, typename ReserveStrategy>
+	typename SmallVector<T, N, ReserveStrategy>::Iterator SmallVector<T, N, ReserveStrategy>::Find(const T & data)
+	{
+		for (size_t i = 0; i < mSize; ++i)
+		{
+			if (mArray[i] == data)
+			{
+				return Iterator(*this, i);
+			}
+		}
+		return end();
+	}
+
+	template <typename T, size_t N, typename ReserveStrategy>
+	typename SmallVector<T, N, ReserveStrategy>::ConstIterator SmallVector<T, N, ReserveStrategy>::Find(const T & data) const
+	{
+		return ConstIterator(const_cast<SmallVector*>(this)->Find(data));
+	}
+
+	template <typename T, size_t N, typename ReserveStrategy>
+	void SmallVector<T, N, ReserveStrategy>::Remove(const T & data)
+	{
+		Remove(Find(data));
+	}
+
+	template <typename T, size_t N, typename ReserveStrategy>
+	void SmallVector<T, N, ReserveStrategy>::Remove(const Iterator & iterator)
+	{
+		Remove(iterator, iterator + 1);
+	}
+
+	template <typename T, size_t N, typename ReserveStrategy>
+	void SmallVector<T, N, ReserveStrategy>::Remove(Iterator begin, Iterator end)
+	{
+		if (begin.mOwner == this && begin.mOwner == end.mOwner)
+		{
+			// Handle backward range
+			if (begin.mIndex > end.mIndex)
+			{
+				std::swap(begin.mIndex, end.mIndex);
+			}
+
+			if (begin.mIndex < mSize)
+			{
+				// Make sure end index doesn't exceed size
+				end.mIndex = end.mIndex > mSize ? mSize : end.mIndex;
+
+				// Destruct objects
+				for (size_t i = begin.mIndex; i < end.mIndex; ++i)
+				{
+					mArray[i].~T();
+				}
+
+				// Fill gap
+				Relocate(mArray + begin.mIndex, mArray + end.mIndex, mSize - end.mIndex);
+
+				// Change size
+				mSize -= end.mIndex - begin.mIndex;
+			}
+		}
+		else
+		{
+			throw std::exception("begin and end iterator don't belong to the same vector or don't have owner!");
+		}
+	}
+
+	template <typename T, size_t N, typename ReserveStrategy>
+	typename SmallVector<T, N, ReserveStrategy>::Iterator SmallVector<T, N, ReserveStrategy>::begin()
+	{
+		return Iterator(*this, 0);
+	}
+
+	template <typename T, size_t N, typename ReserveStrategy>
+	typename SmallVector<T, N, ReserveStrategy>::ConstIterator SmallVector<T, N, ReserveStrategy>::begin() const
+	{
+		return ConstIterator(*this, 0);
+	}
+
+	template <typename T, size_t N, typename ReserveStrategy>
+	typename SmallVector<T, N, ReserveStrategy>::Iterator SmallVector<T, N, ReserveStrategy>::end()
+	{
+		return Iterator(*this, mSize);
+	}
+
+	template <typename T, size_t N, typename ReserveStrategy>
+	typename SmallVector<T, N, ReserveStrategy>::ConstIterator SmallVector<T, N, ReserveStrategy>::end() const
+	{
+		return ConstIterator(*this, mSize);
+	}
+
+	template <typename T, size_t N, typename ReserveStrategy>
+	typename SmallVector<T, N, ReserveStrategy>::ConstIterator SmallVector<T, N, ReserveStrategy>::cbegin() const
+	{
+		return ConstIterator(*this, 0);
+	}
+
+	template <typename T, size_t N, typename ReserveStrategy>
+	typename SmallVector<T, N, ReserveStrategy>::ConstIterator SmallVector<T, N, ReserveStrategy>::cend() const
+	{
+		return ConstIterator(*this, mSize);
+	}
+
+	template <typename T, size_t N, typename ReserveStrategy>
+	T* SmallVector<T, N, ReserveStrategy>::InlineBuffer()
+	{
+		return reinterpret_cast<T*>(mBuffer);
+	}
+
+	template <typename T, size_t N, typename ReserveStrategy>
+	void SmallVector<T, N, ReserveStrategy>::DeepCopy(const SmallVector & other)
+	{
+		Reserve(other.mSize);
+		for (size_t i = 0; i < other.mSize; ++i)
+		{
+			new(mArray + i) T(other.mArray[i]);
+		}
+		mSize = other.mSize;
+	}
+
+	template <typename T, size_t N, typename ReserveStrategy>
+	void SmallVector<T, N, ReserveStrategy>::MoveFrom(SmallVector & other)
+	{
+		if (other.IsInline())
+		{
+			// Inline items live inside other, so they have to be relocated one by one
+			Relocate(mArray, other.mArray, other.mSize);
+		}
+		else
+		{
+			mArray = other.mArray;
+			mCapacity = other.mCapacity;
+			other.mArray = other.InlineBuffer();
+			other.mCapacity = N;
+		}
+		mSize = other.mSize;
+		other.mSize = 0;
+	}
+
+	template <typename T, size_t N, typename ReserveStrategy>
+	void SmallVector<T, N, ReserveStrategy>::Reallocate(size_t capacity)
+	{
+		T* newArray = capacity <= N ? InlineBuffer() : reinterpret_cast<T*>(malloc(sizeof(T) * capacity));
+		if (newArray != mArray)
+		{
+			Relocate(newArray, mArray, mSize);
+			if (!IsInline())
+			{
+				free(mArray);
+			}
+			mArray = newArray;
+		}
+		mCapacity = std::max(capacity, N);
+	}
+
+#pragma region Iterator
+	template <typename T, size_t N, typename ReserveStrategy>
+	SmallVector<T, N, ReserveStrategy>::Iterator::Iterator(const SmallVector & owner, size_t index) :
+		mOwner(&owner),
+		mIndex(index)
+	{}
+
+	template <typename T, size_t N, typename ReserveStrategy>
+	typename SmallVector<T, N, ReserveStrategy>::Iterator & SmallVector<T, N, ReserveStrategy>::Iterator::operator++()
+	{
+		if (mOwner == nullptr)
+		{
+			throw std::exception("Try to increment uninitialized iterator");
+		}
+
+		if (mIndex < mOwner->mSize)
+		{
+			++mIndex;
+		}
+		return *this;
+	}
+
+	template <typename T, size_t N, typename ReserveStrategy>
+	typename SmallVector<T, N, ReserveStrategy>::Iterator SmallVector<T, N, ReserveStrategy>::Iterator::operator++(int)
+	{
+		Iterator copy = *this;
+		operator++();
+		return copy;
+	}
+
+	template <typename T, size_t N, typename ReserveStrategy>
+	typename SmallVector<T, N, ReserveStrategy>::Iterator SmallVector<T, N, ReserveStrategy>::Iterator::operator+(size_t step) const
+	{
+		if (mOwner == nullptr)
+		{
+			throw std::exception("Try to increment uninitialized iterator");
+		}
+
+		size_t newIndex = std::min(mIndex + step, mOwner->mSize);
+		return Iterator(*mOwner, newIndex);
+	}
+
+	template <typename T, size_t N, typename ReserveStrategy>
+	bool SmallVector<T, N, ReserveStrategy>::Iterator::operator==(const Iterator & other) const
+	{
+		return (mOwner == other.mOwner && mIndex == other.mIndex);
+	}
+
+	template <typename T, size_t N, typename ReserveStrategy>
+	bool SmallVector<T, N, ReserveStrategy>::Iterator::operator!=(const Iterator & other) const
+	{
+		return !operator==(other);
+	}
+
+	template <typename T, size_t N, typename ReserveStrategy>
+	T & SmallVector<T, N, ReserveStrategy>::Iterator::operator*() const
+	{
+		if (mOwner != nullptr && mOwner->mSize > mIndex)
+		{
+			return mOwner->mArray[mIndex];
+		}
+		else
+		{
+			throw std::exception("Try to dereference an iterator pointing to invalid data!");
+		}
+	}
+
+	template <typename T, size_t N, typename ReserveStrategy>
+	SmallVector<T, N, ReserveStrategy>::ConstIterator::ConstIterator(const SmallVector & owner, size_t index) :
+		mOwner(&owner),
+		mIndex(index)
+	{}
+
+	template <typename T, size_t N, typename ReserveStrategy>
+	SmallVector<T, N, ReserveStrategy>::ConstIterator::ConstIterator(const Iterator & other) :
+		mOwner(other.mOwner),
+		mIndex(other.mIndex)
+	{}
+
+	template <typename T, size_t N, typename ReserveStrategy>
+	typename SmallVector<T, N, ReserveStrategy>::ConstIterator & SmallVector<T, N, ReserveStrategy>::ConstIterator::operator++()
+	{
+		if (mOwner == nullptr)
+		{
+			throw std::exception("Try to increment uninitialized iterator");
+		}
+
+		if (mIndex < mOwner->mSize)
+		{
+			++mIndex;
+		}
+		return *this;
+	}
+
+	template <typename T, size_t N, typename ReserveStrategy>
+	typename SmallVector<T, N, ReserveStrategy>::ConstIterator SmallVector<T, N, ReserveStrategy>::ConstIterator::operator++(int)
+	{
+		ConstIterator copy = *this;
+		operator++();
+		return copy;
+	}
+
+	template <typename T, size_t N, typename ReserveStrategy>
+	typename SmallVector<T, N, ReserveStrategy>::ConstIterator SmallVector<T, N, ReserveStrategy>::ConstIterator::operator+(size_t step) const
+	{
+		if (mOwner == nullptr)
+		{
+			throw std::exception("Try to increment uninitialized iterator");
+		}
+
+		size_t newIndex = std::min(mIndex + step, mOwner->mSize);
+		return ConstIterator(*mOwner, newIndex);
+	}
+
+	template <typename T, size_t N, typename ReserveStrategy>
+	bool SmallVector<T, N, ReserveStrategy>::ConstIterator::operator==(const ConstIterator & other) const
+	{
+		return (mOwner == other.mOwner && mIndex == other.mIndex);
+	}
+
+	template <typename T, size_t N, typename ReserveStrategy>
+	bool SmallVector<T, N, ReserveStrategy>::ConstIterator::operator!=(const ConstIterator & other) const
+	{
+		return !operator==(other);
+	}
+
+	template <typename T, size_t N, typename ReserveStrategy>
+	const T & SmallVector<T, N, ReserveStrategy>::ConstIterator::operator*() const
+	{
+		if (mOwner != nullptr && mOwner->mSize > mIndex)
+		{
+			return mOwner->mArray[mIndex];
+		}
+		else
+		{
+			throw std::exception("Try to dereference an iterator pointing to invalid data!");
+		}
+	}
+#pragma endregion
+}
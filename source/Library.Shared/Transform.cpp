@@ -10,11 +10,14 @@ void Transform::SetParent(Transform* parent)
 	{
 		if (mParent != nullptr)
 		{
-			mParent->mChildren.erase(std::find(mParent->mChildren.begin(), mParent->mChildren.end(), this));
+			mParent->mChildren.Remove(this);
 		}
 
 		mParent = parent;
-		mParent->mChildren.emplace_back(this);
+		if (mParent != nullptr)
+		{
+			mParent->mChildren.PushBack(this);
+		}
 		mWorldPositionDirty = true;
 		mWorldRotationDirty = true;
 		mWorldScaleDirty = true;
@@ -377,11 +380,11 @@ void Transform::UpdateMatrix()
 
 void Transform::AddTransformUpdateCallback(UpdateCallback callback)
 {
-	mCallbacks.push_back(callback);
+	mCallbacks.PushBack(callback);
 }
 
 void Transform::RemoveTransformUpdateCallback(UpdateCallback callback)
 {
 	auto it = std::find_if(mCallbacks.begin(), mCallbacks.end(), [&callback](const UpdateCallback& c) { return c.target_type() == callback.target_type(); });
-	mCallbacks.erase(it);
+	mCallbacks.Remove(it);
 }
@@ -4,6 +4,7 @@
 #include "Matrix.h"
 #include "Vector4.h"
 #include "Quaternion.h"
+#include "SmallVector.h"
 
 namespace GameEngine
 {
@@ -103,8 +104,8 @@ namespace GameEngine
 		inline bool TransformDirty() const;
 		inline void UpdateMatrix();
 
-		Transform* mParent;
-		std::vector<Transform*> mChildren;
+		Transform* mParent = nullptr;
+		SmallVector<Transform*, 4> mChildren;
 		Matrix mWorldMatrix;
 		Matrix mWorldMatrixInverse;
 		Matrix mLocalMatrix;
@@ -125,6 +126,6 @@ namespace GameEngine
 		bool mWorldRotationDirty = false;
 		bool mWorldScaleDirty = false;
 
-		std::vector<UpdateCallback> mCallbacks;
+		SmallVector<UpdateCallback, 2> mCallbacks;
 	};
 }
@@ -20,6 +20,7 @@ World::World(const GameTime& time) :
 	Append(SECTOR_TABLE_KEY);
 	Append(ACTION_TABLE_KEY);
 	Append(ENTITY_TABLE_KEY);
+	CreateArena();
 	//assert(mDatumPointers[SECTOR_TABLE_INDEX]->first == SECTOR_TABLE_KEY);
 	//assert(mDatumPointers[ACTION_TABLE_INDEX]->first == ACTION_TABLE_KEY);
 	//assert(mDatumPointers[ENTITY_TABLE_INDEX]->first == ENTITY_TABLE_KEY);
@@ -33,6 +34,7 @@ const std::string& World::Name() const
 void World::SetName(const std::string& name)
 {
 	mName = name;
+	MarkAttributeChanged("Name");
 }
 
 Datum& World::Sectors()
@@ -47,6 +49,7 @@ const Datum& World::Sectors() const
 
 Sector* World::CreateSector(const std::string& name)
 {
+	ArenaGuard guard(GetArena());
 	Sector* sector = new Sector();
 	sector->SetName(name);
 	sector->SetWorld(*this);
@@ -141,19 +144,20 @@ void World::Update(WorldState& state)
 	// Dispatch events
 	mEventQueue.Update();
 
-	// Destroy objects
+	// Destroy objects, taking them out of their parents together so each table is compacted once
+	Vector<Scope*> destroyed(mDestroyQueue.Size());
 	for (const auto& object : mDestroyQueue)
 	{
 		if (object != nullptr)
 		{
-			Scope* parent = object->GetParent();
-			if (parent != nullptr)
-			{
-				parent->Orphan(*object);
-			}
-			delete object;
+			destroyed.PushBack(object);
 		}
 	}
+	Scope::OrphanAll(destroyed);
+	for (Scope* object : destroyed)
+	{
+		delete object;
+	}
 	mDestroyQueue.Clear();
 }
 
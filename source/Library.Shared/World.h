@@ -13,7 +13,8 @@ namespace GameEngine
 
 	CLASS(NoLuaAuthority);
 	/// <summary>
-	/// A World is the container for all objects in the game. It contains many sectors and will update each one of them in each tick
+	/// A World is the container for all objects in the game. It contains many sectors and will update each one of them in each tick.
+	/// A World owns an arena, objects it creates and scopes parsed into it are allocated together and released at once when the World is destroyed
 	/// </summary>
 	class World final : public Attributed
 	{
@@ -5,16 +5,57 @@
 
 #include <initializer_list>
 #include <cstddef>
+#include <cstdlib>
+#include <cstring>
 #include <functional>
+#include <memory>
+#include <type_traits>
 #include <algorithm>
 
 namespace GameEngine
 {
 	/// <summary>
-	/// Vector is a dynamic array that behaves almost the same as regular array except that its size can change dynamically based on the number of items in it.
-	/// In Vector size means number of existing items, and capacity means current possible number of items
+	/// Default reserve strategy of Vector. Start with 8 slots and double the capacity until it can hold one more item
+	/// </summary>
+	struct DefaultReserveStrategy
+	{
+		inline size_t operator()(size_t size, size_t capacity) const;
+	};
+
+	/// <summary>
+	/// Tell whether an object of type T can be moved to another address with a plain memory copy, leaving nothing to destruct at the old address.
+	/// Trivially copyable types always qualify. Specialize this trait to opt other types in (e.g. smart pointers that hold no pointer to themselves)
 	/// </summary>
 	template <typename T>
+	struct IsTriviallyRelocatable : std::is_trivially_copyable<T> {};
+
+	template <typename T>
+	struct IsTriviallyRelocatable<std::shared_ptr<T>> : std::true_type {};
+
+	template <typename T>
+	struct IsTriviallyRelocatable<std::weak_ptr<T>> : std::true_type {};
+
+	template <typename T, typename Deleter>
+	struct IsTriviallyRelocatable<std::unique_ptr<T, Deleter>> : IsTriviallyRelocatable<Deleter> {};
+
+	/// <summary>
+	/// Relocate count items from source to destination, leaving source slots unconstructed.
+	/// Destination must not be after source if two ranges overlap. Nothing happens if they are the same range.
+	/// Trivially relocatable items are moved with one memmove, others are move-constructed and destructed one by one
+	/// </summary>
+	/// <param name="destination">Address of the first unconstructed destination slot</param>
+	/// <param name="source">Address of the first item to relocate</param>
+	/// <param name="count">Number of items to relocate</param>
+	template <typename T>
+	inline void Relocate(T* destination, T* source, size_t count);
+
+	/// <summary>
+	/// Vector is a dynamic array that behaves almost the same as regular array except that its size can change dynamically based on the number of items in it.
+	/// In Vector size means number of existing items, and capacity means current possible number of items.
+	/// ReserveStrategy is a default-constructible functor size_t(size_t size, size_t capacity) that decides new capacity when the vector needs to grow.
+	/// It is resolved at compile time, so it costs neither storage nor an indirect call.
+	/// </summary>
+	template <typename T, typename ReserveStrategy = DefaultReserveStrategy>
 	class Vector
 	{
 	private:
@@ -40,17 +81,10 @@ namespace GameEngine
 		void DeepCopy(const Vector & other);
 
 		/// <summary>
-		/// Default functor for reserve strategy
+		/// Change the length of mArray to given capacity, which must be no less than size. Existing items are relocated to the new memory
 		/// </summary>
-		struct DefaultReserveFunction
-		{
-			size_t operator()(size_t size, size_t capacity) const;
-		};
-
-		/// <summary>
-		/// Reserve strategy function, vector uses this to decide new capacity when it needs to grow
-		/// </summary>
-		std::function<size_t(size_t, size_t)> mReserveFunction { DefaultReserveFunction() };
+		/// <param name="capacity">New capacity of the array</param>
+		void Reallocate(size_t capacity);
 
 	public:
 		/// <summary>
@@ -67,7 +101,12 @@ namespace GameEngine
 			using pointer = T*;
 			using reference = T&;
 			using difference_type = std::ptrdiff_t;
-			using iterator_category = std::forward_iterator_tag;
+			using iterator_category = std::random_access_iterator_tag;
+
+			/// <summary>
+			/// Tell MSVC standard library that this Iterator can be unwrapped to a raw pointer inside algorithms
+			/// </summary>
+			using _Prevent_inheriting_unwrap = Iterator;
 
 			/// <summary>
 			/// Default constructor, create an Iterator without parent and without a item to point to
@@ -119,11 +158,64 @@ namespace GameEngine
 			Iterator operator++(int);
 
 			/// <summary>
-			/// Get the Iterator after moving current one by step items forward. This doesn't change original Iterator
+			/// Pre-decrement operator. Decrement the Iterator to point to previous item in the vector and return it
+			/// </summary>
+			/// <returns>The Iterator after decrement</returns>
+			Iterator & operator--();
+
+			/// <summary>
+			/// Post-decrement operator. Decrement the Iterator to point to previous item in the vector and return the copy of the original Iterator before decrement
+			/// </summary>
+			/// <param name="">A signature parameter to tell this is a post decrement</param>
+			/// <returns>The copy of Iterator before decrement</returns>
+			Iterator operator--(int);
+
+			/// <summary>
+			/// Move the Iterator by step items. The result is clamped between begin and end of the vector
+			/// </summary>
+			/// <param name="step">Number of items to move, negative to move backward</param>
+			/// <returns>This Iterator after move</returns>
+			Iterator & operator+=(difference_type step);
+
+			/// <summary>
+			/// Move the Iterator backward by step items. The result is clamped between begin and end of the vector
 			/// </summary>
-			/// <param name="step">Number of items to move</param>
+			/// <param name="step">Number of items to move, negative to move forward</param>
+			/// <returns>This Iterator after move</returns>
+			Iterator & operator-=(difference_type step);
+
+			/// <summary>
+			/// Get the Iterator after moving current one by step items. This doesn't change original Iterator
+			/// </summary>
+			/// <param name="step">Number of items to move, negative to move backward</param>
+			/// <returns>The Iterator after move</returns>
+			Iterator operator+(difference_type step) const;
+
+			/// <summary>
+			/// Get the Iterator after moving current one backward by step items. This doesn't change original Iterator
+			/// </summary>
+			/// <param name="step">Number of items to move, negative to move forward</param>
+			/// <returns>The Iterator after move</returns>
+			Iterator operator-(difference_type step) const;
+
+			/// <summary>
+			/// Get the number of items between two Iterators of the same vector
+			/// </summary>
+			/// <param name="other">The other Iterator to measure from</param>
+			/// <returns>Number of items from other to this Iterator</returns>
+			/// <exception cref="std::exception">Two Iterators belong to different vectors</exception>
+			difference_type operator-(const Iterator & other) const;
+
+			/// <summary>
+			/// Get the Iterator after moving given one by step items
+			/// </summary>
+			/// <param name="step">Number of items to move, negative to move backward</param>
+			/// <param name="iterator">The Iterator to move from</param>
 			/// <returns>The Iterator after move</returns>
-			Iterator operator+(size_t step) const;
+			friend Iterator operator+(difference_type step, const Iterator & iterator)
+			{
+				return iterator + step;
+			}
 
 			/// <summary>
 			/// Check if two Iterators are the equal. Two Iterators are equal if they belong to the same container and they point to the same item.
@@ -141,19 +233,71 @@ namespace GameEngine
 			/// <returns>True if two Iterators are not equal, False otherwise</returns>
 			inline bool operator!=(const Iterator & other) const;
 
+			/// <summary>
+			/// Check if this Iterator points to an item before the other one in the same vector
+			/// </summary>
+			/// <param name="other">The other Iterator to compare with</param>
+			/// <returns>True if this Iterator is before the other one, False otherwise</returns>
+			/// <exception cref="std::exception">Two Iterators belong to different vectors</exception>
+			bool operator<(const Iterator & other) const;
+
+			/// <summary>
+			/// Check if this Iterator points to an item after the other one in the same vector
+			/// </summary>
+			/// <param name="other">The other Iterator to compare with</param>
+			/// <returns>True if this Iterator is after the other one, False otherwise</returns>
+			/// <exception cref="std::exception">Two Iterators belong to different vectors</exception>
+			bool operator>(const Iterator & other) const;
+
+			/// <summary>
+			/// Check if this Iterator points to an item before or at the other one in the same vector
+			/// </summary>
+			/// <param name="other">The other Iterator to compare with</param>
+			/// <returns>True if this Iterator is not after the other one, False otherwise</returns>
+			/// <exception cref="std::exception">Two Iterators belong to different vectors</exception>
+			bool operator<=(const Iterator & other) const;
+
+			/// <summary>
+			/// Check if this Iterator points to an item after or at the other one in the same vector
+			/// </summary>
+			/// <param name="other">The other Iterator to compare with</param>
+			/// <returns>True if this Iterator is not before the other one, False otherwise</returns>
+			/// <exception cref="std::exception">Two Iterators belong to different vectors</exception>
+			bool operator>=(const Iterator & other) const;
+
 			/// <summary>
 			/// Get the reference of item pointed by the Iterator
 			/// </summary>
 			/// <returns>The reference of item pointed by the Iterator</returns>
 			/// <exception cref="std::exception">The Iterator points to nothing</exception>
-			T & operator*();
+			T & operator*() const;
 
 			/// <summary>
-			/// Get the reference of item pointed by the Iterator
+			/// Get the pointer to item pointed by the Iterator
 			/// </summary>
-			/// <returns>The reference of item pointed by the Iterator</returns>
+			/// <returns>The pointer to item pointed by the Iterator</returns>
 			/// <exception cref="std::exception">The Iterator points to nothing</exception>
-			const T & operator*() const;
+			T* operator->() const;
+
+			/// <summary>
+			/// Get the reference of item at given offset from the Iterator
+			/// </summary>
+			/// <param name="offset">Offset from the item pointed by the Iterator</param>
+			/// <returns>The reference of item at given offset</returns>
+			/// <exception cref="std::exception">The offset points to nothing</exception>
+			T & operator[](difference_type offset) const;
+
+			/// <summary>
+			/// Get the raw pointer to the item, used by MSVC standard library to run algorithms without per-item checks
+			/// </summary>
+			/// <returns>Address of the item in the contiguous storage of vector</returns>
+			T* _Unwrapped() const;
+
+			/// <summary>
+			/// Point the Iterator to the item at given raw pointer, used by MSVC standard library after running an algorithm on raw pointers
+			/// </summary>
+			/// <param name="pointer">Address of an item in the contiguous storage of vector</param>
+			void _Seek_to(const T* pointer);
 
 		private:
 			/// <summary>
@@ -183,10 +327,15 @@ namespace GameEngine
 		{
 		public:
 			using value_type = T;
-			using pointer = T * ;
-			using reference = T & ;
+			using pointer = const T*;
+			using reference = const T&;
 			using difference_type = std::ptrdiff_t;
-			using iterator_category = std::forward_iterator_tag;
+			using iterator_category = std::random_access_iterator_tag;
+
+			/// <summary>
+			/// Tell MSVC standard library that this ConstIterator can be unwrapped to a raw pointer inside algorithms
+			/// </summary>
+			using _Prevent_inheriting_unwrap = ConstIterator;
 
 			/// <summary>
 			/// Default constructor, create an ConstIterator without parent and without a item to point to
@@ -251,11 +400,64 @@ namespace GameEngine
 			ConstIterator operator++(int);
 
 			/// <summary>
-			/// Get the ConstIterator after moving current one by step items forward. This doesn't change original ConstIterator
+			/// Pre-decrement operator. Decrement the ConstIterator to point to previous item in the vector and return it
 			/// </summary>
-			/// <param name="step">Number of items to move</param>
+			/// <returns>The ConstIterator after decrement</returns>
+			ConstIterator & operator--();
+
+			/// <summary>
+			/// Post-decrement operator. Decrement the ConstIterator to point to previous item in the vector and return the copy of the original ConstIterator before decrement
+			/// </summary>
+			/// <param name="">A signature parameter to tell this is a post decrement</param>
+			/// <returns>The copy of ConstIterator before decrement</returns>
+			ConstIterator operator--(int);
+
+			/// <summary>
+			/// Move the ConstIterator by step items. The result is clamped between begin and end of the vector
+			/// </summary>
+			/// <param name="step">Number of items to move, negative to move backward</param>
+			/// <returns>This ConstIterator after move</returns>
+			ConstIterator & operator+=(difference_type step);
+
+			/// <summary>
+			/// Move the ConstIterator backward by step items. The result is clamped between begin and end of the vector
+			/// </summary>
+			/// <param name="step">Number of items to move, negative to move forward</param>
+			/// <returns>This ConstIterator after move</returns>
+			ConstIterator & operator-=(difference_type step);
+
+			/// <summary>
+			/// Get the ConstIterator after moving current one by step items. This doesn't change original ConstIterator
+			/// </summary>
+			/// <param name="step">Number of items to move, negative to move backward</param>
+			/// <returns>The ConstIterator after move</returns>
+			ConstIterator operator+(difference_type step) const;
+
+			/// <summary>
+			/// Get the ConstIterator after moving current one backward by step items. This doesn't change original ConstIterator
+			/// </summary>
+			/// <param name="step">Number of items to move, negative to move forward</param>
 			/// <returns>The ConstIterator after move</returns>
-			ConstIterator operator+(size_t step);
+			ConstIterator operator-(difference_type step) const;
+
+			/// <summary>
+			/// Get the number of items between two ConstIterators of the same vector
+			/// </summary>
+			/// <param name="other">The other ConstIterator to measure from</param>
+			/// <returns>Number of items from other to this ConstIterator</returns>
+			/// <exception cref="std::exception">Two ConstIterators belong to different vectors</exception>
+			difference_type operator-(const ConstIterator & other) const;
+
+			/// <summary>
+			/// Get the ConstIterator after moving given one by step items
+			/// </summary>
+			/// <param name="step">Number of items to move, negative to move backward</param>
+			/// <param name="iterator">The ConstIterator to move from</param>
+			/// <returns>The ConstIterator after move</returns>
+			friend ConstIterator operator+(difference_type step, const ConstIterator & iterator)
+			{
+				return iterator + step;
+			}
 
 			/// <summary>
 			/// Check if two ConstIterators are the equal. Two ConstIterators are equal if they belong to the same container and they point to the same item.
@@ -273,6 +475,38 @@ namespace GameEngine
 			/// <returns>True if two ConstIterators are equal, False otherwise</returns>
 			inline bool operator!=(const ConstIterator & other) const;
 
+			/// <summary>
+			/// Check if this ConstIterator points to an item before the other one in the same vector
+			/// </summary>
+			/// <param name="other">The other ConstIterator to compare with</param>
+			/// <returns>True if this ConstIterator is before the other one, False otherwise</returns>
+			/// <exception cref="std::exception">Two ConstIterators belong to different vectors</exception>
+			bool operator<(const ConstIterator & other) const;
+
+			/// <summary>
+			/// Check if this ConstIterator points to an item after the other one in the same vector
+			/// </summary>
+			/// <param name="other">The other ConstIterator to compare with</param>
+			/// <returns>True if this ConstIterator is after the other one, False otherwise</returns>
+			/// <exception cref="std::exception">Two ConstIterators belong to different vectors</exception>
+			bool operator>(const ConstIterator & other) const;
+
+			/// <summary>
+			/// Check if this ConstIterator points to an item before or at the other one in the same vector
+			/// </summary>
+			/// <param name="other">The other ConstIterator to compare with</param>
+			/// <returns>True if this ConstIterator is not after the other one, False otherwise</returns>
+			/// <exception cref="std::exception">Two ConstIterators belong to different vectors</exception>
+			bool operator<=(const ConstIterator & other) const;
+
+			/// <summary>
+			/// Check if this ConstIterator points to an item after or at the other one in the same vector
+			/// </summary>
+			/// <param name="other">The other ConstIterator to compare with</param>
+			/// <returns>True if this ConstIterator is not before the other one, False otherwise</returns>
+			/// <exception cref="std::exception">Two ConstIterators belong to different vectors</exception>
+			bool operator>=(const ConstIterator & other) const;
+
 			/// <summary>
 			/// Get the reference of item pointed by the ConstIterator in const form
 			/// </summary>
@@ -280,6 +514,33 @@ namespace GameEngine
 			/// <exception cref="std::exception">The ConstIterator points to nothing</exception>
 			const T & operator*() const;
 
+			/// <summary>
+			/// Get the pointer to item pointed by the ConstIterator in const form
+			/// </summary>
+			/// <returns>The pointer to item pointed by the ConstIterator</returns>
+			/// <exception cref="std::exception">The ConstIterator points to nothing</exception>
+			const T* operator->() const;
+
+			/// <summary>
+			/// Get the reference of item at given offset from the ConstIterator in const form
+			/// </summary>
+			/// <param name="offset">Offset from the item pointed by the ConstIterator</param>
+			/// <returns>The reference of item at given offset</returns>
+			/// <exception cref="std::exception">The offset points to nothing</exception>
+			const T & operator[](difference_type offset) const;
+
+			/// <summary>
+			/// Get the raw pointer to the item, used by MSVC standard library to run algorithms without per-item checks
+			/// </summary>
+			/// <returns>Address of the item in the contiguous storage of vector</returns>
+			const T* _Unwrapped() const;
+
+			/// <summary>
+			/// Point the ConstIterator to the item at given raw pointer, used by MSVC standard library after running an algorithm on raw pointers
+			/// </summary>
+			/// <param name="pointer">Address of an item in the contiguous storage of vector</param>
+			void _Seek_to(const T* pointer);
+
 		private:
 			/// <summary>
 			/// Construct an ConstIterator with parent list and spcific node in the vector
@@ -303,11 +564,10 @@ namespace GameEngine
 		};
 
 		/// <summary>
-		/// Default constructor. Create an empty Vector with given capacity (default = 0) and given reserve function (default is to double capacity every time)
+		/// Default constructor. Create an empty Vector with given capacity (default = 0)
 		/// </summary>
 		/// <param name="capacity">The capaicty to reserve on construction</param>
-		/// <param name="reserveFunc">Reserve function used to decide new capacity when the vector needs to grow</param>
-		explicit Vector(size_t capacity = 0, std::function<size_t(size_t, size_t)> reserveFunc = DefaultReserveFunction());
+		explicit Vector(size_t capacity = 0);
 
 		/// <summary>
 		/// Copy constructor. Copy the contents from other Vector to this one, clear any existing contents
@@ -325,8 +585,7 @@ namespace GameEngine
 		/// Initilizaer list constructor. Will set both size and capacity to list length
 		/// </summary>
 		/// <param name="list">List of contents used to initilize Vector</param>
-		/// <param name="reserveFunc">Reserve function used to decide new capacity when the vector needs to grow</param>
-		Vector(std::initializer_list<T> list, std::function<size_t(size_t, size_t)> reserveFunc = DefaultReserveFunction());
+		Vector(std::initializer_list<T> list);
 
 		/// <summary>
 		/// Desctructor, destroy all items and free memory
@@ -379,6 +638,18 @@ namespace GameEngine
 		/// /// <exception cref="std::exception">The index is out of range</exception>
 		const T & At(size_t index) const;
 
+		/// <summary>
+		/// Get the pointer to the contiguous storage of items. Items from Data() to Data() + Size() are valid until the Vector is reallocated
+		/// </summary>
+		/// <returns>Pointer to the first item, nullptr if nothing has been reserved</returns>
+		T* Data();
+
+		/// <summary>
+		/// Get the pointer to the contiguous storage of items in const form. Items from Data() to Data() + Size() are valid until the Vector is reallocated
+		/// </summary>
+		/// <returns>Pointer to the first item, nullptr if nothing has been reserved</returns>
+		const T* Data() const;
+
 		/// <summary>
 		/// Get the reference to the first item in the Vector
 		/// </summary>
@@ -547,6 +818,12 @@ namespace GameEngine
 		using iterator = Iterator;
 		using const_iterator = ConstIterator;
 	};
+
+	/// <summary>
+	/// Vector only owns a heap pointer, so moving a Vector itself never needs to touch its items
+	/// </summary>
+	template <typename T, typename ReserveStrategy>
+	struct IsTriviallyRelocatable<Vector<T, ReserveStrategy>> : std::true_type {};
 }
 
 #include "vector.inl"
\ No newline at end of file
@@ -2,34 +2,63 @@
 
 namespace GameEngine
 {
+	size_t DefaultReserveStrategy::operator()(size_t size, size_t capacity) const
+	{
+		size_t currentCapacity = capacity == 0 ? 8 : capacity;
+		while (currentCapacity <= size)
+		{
+			currentCapacity *= 2;
+		}
+		return currentCapacity;
+	}
+
 	template <typename T>
-	Vector<T>::Vector(size_t capacity, std::function<size_t(size_t, size_t)> reserveFunc) :
-		mReserveFunction(reserveFunc)
+	void Relocate(T* destination, T* source, size_t count)
+	{
+		if (destination == source || count == 0)
+		{
+			return;
+		}
+
+		if constexpr (IsTriviallyRelocatable<T>::value)
+		{
+			memmove(destination, source, sizeof(T) * count);
+		}
+		else
+		{
+			for (size_t i = 0; i < count; ++i)
+			{
+				new(destination + i) T(std::move(source[i]));
+				source[i].~T();
+			}
+		}
+	}
+
+	template <typename T, typename ReserveStrategy>
+	Vector<T, ReserveStrategy>::Vector(size_t capacity)
 	{
 		Reserve(capacity);
 	}
 
-	template <typename T>
-	Vector<T>::Vector(const Vector & other)
+	template <typename T, typename ReserveStrategy>
+	Vector<T, ReserveStrategy>::Vector(const Vector & other)
 	{
 		DeepCopy(other);
 	}
 
-	template <typename T>
-	Vector<T>::Vector(Vector && other) :
+	template <typename T, typename ReserveStrategy>
+	Vector<T, ReserveStrategy>::Vector(Vector && other) :
 		mSize(other.mSize),
 		mCapacity(other.mCapacity),
-		mArray(other.mArray),
-		mReserveFunction(other.mReserveFunction)
+		mArray(other.mArray)
 	{
 		other.mCapacity = 0;
 		other.mSize = 0;
 		other.mArray = nullptr;
 	}
 
-	template <typename T>
-	Vector<T>::Vector(std::initializer_list<T> list, std::function<size_t(size_t, size_t)> reserveFunc) :
-		mReserveFunction(reserveFunc)
+	template <typename T, typename ReserveStrategy>
+	Vector<T, ReserveStrategy>::Vector(std::initializer_list<T> list)
 	{
 		Reserve(list.size());
 		for (const auto& item : list)
@@ -38,14 +67,14 @@ namespace GameEngine
 		}
 	}
 
-	template <typename T>
-	Vector<T>::~Vector()
+	template <typename T, typename ReserveStrategy>
+	Vector<T, ReserveStrategy>::~Vector()
 	{
 		Destroy();
 	}
 
-	template <typename T>
-	Vector<T> & Vector<T>::operator=(const Vector & other)
+	template <typename T, typename ReserveStrategy>
+	Vector<T, ReserveStrategy> & Vector<T, ReserveStrategy>::operator=(const Vector & other)
 	{
 		if (this != &other)
 		{
@@ -55,8 +84,8 @@ namespace GameEngine
 		return *this;
 	}
 
-	template <typename T>
-	Vector<T> & Vector<T>::operator=(Vector && other)
+	template <typename T, typename ReserveStrategy>
+	Vector<T, ReserveStrategy> & Vector<T, ReserveStrategy>::operator=(Vector && other)
 	{
 		if (this != &other)
 		{
@@ -64,7 +93,6 @@ namespace GameEngine
 			mSize = other.mSize;
 			mCapacity = other.mCapacity;
 			mArray = other.mArray;
-			mReserveFunction = other.mReserveFunction;
 			other.mSize = 0;
 			other.mCapacity = 0;
 			other.mArray = nullptr;
@@ -72,8 +100,8 @@ namespace GameEngine
 		return *this;
 	}
 
-	template <typename T>
-	T & Vector<T>::operator[](size_t index)
+	template <typename T, typename ReserveStrategy>
+	T & Vector<T, ReserveStrategy>::operator[](size_t index)
 	{
 		if (index < mSize)
 		{
@@ -85,26 +113,38 @@ namespace GameEngine
 		}
 	}
 
-	template <typename T>
-	const T & Vector<T>::operator[](size_t index) const
+	template <typename T, typename ReserveStrategy>
+	const T & Vector<T, ReserveStrategy>::operator[](size_t index) const
 	{
 		return const_cast<Vector*>(this)->operator[](index);
 	}
 
-	template <typename T>
-	T & Vector<T>::At(size_t index)
+	template <typename T, typename ReserveStrategy>
+	T & Vector<T, ReserveStrategy>::At(size_t index)
 	{
 		return operator[](index);
 	}
 
-	template <typename T>
-	const T & Vector<T>::At(size_t index) const
+	template <typename T, typename ReserveStrategy>
+	const T & Vector<T, ReserveStrategy>::At(size_t index) const
 	{
 		return operator[](index);
 	}
 
-	template <typename T>
-	T & Vector<T>::Front()
+	template <typename T, typename ReserveStrategy>
+	T* Vector<T, ReserveStrategy>::Data()
+	{
+		return mArray;
+	}
+
+	template <typename T, typename ReserveStrategy>
+	const T* Vector<T, ReserveStrategy>::Data() const
+	{
+		return mArray;
+	}
+
+	template <typename T, typename ReserveStrategy>
+	T & Vector<T, ReserveStrategy>::Front()
 	{
 		if (mSize > 0)
 		{
@@ -116,14 +156,14 @@ namespace GameEngine
 		}
 	}
 
-	template <typename T>
-	const T & Vector<T>::Front() const
+	template <typename T, typename ReserveStrategy>
+	const T & Vector<T, ReserveStrategy>::Front() const
 	{
 		return const_cast<Vector*>(this)->Front();
 	}
 
-	template <typename T>
-	T & Vector<T>::Back()
+	template <typename T, typename ReserveStrategy>
+	T & Vector<T, ReserveStrategy>::Back()
 	{
 		if (mSize > 0)
 		{
@@ -135,44 +175,44 @@ namespace GameEngine
 		}
 	}
 
-	template <typename T>
-	const T & Vector<T>::Back() const
+	template <typename T, typename ReserveStrategy>
+	const T & Vector<T, ReserveStrategy>::Back() const
 	{
 		return const_cast<Vector*>(this)->Back();
 	}
 
-	template <typename T>
-	bool Vector<T>::IsEmpty() const
+	template <typename T, typename ReserveStrategy>
+	bool Vector<T, ReserveStrategy>::IsEmpty() const
 	{
 		return mSize == 0;
 	}
 
-	template <typename T>
-	size_t Vector<T>::Size() const
+	template <typename T, typename ReserveStrategy>
+	size_t Vector<T, ReserveStrategy>::Size() const
 	{
 		return mSize;
 	}
 
-	template <typename T>
-	size_t Vector<T>::Capacity() const
+	template <typename T, typename ReserveStrategy>
+	size_t Vector<T, ReserveStrategy>::Capacity() const
 	{
 		return mCapacity;
 	}
 
-	template <typename T>
-	typename Vector<T>::Iterator Vector<T>::PushBack(const T & data)
+	template <typename T, typename ReserveStrategy>
+	typename Vector<T, ReserveStrategy>::Iterator Vector<T, ReserveStrategy>::PushBack(const T & data)
 	{
 		return EmplaceBack(data);
 	}
 
-	template <typename T>
+	template <typename T, typename ReserveStrategy>
 	template <typename... Args>
-	typename Vector<T>::Iterator Vector<T>::EmplaceBack(Args&&... args)
+	typename Vector<T, ReserveStrategy>::Iterator Vector<T, ReserveStrategy>::EmplaceBack(Args&&... args)
 	{
 		// Increse capacity if necessary
 		if (mSize == mCapacity)
 		{
-			Reserve(std::max(mCapacity + 1, mReserveFunction(mSize, mCapacity)));
+			Reserve(std::max(mCapacity + 1, ReserveStrategy()(mSize, mCapacity)));
 		}
 
 		new(mArray + mSize) T(std::forward<Args>(args)...);
@@ -181,8 +221,8 @@ namespace GameEngine
 		return Iterator(*this, mSize - 1);
 	}
 
-	template <typename T>
-	void Vector<T>::PopBack()
+	template <typename T, typename ReserveStrategy>
+	void Vector<T, ReserveStrategy>::PopBack()
 	{
 		if (mSize > 0)
 		{
@@ -191,24 +231,17 @@ namespace GameEngine
 		}
 	}
 
-	template <typename T>
-	void Vector<T>::Reserve(size_t capacity)
+	template <typename T, typename ReserveStrategy>
+	void Vector<T, ReserveStrategy>::Reserve(size_t capacity)
 	{
 		if (capacity > mCapacity)
 		{
-			T* newArray = reinterpret_cast<T*>(malloc(sizeof(T) * capacity));
-			if (mArray != nullptr)
-			{
-				memmove(newArray, mArray, sizeof(T) * mSize);   // Move contents to new array
-				free(mArray);
-			}
-			mArray = newArray;
-			mCapacity = capacity;
+			Reallocate(capacity);
 		}
 	}
 
-	template <typename T>
-	void Vector<T>::ShrinkToFit()
+	template <typename T, typename ReserveStrategy>
+	void Vector<T, ReserveStrategy>::ShrinkToFit()
 	{
 		if (mSize == 0)
 		{
@@ -218,20 +251,18 @@ namespace GameEngine
 		}
 		else if (mSize < mCapacity)
 		{
-			mCapacity = mSize;
-			mArray = reinterpret_cast<T*>(realloc(mArray, sizeof(T) * mSize));
+			Reallocate(mSize);
 		}
 	}
 
-	template <typename T>
-	void Vector<T>::Resize(size_t newSize, const T& sample)
+	template <typename T, typename ReserveStrategy>
+	void Vector<T, ReserveStrategy>::Resize(size_t newSize, const T& sample)
 	{
 		if (newSize > mSize)
 		{
 			if (newSize > mCapacity)
 			{
-				mArray = reinterpret_cast<T*>(realloc(mArray, sizeof(T) * newSize));
-				mCapacity = newSize;
+				Reallocate(newSize);
 			}
 			for (size_t i = mSize; i < newSize; ++i)
 			{
@@ -248,8 +279,8 @@ namespace GameEngine
 		mSize = newSize;
 	}
 
-	template <typename T>
-	void Vector<T>::Clear()
+	template <typename T, typename ReserveStrategy>
+	void Vector<T, ReserveStrategy>::Clear()
 	{
 		while (mSize > 0)
 		{
@@ -257,8 +288,8 @@ namespace GameEngine
 		}
 	}
 
-	template <typename T>
-	void Vector<T>::Destroy()
+	template <typename T, typename ReserveStrategy>
+	void Vector<T, ReserveStrategy>::Destroy()
 	{
 		if (mCapacity > 0)
 		{
@@ -269,8 +300,8 @@ namespace GameEngine
 		}
 	}
 
-	template <typename T>
-	typename Vector<T>::Iterator Vector<T>::Find(const T & data)
+	template <typename T, typename ReserveStrategy>
+	typename Vector<T, ReserveStrategy>::Iterator Vector<T, ReserveStrategy>::Find(const T & data)
 	{
 		for (size_t i = 0; i < mSize; ++i)
 		{
@@ -282,26 +313,26 @@ namespace GameEngine
 		return end();
 	}
 
-	template <typename T>
-	typename Vector<T>::ConstIterator Vector<T>::Find(const T & data) const
+	template <typename T, typename ReserveStrategy>
+	typename Vector<T, ReserveStrategy>::ConstIterator Vector<T, ReserveStrategy>::Find(const T & data) const
 	{
 		return ConstIterator(const_cast<Vector*>(this)->Find(data));
 	}
 
-	template <typename T>
-	void Vector<T>::Remove(const T & data)
+	template <typename T, typename ReserveStrategy>
+	void Vector<T, ReserveStrategy>::Remove(const T & data)
 	{
 		Remove(Find(data));
 	}
 
-	template <typename T>
-	void Vector<T>::Remove(const Vector<T>::Iterator& iterator)
+	template <typename T, typename ReserveStrategy>
+	void Vector<T, ReserveStrategy>::Remove(const Vector<T, ReserveStrategy>::Iterator& iterator)
 	{
 		Remove(iterator, iterator + 1);
 	}
 
-	template <typename T>
-	void Vector<T>::Remove(Vector<T>::Iterator begin, Vector<T>::Iterator end)
+	template <typename T, typename ReserveStrategy>
+	void Vector<T, ReserveStrategy>::Remove(Vector<T, ReserveStrategy>::Iterator begin, Vector<T, ReserveStrategy>::Iterator end)
 	{
 		if (begin.mOwner == this && begin.mOwner == end.mOwner)
 		{
@@ -324,7 +355,7 @@ namespace GameEngine
 
 				// Fill gap
 				size_t moveNumber = this->end().mIndex - end.mIndex;
-				memmove(mArray + begin.mIndex, mArray + end.mIndex, sizeof(T) * moveNumber);
+				Relocate(mArray + begin.mIndex, mArray + end.mIndex, moveNumber);
 
 				// Change size
 				mSize -= end.mIndex - begin.mIndex;
@@ -336,48 +367,47 @@ namespace GameEngine
 		}
 	}
 
-	template <typename T>
-	typename Vector<T>::Iterator Vector<T>::begin()
+	template <typename T, typename ReserveStrategy>
+	typename Vector<T, ReserveStrategy>::Iterator Vector<T, ReserveStrategy>::begin()
 	{
 		return Iterator(*this, 0);
 	}
 
-	template <typename T>
-	typename Vector<T>::ConstIterator Vector<T>::begin() const
+	template <typename T, typename ReserveStrategy>
+	typename Vector<T, ReserveStrategy>::ConstIterator Vector<T, ReserveStrategy>::begin() const
 	{
 		return ConstIterator(*this, 0);
 	}
 
-	template <typename T>
-	typename Vector<T>::Iterator Vector<T>::end()
+	template <typename T, typename ReserveStrategy>
+	typename Vector<T, ReserveStrategy>::Iterator Vector<T, ReserveStrategy>::end()
 	{
 		return Iterator(*this, mSize);
 	}
 
-	template <typename T>
-	typename Vector<T>::ConstIterator Vector<T>::end() const
+	template <typename T, typename ReserveStrategy>
+	typename Vector<T, ReserveStrategy>::ConstIterator Vector<T, ReserveStrategy>::end() const
 	{
 		return ConstIterator(*this, mSize);
 	}
 
-	template <typename T>
-	typename Vector<T>::ConstIterator Vector<T>::cbegin() const
+	template <typename T, typename ReserveStrategy>
+	typename Vector<T, ReserveStrategy>::ConstIterator Vector<T, ReserveStrategy>::cbegin() const
 	{
 		return ConstIterator(*this, 0);
 	}
 
-	template <typename T>
-	typename Vector<T>::ConstIterator Vector<T>::cend() const
+	template <typename T, typename ReserveStrategy>
+	typename Vector<T, ReserveStrategy>::ConstIterator Vector<T, ReserveStrategy>::cend() const
 	{
 		return ConstIterator(*this, mSize);
 	}
 
-	template <typename T>
-	void Vector<T>::DeepCopy(const Vector & other)
+	template <typename T, typename ReserveStrategy>
+	void Vector<T, ReserveStrategy>::DeepCopy(const Vector & other)
 	{
 		mCapacity = other.mCapacity;
 		mSize = other.mSize;
-		mReserveFunction = other.mReserveFunction;
 
 		if (mCapacity > 0)
 		{
@@ -389,26 +419,36 @@ namespace GameEngine
 		}
 	}
 
-	template <typename T>
-	size_t Vector<T>::DefaultReserveFunction::operator()(size_t size, size_t capacity) const
+	template <typename T, typename ReserveStrategy>
+	void Vector<T, ReserveStrategy>::Reallocate(size_t capacity)
 	{
-		size_t currentCapacity = capacity == 0 ? 8 : capacity;
-		while (currentCapacity <= size)
+		if constexpr (IsTriviallyRelocatable<T>::value)
 		{
-			currentCapacity *= 2;
+			// realloc may grow the block in place, otherwise it copies the bytes for us
+			mArray = reinterpret_cast<T*>(realloc(mArray, sizeof(T) * capacity));
 		}
-		return currentCapacity;
+		else
+		{
+			T* newArray = reinterpret_cast<T*>(malloc(sizeof(T) * capacity));
+			if (mArray != nullptr)
+			{
+				Relocate(newArray, mArray, mSize);
+				free(mArray);
+			}
+			mArray = newArray;
+		}
+		mCapacity = capacity;
 	}
 
 #pragma region Iterator
-	template <typename T>
-	Vector<T>::Iterator::Iterator(const Vector & owner, size_t index) :
+	template <typename T, typename ReserveStrategy>
+	Vector<T, ReserveStrategy>::Iterator::Iterator(const Vector & owner, size_t index) :
 		mOwner(&owner),
 		mIndex(index)
 	{}
 
-	template <typename T>
-	typename Vector<T>::Iterator & Vector<T>::Iterator::operator++()
+	template <typename T, typename ReserveStrategy>
+	typename Vector<T, ReserveStrategy>::Iterator & Vector<T, ReserveStrategy>::Iterator::operator++()
 	{
 		if (mOwner == nullptr)
 		{
@@ -422,40 +462,124 @@ namespace GameEngine
 		return *this;
 	}
 
-	template <typename T>
-	typename Vector<T>::Iterator Vector<T>::Iterator::operator++(int)
+	template <typename T, typename ReserveStrategy>
+	typename Vector<T, ReserveStrategy>::Iterator Vector<T, ReserveStrategy>::Iterator::operator++(int)
 	{
 		Iterator copy = *this;
 		operator++();
 		return copy;
 	}
 
-	template <typename T>
-	typename Vector<T>::Iterator Vector<T>::Iterator::operator+(size_t step) const
+	template <typename T, typename ReserveStrategy>
+	typename Vector<T, ReserveStrategy>::Iterator & Vector<T, ReserveStrategy>::Iterator::operator--()
+	{
+		if (mOwner == nullptr)
+		{
+			throw std::exception("Try to decrement uninitialized iterator");
+		}
+
+		if (mIndex > 0)
+		{
+			--mIndex;
+		}
+		return *this;
+	}
+
+	template <typename T, typename ReserveStrategy>
+	typename Vector<T, ReserveStrategy>::Iterator Vector<T, ReserveStrategy>::Iterator::operator--(int)
+	{
+		Iterator copy = *this;
+		operator--();
+		return copy;
+	}
+
+	template <typename T, typename ReserveStrategy>
+	typename Vector<T, ReserveStrategy>::Iterator & Vector<T, ReserveStrategy>::Iterator::operator+=(difference_type step)
 	{
 		if (mOwner == nullptr)
 		{
 			throw std::exception("Try to increment uninitialized iterator");
 		}
 
-		size_t newIndex = std::min(mIndex + step, mOwner->mSize);
-		return Iterator(*mOwner, newIndex);
+		if (step < 0)
+		{
+			mIndex -= std::min(mIndex, static_cast<size_t>(-step));
+		}
+		else
+		{
+			mIndex = std::min(mIndex + static_cast<size_t>(step), mOwner->mSize);
+		}
+		return *this;
 	}
 
-	template <typename T>
-	bool Vector<T>::Iterator::operator==(const Iterator & other) const
+	template <typename T, typename ReserveStrategy>
+	typename Vector<T, ReserveStrategy>::Iterator & Vector<T, ReserveStrategy>::Iterator::operator-=(difference_type step)
+	{
+		return operator+=(-step);
+	}
+
+	template <typename T, typename ReserveStrategy>
+	typename Vector<T, ReserveStrategy>::Iterator Vector<T, ReserveStrategy>::Iterator::operator+(difference_type step) const
+	{
+		Iterator copy = *this;
+		return copy += step;
+	}
+
+	template <typename T, typename ReserveStrategy>
+	typename Vector<T, ReserveStrategy>::Iterator Vector<T, ReserveStrategy>::Iterator::operator-(difference_type step) const
+	{
+		Iterator copy = *this;
+		return copy -= step;
+	}
+
+	template <typename T, typename ReserveStrategy>
+	typename Vector<T, ReserveStrategy>::Iterator::difference_type Vector<T, ReserveStrategy>::Iterator::operator-(const Iterator & other) const
+	{
+		if (mOwner != other.mOwner)
+		{
+			throw std::exception("Iterators belong to different vectors!");
+		}
+		return static_cast<difference_type>(mIndex) - static_cast<difference_type>(other.mIndex);
+	}
+
+	template <typename T, typename ReserveStrategy>
+	bool Vector<T, ReserveStrategy>::Iterator::operator==(const Iterator & other) const
 	{
 		return (mOwner == other.mOwner && mIndex == other.mIndex);
 	}
 
-	template <typename T>
-	bool Vector<T>::Iterator::operator!=(const Iterator & other) const
+	template <typename T, typename ReserveStrategy>
+	bool Vector<T, ReserveStrategy>::Iterator::operator!=(const Iterator & other) const
 	{
 		return !operator==(other);
 	}
 
-	template <typename T>
-	T & Vector<T>::Iterator::operator*()
+	template <typename T, typename ReserveStrategy>
+	bool Vector<T, ReserveStrategy>::Iterator::operator<(const Iterator & other) const
+	{
+		return operator-(other) < 0;
+	}
+
+	template <typename T, typename ReserveStrategy>
+	bool Vector<T, ReserveStrategy>::Iterator::operator>(const Iterator & other) const
+	{
+		return operator-(other) > 0;
+	}
+
+	template <typename T, typename ReserveStrategy>
+	bool Vector<T, ReserveStrategy>::Iterator::operator<=(const Iterator & other) const
+	{
+		return operator-(other) <= 0;
+	}
+
+	template <typename T, typename ReserveStrategy>
+	bool Vector<T, ReserveStrategy>::Iterator::operator>=(const Iterator & other) const
+	{
+		return operator-(other) >= 0;
+	}
+
+	template <typename T, typename ReserveStrategy>
+	T & Vector<T, ReserveStrategy>::Iterator::operator*() const
 	{
 		if (mOwner != nullptr && mOwner->Size() > mIndex)
 		{
@@ -467,34 +591,52 @@ namespace GameEngine
 		}
 	}
 
-	template <typename T>
-	const T & Vector<T>::Iterator::operator*() const
+	template <typename T, typename ReserveStrategy>
+	T* Vector<T, ReserveStrategy>::Iterator::operator->() const
 	{
-		return const_cast<Iterator*>(this)->operator*();
+		return &operator[](0);
 	}
 
-	template <typename T>
-	Vector<T>::ConstIterator::ConstIterator(const Vector & owner, size_t index) :
+	template <typename T, typename ReserveStrategy>
+	T & Vector<T, ReserveStrategy>::Iterator::operator[](difference_type offset) const
+	{
+		return *(*this + offset);
+	}
+
+	template <typename T, typename ReserveStrategy>
+	T* Vector<T, ReserveStrategy>::Iterator::_Unwrapped() const
+	{
+		return mOwner != nullptr ? mOwner->mArray + mIndex : nullptr;
+	}
+
+	template <typename T, typename ReserveStrategy>
+	void Vector<T, ReserveStrategy>::Iterator::_Seek_to(const T* pointer)
+	{
+		mIndex = static_cast<size_t>(pointer - mOwner->mArray);
+	}
+
+	template <typename T, typename ReserveStrategy>
+	Vector<T, ReserveStrategy>::ConstIterator::ConstIterator(const Vector & owner, size_t index) :
 		mOwner(&owner),
 		mIndex(index)
 	{}
 
-	template <typename T>
-	Vector<T>::ConstIterator::ConstIterator(const Iterator & other) :
+	template <typename T, typename ReserveStrategy>
+	Vector<T, ReserveStrategy>::ConstIterator::ConstIterator(const Iterator & other) :
 		mOwner(other.mOwner),
 		mIndex(other.mIndex)
 	{}
 
-	template <typename T>
-	typename Vector<T>::ConstIterator & Vector<T>::ConstIterator::operator=(const Iterator & other)
+	template <typename T, typename ReserveStrategy>
+	typename Vector<T, ReserveStrategy>::ConstIterator & Vector<T, ReserveStrategy>::ConstIterator::operator=(const Iterator & other)
 	{
 		mOwner = other.mOwner;
 		mIndex = other.mIndex;
 		return *this;
 	}
 
-	template <typename T>
-	typename Vector<T>::ConstIterator & Vector<T>::ConstIterator::operator++()
+	template <typename T, typename ReserveStrategy>
+	typename Vector<T, ReserveStrategy>::ConstIterator & Vector<T, ReserveStrategy>::ConstIterator::operator++()
 	{
 		if (mOwner == nullptr)
 		{
@@ -508,40 +650,124 @@ namespace GameEngine
 		return *this;
 	}
 
-	template <typename T>
-	typename Vector<T>::ConstIterator Vector<T>::ConstIterator::operator++(int)
+	template <typename T, typename ReserveStrategy>
+	typename Vector<T, ReserveStrategy>::ConstIterator Vector<T, ReserveStrategy>::ConstIterator::operator++(int)
 	{
 		ConstIterator copy = *this;
 		operator++();
 		return copy;
 	}
 
-	template <typename T>
-	typename Vector<T>::ConstIterator Vector<T>::ConstIterator::operator+(size_t step)
+	template <typename T, typename ReserveStrategy>
+	typename Vector<T, ReserveStrategy>::ConstIterator & Vector<T, ReserveStrategy>::ConstIterator::operator--()
+	{
+		if (mOwner == nullptr)
+		{
+			throw std::exception("Try to decrement uninitialized iterator");
+		}
+
+		if (mIndex > 0)
+		{
+			--mIndex;
+		}
+		return *this;
+	}
+
+	template <typename T, typename ReserveStrategy>
+	typename Vector<T, ReserveStrategy>::ConstIterator Vector<T, ReserveStrategy>::ConstIterator::operator--(int)
+	{
+		ConstIterator copy = *this;
+		operator--();
+		return copy;
+	}
+
+	template <typename T, typename ReserveStrategy>
+	typename Vector<T, ReserveStrategy>::ConstIterator & Vector<T, ReserveStrategy>::ConstIterator::operator+=(difference_type step)
 	{
 		if (mOwner == nullptr)
 		{
 			throw std::exception("Try to increment uninitialized iterator");
 		}
 
-		size_t newIndex = std::min(mIndex + step, mOwner->mSize);
-		return Iterator(*mOwner, newIndex);
+		if (step < 0)
+		{
+			mIndex -= std::min(mIndex, static_cast<size_t>(-step));
+		}
+		else
+		{
+			mIndex = std::min(mIndex + static_cast<size_t>(step), mOwner->mSize);
+		}
+		return *this;
 	}
 
-	template <typename T>
-	bool Vector<T>::ConstIterator::operator==(const ConstIterator & other) const
+	template <typename T, typename ReserveStrategy>
+	typename Vector<T, ReserveStrategy>::ConstIterator & Vector<T, ReserveStrategy>::ConstIterator::operator-=(difference_type step)
+	{
+		return operator+=(-step);
+	}
+
+	template <typename T, typename ReserveStrategy>
+	typename Vector<T, ReserveStrategy>::ConstIterator Vector<T, ReserveStrategy>::ConstIterator::operator+(difference_type step) const
+	{
+		ConstIterator copy = *this;
+		return copy += step;
+	}
+
+	template <typename T, typename ReserveStrategy>
+	typename Vector<T, ReserveStrategy>::ConstIterator Vector<T, ReserveStrategy>::ConstIterator::operator-(difference_type step) const
+	{
+		ConstIterator copy = *this;
+		return copy -= step;
+	}
+
+	template <typename T, typename ReserveStrategy>
+	typename Vector<T, ReserveStrategy>::ConstIterator::difference_type Vector<T, ReserveStrategy>::ConstIterator::operator-(const ConstIterator & other) const
+	{
+		if (mOwner != other.mOwner)
+		{
+			throw std::exception("Iterators belong to different vectors!");
+		}
+		return static_cast<difference_type>(mIndex) - static_cast<difference_type>(other.mIndex);
+	}
+
+	template <typename T, typename ReserveStrategy>
+	bool Vector<T, ReserveStrategy>::ConstIterator::operator==(const ConstIterator & other) const
 	{
 		return (mOwner == other.mOwner && mIndex == other.mIndex);
 	}
 
-	template <typename T>
-	bool Vector<T>::ConstIterator::operator!=(const ConstIterator & other) const
+	template <typename T, typename ReserveStrategy>
+	bool Vector<T, ReserveStrategy>::ConstIterator::operator!=(const ConstIterator & other) const
 	{
 		return !operator==(other);
 	}
 
-	template <typename T>
-	const T & Vector<T>::ConstIterator::operator*() const
+	template <typename T, typename ReserveStrategy>
+	bool Vector<T, ReserveStrategy>::ConstIterator::operator<(const ConstIterator & other) const
+	{
+		return operator-(other) < 0;
+	}
+
+	template <typename T, typename ReserveStrategy>
+	bool Vector<T, ReserveStrategy>::ConstIterator::operator>(const ConstIterator & other) const
+	{
+		return operator-(other) > 0;
+	}
+
+	template <typename T, typename ReserveStrategy>
+	bool Vector<T, ReserveStrategy>::ConstIterator::operator<=(const ConstIterator & other) const
+	{
+		return operator-(other) <= 0;
+	}
+
+	template <typename T, typename ReserveStrategy>
+	bool Vector<T, ReserveStrategy>::ConstIterator::operator>=(const ConstIterator & other) const
+	{
+		return operator-(other) >= 0;
+	}
+
+	template <typename T, typename ReserveStrategy>
+	const T & Vector<T, ReserveStrategy>::ConstIterator::operator*() const
 	{
 		if (mOwner != nullptr && mOwner->Size() > mIndex)
 		{
@@ -552,5 +778,29 @@ namespace GameEngine
 			throw std::exception("Try to dereference an iterator pointing to invalid data!");
 		}
 	}
+
+	template <typename T, typename ReserveStrategy>
+	const T* Vector<T, ReserveStrategy>::ConstIterator::operator->() const
+	{
+		return &operator[](0);
+	}
+
+	template <typename T, typename ReserveStrategy>
+	const T & Vector<T, ReserveStrategy>::ConstIterator::operator[](difference_type offset) const
+	{
+		return *(*this + offset);
+	}
+
+	template <typename T, typename ReserveStrategy>
+	const T* Vector<T, ReserveStrategy>::ConstIterator::_Unwrapped() const
+	{
+		return mOwner != nullptr ? mOwner->mArray + mIndex : nullptr;
+	}
+
+	template <typename T, typename ReserveStrategy>
+	void Vector<T, ReserveStrategy>::ConstIterator::_Seek_to(const T* pointer)
+	{
+		mIndex = static_cast<size_t>(pointer - mOwner->mArray);
+	}
 #pragma endregion
 };
\ No newline at end of file
@@ -0,0 +1,160 @@
+#include "pch.h"
+#include "CppUnitTest.h"
+#include "Atom.h"
+#include "Scope.h"
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using namespace GameEngine;
+using namespace std::string_literals;
+
+namespace UnitTestLibraryDesktop
+{
+	TEST_CLASS(AtomTest)
+	{
+	public:
+
+		TEST_METHOD_INITIALIZE(Initialize)
+		{
+#if defined(DEBUG) || defined(_DEBUG)
+			_CrtSetDbgFlag(_CRTDBG_ALLOC_MEM_DF);
+			_CrtMemCheckpoint(&sStartMemState);
+#endif
+		}
+
+		TEST_METHOD_CLEANUP(Cleanup)
+		{
+#if defined(DEBUG) || defined(_DEBUG)
+			_CrtMemState endMemState, diffMemState;
+			_CrtMemCheckpoint(&endMemState);
+			if (_CrtMemDifference(&diffMemState, &sStartMemState, &endMemState))
+			{
+				_CrtMemDumpStatistics(&diffMemState);
+				Assert::Fail(L"Memory Leaks!");
+			}
+#endif
+		}
+
+		TEST_METHOD(TestIntern)
+		{
+			const size_t count = Atom::Count();
+			{
+				Atom empty;
+				Assert::IsTrue(empty.IsEmpty());
+				Assert::AreEqual(""s, empty.Name());
+				Assert::IsTrue(empty == Atom(""));
+
+				Atom a("AtomTestKey");
+				Atom b(std::string("AtomTestKey"));
+				Atom c("AtomTestOther");
+				Assert::AreEqual(count + 2, Atom::Count());
+				Assert::IsFalse(a.IsEmpty());
+				Assert::AreEqual("AtomTestKey"s, a.Name());
+				Assert::IsTrue(a == b);
+				Assert::IsTrue(&a.Name() == &b.Name());
+				Assert::IsTrue(a != c);
+				Assert::AreEqual(DefaultHash<std::string>()("AtomTestKey"s), a.Hash());
+				Assert::AreEqual(DefaultHash<Atom>()("AtomTestKey"), a.Hash());
+				Assert::IsTrue(DefaultKeyEquality<Atom>()(a, "AtomTestKey"));
+				Assert::IsFalse(DefaultKeyEquality<Atom>()("AtomTestKey", c));
+
+				Atom copy(a);
+				Atom moved(std::move(b));
+				Assert::IsTrue(copy == a);
+				Assert::IsTrue(moved == a);
+				Assert::IsTrue(b.IsEmpty());
+				c = copy;
+				Assert::IsTrue(c == a);
+				Assert::AreEqual(count + 1, Atom::Count());
+			}
+			Assert::AreEqual(count, Atom::Count());
+		}
+
+		TEST_METHOD(TestFind)
+		{
+			const size_t count = Atom::Count();
+			Assert::IsTrue(Atom::Find("AtomTestKey").IsEmpty());
+			Assert::AreEqual(count, Atom::Count());
+			{
+				Atom a("AtomTestKey");
+				Atom found = Atom::Find("AtomTestKey");
+				Assert::IsTrue(found == a);
+				Assert::IsTrue(Atom::Find("").IsEmpty());
+			}
+			Assert::IsTrue(Atom::Find("AtomTestKey").IsEmpty());
+			Assert::AreEqual(count, Atom::Count());
+		}
+
+		TEST_METHOD(TestGrow)
+		{
+			const size_t count = Atom::Count();
+			{
+				std::vector<Atom> atoms;
+				for (size_t i = 0; i < 5000; ++i)
+				{
+					atoms.emplace_back(std::to_string(i) + "AtomTest");
+				}
+				Assert::AreEqual(count + 5000, Atom::Count());
+				for (size_t i = 0; i < 5000; ++i)
+				{
+					Assert::IsTrue(atoms[i] == Atom::Find(std::to_string(i) + "AtomTest"));
+				}
+			}
+			Assert::AreEqual(count, Atom::Count());
+		}
+
+		TEST_METHOD(TestConcurrent)
+		{
+			const size_t count = Atom::Count();
+			{
+				std::vector<std::thread> threads;
+				std::vector<std::vector<Atom>> results(4);
+				for (size_t t = 0; t < results.size(); ++t)
+				{
+					threads.emplace_back([&results, t]()
+					{
+						for (size_t i = 0; i < 1000; ++i)
+						{
+							Atom atom(std::to_string(i % 100) + "AtomTest");
+							results[t].push_back(atom);
+						}
+					});
+				}
+				for (auto& thread : threads)
+				{
+					thread.join();
+				}
+
+				Assert::AreEqual(count + 100, Atom::Count());
+				for (size_t t = 1; t < results.size(); ++t)
+				{
+					for (size_t i = 0; i < 1000; ++i)
+					{
+						Assert::IsTrue(results[0][i] == results[t][i]);
+					}
+				}
+			}
+			Assert::AreEqual(count, Atom::Count());
+		}
+
+		TEST_METHOD(TestScopeKeys)
+		{
+			Scope scope;
+			Atom key("AtomTestKey");
+			scope.Append(key).first = 10;
+			Assert::AreEqual(10, scope["AtomTestKey"].AsInt());
+			Assert::IsTrue(scope.Find(key) == scope.Find("AtomTestKey"s));
+			Assert::IsTrue(scope.Find(Atom("AtomTestOther")) == nullptr);
+			Assert::AreEqual(20, (scope[key] = 20).AsInt());
+			Assert::IsFalse(scope.Append(Atom("AtomTestKey")).second);
+			Assert::ExpectException<std::exception>([&scope] { scope.Append(Atom()); });
+		}
+
+	private:
+		static _CrtMemState sStartMemState;
+	};
+
+	_CrtMemState AtomTest::sStartMemState;
+}
@@ -2,6 +2,8 @@
 #include "CppUnitTest.h"
 #include "AttributedFoo.h"
 #include "Attributed.h"
+#include "ScopeColumns.h"
+#include "ScopePath.h"
 
 using namespace Microsoft::VisualStudio::CppUnitTestFramework;
 using namespace GameEngine;
@@ -291,6 +293,57 @@ namespace UnitTestLibraryDesktop
 			Assert::AreEqual(3_z, foo.Find("InternalScopeArray")->Size());
 		}
 
+		TEST_METHOD(TestPrototype)
+		{
+			auto prototype = AttributedTypeManager::GetPrototype(AttributedFoo::TypeIdClass());
+			Assert::IsNotNull(prototype.get());
+			Assert::AreEqual(DefaultSize(AttributedFoo::TypeIdClass()), prototype->Size());
+			Assert::IsNull(AttributedTypeManager::GetPrototype(Foo::TypeIdClass()).get());
+
+			// Instances copy the layout of the prototype and own their storage
+			AttributedFoo foo(1);
+			Check(foo);
+			auto signatures = AttributedTypeManager::GetSignature(AttributedFoo::TypeIdClass());
+			for (size_t i = 0; i < signatures->Size(); ++i)
+			{
+				const auto& signature = (*signatures)[i];
+				Assert::AreEqual(signature.mType, foo[i + 1].Type());
+				Assert::AreEqual(signature.mType, (*prototype)[i + 1].Type());
+				Assert::AreEqual(signature.mSize, foo[i + 1].Size());
+				Assert::AreEqual(signature.mOffset == 0, foo[i + 1].IsInternal());
+			}
+			foo.Find("InternalInt")->Set(100);
+			foo.Find("InternalScopeArray")->AsTable(1).Append("Int").first = 666;
+			Assert::AreEqual(0, prototype->Find("InternalInt")->AsInt());
+			Assert::AreEqual(0_z, prototype->Find("InternalScopeArray")->AsTable(1).Size());
+			Assert::IsTrue(foo.Find("InternalScopeArray")->AsTable(1).GetParent() == &foo);
+			Assert::IsTrue(foo.Find("Int") != prototype->Find("Int"));
+		}
+
+		TEST_METHOD(TestTypeInfoLifetime)
+		{
+			{
+				Vector<Attributed::Signature> signatures;
+				signatures.EmplaceBack("Int", Datum::DatumType::Integer, 1, 0);
+				AttributedTypeManager::RegisterType(Foo::TypeIdClass(), signatures, Attributed::TypeIdClass());
+				AttributedTypeManager::FinalizeSignature();
+			}
+
+			// Held tables outlive the registration
+			auto signatures = AttributedTypeManager::GetSignature(Foo::TypeIdClass());
+			auto prototype = AttributedTypeManager::GetPrototype(Foo::TypeIdClass());
+			Assert::IsNotNull(signatures.get());
+			Assert::IsNotNull(prototype.get());
+			AttributedTypeManager::UnregisterType(Foo::TypeIdClass());
+			AttributedTypeManager::FinalizeSignature();
+			Assert::IsNull(AttributedTypeManager::GetSignature(Foo::TypeIdClass()).get());
+			Assert::IsNull(AttributedTypeManager::GetPrototype(Foo::TypeIdClass()).get());
+			Assert::AreEqual(1_z, signatures->Size());
+			Assert::AreEqual(Datum::DatumType::Integer, (*signatures)[0].mType);
+			Assert::AreEqual(2_z, prototype->Size());
+			Assert::AreEqual(1_z, prototype->Find("Int")->Size());
+		}
+
 		TEST_METHOD(TestAuxiliaryAttribute)
 		{
 			AttributedFoo foo(1);
@@ -307,6 +360,15 @@ namespace UnitTestLibraryDesktop
 			Assert::AreEqual("10.f"s, foo.Find("string")->AsString());
 			Assert::IsTrue(foo.Find("pointer")->AsPointer() == reinterpret_cast<RTTI*>(&foo));
 
+			// Removing an attribute drops cached paths to it, prescribed attributes can't be removed
+			ScopePath path("int"s, true);
+			Assert::IsTrue(path.Resolve(foo).first == foo.Find("int"));
+			foo.RemoveAuxiliaryAttribute("int");
+			Assert::IsFalse(foo.IsAttribute("int"));
+			Assert::IsTrue(path.Resolve(foo).first == nullptr);
+			foo.RemoveAuxiliaryAttribute("Int");
+			Assert::IsTrue(foo.IsAttribute("Int"));
+
 			foo.Clear();
 			Check(foo);
 			Assert::AreEqual(DefaultSize(AttributedFoo::TypeIdClass()), foo.Size());
@@ -485,27 +547,27 @@ namespace UnitTestLibraryDesktop
 			auto vector = foo.Attributes();
 			auto signatures = AttributedTypeManager::GetSignature(AttributedFoo::TypeIdClass());
 			Assert::AreEqual(signatures->Size() + 4, vector.Size());
-			Assert::AreEqual("this"s, vector[0]->first);
+			Assert::AreEqual("this"s, vector[0]->first.Name());
 			for (size_t i = 0; i < signatures->Size(); ++i)
 			{
-				Assert::AreEqual((*signatures)[i].mName, vector[i + 1]->first);
+				Assert::AreEqual((*signatures)[i].mName.Name(), vector[i + 1]->first.Name());
 			}
-			Assert::AreEqual("a"s, vector[signatures->Size() + 1]->first);
-			Assert::AreEqual("b"s, vector[signatures->Size() + 2]->first);
-			Assert::AreEqual("c"s, vector[signatures->Size() + 3]->first);
+			Assert::AreEqual("a"s, vector[signatures->Size() + 1]->first.Name());
+			Assert::AreEqual("b"s, vector[signatures->Size() + 2]->first.Name());
+			Assert::AreEqual("c"s, vector[signatures->Size() + 3]->first.Name());
 
 			// Const
 			AttributedFoo const& cFoo = foo;
 			auto cVector = cFoo.Attributes();
 			Assert::AreEqual(signatures->Size() + 4, cVector.Size());
-			Assert::AreEqual("this"s, cVector[0]->first);
+			Assert::AreEqual("this"s, cVector[0]->first.Name());
 			for (size_t i = 0; i < signatures->Size(); ++i)
 			{
-				Assert::AreEqual((*signatures)[i].mName, cVector[i + 1]->first);
+				Assert::AreEqual((*signatures)[i].mName.Name(), cVector[i + 1]->first.Name());
 			}
-			Assert::AreEqual("a"s, cVector[signatures->Size() + 1]->first);
-			Assert::AreEqual("b"s, cVector[signatures->Size() + 2]->first);
-			Assert::AreEqual("c"s, cVector[signatures->Size() + 3]->first);
+			Assert::AreEqual("a"s, cVector[signatures->Size() + 1]->first.Name());
+			Assert::AreEqual("b"s, cVector[signatures->Size() + 2]->first.Name());
+			Assert::AreEqual("c"s, cVector[signatures->Size() + 3]->first.Name());
 
 			// Empty
 			Bar bar;
@@ -515,8 +577,8 @@ namespace UnitTestLibraryDesktop
 			Assert::AreEqual(3_z, barVector.Size());
 			Assert::IsTrue(barVector[0]->second.AsPointer() == reinterpret_cast<RTTI*>(&bar));
 			Assert::AreSame(barVector[0]->second, bar["this"]);
-			Assert::AreEqual("a"s, barVector[1]->first);
-			Assert::AreEqual("b"s, barVector[2]->first);
+			Assert::AreEqual("a"s, barVector[1]->first.Name());
+			Assert::AreEqual("b"s, barVector[2]->first.Name());
 		}
 
 		TEST_METHOD(TestGetPrescribedAttribute)
@@ -530,20 +592,20 @@ namespace UnitTestLibraryDesktop
 			auto vector = foo.PrescribedAttributes();
 			auto signatures = AttributedTypeManager::GetSignature(AttributedFoo::TypeIdClass());
 			Assert::AreEqual(signatures->Size() + 1, vector.Size());
-			Assert::AreEqual("this"s, vector[0]->first);
+			Assert::AreEqual("this"s, vector[0]->first.Name());
 			for (size_t i = 0; i < signatures->Size(); ++i)
 			{
-				Assert::AreEqual((*signatures)[i].mName, vector[i + 1]->first);
+				Assert::AreEqual((*signatures)[i].mName.Name(), vector[i + 1]->first.Name());
 			}
 
 			// Const
 			AttributedFoo const& cFoo = foo;
 			auto cVector = cFoo.PrescribedAttributes();
 			Assert::AreEqual(signatures->Size() + 1, cVector.Size());
-			Assert::AreEqual("this"s, cVector[0]->first);
+			Assert::AreEqual("this"s, cVector[0]->first.Name());
 			for (size_t i = 0; i < signatures->Size(); ++i)
 			{
-				Assert::AreEqual((*signatures)[i].mName, cVector[i + 1]->first);
+				Assert::AreEqual((*signatures)[i].mName.Name(), cVector[i + 1]->first.Name());
 			}
 
 			// Empty
@@ -566,17 +628,17 @@ namespace UnitTestLibraryDesktop
 			foo.AppendAuxiliaryAttribute("c");
 			auto vector = foo.AuxiliaryAttributes();
 			Assert::AreEqual(3_z, vector.Size());
-			Assert::AreEqual("a"s, vector[0]->first);
-			Assert::AreEqual("b"s, vector[1]->first);
-			Assert::AreEqual("c"s, vector[2]->first);
+			Assert::AreEqual("a"s, vector[0]->first.Name());
+			Assert::AreEqual("b"s, vector[1]->first.Name());
+			Assert::AreEqual("c"s, vector[2]->first.Name());
 
 			// Const
 			AttributedFoo const& cFoo = foo;
 			auto cVector = cFoo.AuxiliaryAttributes();
 			Assert::AreEqual(3_z, vector.Size());
-			Assert::AreEqual("a"s, vector[0]->first);
-			Assert::AreEqual("b"s, vector[1]->first);
-			Assert::AreEqual("c"s, vector[2]->first);
+			Assert::AreEqual("a"s, vector[0]->first.Name());
+			Assert::AreEqual("b"s, vector[1]->first.Name());
+			Assert::AreEqual("c"s, vector[2]->first.Name());
 
 			// Empty
 			Bar bar;
@@ -584,8 +646,161 @@ namespace UnitTestLibraryDesktop
 			bar.AppendAuxiliaryAttribute("b"s);
 			auto barVector = bar.AuxiliaryAttributes();
 			Assert::AreEqual(2_z, barVector.Size());
-			Assert::AreEqual("a"s, barVector[0]->first);
-			Assert::AreEqual("b"s, barVector[1]->first);
+			Assert::AreEqual("a"s, barVector[0]->first.Name());
+			Assert::AreEqual("b"s, barVector[1]->first.Name());
+		}
+
+		TEST_METHOD(TestHash)
+		{
+			// Member variables are cached like internal storage, writes to them are seen after MarkChanged
+			AttributedFoo foo(1);
+			const size_t hash = foo.Hash();
+			Assert::AreEqual(hash, foo.Hash());
+			foo.mInt = 2;
+			Assert::AreEqual(hash, foo.Hash());
+			foo["Int"].MarkChanged();
+			const size_t changed = foo.Hash();
+			Assert::AreNotEqual(hash, changed);
+			foo["Int"] = 1;
+			Assert::AreEqual(hash, foo.Hash());
+
+			// A copy points at its own members
+			foo.mInt = 2;
+			foo["Int"].MarkChanged();
+			AttributedFoo copy(foo);
+			Assert::AreEqual(changed, copy.Hash());
+			copy.mInt = 3;
+			copy["Int"].MarkChanged();
+			Assert::AreNotEqual(changed, copy.Hash());
+			Assert::AreEqual(changed, foo.Hash());
+
+			// Attributes in columns can be written through the column without the row knowing, so they are hashed every time
+			Scope world;
+			AttributedFoo* row = new AttributedFoo(1);
+			world.Adopt(*row, "Foos");
+			ScopeColumns& columns = world.MakeColumnar("Foos", AttributedFoo::TypeIdClass());
+			const size_t rowHash = row->Hash();
+			columns.Find("InternalInt")->Set(5);
+			Assert::AreNotEqual(rowHash, row->Hash());
+		}
+
+		TEST_METHOD(TestColumnar)
+		{
+			Scope world;
+			Assert::ExpectException<exception>([&world] { world.MakeColumnar("Plain", Scope::TypeIdClass()); });
+			AttributedFoo* first = new AttributedFoo();
+			(*first)["InternalFloat"] = 0.5f;
+			world.Adopt(*first, "Foos");
+			ScopeColumns& columns = world.MakeColumnar("Foos", AttributedFoo::TypeIdClass());
+			Assert::AreSame(columns, world.MakeColumnar("Foos", AttributedFoo::TypeIdClass()));
+			Assert::IsTrue(world["Foos"].Columns() == &columns);
+
+			// Internal attributes other than tables get columns, member variables stay in the object
+			Assert::AreEqual(12_z, columns.ColumnCount());
+			Assert::IsNull(columns.Find("Int"));
+			Assert::IsNull(columns.Find("InternalScopeArray"));
+			Assert::AreEqual(AttributedFoo::ArraySize, columns.WidthAt(11));
+			Datum& floats = *columns.Find("InternalFloat");
+			Assert::AreEqual(0.5f, floats.AsFloat());
+			Assert::IsFalse((*first)["InternalFloat"].IsInternal());
+
+			// Rows keep their values and point into the columns as they grow
+			for (int i = 1; i < 100; ++i)
+			{
+				AttributedFoo* foo = new AttributedFoo(i);
+				(*foo)["InternalFloat"] = static_cast<float>(i);
+				(*foo)["InternalStringArray"].Set(to_string(i), 1);
+				world.Adopt(*foo, "Foos");
+			}
+			Datum& foos = world["Foos"];
+			const Datum& strings = *columns.Find("InternalStringArray");
+			Assert::AreEqual(100_z, columns.RowCount());
+			Assert::AreEqual(100_z, floats.Size());
+			Assert::AreEqual(100 * AttributedFoo::ArraySize, strings.Size());
+			for (size_t i = 1; i < foos.Size(); ++i)
+			{
+				Assert::AreEqual(static_cast<float>(i), floats.AsFloat(i));
+				Assert::AreEqual(to_string(i), strings.AsString(i * AttributedFoo::ArraySize + 1));
+				Assert::AreSame(floats.AsFloat(i), foos.AsTable(i)["InternalFloat"].AsFloat());
+			}
+
+			// Write a whole column at once, or a row
+			for (size_t i = 0; i < floats.Size(); ++i)
+			{
+				floats.Set(floats.AsFloat(i) * 2.f, i);
+			}
+			Assert::AreEqual(10.f, foos.AsTable(5)["InternalFloat"].AsFloat());
+			foos.AsTable(7)["InternalInt"] = 70;
+			Assert::AreEqual(70, columns.Find("InternalInt")->AsInt(7));
+
+			// Other classes are rejected
+			Scope* plain = new Scope();
+			Assert::ExpectException<exception>([&world, plain] { world.Adopt(*plain, "Foos"); });
+			delete plain;
+			Assert::ExpectException<exception>([&world] { world.AppendScope("Foos"); });
+			Assert::ExpectException<exception>([&world] { world.MakeColumnar("Foos", Attributed::TypeIdClass()); });
+			Assert::AreEqual(100_z, foos.Size());
+
+			// Copies get internal storage, or their own columns
+			Datum attribute(foos.AsTable(5)["InternalFloat"]);
+			Assert::IsTrue(attribute.IsInternal());
+			Scope copy(world);
+			ScopeColumns* copyColumns = copy["Foos"].Columns();
+			Assert::IsNotNull(copyColumns);
+			Assert::IsTrue(copyColumns != &columns);
+			Assert::AreEqual(100_z, copyColumns->RowCount());
+			Assert::AreSame(copyColumns->Find("InternalFloat")->AsFloat(5), copy["Foos"].AsTable(5)["InternalFloat"].AsFloat());
+			floats.Set(-1.f, 5);
+			Assert::AreEqual(10.f, attribute.AsFloat());
+			Assert::AreNotEqual(-1.f, copy["Foos"].AsTable(5)["InternalFloat"].AsFloat());
+
+			// A row leaving gets its values back, the rows after it move up
+			Scope& row = foos.AsTable(5);
+			world.Orphan(row);
+			Assert::IsTrue(row["InternalFloat"].IsInternal());
+			Assert::AreEqual(-1.f, row["InternalFloat"].AsFloat());
+			Assert::AreEqual(99_z, columns.RowCount());
+			Assert::AreEqual(12.f, floats.AsFloat(5));
+			Assert::AreEqual(12.f, foos.AsTable(5)["InternalFloat"].AsFloat());
+			Assert::AreEqual("7"s, foos.AsTable(6)["InternalStringArray"].AsString(1));
+			delete &row;
+			delete &foos.AsTable(0);
+			Assert::AreEqual(98_z, columns.RowCount());
+			Assert::AreEqual(98_z, floats.Size());
+			Assert::AreEqual(2.f, foos.AsTable(0)["InternalFloat"].AsFloat());
+			Assert::AreSame(floats.AsFloat(0), foos.AsTable(0)["InternalFloat"].AsFloat());
+
+			// Many rows leave in one pass, the others move up in order
+			Vector<Scope*> leaving;
+			Vector<float> kept;
+			for (size_t i = 0; i < foos.Size(); ++i)
+			{
+				if (i % 2 == 0)
+				{
+					leaving.PushBack(&foos.AsTable(i));
+				}
+				else
+				{
+					kept.PushBack(foos.AsTable(i)["InternalFloat"].AsFloat());
+				}
+			}
+			Scope::OrphanAll(leaving);
+			Assert::AreEqual(49_z, foos.Size());
+			Assert::AreEqual(49_z, columns.RowCount());
+			Assert::AreEqual(49_z, floats.Size());
+			Assert::AreEqual(49 * AttributedFoo::ArraySize, strings.Size());
+			for (size_t i = 0; i < foos.Size(); ++i)
+			{
+				Assert::AreEqual(kept[i], floats.AsFloat(i));
+				Assert::AreSame(floats.AsFloat(i), foos.AsTable(i)["InternalFloat"].AsFloat());
+			}
+			Assert::AreEqual(2.f, (*leaving[0])["InternalFloat"].AsFloat());
+			for (Scope* scope : leaving)
+			{
+				Assert::IsNull(scope->GetParent());
+				Assert::IsTrue((*scope)["InternalFloat"].IsInternal());
+				delete scope;
+			}
 		}
 
 	private:
@@ -0,0 +1,197 @@
+#include "pch.h"
+#include "CppUnitTest.h"
+#include "Foo.h"
+#include "ConcurrentRegistry.h"
+#include "Factory.h"
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using namespace GameEngine;
+using namespace std::string_literals;
+
+namespace UnitTestLibraryDesktop
+{
+	TEST_CLASS(ConcurrentRegistryTest)
+	{
+	public:
+
+		TEST_METHOD_INITIALIZE(Initialize)
+		{
+#if defined(DEBUG) || defined(_DEBUG)
+			_CrtSetDbgFlag(_CRTDBG_ALLOC_MEM_DF);
+			_CrtMemCheckpoint(&sStartMemState);
+#endif
+		}
+
+		TEST_METHOD_CLEANUP(Cleanup)
+		{
+#if defined(DEBUG) || defined(_DEBUG)
+			_CrtMemState endMemState, diffMemState;
+			_CrtMemCheckpoint(&endMemState);
+			if (_CrtMemDifference(&diffMemState, &sStartMemState, &endMemState))
+			{
+				_CrtMemDumpStatistics(&diffMemState);
+				Assert::Fail(L"Memory Leaks!");
+			}
+#endif
+		}
+
+		TEST_METHOD(TestReadUpdate)
+		{
+			ConcurrentRegistry<std::string, int> registry;
+			Assert::AreEqual(size_t(0), registry.Size());
+			Assert::IsFalse(registry.ContainsKey("a"s));
+			Assert::IsTrue(registry.Read([](const auto* map) { return map == nullptr; }));
+
+			registry.Update([](auto& map)
+			{
+				map["a"s] = 1;
+				map["b"s] = 2;
+			});
+			int value = 0;
+			Assert::AreEqual(size_t(2), registry.Size());
+			Assert::IsTrue(registry.TryGet("b"s, value));
+			Assert::AreEqual(2, value);
+			Assert::IsFalse(registry.TryGet("c"s, value));
+			Assert::AreEqual(2, value);
+
+			// Snapshot read by a reader never changes
+			const auto* snapshot = registry.Read([](const auto* map) { return map; });
+			registry.Update([](auto& map) { map["c"s] = 3; });
+			Assert::IsFalse(snapshot == registry.Read([](const auto* map) { return map; }));
+			Assert::IsTrue(registry.ContainsKey("c"s));
+
+			// Nothing is published if update throws
+			auto function = [&registry]
+			{
+				registry.Update([](auto& map)
+				{
+					map.Remove("a"s);
+					throw std::exception("Failed");
+				});
+			};
+			Assert::ExpectException<std::exception>(function);
+			Assert::IsTrue(registry.ContainsKey("a"s));
+			Assert::AreEqual(size_t(3), registry.Size());
+
+			// Empty registry drops its snapshot
+			registry.Update([](auto& map)
+			{
+				map.Remove("a"s);
+				map.Remove("b"s);
+			});
+			Assert::AreEqual(size_t(1), registry.Size());
+			registry.Clear();
+			Assert::AreEqual(size_t(0), registry.Size());
+			Assert::IsTrue(registry.Read([](const auto* map) { return map == nullptr; }));
+		}
+
+		TEST_METHOD(TestConcurrentReaders)
+		{
+			// Readers check that every value they see belongs to its key while the writer keeps replacing the table
+			ConcurrentRegistry<int, int> registry;
+			const int keyCount = 64;
+			std::atomic<bool> done = false;
+			std::atomic<size_t> mismatches = 0;
+			std::atomic<size_t> hits = 0;
+
+			std::vector<std::thread> readers;
+			for (int i = 0; i < 4; ++i)
+			{
+				readers.emplace_back([&registry, &done, &mismatches, &hits, keyCount]
+				{
+					while (!done.load())
+					{
+						for (int key = 0; key < keyCount; ++key)
+						{
+							int value = 0;
+							if (registry.TryGet(key, value))
+							{
+								hits.fetch_add(1);
+								if (value != key * 2)
+								{
+									mismatches.fetch_add(1);
+								}
+							}
+						}
+					}
+				});
+			}
+
+			for (int round = 0; round < 200; ++round)
+			{
+				const int key = round % keyCount;
+				registry.Update([key](auto& map) { map[key] = key * 2; });
+				if (round % 3 == 0)
+				{
+					registry.Update([key](auto& map) { map.Remove(key); });
+				}
+			}
+			done.store(true);
+			for (auto& reader : readers)
+			{
+				reader.join();
+			}
+
+			Assert::AreEqual(size_t(0), mismatches.load());
+			Logger::WriteMessage(("Lookups that found a key: " + std::to_string(hits.load()) + "\n").c_str());
+			registry.Clear();
+		}
+
+		TEST_METHOD(TestConcurrentFactory)
+		{
+			// Worker threads create objects while another factory is added and removed
+			std::atomic<bool> done = false;
+			std::atomic<size_t> failures = 0;
+			FooFactory fooFactory;
+
+			std::vector<std::thread> workers;
+			for (int i = 0; i < 4; ++i)
+			{
+				workers.emplace_back([&done, &failures]
+				{
+					while (!done.load())
+					{
+						Foo* foo = Factory<Foo>::Create("Foo");
+						if (foo == nullptr || !foo->Is("Foo"))
+						{
+							failures.fetch_add(1);
+						}
+						delete foo;
+					}
+				});
+			}
+
+			for (int i = 0; i < 100; ++i)
+			{
+				class BarFactory final : public Factory<Foo>
+				{
+				public:
+					BarFactory() { Add(*this); }
+					~BarFactory() { Remove(*this); }
+					gsl::owner<Foo*> Create() const override { return new Foo(); }
+					const std::string& ClassName() const override { return mName; }
+				private:
+					const std::string mName = "Bar";
+				} barFactory;
+				Assert::IsTrue(Factory<Foo>::Find("Bar") == &barFactory);
+			}
+			done.store(true);
+			for (auto& worker : workers)
+			{
+				worker.join();
+			}
+
+			Assert::AreEqual(size_t(0), failures.load());
+			Assert::IsNull(Factory<Foo>::Find("Bar"));
+		}
+
+	private:
+		static _CrtMemState sStartMemState;
+	};
+
+	_CrtMemState ConcurrentRegistryTest::sStartMemState;
+}
@@ -3,11 +3,13 @@
 #include "Foo.h"
 #include "Datum.h"
 #include "Scope.h"
+#include <algorithm>
 
 using namespace Microsoft::VisualStudio::CppUnitTestFramework;
 using namespace GameEngine;
 using namespace std;
 using namespace std::string_literals;
+using namespace std::string_view_literals;
 using namespace glm;
 
 namespace Microsoft::VisualStudio::CppUnitTestFramework
@@ -952,6 +954,59 @@ namespace UnitTestLibraryDesktop
 			Assert::AreEqual(0_z, d.Capacity());
 		}
 
+		TEST_METHOD(TestInlineStorage)
+		{
+			auto isInline = [](const Datum& datum, const void* item)
+			{
+				const char* address = reinterpret_cast<const char*>(item);
+				return address >= reinterpret_cast<const char*>(&datum) && address < reinterpret_cast<const char*>(&datum + 1);
+			};
+
+			// Single scalar lives inside the Datum and spills on growth
+			Datum d = 5;
+			Assert::AreEqual(1_z, d.Capacity());
+			Assert::IsTrue(isInline(d, &d.Front<int32_t>()));
+			d.PushBack(6);
+			Assert::AreEqual(2_z, d.Capacity());
+			Assert::IsFalse(isInline(d, &d.Front<int32_t>()));
+			Assert::AreEqual(5, d.AsInt());
+			Assert::AreEqual(6, d.AsInt(1));
+			d.PopBack();
+			d.ShrinkToFit();
+			Assert::AreEqual(1_z, d.Capacity());
+			Assert::IsTrue(isInline(d, &d.Front<int32_t>()));
+			Assert::AreEqual(5, d.AsInt());
+			d.Reserve(4);
+			Assert::IsFalse(isInline(d, &d.Front<int32_t>()));
+			Assert::AreEqual(5, d.AsInt());
+
+			// Copy and move keep inline data inside their own object
+			Datum v = vec4(1.f, 2.f, 3.f, 4.f);
+			Assert::IsTrue(isInline(v, &v.Front<vec4>()));
+			Datum copy = v;
+			Assert::IsTrue(isInline(copy, &copy.Front<vec4>()));
+			Assert::AreEqual(vec4(1.f, 2.f, 3.f, 4.f), copy.AsVector());
+			Datum moved = std::move(copy);
+			Assert::IsTrue(isInline(moved, &moved.Front<vec4>()));
+			Assert::AreEqual(vec4(1.f, 2.f, 3.f, 4.f), moved.AsVector());
+			Assert::AreEqual(0_z, copy.Size());
+			Datum assigned;
+			assigned = std::move(moved);
+			Assert::IsTrue(isInline(assigned, &assigned.Front<vec4>()));
+			Assert::IsTrue(assigned == v);
+
+			Foo foo;
+			Datum p = &foo;
+			Assert::IsTrue(isInline(p, &p.Front<RTTI*>()));
+			Assert::IsTrue(p.AsPointer() == &foo);
+
+			// Strings and matrices always go to the heap
+			Datum s = "a"s;
+			Assert::IsFalse(isInline(s, &s.Front<std::string>()));
+			Datum m = mat4(1.f);
+			Assert::IsFalse(isInline(m, &m.Front<mat4>()));
+		}
+
 		TEST_METHOD(TestPopBack)
 		{
 			Datum d;
@@ -2386,6 +2441,144 @@ namespace UnitTestLibraryDesktop
 			}
 		}
 
+		TEST_METHOD(TestSetFromStringFormat)
+		{
+			Datum d;
+			d.SetType(Datum::DatumType::Integer);
+			d.SetSize(1);
+			Assert::IsTrue(d.SetFromString(" +12 "sv));
+			Assert::AreEqual(12, d.AsInt());
+			Assert::IsFalse(d.SetFromString("12abc"s));
+			Assert::IsFalse(d.SetFromString("1.5"s));
+			Assert::IsFalse(d.SetFromString("99999999999"s));
+			Assert::IsFalse(d.SetFromString(""s));
+			Assert::AreEqual(12, d.AsInt());
+
+			Datum v = vec4();
+			Assert::IsTrue(v.SetFromString("vec4(1,2 ,3,  4)"s));
+			Assert::AreEqual(vec4(1, 2, 3, 4), v.AsVector());
+			Assert::IsFalse(v.SetFromString("vec4(1, 2, 3)"s));
+			Assert::IsFalse(v.SetFromString("vec4(1, 2, 3, 4"s));
+			Assert::IsFalse(v.SetFromString("vec3(1, 2, 3, 4)"s));
+			Assert::AreEqual(vec4(1, 2, 3, 4), v.AsVector());
+
+			// Exact output parses back to the same value
+			Datum f = { 0.1f, 1.f / 3.f, 1e-30f, 3.4e38f, -2.5f, 16777216.f };
+			Datum parsed;
+			parsed.SetType(Datum::DatumType::Float);
+			parsed.SetSize(1);
+			for (size_t i = 0; i < f.Size(); ++i)
+			{
+				Assert::IsTrue(parsed.SetFromString(f.ToString(i, true)));
+				Assert::AreEqual(f.AsFloat(i), parsed.AsFloat());
+			}
+			Assert::AreEqual("0.1"s, f.ToString(0, true));
+			Assert::AreEqual("0.100000"s, f.ToString(0));
+			Assert::AreEqual("vec4(1, 2, 3, 4)"s, v.ToString(0, true));
+			Datum m = mat4(0.5f);
+			Assert::AreEqual("mat4x4((0.5, 0, 0, 0), (0, 0.5, 0, 0), (0, 0, 0.5, 0), (0, 0, 0, 0.5))"s, m.ToString(0, true));
+			Assert::IsTrue(m.SetFromString(Datum(mat4(1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16)).ToString(0, true)));
+			Assert::AreEqual(mat4(1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16), m.AsMatrix());
+
+			string text = "Value: ";
+			v.AppendString(text);
+			Assert::AreEqual("Value: vec4(1.000000, 2.000000, 3.000000, 4.000000)"s, text);
+		}
+
+		TEST_METHOD(TestSetFromStrings)
+		{
+			Datum ints = 9;
+			Assert::AreEqual(4_z, ints.SetFromStrings(" 1, 2,3 , +4 "sv, 1));
+			Assert::AreEqual(5_z, ints.Size());
+			for (int32_t i = 0; i < 5; ++i)
+			{
+				Assert::AreEqual(i == 0 ? 9 : i, ints.AsInt(i));
+			}
+			Assert::AreEqual(2_z, ints.SetFromStrings("7, 8, x, 10"s));
+			Assert::AreEqual(7, ints.AsInt(0));
+			Assert::AreEqual(8, ints.AsInt(1));
+			Assert::AreEqual(2, ints.AsInt(2));
+			Assert::AreEqual(5_z, ints.Size());
+
+			Datum floats;
+			floats.SetType(Datum::DatumType::Float);
+			Assert::AreEqual(3_z, floats.SetFromStrings("0.5, -1e3, 2"s));
+			Assert::AreEqual(-1000.f, floats.AsFloat(1));
+
+			Datum vectors;
+			vectors.SetType(Datum::DatumType::Vector);
+			Assert::AreEqual(2_z, vectors.SetFromStrings("vec4(1, 2, 3, 4), vec4(5, 6, 7, 8)"s));
+			Assert::AreEqual(vec4(5, 6, 7, 8), vectors.AsVector(1));
+
+			Datum matrices;
+			matrices.SetType(Datum::DatumType::Matrix);
+			Assert::AreEqual(2_z, matrices.SetFromStrings(Datum(mat4(1)).ToString() + ", " + Datum(mat4(2)).ToString()));
+			Assert::AreEqual(mat4(2), matrices.AsMatrix(1));
+
+			// External storage doesn't grow
+			int32_t array[2] = {};
+			Datum external;
+			external.SetStorage(array, 2);
+			Assert::AreEqual(2_z, external.SetFromStrings("1, 2, 3"s));
+			Assert::AreEqual(2, array[1]);
+
+			Datum strings = "a"s;
+			Assert::ExpectException<std::exception>([&strings] { strings.SetFromStrings("b, c"s); });
+		}
+
+		TEST_METHOD(TestParseRoundTrip)
+		{
+			// Shape of a level file: many vectors written exactly and loaded back
+			const size_t count = 200;
+			Datum source;
+			for (size_t i = 0; i < count; ++i)
+			{
+				const float value = static_cast<float>(i) * 0.37f;
+				source.PushBack(vec4(value, -value, value * 0.5f, 1.f));
+			}
+			Vector<string> lines;
+			string text;
+			for (size_t i = 0; i < count; ++i)
+			{
+				lines.PushBack(source.ToString(i, true));
+				text.append(i > 0 ? ", " : "").append(lines[i]);
+			}
+
+			Datum single;
+			single.SetType(Datum::DatumType::Vector);
+			single.SetSize(count);
+			for (size_t i = 0; i < count; ++i)
+			{
+				Assert::IsTrue(single.SetFromString(lines[i], i));
+			}
+			Assert::IsTrue(single == source);
+
+			Datum bulk;
+			bulk.SetType(Datum::DatumType::Vector);
+			Assert::AreEqual(count, bulk.SetFromStrings(text));
+			Assert::IsTrue(bulk == source);
+
+			// Trailing garbage is rejected and leaves the value alone
+			Assert::IsFalse(single.SetFromString(lines[1] + " x", 0));
+			Assert::IsFalse(single.SetFromString(lines[1] + lines[2], 0));
+			Assert::AreEqual(source.AsVector(0), single.AsVector(0));
+
+			// A bad entry ends the list, values before it are kept
+			Datum partial;
+			partial.SetType(Datum::DatumType::Vector);
+			Assert::AreEqual(2_z, partial.SetFromStrings(lines[0] + ", " + lines[1] + ", vec4(x), " + lines[2]));
+			Assert::AreEqual(2_z, partial.Size());
+			Assert::AreEqual(source.AsVector(1), partial.AsVector(1));
+
+			// External storage stops at its size, elements after it are left unparsed
+			vec4 array[2] = {};
+			Datum external;
+			external.SetStorage(array, 2);
+			Assert::AreEqual(2_z, external.SetFromStrings(text));
+			Assert::AreEqual(2_z, external.Size());
+			Assert::AreEqual(source.AsVector(1), array[1]);
+		}
+
 		TEST_METHOD(TestSetStorageInt)
 		{
 			Datum d;
@@ -3330,6 +3523,210 @@ namespace UnitTestLibraryDesktop
 			Assert::AreEqual(15, sum);
 		}
 
+		TEST_METHOD(TestCompute)
+		{
+			using Operation = Datum::ArithmeticOperation;
+
+			// Element-wise int, with a size that leaves a tail after the vectorized blocks
+			Datum left;
+			Datum right;
+			for (int32_t i = 0; i < 37; ++i)
+			{
+				left.PushBack(i);
+				right.PushBack(2 * i + 1);
+			}
+			Datum result;
+			Datum::Compute(Operation::Add, left, right, result);
+			Assert::AreEqual(Datum::DatumType::Integer, result.Type());
+			Assert::AreEqual(37_z, result.Size());
+			for (int32_t i = 0; i < 37; ++i)
+			{
+				Assert::AreEqual(3 * i + 1, result.AsInt(i));
+			}
+			Datum::Compute(Operation::Multiply, left, right, result);
+			Datum::Compute(Operation::Subtract, result, Datum(5), result);
+			Datum::Compute(Operation::Divide, result, Datum(2), result);
+			Datum::Compute(Operation::Modulus, Datum(100), right, right);
+			for (int32_t i = 0; i < 37; ++i)
+			{
+				Assert::AreEqual((i * (2 * i + 1) - 5) / 2, result.AsInt(i));
+				Assert::AreEqual(100 % (2 * i + 1), right.AsInt(i));
+			}
+
+			// Mixing int and float gives float, long enough to be converted in several chunks
+			Datum floats;
+			for (int32_t i = 0; i < 150; ++i)
+			{
+				floats.PushBack(i * 0.5f);
+			}
+			Datum ints;
+			ints.SetType(Datum::DatumType::Integer);
+			ints.SetSize(150);
+			Datum mixed;
+			Datum::Compute(Operation::Add, ints, floats, mixed);
+			Datum::Compute(Operation::Multiply, Datum(2), mixed, mixed);
+			Datum::Compute(Operation::Modulus, mixed, Datum(7.9f), ints);
+			Assert::AreEqual(Datum::DatumType::Float, mixed.Type());
+			for (int32_t i = 0; i < 150; ++i)
+			{
+				Assert::AreEqual(static_cast<float>(i), mixed.AsFloat(i));
+				Assert::AreEqual(i % 7, ints.AsInt(i));
+			}
+
+			// Vectors, with a single vector or number applied to all
+			Datum vectors = { vec4(1.f), vec4(2.f), vec4(3.f) };
+			Datum vectorResult;
+			Datum::Compute(Operation::Multiply, vectors, Datum(vec4(1.f, 2.f, 3.f, 4.f)), vectorResult);
+			Datum::Compute(Operation::Add, vectorResult, Datum(1), vectorResult);
+			Assert::AreEqual(Datum::DatumType::Vector, vectorResult.Type());
+			for (size_t i = 0; i < 3; ++i)
+			{
+				const float scale = static_cast<float>(i + 1);
+				Assert::AreEqual(vec4(scale + 1.f, 2.f * scale + 1.f, 3.f * scale + 1.f, 4.f * scale + 1.f), vectorResult.AsVector(i));
+			}
+			Datum::Compute(Operation::Divide, Datum(6.f), vectors, vectors);
+			Assert::AreEqual(vec4(2.f), vectors.AsVector(2));
+
+			// A single operand that is also the destination still repeats over every element
+			Datum single(5);
+			Datum::Compute(Operation::Add, single, Datum({ 1, 2, 3 }), single);
+			Assert::AreEqual(3_z, single.Size());
+			Assert::AreEqual(6, single.AsInt(0));
+			Assert::AreEqual(7, single.AsInt(1));
+			Assert::AreEqual(8, single.AsInt(2));
+			Datum scale(2.f);
+			Datum::Compute(Operation::Multiply, Datum({ 1.f, 2.f, 3.f }), scale, scale);
+			Assert::AreEqual(3_z, scale.Size());
+			Assert::AreEqual(2.f, scale.AsFloat(0));
+			Assert::AreEqual(4.f, scale.AsFloat(1));
+			Assert::AreEqual(6.f, scale.AsFloat(2));
+			Datum offset(vec4(1.f, 2.f, 3.f, 4.f));
+			Datum::Compute(Operation::Subtract, offset, Datum({ vec4(1.f), vec4(2.f) }), offset);
+			Assert::AreEqual(vec4(0.f, 1.f, 2.f, 3.f), offset.AsVector(0));
+			Assert::AreEqual(vec4(-1.f, 0.f, 1.f, 2.f), offset.AsVector(1));
+
+			// Matrices, multiply and divide are matrix products
+			mat4 transform(2.f);
+			transform[3] = vec4(1.f, 2.f, 3.f, 1.f);
+			Datum matrices = { mat4(1.f), transform };
+			Datum matrixResult;
+			Datum::Compute(Operation::Multiply, matrices, Datum(transform), matrixResult);
+			Assert::AreEqual(Datum::DatumType::Matrix, matrixResult.Type());
+			Assert::AreEqual(transform, matrixResult.AsMatrix(0));
+			Assert::AreEqual(transform * transform, matrixResult.AsMatrix(1));
+			Datum::Compute(Operation::Divide, matrixResult, matrices, matrixResult);
+			Assert::AreEqual(transform, matrixResult.AsMatrix(1));
+			Datum::Compute(Operation::Add, matrices, matrices, matrixResult);
+			Assert::AreEqual(transform + transform, matrixResult.AsMatrix(1));
+			Datum::Compute(Operation::Subtract, matrices, Datum(mat4(1.f)), matrixResult);
+			Assert::AreEqual(mat4(0.f), matrixResult.AsMatrix(0));
+			Assert::AreEqual(transform - mat4(1.f), matrixResult.AsMatrix(1));
+			Datum::Compute(Operation::Multiply, Datum(0.5f), matrices, matrixResult);
+			Assert::AreEqual(transform * 0.5f, matrixResult.AsMatrix(1));
+
+			// External destination
+			float array[3] = {};
+			Datum external;
+			external.SetStorage(array, 3);
+			Datum::Compute(Operation::Subtract, Datum({ 1.f, 2.f, 3.f }), Datum(1), external);
+			Assert::AreEqual(2.f, array[2]);
+
+			// Errors
+			Assert::ExpectException<std::exception>([&left] { Datum sink; Datum::Compute(Operation::Add, left, Datum({ 1, 2 }), sink); });
+			Assert::ExpectException<std::exception>([&external] { Datum::Compute(Operation::Add, Datum({ 1.f, 2.f }), Datum(1.f), external); });
+			Assert::ExpectException<std::exception>([&left, &floats] { Datum::Compute(Operation::Add, left, Datum(1), floats); });
+			Assert::ExpectException<std::exception>([&vectors] { Datum sink; Datum::Compute(Operation::Modulus, vectors, Datum(2), sink); });
+			Assert::ExpectException<std::exception>([&vectors] { Datum sink; Datum::Compute(Operation::Add, vectors, Datum({ 1.f, 2.f, 3.f }), sink); });
+			Assert::ExpectException<std::exception>([] { Datum sink; Datum::Compute(Operation::Add, Datum("a"s), Datum("b"s), sink); });
+		}
+
+		TEST_METHOD(TestCopyOnWrite)
+		{
+			Datum ints = { 1, 2, 3, 4 };
+			Datum strings = { "a"s, "b"s, "c"s };
+			Datum single = 5;
+			Datum matrix = mat4(2.f);
+
+			// Plain copies never share
+			{
+				Datum copy = ints;
+				Assert::IsFalse(copy.IsShared());
+				Assert::AreNotSame(ints.AsInt(), copy.AsInt());
+			}
+
+			CopyOnWriteGuard guard;
+			Datum intsCopy = ints;
+			Datum stringsCopy(strings);
+			Datum singleCopy = single;
+			Datum matrixCopy = matrix;
+			Assert::IsTrue(ints.IsShared());
+			Assert::IsTrue(intsCopy.IsShared());
+			Assert::IsTrue(stringsCopy.IsShared());
+			Assert::IsTrue(matrixCopy.IsShared());
+			Assert::IsFalse(singleCopy.IsShared());  // Inline storage is always copied
+			const Datum& constCopy = intsCopy;
+			Assert::AreSame(static_cast<const Datum&>(ints).AsInt(2), constCopy.AsInt(2));
+			Assert::IsTrue(ints == intsCopy);
+
+			// First write detaches, the source keeps the original values
+			intsCopy.Set(10, 1);
+			Assert::IsFalse(intsCopy.IsShared());
+			Assert::IsFalse(ints.IsShared());
+			Assert::AreEqual(2, ints.AsInt(1));
+			Assert::AreEqual(10, intsCopy.AsInt(1));
+			stringsCopy.PushBack("d"s);
+			Assert::AreEqual(3_z, strings.Size());
+			Assert::AreEqual(4_z, stringsCopy.Size());
+			Assert::AreEqual("c"s, stringsCopy.AsString(2));
+			matrixCopy.AsMatrix() = mat4(3.f);
+			Assert::AreEqual(mat4(2.f), matrix.AsMatrix());
+
+			// Writing to the source detaches it and leaves the copies alone
+			Datum first = ints;
+			Datum second = ints;
+			ints.RemoveAt(0);
+			Assert::AreEqual(3_z, ints.Size());
+			Assert::IsTrue(first.IsShared());
+			Assert::AreEqual(1, first.AsInt());
+			Assert::IsFalse(second.IsShared());
+			Assert::AreEqual(4_z, second.Size());
+
+			// Clearing, resizing and moving a shared Datum
+			Datum third = strings;
+			Datum fourth = strings;
+			third.Clear();
+			Assert::AreEqual(0_z, third.Size());
+			Assert::AreEqual(3_z, strings.Size());
+			third.PushBack("x"s);
+			Assert::AreEqual("x"s, third.AsString());
+			fourth.SetSize(1);
+			Assert::AreEqual("a"s, fourth.AsString());
+			Assert::AreEqual(3_z, strings.Size());
+			Datum fifth = strings;
+			Datum moved = std::move(fifth);
+			Assert::IsTrue(moved.IsShared());
+			moved = fourth;
+			Assert::IsFalse(strings.IsShared());
+			Assert::IsTrue(fourth.IsShared());
+
+			// External storage is never shared
+			int32_t array[2] = { 1, 2 };
+			Datum external;
+			external.SetStorage(array, 2);
+			Datum externalCopy = external;
+			Assert::IsFalse(externalCopy.IsShared());
+			Assert::AreSame(array[0], externalCopy.AsInt());
+
+			// Guards nest
+			{
+				CopyOnWriteGuard disable(false);
+				Datum copy = strings;
+				Assert::IsFalse(copy.IsShared());
+			}
+			Datum copy = strings;
+			Assert::IsTrue(copy.IsShared());
+		}
+
 	private:
 		static _CrtMemState sStartMemState;
 	};
@@ -0,0 +1,399 @@
+#include "pch.h"
+#include "CppUnitTest.h"
+#include "Foo.h"
+#include "FlatHashMap.h"
+#include "HashMap.h"
+#include <set>
+#include <chrono>
+#include <string>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using namespace GameEngine;
+
+struct FlatFooHashFunction
+{
+	size_t operator()(const Foo& foo) const
+	{
+		return foo.Data();
+	}
+};
+
+struct FlatFooCompareFunction
+{
+	bool operator()(const Foo& foo1, const Foo& foo2) const
+	{
+		return foo1.Data() == foo2.Data();
+	}
+};
+
+using FlatFooMap = FlatHashMap<Foo, int, FlatFooHashFunction, FlatFooCompareFunction>;
+
+namespace Microsoft::VisualStudio::CppUnitTestFramework
+{
+	template<>
+	inline std::wstring ToString<FlatFooMap::Iterator>(const FlatFooMap::Iterator& it)
+	{
+		try
+		{
+			RETURN_WIDE_STRING((*it).first.Data());
+		}
+		catch (std::exception e)
+		{
+			return L"Iterator points to nothing";
+		}
+	}
+
+	template<>
+	inline std::wstring ToString<FlatFooMap::ConstIterator>(const FlatFooMap::ConstIterator& it)
+	{
+		try
+		{
+			RETURN_WIDE_STRING((*it).first.Data());
+		}
+		catch (std::exception e)
+		{
+			return L"Iterator points to nothing";
+		}
+	}
+}
+
+namespace UnitTestLibraryDesktop
+{
+	TEST_CLASS(FlatHashMapTest)
+	{
+	public:
+
+		TEST_METHOD_INITIALIZE(Initialize)
+		{
+#if defined(DEBUG) || defined(_DEBUG)
+			_CrtSetDbgFlag(_CRTDBG_ALLOC_MEM_DF);
+			_CrtMemCheckpoint(&sStartMemState);
+#endif
+		}
+
+		TEST_METHOD_CLEANUP(Cleanup)
+		{
+#if defined(DEBUG) || defined(_DEBUG)
+			_CrtMemState endMemState, diffMemState;
+			_CrtMemCheckpoint(&endMemState);
+			if (_CrtMemDifference(&diffMemState, &sStartMemState, &endMemState))
+			{
+				_CrtMemDumpStatistics(&diffMemState);
+				Assert::Fail(L"Memory Leaks!");
+			}
+#endif
+		}
+
+		TEST_METHOD(TestConstructor)
+		{
+			FlatHashMap<Foo, int> map;
+			Assert::AreEqual(size_t(0), map.Size());
+			Assert::IsTrue(map.IsEmpty());
+			Assert::AreEqual(size_t(64), map.BucketCount());
+
+			FlatHashMap<Foo, int> map2(0);
+			Assert::AreEqual(size_t(16), map2.BucketCount());
+
+			FlatFooMap map3 =
+			{
+				std::make_pair(Foo(1), 1),
+				std::make_pair(Foo(2), 2),
+				std::make_pair(Foo(3), 3),
+				std::make_pair(Foo(4), 4)
+			};
+			Assert::AreEqual(size_t(4), map3.Size());
+			Assert::IsTrue(map3.ContainsKey(Foo(1)));
+			Assert::IsTrue(map3.ContainsKey(Foo(2)));
+			Assert::IsTrue(map3.ContainsKey(Foo(3)));
+			Assert::IsTrue(map3.ContainsKey(Foo(4)));
+		}
+
+		TEST_METHOD(TestCopyMove)
+		{
+			FlatFooMap map;
+			map.Insert(std::make_pair(Foo(1), 1));
+			map.Insert(std::make_pair(Foo(2), 2));
+			map.Insert(std::make_pair(Foo(3), 3));
+
+			FlatFooMap map2 = map;
+			Assert::AreEqual(size_t(3), map.Size());
+			Assert::AreEqual(size_t(3), map2.Size());
+			Assert::AreEqual(2, map2.At(Foo(2)));
+			Assert::AreNotSame(map.At(Foo(2)), map2.At(Foo(2)));
+
+			FlatFooMap map3 = std::move(map);
+			Assert::AreEqual(size_t(0), map.Size());
+			Assert::AreEqual(size_t(3), map3.Size());
+			Assert::IsFalse(map.ContainsKey(Foo(1)));
+			Assert::AreEqual(map.end(), map.begin());
+
+			// Moved-from map is still usable
+			map[Foo(10)] = 10;
+			Assert::AreEqual(10, map.At(Foo(10)));
+
+			map2 = map;
+			Assert::AreEqual(size_t(1), map2.Size());
+			Assert::IsFalse(map2.ContainsKey(Foo(1)));
+			Assert::IsTrue(map2.ContainsKey(Foo(10)));
+
+			map2 = std::move(map3);
+			Assert::AreEqual(size_t(3), map2.Size());
+			Assert::AreEqual(size_t(0), map3.Size());
+			Assert::AreEqual(3, map2.At(Foo(3)));
+		}
+
+		TEST_METHOD(TestInsert)
+		{
+			FlatFooMap map;
+			auto [it, inserted] = map.Insert(std::make_pair(Foo(1), 1));
+			Assert::IsTrue(inserted);
+			Assert::AreEqual(1, it->second);
+
+			auto [it2, inserted2] = map.Insert(std::make_pair(Foo(1), 2));
+			Assert::IsFalse(inserted2);
+			Assert::AreEqual(it, it2);
+			Assert::AreEqual(1, it2->second);
+
+			for (int i = 0; i < 1000; ++i)
+			{
+				auto result = map.Insert(std::make_pair(Foo(i + 2), i));
+				Assert::IsTrue(result.second);
+				Assert::AreEqual(size_t(i + 2), map.Size());
+				Assert::AreEqual(i, map.Find(Foo(i + 2))->second);
+			}
+
+			for (int i = 0; i < 1000; ++i)
+			{
+				Assert::AreEqual(i, map.At(Foo(i + 2)));
+			}
+		}
+
+		TEST_METHOD(TestReferenceStability)
+		{
+			FlatHashMap<std::string, int> map(0);
+			int& value = map["Stable"];
+			value = 42;
+			const size_t bucketCount = map.BucketCount();
+
+			for (int i = 0; i < 500; ++i)
+			{
+				map["Key" + std::to_string(i)] = i;
+			}
+			Assert::IsTrue(map.BucketCount() > bucketCount);
+			Assert::AreSame(value, map["Stable"]);
+
+			map.Resize(0);
+			Assert::AreSame(value, map["Stable"]);
+			Assert::AreEqual(42, value);
+		}
+
+		TEST_METHOD(TestRemove)
+		{
+			FlatFooMap map;
+			map.Remove(Foo(1));
+			Assert::IsTrue(map.IsEmpty());
+
+			{
+				FlatFooMap::Iterator it;
+				auto lamda = [&it, &map]()
+				{
+					map.Remove(it);
+				};
+				Assert::ExpectException<std::exception>(lamda);
+			}
+
+			map.Insert(std::make_pair(Foo(1), 1));
+			map.Insert(std::make_pair(Foo(2), 2));
+			map.Insert(std::make_pair(Foo(3), 3));
+			map.Remove(Foo(4));
+			Assert::AreEqual(size_t(3), map.Size());
+			map.Remove(Foo(1));
+			Assert::AreEqual(size_t(2), map.Size());
+			Assert::IsFalse(map.ContainsKey(Foo(1)));
+			map.Remove(map.Find(Foo(2)));
+			Assert::IsFalse(map.ContainsKey(Foo(2)));
+			map.Remove(Foo(3));
+			Assert::AreEqual(size_t(0), map.Size());
+
+			// Churn through the same slots, deleted slots must be reused or purged instead of growing forever
+			const size_t bucketCount = map.BucketCount();
+			for (int round = 0; round < 100; ++round)
+			{
+				for (int i = 0; i < 20; ++i)
+				{
+					map.Insert(std::make_pair(Foo(round * 20 + i), i));
+				}
+				for (int i = 0; i < 20; ++i)
+				{
+					Assert::AreEqual(i, map.At(Foo(round * 20 + i)));
+					map.Remove(Foo(round * 20 + i));
+				}
+			}
+			Assert::IsTrue(map.IsEmpty());
+			Assert::AreEqual(bucketCount, map.BucketCount());
+		}
+
+		TEST_METHOD(TestFindAndAccess)
+		{
+			FlatFooMap map;
+			Assert::AreEqual(map.end(), map.Find(Foo()));
+			map.Insert(std::make_pair(Foo(1), 1));
+			map.Insert(std::make_pair(Foo(2), 2));
+			Assert::AreEqual(1, map.Find(Foo(1))->second);
+			Assert::AreEqual(map.end(), map.Find(Foo(3)));
+
+			FlatFooMap::Iterator it;
+			Assert::IsTrue(map.ContainsKey(Foo(2), it));
+			Assert::AreEqual(2, it->second);
+			Assert::IsFalse(map.ContainsKey(Foo(3), it));
+			Assert::AreEqual(map.end(), it);
+
+			map[Foo(3)] = 3;
+			Assert::AreEqual(size_t(3), map.Size());
+			Assert::AreEqual(3, map.At(Foo(3)));
+
+			const FlatFooMap& constMap = map;
+			FlatFooMap::ConstIterator cit;
+			Assert::IsTrue(constMap.ContainsKey(Foo(3), cit));
+			Assert::AreEqual(3, constMap[Foo(3)]);
+			auto lamda = [&constMap]()
+			{
+				constMap[Foo(5)];
+			};
+			Assert::ExpectException<std::exception>(lamda);
+		}
+
+		TEST_METHOD(TestIterator)
+		{
+			FlatFooMap map =
+			{
+				std::make_pair(Foo(1), 1),
+				std::make_pair(Foo(2), 2),
+				std::make_pair(Foo(3), 3),
+				std::make_pair(Foo(4), 4)
+			};
+
+			std::set<int> set = { 1, 2, 3, 4 };
+			for (const auto& pair : map)
+			{
+				set.erase(pair.second);
+			}
+			Assert::IsTrue(set.empty());
+
+			auto it = map.begin();
+			set = { 1, 2, 3, 4 };
+			for (int i = 0; i < 4; ++i)
+			{
+				set.erase(it++->second);
+			}
+			Assert::AreEqual(map.end(), it);
+			Assert::AreEqual(map.end(), ++it);
+			Assert::IsTrue(set.empty());
+
+			FlatFooMap::ConstIterator cit = map.cbegin();
+			Assert::AreEqual(FlatFooMap::ConstIterator(map.begin()), cit);
+			cit = map.end();
+			Assert::AreEqual(map.cend(), cit);
+			auto dereferenceLamda = [&cit]()
+			{
+				*cit;
+			};
+			Assert::ExpectException<std::exception>(dereferenceLamda);
+
+			FlatFooMap::Iterator empty;
+			auto incrementLamda = [&empty]()
+			{
+				++empty;
+			};
+			Assert::ExpectException<std::exception>(incrementLamda);
+		}
+
+		TEST_METHOD(TestClear)
+		{
+			FlatFooMap map;
+			for (int i = 0; i < 100; ++i)
+			{
+				map[Foo(i)] = i;
+			}
+			const size_t bucketCount = map.BucketCount();
+			map.Clear();
+			Assert::IsTrue(map.IsEmpty());
+			Assert::AreEqual(map.end(), map.begin());
+			Assert::AreEqual(bucketCount, map.BucketCount());
+			Assert::IsFalse(map.ContainsKey(Foo(1)));
+		}
+
+		TEST_METHOD(TestLookupBenchmark)
+		{
+			// Scope-like workload: many small string keys, lookups are mostly misses
+			const int keyCount = 20000;
+			const int rounds = 10;
+			Vector<std::string> keys(keyCount);
+			Vector<std::string> misses(keyCount);
+			for (int i = 0; i < keyCount; ++i)
+			{
+				keys.PushBack("Attribute" + std::to_string(i));
+				misses.PushBack("Missing" + std::to_string(i));
+			}
+
+			HashMap<std::string, int> chained(keyCount);
+			FlatHashMap<std::string, int> flat(keyCount);
+			for (int i = 0; i < keyCount; ++i)
+			{
+				chained.Insert(std::make_pair(keys[i], i));
+				flat.Insert(std::make_pair(keys[i], i));
+			}
+
+			auto measure = [&](auto& map)
+			{
+				size_t found = 0;
+				auto start = std::chrono::high_resolution_clock::now();
+				for (int round = 0; round < rounds; ++round)
+				{
+					for (int i = 0; i < keyCount; ++i)
+					{
+						found += map.ContainsKey(keys[i]);
+						found += map.ContainsKey(misses[i]);
+					}
+				}
+				auto duration = std::chrono::high_resolution_clock::now() - start;
+				Assert::AreEqual(size_t(keyCount * rounds), found);
+				return std::chrono::duration_cast<std::chrono::microseconds>(duration).count();
+			};
+
+			const long long chainedTime = measure(chained);
+			const long long flatTime = measure(flat);
+			Logger::WriteMessage(("HashMap lookup: " + std::to_string(chainedTime) + "us, FlatHashMap lookup: " + std::to_string(flatTime) + "us\n").c_str());
+		}
+
+		TEST_METHOD(TestHeterogeneousLookup)
+		{
+			FlatHashMap<std::string, int> map = { { "Actions", 1 }, { "Entities", 2 } };
+			const std::string buffer = "EntitiesSectors";
+			const std::string_view entities(buffer.data(), 8);
+			const std::string_view sectors(buffer.data() + 8, 7);
+
+			Assert::AreEqual(2, map.Find(entities)->second);
+			Assert::AreEqual(1, map.Find("Actions")->second);
+			Assert::IsTrue(map.Find(sectors) == map.end());
+			Assert::IsTrue(map.ContainsKey(entities));
+			Assert::IsFalse(map.ContainsKey(sectors));
+
+			const FlatHashMap<std::string, int>& constMap = map;
+			Assert::AreEqual(2, constMap.Find(entities)->second);
+			Assert::IsTrue(constMap.Find(sectors) == constMap.end());
+
+			// Iterator from a view can be used to modify and remove
+			map.Find(entities)->second = 20;
+			Assert::AreEqual(20, map.At("Entities"));
+			map.Remove(map.Find(entities));
+			Assert::IsFalse(map.ContainsKey("Entities"));
+			Assert::AreEqual(size_t(1), map.Size());
+		}
+
+	private:
+		static _CrtMemState sStartMemState;
+	};
+
+	_CrtMemState FlatHashMapTest::sStartMemState;
+}
@@ -2,6 +2,11 @@
 #include "CppUnitTest.h"
 #include "Foo.h"
 #include "DefaultHashFunction.h"
+#include "RTTI.h"
+#include <chrono>
+#include <string>
+#include <vector>
+#include <set>
 
 using namespace Microsoft::VisualStudio::CppUnitTestFramework;
 using namespace GameEngine;
@@ -42,6 +47,82 @@ struct DefaultKeyEquality<Foo>
 	}
 };
 
+namespace
+{
+	/// <summary>
+	/// Chain statistics of a key set distributed with hash % bucketCount, same as HashMap
+	/// </summary>
+	struct ChainStatistics
+	{
+		size_t MaxChainLength = 0;
+		size_t EmptyBuckets = 0;
+		size_t Collisions = 0;
+		double AverageComparisons = 0.0;
+
+		std::string ToString() const
+		{
+			return "max chain " + std::to_string(MaxChainLength) + ", empty buckets " + std::to_string(EmptyBuckets)
+				+ ", full hash collisions " + std::to_string(Collisions) + ", comparisons per hit " + std::to_string(AverageComparisons);
+		}
+	};
+
+	template <typename TKey, typename THash>
+	ChainStatistics ComputeChainStatistics(const std::vector<TKey>& keys, size_t bucketCount, THash hash)
+	{
+		ChainStatistics statistics;
+		std::vector<size_t> chainLengths(bucketCount);
+		std::set<size_t> hashes;
+		for (const auto& key : keys)
+		{
+			const size_t value = hash(key);
+			statistics.Collisions += hashes.insert(value).second ? 0 : 1;
+			++chainLengths[value % bucketCount];
+		}
+
+		size_t comparisons = 0;
+		for (size_t length : chainLengths)
+		{
+			statistics.MaxChainLength = std::max(statistics.MaxChainLength, length);
+			statistics.EmptyBuckets += length == 0 ? 1 : 0;
+			comparisons += length * (length + 1) / 2;
+		}
+		statistics.AverageComparisons = static_cast<double>(comparisons) / keys.size();
+		return statistics;
+	}
+
+	/// <summary>
+	/// The additive hash used before, kept to compare quality and throughput
+	/// </summary>
+	size_t ByteSumHash(const std::string& key)
+	{
+		size_t hash = 0;
+		for (char c : key)
+		{
+			hash += 13 * c;
+		}
+		return hash;
+	}
+
+	/// <summary>
+	/// Keys found in attributed signatures and world files, plus generated names of auxiliary attributes
+	/// </summary>
+	std::vector<std::string> ScopeKeys()
+	{
+		std::vector<std::string> keys = { "this", "Name", "Active", "Actions", "Entities", "Sectors", "Reactions", "Transform", "Position", "Rotation", "Scale",
+			"Int", "Float", "Vector", "Matrix", "String", "Pointer", "IntArray", "FloatArray", "VectorArray", "MatrixArray", "StringArray", "PointerArray",
+			"InternalInt", "InternalFloat", "InternalVector", "InternalMatrix", "InternalString", "InternalPointer", "InternalIntArray", "InternalFloatArray",
+			"InternalVectorArray", "InternalMatrixArray", "InternalStringArray", "InternalPointerArray", "InternalScopeArray", "InternalScopeEmpty",
+			"Value", "Tags", "Radius", "MouseButtons", "Press", "class", "objs" };
+		for (int i = 0; i < 200; ++i)
+		{
+			keys.push_back("Entity" + std::to_string(i));
+			keys.push_back("Action_" + std::to_string(i));
+			keys.push_back("AuxiliaryAttribute" + std::to_string(i));
+		}
+		return keys;
+	}
+}
+
 namespace UnitTestLibraryDesktop
 {
 	TEST_CLASS(HashFunctionTest)
@@ -238,6 +319,98 @@ namespace UnitTestLibraryDesktop
 			Assert::IsFalse(func(b, c));
 		}
 
+		TEST_METHOD(TestHashQuality)
+		{
+			DefaultHash<std::string> func;
+
+			// Anagrams and keys differing in one bit don't collide
+			Assert::AreNotEqual(func("Name"), func("mNae"));
+			Assert::AreNotEqual(func("Actions"), func("Sactoin"));
+			Assert::AreNotEqual(func("ab"), func("ba"));
+			Assert::AreNotEqual(func("A"), func("C"));
+			Assert::AreNotEqual(func(""), func(std::string(1, '\0')));
+
+			// Every length goes through a different read path, all bytes must matter
+			std::set<size_t> hashes;
+			size_t count = 0;
+			for (size_t length = 0; length < 120; ++length)
+			{
+				std::string key(length, 'x');
+				hashes.insert(func(key));
+				++count;
+				for (size_t i = 0; i < length; ++i)
+				{
+					std::string changed(key);
+					changed[i] ^= 1;
+					hashes.insert(func(changed));
+					++count;
+				}
+			}
+			Assert::AreEqual(count, hashes.size());
+
+			// Chain lengths on scope keys should be close to random placement
+			const std::vector<std::string> keys = ScopeKeys();
+			for (size_t bucketCount : { size_t(64), keys.size(), size_t(4096) })
+			{
+				const ChainStatistics statistics = ComputeChainStatistics(keys, bucketCount, func);
+				const ChainStatistics oldStatistics = ComputeChainStatistics(keys, bucketCount, ByteSumHash);
+				Logger::WriteMessage(("Keys " + std::to_string(keys.size()) + ", buckets " + std::to_string(bucketCount)
+					+ "\n  DefaultHash: " + statistics.ToString() + "\n  ByteSumHash: " + oldStatistics.ToString() + "\n").c_str());
+
+				// Random placement averages 1 + load / 2 comparisons per hit
+				const double load = static_cast<double>(keys.size()) / bucketCount;
+				Assert::AreEqual(size_t(0), statistics.Collisions);
+				Assert::IsTrue(statistics.AverageComparisons < 1.2 * (1.0 + load / 2.0));
+				Assert::IsTrue(statistics.AverageComparisons <= oldStatistics.AverageComparisons);
+			}
+
+			// Sequential ids and aligned pointers still spread over the low bits
+			std::vector<RTTI::IdType> ids;
+			std::vector<const int*> pointers;
+			static int sArray[1024];
+			for (size_t i = 0; i < 1024; ++i)
+			{
+				ids.push_back(RTTI::IdType(i) << 12);
+				pointers.push_back(sArray + i);
+			}
+			const ChainStatistics idStatistics = ComputeChainStatistics(ids, 1024, DefaultHash<RTTI::IdType>());
+			const ChainStatistics pointerStatistics = ComputeChainStatistics(pointers, 1024, DefaultHash<const int*>());
+			Logger::WriteMessage(("RTTI::IdType: " + idStatistics.ToString() + "\nPointer: " + pointerStatistics.ToString() + "\n").c_str());
+			Assert::IsTrue(idStatistics.MaxChainLength <= 8);
+			Assert::IsTrue(pointerStatistics.MaxChainLength <= 8);
+		}
+
+		TEST_METHOD(TestHashThroughput)
+		{
+			const std::vector<std::string> keys = ScopeKeys();
+			const int rounds = 200;
+			size_t bytes = 0;
+			for (const auto& key : keys)
+			{
+				bytes += key.length() * rounds;
+			}
+
+			size_t checksum = 0;
+			auto measure = [&keys, &checksum, rounds](auto hash)
+			{
+				auto start = std::chrono::high_resolution_clock::now();
+				for (int round = 0; round < rounds; ++round)
+				{
+					for (const auto& key : keys)
+					{
+						checksum += hash(key);
+					}
+				}
+				auto duration = std::chrono::high_resolution_clock::now() - start;
+				return std::max(1LL, static_cast<long long>(std::chrono::duration_cast<std::chrono::microseconds>(duration).count()));
+			};
+
+			const long long defaultTime = measure(DefaultHash<std::string>());
+			const long long byteSumTime = measure(ByteSumHash);
+			Logger::WriteMessage(("DefaultHash: " + std::to_string(defaultTime) + "us (" + std::to_string(bytes / defaultTime) + " MB/s), ByteSumHash: "
+				+ std::to_string(byteSumTime) + "us (" + std::to_string(bytes / byteSumTime) + " MB/s), checksum " + std::to_string(checksum) + "\n").c_str());
+		}
+
 	private:
 		static _CrtMemState sStartMemState;
 	};
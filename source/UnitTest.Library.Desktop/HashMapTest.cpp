@@ -1040,6 +1040,191 @@ namespace UnitTestLibraryDesktop
 			Assert::IsTrue(set.empty());
 		}
 
+		TEST_METHOD(TestMaxLoadFactor)
+		{
+			HashMap<Foo, int, FooHashFunction, FooCompareFunction> map(4);
+			Assert::AreEqual(1.0f, map.MaxLoadFactor());
+			Assert::AreEqual(0.0f, map.LoadFactor());
+			Assert::ExpectException<std::exception>([&map] { map.SetMaxLoadFactor(0.0f); });
+			Assert::ExpectException<std::exception>([&map] { map.SetMaxLoadFactor(-1.0f); });
+			Assert::AreEqual(1.0f, map.MaxLoadFactor());
+
+			map.SetMaxLoadFactor(2.0f);
+			for (int i = 0; i < 8; ++i)
+			{
+				map.Insert(std::make_pair(Foo(i), i));
+			}
+			Assert::AreEqual(size_t(4), map.BucketCount());
+			Assert::AreEqual(2.0f, map.LoadFactor());
+
+			map[Foo(8)] = 8;
+			Assert::AreEqual(size_t(8), map.BucketCount());
+			Assert::IsTrue(map.LoadFactor() <= map.MaxLoadFactor());
+		}
+
+		TEST_METHOD(TestAutomaticGrowth)
+		{
+			HashMap<Foo, int, FooHashFunction, FooCompareFunction> map(1);
+			Assert::AreEqual(size_t(1), map.BucketCount());
+
+			for (int i = 0; i < 100; ++i)
+			{
+				map.Insert(std::make_pair(Foo(i), i));
+				Assert::IsTrue(map.LoadFactor() <= map.MaxLoadFactor());
+				Assert::IsFalse(map.IsRehashing());
+			}
+			Assert::AreEqual(size_t(128), map.BucketCount());
+			Assert::AreEqual(size_t(100), map.Size());
+			for (int i = 0; i < 100; ++i)
+			{
+				Assert::AreEqual(i, map.At(Foo(i)));
+			}
+
+			// Growth relinks nodes, so pairs keep their addresses
+			HashMap<Foo, int, FooHashFunction, FooCompareFunction> indexMap(1);
+			int& value = indexMap[Foo(0)];
+			for (int i = 1; i < 50; ++i)
+			{
+				indexMap[Foo(i)] = i;
+			}
+			Assert::AreEqual(&value, &indexMap[Foo(0)]);
+			Assert::AreEqual(size_t(64), indexMap.BucketCount());
+		}
+
+		TEST_METHOD(TestIncrementalRehash)
+		{
+			HashMap<Foo, int, FooHashFunction, FooCompareFunction> map(8);
+			map.SetRehashStep(1);
+			Assert::AreEqual(size_t(1), map.RehashStep());
+			for (int i = 0; i < 8; ++i)
+			{
+				map.Insert(std::make_pair(Foo(i), i));
+			}
+			Assert::IsFalse(map.IsRehashing());
+			int* address = &map.At(Foo(7));
+
+			// Growth only starts the rehash, pairs stay reachable while migrating
+			map.Insert(std::make_pair(Foo(8), 8));
+			Assert::IsTrue(map.IsRehashing());
+			Assert::AreEqual(size_t(16), map.BucketCount());
+			Assert::AreEqual(size_t(9), map.Size());
+			for (int i = 0; i < 9; ++i)
+			{
+				Assert::IsTrue(map.ContainsKey(Foo(i)));
+				Assert::AreEqual(i, map[Foo(i)]);
+			}
+
+			// Iteration covers both bucket lists
+			std::set<int> set;
+			for (const auto& pair : map)
+			{
+				set.insert(pair.second);
+			}
+			Assert::AreEqual(size_t(9), set.size());
+
+			// Remove pairs in either bucket list
+			map.Remove(Foo(8));
+			map.Remove(map.Find(Foo(0)));
+			Assert::AreEqual(size_t(7), map.Size());
+			Assert::IsFalse(map.ContainsKey(Foo(0)));
+			Assert::IsFalse(map.ContainsKey(Foo(8)));
+
+			// Each mutating operation migrates one bucket
+			for (int i = 10; map.IsRehashing(); ++i)
+			{
+				map.Insert(std::make_pair(Foo(i), i));
+			}
+			Assert::AreEqual(address, &map.At(Foo(7)));
+			for (int i = 1; i < 8; ++i)
+			{
+				Assert::AreEqual(i, map.At(Foo(i)));
+			}
+
+			// Copy and move preserve a rehash in progress
+			for (int i = 20; !map.IsRehashing(); ++i)
+			{
+				map.Insert(std::make_pair(Foo(i), i));
+			}
+			HashMap<Foo, int, FooHashFunction, FooCompareFunction> copy(map);
+			Assert::IsTrue(copy.IsRehashing());
+			Assert::AreEqual(map.Size(), copy.Size());
+			for (const auto& pair : map)
+			{
+				Assert::AreEqual(pair.second, copy.At(pair.first));
+			}
+			HashMap<Foo, int, FooHashFunction, FooCompareFunction> moved(std::move(copy));
+			Assert::IsTrue(moved.IsRehashing());
+			Assert::AreEqual(map.Size(), moved.Size());
+
+			// Setting step to 0 finishes the rehash
+			moved.SetRehashStep(0);
+			Assert::IsFalse(moved.IsRehashing());
+			Assert::AreEqual(map.Size(), moved.Size());
+			for (const auto& pair : map)
+			{
+				Assert::AreEqual(pair.second, moved.At(pair.first));
+			}
+
+			// Resize and clear finish or drop the rehash
+			map.Resize(3);
+			Assert::IsFalse(map.IsRehashing());
+			Assert::AreEqual(moved.Size(), map.Size());
+			map.Insert(std::make_pair(Foo(100), 100));
+			map.Clear();
+			Assert::IsFalse(map.IsRehashing());
+			Assert::AreEqual(map.end(), map.begin());
+
+			// Removing while iterating keeps other iterators valid during a rehash
+			HashMap<Foo, int, FooHashFunction, FooCompareFunction> erased(8);
+			erased.SetRehashStep(1);
+			for (int i = 0; i < 9; ++i)
+			{
+				erased.Insert(std::make_pair(Foo(i), i));
+			}
+			Assert::IsTrue(erased.IsRehashing());
+			for (auto it = erased.begin(); it != erased.end();)
+			{
+				auto next = it;
+				++next;
+				if (it->second % 2 == 0)
+				{
+					erased.Remove(it);
+				}
+				it = next;
+			}
+			Assert::IsTrue(erased.IsRehashing());
+			Assert::AreEqual(size_t(4), erased.Size());
+			for (int i = 0; i < 9; ++i)
+			{
+				Assert::AreEqual(i % 2 == 1, erased.ContainsKey(Foo(i)));
+			}
+		}
+
+		TEST_METHOD(TestHeterogeneousLookup)
+		{
+			HashMap<std::string, int> map = { { "Actions", 1 }, { "Entities", 2 } };
+			const std::string buffer = "EntitiesSectors";
+			const std::string_view entities(buffer.data(), 8);
+			const std::string_view sectors(buffer.data() + 8, 7);
+
+			Assert::AreEqual(2, map.Find(entities)->second);
+			Assert::AreEqual(1, map.Find("Actions")->second);
+			Assert::IsTrue(map.Find(sectors) == map.end());
+			Assert::IsTrue(map.ContainsKey(entities));
+			Assert::IsFalse(map.ContainsKey(sectors));
+
+			const HashMap<std::string, int>& constMap = map;
+			Assert::AreEqual(2, constMap.Find(entities)->second);
+			Assert::IsTrue(constMap.Find(sectors) == constMap.end());
+
+			// Iterator from a view can be used to modify and remove
+			map.Find(entities)->second = 20;
+			Assert::AreEqual(20, map.At("Entities"));
+			map.Remove(map.Find(entities));
+			Assert::IsFalse(map.ContainsKey("Entities"));
+			Assert::AreEqual(size_t(1), map.Size());
+		}
+
 	private:
 		static _CrtMemState sStartMemState;
 	};
@@ -630,6 +630,117 @@ namespace UnitTestLibraryDesktop
 			Assert::ExpectException<std::exception>(lamda);
 		}
 
+		TEST_METHOD(TestSpliceFront)
+		{
+			// Splice from empty list, both lists share one pool so nodes are relinked
+			SList<int> list(PoolAllocator::Create());
+			SList<int> other(list.GetAllocator());
+			Assert::IsTrue(list.GetAllocator() == other.GetAllocator());
+			Assert::ExpectException<std::exception>([&list, &other] { list.SpliceFront(other); });
+
+			// Splice to empty list
+			other.PushBack(1);
+			other.PushBack(2);
+			other.PushBack(3);
+			int* address = &other.Front();
+			auto it = list.SpliceFront(other);
+			Assert::AreEqual(1, *it);
+			Assert::AreEqual(address, &list.Front());
+			Assert::AreEqual(size_t(1), list.Size());
+			Assert::AreEqual(1, list.Back());
+			Assert::AreEqual(size_t(2), other.Size());
+			Assert::AreEqual(2, other.Front());
+
+			// Splice the last item
+			list.SpliceFront(other);
+			list.SpliceFront(other);
+			Assert::AreEqual(size_t(3), list.Size());
+			Assert::AreEqual(1, list.Front());
+			Assert::AreEqual(3, list.Back());
+			Assert::IsTrue(other.IsEmpty());
+			Assert::IsTrue(other.begin() == other.end());
+
+			// Both lists still work after splicing
+			other.PushBack(10);
+			list.PushBack(4);
+			Assert::AreEqual(10, other.Front());
+			Assert::AreEqual(10, other.Back());
+			Assert::AreEqual(size_t(4), list.Size());
+			Assert::AreEqual(4, list.Back());
+
+			// Lists with different pools copy the item instead
+			SList<int> third = { 5 };
+			Assert::IsTrue(list.GetAllocator() != third.GetAllocator());
+			address = &third.Front();
+			it = list.SpliceFront(third);
+			Assert::AreEqual(5, *it);
+			Assert::AreNotEqual(address, &list.Back());
+			Assert::AreEqual(size_t(5), list.Size());
+			Assert::IsTrue(third.IsEmpty());
+
+			// Heap allocators are always equal
+			SList<Foo, HeapAllocator> heapList;
+			SList<Foo, HeapAllocator> heapOther = { Foo(1), Foo(2) };
+			Foo* fooAddress = &heapOther.Front();
+			heapList.SpliceFront(heapOther);
+			Assert::AreEqual(fooAddress, &heapList.Front());
+			Assert::AreEqual(Foo(2), heapOther.Front());
+		}
+
+		TEST_METHOD(TestNodePool)
+		{
+			SList<Foo> list;
+			Assert::IsNull(list.GetAllocator().Pool());
+			for (int i = 0; i < 100; ++i)
+			{
+				list.PushBack(Foo(i));
+			}
+			const NodePool* pool = list.GetAllocator().Pool();
+			Assert::IsNotNull(pool);
+			Assert::AreEqual(size_t(100), pool->LiveCount());
+			const size_t slabCount = pool->SlabCount();
+			Assert::IsTrue(slabCount < size_t(10));
+
+			// Removed nodes are recycled instead of allocating new slabs
+			list.Clear();
+			Assert::AreEqual(size_t(0), pool->LiveCount());
+			for (int i = 0; i < 100; ++i)
+			{
+				list.PushFront(Foo(i));
+				list.PopBack();
+				list.PushBack(Foo(i));
+			}
+			Assert::AreEqual(size_t(100), list.Size());
+			Assert::AreEqual(slabCount, pool->SlabCount());
+
+			// Copies share the pool, copy assignment keeps its own
+			SList<Foo> copy(list);
+			Assert::IsTrue(copy.GetAllocator() == list.GetAllocator());
+			Assert::AreEqual(size_t(200), pool->LiveCount());
+			SList<Foo> assigned = { Foo(0) };
+			assigned = list;
+			Assert::IsTrue(assigned.GetAllocator() != list.GetAllocator());
+			Assert::AreEqual(size_t(200), pool->LiveCount());
+			Assert::AreEqual(size_t(100), assigned.GetAllocator().Pool()->LiveCount());
+
+			// Moved list takes the pool along with its nodes
+			SList<Foo> moved(std::move(copy));
+			Assert::IsTrue(moved.GetAllocator() == list.GetAllocator());
+			Assert::AreEqual(Foo(99), moved.Back());
+			assigned = std::move(moved);
+			Assert::IsTrue(assigned.GetAllocator() == list.GetAllocator());
+			Assert::AreEqual(size_t(200), pool->LiveCount());
+
+			// Pool rejects blocks larger than the ones it was created for
+			NodePool nodePool;
+			void* block = nodePool.Allocate(sizeof(int));
+			Assert::AreEqual(NodePool::Alignment, nodePool.BlockSize());
+			Assert::ExpectException<std::exception>([&nodePool] { nodePool.Allocate(NodePool::Alignment + 1); });
+			nodePool.Deallocate(block);
+			Assert::AreEqual(size_t(0), nodePool.LiveCount());
+			Assert::IsTrue(block == nodePool.Allocate(NodePool::Alignment));
+		}
+
 		TEST_METHOD(TestRemoveIterator)
 		{
 			SList<float> list = {0.0f, 1.0f, 2.0f, 3.0f, 4.0f};
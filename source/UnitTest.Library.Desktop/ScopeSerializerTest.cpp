@@ -0,0 +1,386 @@
+#include "pch.h"
+#include "CppUnitTest.h"
+#include "Factory.h"
+#include "Foo.h"
+#include "JsonParseMaster.h"
+#include "JsonTableParseHelper.h"
+#include "Scope.h"
+#include "ScopeSerializer.h"
+#include "ScopeSnapshot.h"
+#include "ScopeWriter.h"
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <sstream>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using namespace GameEngine;
+using namespace std;
+using namespace std::string_literals;
+using namespace glm;
+
+inline std::size_t operator "" _z(unsigned long long int x)
+{
+	return static_cast<size_t>(x);
+}
+
+namespace UnitTestLibraryDesktop
+{
+	/// <summary>
+	/// Scope subclass created by factory when reading
+	/// </summary>
+	class SerializedScope final : public Scope
+	{
+		RTTI_DECLARATIONS(SerializedScope, Scope);
+
+	public:
+		virtual gsl::owner<Scope*> Clone() const override
+		{
+			return new SerializedScope(*this);
+		}
+	};
+
+	RTTI_DEFINITIONS(SerializedScope);
+	DECLARE_FACTORY(SerializedScope, Scope);
+
+	TEST_CLASS(ScopeSerializerTest)
+	{
+	public:
+		TEST_METHOD_INITIALIZE(Initialize)
+		{
+#if defined(DEBUG) || defined(_DEBUG)
+			_CrtSetDbgFlag(_CRTDBG_ALLOC_MEM_DF);
+			_CrtMemCheckpoint(&sStartMemState);
+#endif
+		}
+
+		TEST_METHOD_CLEANUP(Cleanup)
+		{
+#if defined(DEBUG) || defined(_DEBUG)
+			_CrtMemState endMemState, diffMemState;
+			_CrtMemCheckpoint(&endMemState);
+			if (_CrtMemDifference(&diffMemState, &sStartMemState, &endMemState))
+			{
+				_CrtMemDumpStatistics(&diffMemState);
+				Assert::Fail(L"Memory Leaks!");
+			}
+#endif
+		}
+
+		TEST_METHOD(TestRoundTrip)
+		{
+			SerializedScopeFactory factory;
+			Scope scope;
+			FillScope(scope);
+			Foo foo;
+			scope["Pointer"] = &foo;
+
+			const string data = ScopeSerializer::Write(scope);
+			Scope copy;
+			ScopeSerializer::Read(data, copy);
+
+			// Pointers are skipped, everything else is the same
+			Assert::IsNull(copy.Find("Pointer"));
+			Scope expected;
+			FillScope(expected);
+			Assert::IsTrue(expected == copy);
+			Assert::AreEqual("Prefab"s, copy["Name"].AsString());
+			Assert::AreEqual(1000_z, copy["Positions"].Size());
+			Assert::IsTrue(vec4(999.f, 0.f, 0.f, 1.f) == copy["Positions"].AsVector(999));
+			Assert::IsTrue(copy["Children"].AsTable(0).Is(Scope::TypeIdClass()));
+			Assert::IsFalse(copy["Children"].AsTable(0).Is(SerializedScope::TypeIdClass()));
+			Scope& special = copy["Children"].AsTable(1);
+			Assert::IsTrue(special.Is(SerializedScope::TypeIdClass()));
+			Assert::IsTrue(special.GetParent() == &copy);
+			Assert::AreEqual(2_z, special["Grandchild"].AsTable()["Tags"].Size());
+
+			// Reading again overwrites values in place and reuses nested scopes
+			copy["Health"] = 1.f;
+			copy["Extra"] = 5;
+			ScopeSerializer::Read(data, copy);
+			Assert::AreEqual(10.5f, copy["Health"].AsFloat());
+			Assert::AreEqual(5, copy["Extra"].AsInt());
+			Assert::AreEqual(2_z, copy["Children"].Size());
+			Assert::AreSame(special, copy["Children"].AsTable(1));
+
+			// Values read over a hashed scope drop its cached hash
+			Scope hashed;
+			hashed["a"] = "old"s;
+			hashed["n"] = 1;
+			Scope source;
+			source["a"] = "new"s;
+			source["n"] = 2;
+			const size_t oldHash = hashed.Hash();
+			hashed.TrackChanges();
+			ScopeSerializer::Read(ScopeSerializer::Write(source), hashed);
+			Assert::AreNotEqual(oldHash, hashed.Hash());
+			Assert::AreEqual(source.Hash(), hashed.Hash());
+			Assert::IsTrue(source == hashed);
+
+			// And are tracked as changes
+			const Vector<string> paths = hashed.ChangedPaths();
+			Assert::AreEqual(2_z, paths.Size());
+			Assert::IsTrue(paths.Find("a"s) != paths.end());
+			Assert::IsTrue(paths.Find("n"s) != paths.end());
+
+			// Empty scope
+			Scope empty;
+			Scope emptyCopy;
+			ScopeSerializer::Read(ScopeSerializer::Write(empty), emptyCopy);
+			Assert::AreEqual(0_z, emptyCopy.Size());
+		}
+
+		TEST_METHOD(TestInvalidData)
+		{
+			Scope scope;
+			FillScope(scope);
+			const string data = ScopeSerializer::Write(scope);
+
+			// Every truncation is detected
+			for (size_t size = 0; size < data.size(); size += 7)
+			{
+				Scope target;
+				Assert::ExpectException<exception>([&data, &target, size] { ScopeSerializer::Read(string_view(data.data(), size), target); });
+			}
+
+			// Bad header and trailing bytes
+			string badMagic = data;
+			badMagic[0] = 'X';
+			string newer = data;
+			const uint32_t version = ScopeSerializer::Version + 1;
+			memcpy(newer.data() + sizeof(uint32_t), &version, sizeof(version));
+			string trailing = data + "!";
+			for (const string& bad : { badMagic, newer, trailing })
+			{
+				Scope target;
+				Assert::ExpectException<exception>([&bad, &target] { ScopeSerializer::Read(bad, target); });
+			}
+
+			// Type doesn't match an existing Datum
+			Scope mismatch;
+			mismatch["Health"] = 10;
+			Assert::ExpectException<exception>([&data, &mismatch] { ScopeSerializer::Read(data, mismatch); });
+
+			// Class without factory
+			Scope target;
+			Assert::ExpectException<exception>([&data, &target] { ScopeSerializer::Read(data, target); });
+			SerializedScopeFactory factory;
+			ScopeSerializer::Read(data, target);
+			Assert::IsTrue(scope == target);
+		}
+
+		TEST_METHOD(TestConvertJson)
+		{
+			const string jsonPath = "content/scopeJsonTest.json";
+			const string binaryPath = "content/scopeJsonTest.bin";
+			Assert::IsTrue(ScopeSerializer::ConvertJsonFile(jsonPath, binaryPath));
+
+			shared_ptr<Scope> json = make_shared<Scope>();
+			JsonTableParseHelper::SharedData data(json);
+			JsonParseMaster master(data);
+			JsonTableParseHelper helper;
+			master.AddHelper(helper);
+			Assert::IsTrue(master.ParseFromFile(jsonPath));
+			Scope binary;
+			ScopeSerializer::ReadFromFile(binaryPath, binary);
+			Assert::IsTrue(*json == binary);
+			Assert::AreEqual("Jack"s, binary["Name"].AsString());
+
+			// Compare load times of the same content
+			const size_t loadCount = 100;
+			auto start = chrono::high_resolution_clock::now();
+			for (size_t i = 0; i < loadCount; ++i)
+			{
+				json->Clear();
+				master.ParseFromFile(jsonPath);
+			}
+			auto jsonDuration = chrono::high_resolution_clock::now() - start;
+			start = chrono::high_resolution_clock::now();
+			for (size_t i = 0; i < loadCount; ++i)
+			{
+				Scope scope;
+				ScopeSerializer::ReadFromFile(binaryPath, scope);
+			}
+			auto binaryDuration = chrono::high_resolution_clock::now() - start;
+			Logger::WriteMessage(("JSON: " + to_string(chrono::duration_cast<chrono::microseconds>(jsonDuration).count() / loadCount)
+				+ "us, binary: " + to_string(chrono::duration_cast<chrono::microseconds>(binaryDuration).count() / loadCount) + "us per load\n").c_str());
+
+			remove(binaryPath.c_str());
+			Assert::ExpectException<exception>([&binaryPath, &binary] { ScopeSerializer::ReadFromFile(binaryPath, binary); });
+		}
+
+		TEST_METHOD(TestSnapshot)
+		{
+			const string path = "content/scopeSnapshotTest.bin";
+			Assert::ExpectException<exception>([&path] { ScopeSnapshot snapshot(path); });
+			SerializedScopeFactory factory;
+			Scope expected;
+			FillScope(expected);
+			ScopeSerializer::WriteToFile(expected, path);
+
+			{
+				ScopeSnapshot snapshot(path);
+				Scope scope;
+				snapshot.Read(scope);
+				Assert::IsTrue(expected == scope);
+
+				// Arrays point into the mapping, strings are copied
+				const Datum& positions = scope["Positions"];
+				const char* address = reinterpret_cast<const char*>(&positions.AsVector());
+				Assert::IsTrue(positions.IsShared());
+				Assert::IsTrue(address >= snapshot.Data() && address < snapshot.Data() + snapshot.Size());
+				Assert::AreEqual(0_z, reinterpret_cast<uintptr_t>(address) % alignof(vec4));
+				Assert::IsFalse(scope["Name"].IsShared());
+				const size_t sharedCount = snapshot.SharedCount();
+				Assert::AreEqual(6_z, sharedCount);
+
+				// Changing a Datum copies it out and leaves the mapping alone
+				scope["Positions"].Set(vec4(-1.f), 0);
+				Assert::IsFalse(scope["Positions"].IsShared());
+				Assert::AreEqual(sharedCount - 1, snapshot.SharedCount());
+				Assert::IsTrue(vec4(-1.f) == scope["Positions"].AsVector(0));
+				Scope other;
+				snapshot.Read(other);
+				Assert::IsTrue(expected == other);
+				Assert::AreEqual(2 * sharedCount - 1, snapshot.SharedCount());
+
+				// Copy on write copies share the mapping too, plain copies don't
+				Scope* shared = other.CloneShared();
+				Assert::AreEqual(3 * sharedCount - 1, snapshot.SharedCount());
+				delete shared;
+				Scope copy(other);
+				Assert::AreEqual(2 * sharedCount - 1, snapshot.SharedCount());
+				Assert::IsFalse(copy["Positions"].IsShared());
+
+				// Prescribed external storage is filled by copying
+				Scope prescribed;
+				float health = 0.f;
+				prescribed["Health"].SetStorage(&health, 1);
+				snapshot.Read(prescribed);
+				Assert::AreEqual(10.5f, health);
+				Assert::IsTrue(prescribed["Money"].IsShared());
+
+				prescribed.Clear();
+				other.Clear();
+				scope.Clear();
+				Assert::AreEqual(0_z, snapshot.SharedCount());
+			}
+
+			{
+				// Scopes may outlive the snapshot, the file stays mapped until they let go of it
+				Scope scope;
+				Scope* shared = nullptr;
+				{
+					ScopeSnapshot snapshot(path);
+					snapshot.Read(scope);
+					shared = scope.CloneShared();
+				}
+				Assert::IsTrue(expected == scope);
+				Assert::IsTrue(scope["Positions"].IsShared());
+				scope["Positions"].Set(vec4(-1.f), 0);
+				Assert::IsFalse(scope["Positions"].IsShared());
+				Assert::IsTrue(vec4(-1.f) == scope["Positions"].AsVector(0));
+				scope.Clear();
+				Assert::IsTrue(expected == *shared);
+				Assert::IsTrue((*shared)["Positions"].IsShared());
+				delete shared;
+			}
+
+			remove(path.c_str());
+		}
+
+		TEST_METHOD(TestWriter)
+		{
+			SerializedScopeFactory factory;
+			Scope scope;
+			FillScope(scope);
+			scope["Quote"] = "say \"hi\"\n\t\\"s;
+			Foo foo;
+			scope["Pointer"] = &foo;
+
+			// JSON is read back by the table parser, a small buffer is flushed many times
+			ostringstream json;
+			ScopeWriter(json, ScopeWriter::Format::Json, 256).Write(scope);
+			shared_ptr<Scope> parsed = make_shared<Scope>();
+			JsonTableParseHelper::SharedData data(parsed);
+			JsonParseMaster master(data);
+			JsonTableParseHelper helper;
+			master.AddHelper(helper);
+			Assert::IsTrue(master.Parse(json.str()));
+			Assert::IsNull(parsed->Find("Pointer"));
+			Scope expected;
+			FillScope(expected);
+			expected["Quote"] = scope["Quote"];
+			Assert::IsTrue(expected == *parsed);
+			Assert::IsTrue((*parsed)["Children"].AsTable(1).Is(SerializedScope::TypeIdClass()));
+
+			// Text is the same as ToString
+			ostringstream text;
+			ScopeWriter(text, ScopeWriter::Format::Text, 256).Write(scope);
+			Assert::AreEqual(scope.ToString(), text.str());
+			Assert::AreEqual(0_z, text.str().find("{\n\"Health\": [10.500000],\n\"Money\": [100, 200, 300],\n"));
+
+			// Dump a large world to a file
+			const string path = "content/scopeWriterTest.json";
+			Scope world;
+			for (size_t i = 0; i < 10000; ++i)
+			{
+				FillEntity(world.AppendScope("Entities"), i);
+			}
+			auto start = chrono::high_resolution_clock::now();
+			ScopeWriter::WriteToFile(world, path);
+			auto duration = chrono::high_resolution_clock::now() - start;
+			Logger::WriteMessage(("Write " + to_string(world["Entities"].Size()) + " entities: "
+				+ to_string(chrono::duration_cast<chrono::milliseconds>(duration).count()) + "ms\n").c_str());
+			parsed->Clear();
+			Assert::IsTrue(master.ParseFromFile(path));
+			Assert::IsTrue(world == *parsed);
+			remove(path.c_str());
+		}
+
+	private:
+		/// <summary>
+		/// Fill a scope with every type that can be saved, arrays and nested scopes
+		/// </summary>
+		static void FillScope(Scope& scope)
+		{
+			scope["Health"] = 10.5f;
+			scope["Money"] = Datum({ 100, 200, 300 });
+			scope["Name"] = "Prefab"s;
+			scope["Transform"] = mat4(2.f);
+			Datum& positions = scope["Positions"];
+			positions.SetType(Datum::DatumType::Vector);
+			positions.SetSize(1000);
+			for (size_t i = 0; i < positions.Size(); ++i)
+			{
+				positions.Set(vec4(static_cast<float>(i), 0.f, 0.f, 1.f), i);
+			}
+			scope["Empty"].SetType(Datum::DatumType::Float);
+
+			Scope& child = scope.AppendScope("Children");
+			child["Id"] = 1;
+			Scope* special = new SerializedScope();
+			scope.Adopt(*special, "Children");
+			(*special)["Id"] = 2;
+			Scope& grandchild = special->AppendScope("Grandchild");
+			grandchild["Tags"] = Datum({ "Hero"s, ""s });
+		}
+
+		/// <summary>
+		/// Fill a scope like a typical game object
+		/// </summary>
+		static void FillEntity(Scope& entity, size_t index)
+		{
+			entity["Name"] = "Entity" + to_string(index);
+			entity["Health"] = static_cast<float>(index) / 3.f;
+			entity["Level"] = static_cast<int>(index % 100);
+			entity["Position"] = vec4(static_cast<float>(index), 0.5f, -2.f, 1.f);
+			entity["Transform"] = mat4(1.f);
+			entity.AppendScope("Components")["Speed"] = 1.25f;
+		}
+
+		static _CrtMemState sStartMemState;
+	};
+
+	_CrtMemState ScopeSerializerTest::sStartMemState;
+}
@@ -2,12 +2,15 @@
 #include "CppUnitTest.h"
 #include "Foo.h"
 #include "Scope.h"
+#include "ScopePath.h"
+#include <chrono>
 #include <string>
 
 using namespace Microsoft::VisualStudio::CppUnitTestFramework;
 using namespace GameEngine;
 using namespace std;
 using namespace std::string_literals;
+using namespace std::string_view_literals;
 using namespace glm;
 
 namespace Microsoft::VisualStudio::CppUnitTestFramework
@@ -240,6 +243,80 @@ namespace UnitTestLibraryDesktop
 			Assert::AreEqual(vec4(1.f), scope[key3].AsTable()[0].AsVector());
 		}
 
+		TEST_METHOD(TestArena)
+		{
+			// Freed small blocks are reused, large blocks are tracked separately
+			{
+				Arena arena(4096);
+				void* a = arena.Allocate(24);
+				void* b = arena.Allocate(24);
+				Assert::AreEqual(0_z, reinterpret_cast<uintptr_t>(a) % Arena::Alignment);
+				Assert::AreEqual(64_z, arena.LiveBytes());
+				arena.Deallocate(a, 24);
+				Assert::IsTrue(arena.Allocate(20) == a);
+				void* large = arena.Allocate(Arena::MaxSmallSize * 4);
+				Assert::AreEqual(1_z, arena.ChunkCount());
+				arena.Deallocate(large, Arena::MaxSmallSize * 4);
+				arena.Deallocate(b, 24);
+				arena.Deallocate(a, 20);
+				Assert::AreEqual(0_z, arena.LiveBytes());
+				Assert::IsNull(Arena::Current());
+
+				// Releasing frees every chunk, the arena starts over
+				arena.Allocate(24);
+				arena.Release();
+				Assert::AreEqual(0_z, arena.ChunkCount());
+				Assert::AreEqual(0_z, arena.LiveBytes());
+				arena.Allocate(24);
+				Assert::AreEqual(1_z, arena.ChunkCount());
+			}
+
+			// A tree under an arena root allocates nested scopes and Datum storage from it
+			{
+				Scope root;
+				Arena& arena = root.CreateArena();
+				Assert::IsTrue(root.GetArena() == &arena);
+				Assert::ExpectException<std::exception>([&root] { root.CreateArena(); });
+				FillScope(root);
+				Check(root);
+				Scope& child1 = root[key3].AsTable();
+				Assert::IsTrue(child1.GetArena() == &arena);
+				Assert::IsTrue(child1[key3].AsTable().GetArena() == &arena);
+				Assert::ExpectException<std::exception>([&child1] { child1.CreateArena(); });
+				const size_t liveBytes = arena.LiveBytes();
+				Assert::IsTrue(liveBytes > 0);
+				for (int32_t i = 12; i < 18; ++i)
+				{
+					root[key1].PushBack(i);
+				}
+				Assert::IsTrue(arena.LiveBytes() > liveBytes);
+
+				// Copies and deletes go back to the arena they came from
+				Scope copy(root);
+				Check(copy);
+				Assert::IsTrue(copy.GetArena() == nullptr);
+				delete &child1;
+				Assert::IsTrue(arena.LiveBytes() < liveBytes);
+
+				// Scopes created under a guard come from the arena
+				Scope* adopted;
+				{
+					ArenaGuard guard(&arena);
+					Assert::IsTrue(Arena::Current() == &arena);
+					adopted = new Scope();
+				}
+				Assert::IsNull(Arena::Current());
+				Assert::IsTrue(adopted->GetArena() == &arena);
+				root.Adopt(*adopted, key3);
+				Assert::ExpectException<std::exception>([this, &copy, &root] { copy.Adopt(root[key3].AsTable(1), key3); });
+
+				// Moving the root takes the arena along
+				Scope moved(std::move(root));
+				Assert::IsTrue(moved.GetArena() == &arena);
+				Assert::IsTrue(moved[key3].AsTable(1).GetParent() == &moved);
+			}
+		}
+
 		TEST_METHOD(TestEuqalityOperator)
 		{
 			{
@@ -581,6 +658,117 @@ namespace UnitTestLibraryDesktop
 			}
 		}
 
+		TEST_METHOD(TestStringViewLookup)
+		{
+			Scope root;
+			FillScope(root);
+			Scope& child1 = root[key3].AsTable();
+			child1.Append("Name"sv).first = "Dummy";
+
+			// Views don't need to be null-terminated
+			const string path = "/c[Dummy]/c[0]/a/b";
+			const string_view view = string_view(path).substr(0, path.size() - 2);
+			Assert::AreEqual(mat4(2.f), child1.Search(view).first->AsMatrix());
+			Assert::IsTrue(root.Find(string_view(path).substr(1, 1)) == &root[key3]);
+			Assert::IsTrue(root.Find("cc"sv.substr(0, 1)) == &root[key3]);
+			Assert::IsTrue(root.Find("d"sv) == nullptr);
+			Assert::AreEqual(10, root.Find("a")->AsInt());
+
+			const Scope& constRoot = root;
+			Assert::AreEqual("abc"s, constRoot["b"sv].AsString());
+			Assert::AreEqual("abc"s, constRoot.Find("b"sv)->AsString());
+			Assert::AreEqual("abc"s, constRoot.Search("b"sv).first->AsString());
+			Assert::ExpectException<std::exception>([&constRoot] { constRoot["d"sv]; });
+
+			// Append only copies the key for a new entry
+			auto [datum, inserted] = root.Append("a"sv);
+			Assert::IsFalse(inserted);
+			Assert::AreEqual(10, datum.AsInt());
+			root["d"sv] = 5;
+			Assert::AreEqual(4_z, root.Size());
+			Assert::AreEqual(5, root["d"].AsInt());
+			Assert::ExpectException<std::exception>([&root] { root.Append(""sv); });
+
+			// Datum lookups take views as well
+			Assert::AreEqual(1_z, child1.Search("../b"sv).first->Size());
+			Datum strings = { "x"s, "y"s, "z"s };
+			Assert::IsTrue(strings.Find("y"sv) != strings.end());
+			Assert::IsTrue(strings.Find("w"sv) == strings.end());
+			Assert::IsTrue(strings.Remove("x"sv));
+			Assert::AreEqual(2_z, strings.Size());
+		}
+
+		TEST_METHOD(TestScopePath)
+		{
+			Scope root;
+			FillScope(root);
+			Scope& child1 = root[key3].AsTable();
+			Scope& child2 = root[key3].AsTable(1);
+			Scope& child3 = child1[key3].AsTable();
+			child1.Append("Name").first = "Dummy";
+			child2.Append("Name").first = "Genius";
+
+			// Compiled paths resolve the same as searching with the text
+			const string paths[] = { key1, key2, key3, "bb"s, "./a"s, "../b"s, "../../c[1]/c"s, "/c[0]/c[0]/a"s, "/c[Dummy]/c[0]/../../c[Genius]/c"s,
+				"/c[2]/a"s, "/c[-1]/a"s, "/c[Nobody]/a"s, "/../a"s, "/c[0]//b/"s, "./"s };
+			Scope* starts[] = { &root, &child1, &child2, &child3 };
+			for (const string& text : paths)
+			{
+				const ScopePath path(text);
+				for (Scope* start : starts)
+				{
+					Assert::IsTrue(start->Search(text) == path.Resolve(*start));
+					const Scope& constStart = *start;
+					Assert::IsTrue(constStart.Search(text) == path.Resolve(constStart));
+				}
+			}
+
+			// Cached result is reused until the structure changes
+			ScopePath cached("../../c[1]/c"s, true);
+			Assert::IsTrue(cached.IsCached());
+			Assert::AreEqual("../../c[1]/c"s, cached.Text());
+			Assert::AreEqual(vec4(1.f), cached.Resolve(child3).first->AsVector());
+			Assert::IsTrue(cached.Resolve(child3).second == &child2);
+			Assert::IsTrue(cached.Resolve(child1).first == nullptr);
+			delete &child2;
+			Assert::IsTrue(cached.Resolve(child3).first == nullptr);
+			Scope& newChild = root.AppendScope(key3);
+			Assert::IsTrue(cached.Resolve(child3).first == nullptr);
+			newChild[key3] = vec4(3.f);
+			Assert::AreEqual(vec4(3.f), cached.Resolve(child3).first->AsVector());
+
+			// Changing the table Datum directly is a structure change too
+			Datum& table = root[key3];
+			table.Set(child1, 1);
+			Assert::IsTrue(cached.Resolve(child3).first == &child1[key3]);
+			table.Set(newChild, 1);
+			Assert::AreEqual(vec4(3.f), cached.Resolve(child3).first->AsVector());
+			table.RemoveAt(1);
+			Assert::IsTrue(cached.Resolve(child3).first == nullptr);
+			delete &newChild;
+
+			// Each tree has its own epoch, changes in another tree don't drop cached results
+			const uint64_t epoch = root.StructureEpoch();
+			Assert::AreEqual(epoch, child3.StructureEpoch());
+			{
+				Scope other;
+				FillScope(other);
+				Assert::AreNotEqual(epoch, other.StructureEpoch());
+			}
+			Assert::AreEqual(epoch, root.StructureEpoch());
+			root.Append(key1);
+			Assert::AreEqual(epoch, root.StructureEpoch());
+			root.Append("New"s);
+			Assert::AreNotEqual(epoch, root.StructureEpoch());
+
+			// Name selectors depend on values, never cached
+			ScopePath named("/c[Dummy]/a"s, true);
+			Assert::IsFalse(named.IsCached());
+			Assert::AreEqual(10.f, named.Resolve(root).first->AsFloat());
+			child1["Name"] = "Smart";
+			Assert::IsTrue(named.Resolve(root).first == nullptr);
+		}
+
 		TEST_METHOD(TestFindScope)
 		{
 			Scope scope;
@@ -626,6 +814,338 @@ namespace UnitTestLibraryDesktop
 			}
 		}
 
+		TEST_METHOD(TestOrphanStress)
+		{
+			// Shape of a sector: thousands of entities, destroyed in a different order than they were created
+			const size_t entityCount = 10000;
+			Scope sector;
+			sector.Append(key1).first = 10;
+			sector.AppendScope(key2);
+			Vector<Scope*> entities;
+			for (size_t i = 0; i < entityCount; ++i)
+			{
+				Scope& entity = sector.AppendScope(key3);
+				entity[key1] = static_cast<int>(i);
+				entities.PushBack(&entity);
+			}
+
+			// Destroy every odd entity from the back, then every even one from the front, which always shifts the remaining ones
+			auto start = std::chrono::high_resolution_clock::now();
+			for (size_t i = entityCount - 1; i < entityCount; i -= 2)
+			{
+				delete entities[i];
+			}
+			Assert::AreEqual(entityCount / 2, sector[key3].Size());
+			for (size_t i = 0; i < sector[key3].Size(); ++i)
+			{
+				Scope& entity = sector[key3].AsTable(i);
+				Assert::AreEqual(static_cast<int>(2 * i), entity[key1].AsInt());
+				auto [key, datum] = sector.FindScope(&entity);
+				Assert::AreEqual(key3, key);
+				Assert::AreSame(sector[key3], *datum);
+			}
+			for (size_t i = 0; i < entityCount; i += 2)
+			{
+				delete entities[i];
+			}
+			auto duration = std::chrono::high_resolution_clock::now() - start;
+			Logger::WriteMessage(("Destroyed " + std::to_string(entityCount) + " nested scopes in "
+				+ std::to_string(std::chrono::duration_cast<std::chrono::microseconds>(duration).count()) + "us\n").c_str());
+			Assert::AreEqual(0_z, sector[key3].Size());
+			Assert::AreEqual(0_z, sector[key2].AsTable().Size());
+
+			// Changing the Datum directly leaves stale back references, which are still handled
+			Scope& child1 = sector.AppendScope(key3);
+			Scope& child2 = sector.AppendScope(key3);
+			Scope& child3 = sector.AppendScope(key3);
+			sector[key3].RemoveAt(0);
+			sector.Orphan(child3);
+			Assert::IsTrue(child3.GetParent() == nullptr);
+			Assert::AreEqual(1_z, sector[key3].Size());
+			Assert::AreSame(child2, sector[key3].AsTable());
+			Assert::AreSame(sector[key3], *sector.FindScope(&child2).second);
+			sector.Orphan(child1);
+			Assert::AreEqual(1_z, sector[key3].Size());
+			delete &child1;
+			delete &child3;
+
+			// Many scopes of different parents and Datums leave at once, even with stale back references or without a parent
+			Scope other;
+			Scope& a = sector.AppendScope(key2);
+			Scope& b = sector.AppendScope(key3);
+			Scope& c = other.AppendScope(key1);
+			Scope& d = other.AppendScope(key1);
+			Scope* loose = new Scope();
+			other[key1].Set(d, 0);
+			other[key1].Set(c, 1);
+			Scope::OrphanAll({ &d, &b, loose, &a });
+			Assert::IsTrue(a.GetParent() == nullptr && b.GetParent() == nullptr && d.GetParent() == nullptr);
+			Assert::AreEqual(1_z, sector[key2].Size());
+			Assert::AreEqual(1_z, sector[key3].Size());
+			Assert::AreSame(child2, sector[key3].AsTable());
+			Assert::AreEqual(1_z, other[key1].Size());
+			Assert::AreSame(c, other[key1].AsTable());
+			Assert::AreSame(other[key1], *other.FindScope(&c).second);
+			delete &a;
+			delete &b;
+			delete &d;
+			delete loose;
+
+			// Taking all children out at once stays linear, where orphaning them front first would shift every remaining sibling each time
+			auto destroyAll = [this](size_t count)
+			{
+				Scope parent;
+				Vector<Scope*> children(count);
+				for (size_t i = 0; i < count; ++i)
+				{
+					children.PushBack(&parent.AppendScope(key3));
+				}
+				auto start = std::chrono::high_resolution_clock::now();
+				Scope::OrphanAll(children);
+				for (Scope* child : children)
+				{
+					delete child;
+				}
+				auto duration = std::chrono::high_resolution_clock::now() - start;
+				Assert::AreEqual(0_z, parent[key3].Size());
+				return duration;
+			};
+			auto fewest = destroyAll(entityCount);
+			auto most = destroyAll(entityCount * 8);
+			for (size_t i = 0; i < 2; ++i)
+			{
+				fewest = std::min(fewest, destroyAll(entityCount));
+				most = std::min(most, destroyAll(entityCount * 8));
+			}
+			Logger::WriteMessage(("Destroyed " + std::to_string(entityCount) + " and " + std::to_string(entityCount * 8) + " nested scopes at once in "
+				+ std::to_string(std::chrono::duration_cast<std::chrono::microseconds>(fewest).count()) + "us and "
+				+ std::to_string(std::chrono::duration_cast<std::chrono::microseconds>(most).count()) + "us\n").c_str());
+			Assert::IsTrue(most < fewest * 24);  // 8 times when linear, 64 times when quadratic
+		}
+
+		TEST_METHOD(TestCloneShared)
+		{
+			// A prefab with a few large attributes and a nested scope, spawned many times
+			Scope prefab;
+			prefab[key1].SetType(Datum::DatumType::Float);
+			prefab[key1].SetSize(1000);
+			prefab[key2] = "Prefab"s;
+			Scope& child = prefab.AppendScope(key3);
+			child[key1].SetType(Datum::DatumType::Vector);
+			child[key1].SetSize(1000);
+			child[key1].Set(vec4(1.f), 999);
+
+			const size_t spawnCount = 100;
+			Vector<Scope*> spawned;
+			for (size_t i = 0; i < spawnCount; ++i)
+			{
+				spawned.PushBack(prefab.CloneShared());
+			}
+			Assert::IsTrue(prefab[key1].IsShared());
+			Assert::IsTrue(child[key1].IsShared());
+
+			const Scope& first = *spawned[0];
+			Assert::IsTrue(prefab == first);
+			Assert::AreNotSame(child, first[key3].AsTable());
+			Assert::IsTrue(first[key3].AsTable().GetParent() == &first);
+			Assert::IsTrue(vec4(1.f) == first[key3].AsTable()[key1].AsVector(999));
+
+			// Only modified attributes get their own copy
+			Scope& second = *spawned[1];
+			second[key3].AsTable()[key1].Set(vec4(2.f), 0);
+			Assert::IsFalse(second[key3].AsTable()[key1].IsShared());
+			Assert::IsTrue(static_cast<const Scope&>(second)[key1].IsShared());
+			Assert::IsTrue(vec4(0.f) == static_cast<const Scope&>(child)[key1].AsVector(0));
+			Assert::IsFalse(prefab == second);
+
+			for (Scope* scope : spawned)
+			{
+				delete scope;
+			}
+			Assert::IsFalse(prefab[key1].IsShared());
+			Assert::IsFalse(child[key1].IsShared());
+
+			// Regular clones still copy everything
+			Scope* clone = prefab.Clone();
+			Assert::IsFalse(static_cast<const Scope&>(*clone)[key1].IsShared());
+			delete clone;
+		}
+
+		TEST_METHOD(TestHash)
+		{
+			// Same content in different order hashes the same
+			Scope first;
+			first["Name"] = "Prefab"s;
+			first["Health"] = 100;
+			first.AppendScope("Children")["Position"] = vec4(1.f);
+			Scope second;
+			second.AppendScope("Children")["Position"] = vec4(1.f);
+			second["Health"] = 100;
+			second["Name"] = "Prefab"s;
+			Assert::AreEqual(first.Hash(), second.Hash());
+			Assert::IsTrue(first == second);
+
+			// Any change below changes the hash, changing it back restores it
+			const size_t hash = first.Hash();
+			Scope& child = first["Children"].AsTable();
+			child["Position"] = vec4(2.f);
+			Assert::AreNotEqual(hash, first.Hash());
+			Assert::IsFalse(first == second);
+			child["Position"] = vec4(1.f);
+			Assert::AreEqual(hash, first.Hash());
+			child["Extra"];
+			Assert::AreNotEqual(hash, first.Hash());
+			second["Children"].AsTable()["Extra"];
+			Assert::AreEqual(first.Hash(), second.Hash());
+			second["Children"].AsTable().AppendScope("Grandchild");
+			Assert::AreNotEqual(first.Hash(), second.Hash());
+			child.AppendScope("Grandchild");
+			Assert::AreEqual(first.Hash(), second.Hash());
+
+			// Writes through references are seen, since non-const access drops the cached hash
+			first["Health"].AsInt() = 50;
+			Assert::AreNotEqual(second.Hash(), first.Hash());
+			first["Health"].AsInt() = 100;
+			Assert::AreEqual(second.Hash(), first.Hash());
+
+			// Copies carry the hash over
+			Scope copy(first);
+			Assert::AreEqual(first.Hash(), copy.Hash());
+			Assert::IsTrue(first == copy);
+			Scope moved(std::move(copy));
+			Assert::AreEqual(first.Hash(), moved.Hash());
+
+			// External storage is hashed again every time
+			int32_t value = 1;
+			first["External"].SetStorage(&value, 1);
+			const size_t external = first.Hash();
+			value = 2;
+			Assert::AreNotEqual(external, first.Hash());
+			Assert::AreEqual(Datum(2).Hash(), static_cast<const Scope&>(first)["External"].Hash());
+
+			// Pointers only count, since what they point to can change
+			Foo foo(1);
+			Foo other(2);
+			Assert::AreEqual(Datum(&foo).Hash(), Datum(&other).Hash());
+
+			// Cached hashes make comparing big different trees cheap
+			Scope world;
+			for (size_t i = 0; i < 1000; ++i)
+			{
+				Scope& entity = world.AppendScope("Entities");
+				entity["Position"] = vec4(static_cast<float>(i));
+				entity["Name"] = "Entity"s;
+			}
+			Scope changed(world);
+			changed["Entities"].AsTable(999)["Name"] = "Changed"s;
+			auto start = std::chrono::high_resolution_clock::now();
+			world.Hash();
+			changed.Hash();
+			auto hashDuration = std::chrono::high_resolution_clock::now() - start;
+			start = std::chrono::high_resolution_clock::now();
+			Assert::IsFalse(world == changed);
+			auto compareDuration = std::chrono::high_resolution_clock::now() - start;
+			Logger::WriteMessage(("Hashed 2 trees in " + std::to_string(std::chrono::duration_cast<std::chrono::microseconds>(hashDuration).count())
+				+ "us, compared in " + std::to_string(std::chrono::duration_cast<std::chrono::microseconds>(compareDuration).count()) + "us\n").c_str());
+		}
+
+		TEST_METHOD(TestChangeTracking)
+		{
+			Scope world;
+			world["Name"] = "World"s;
+			Scope& sector = world.AppendScope("Sectors");
+			Scope& entity = sector.AppendScope("Entities");
+			entity["Health"] = 100;
+			entity["Position"] = vec4(0.f);
+			Scope& other = sector.AppendScope("Entities");
+			other["Health"] = 50;
+
+			// Nothing is tracked until asked
+			Assert::IsFalse(world.IsChanged());
+			world.TrackChanges();
+			Assert::IsTrue(other.IsTrackingChanges());
+			Assert::IsFalse(world.IsChanged());
+			Assert::AreEqual(0_z, world.ChangedPaths().Size());
+
+			// A change flags the Datum and every scope above it, but not siblings
+			other["Health"].Set(40);
+			Assert::IsTrue(other["Health"].IsChanged());
+			Assert::IsTrue(other.IsChanged());
+			Assert::IsTrue(sector.IsChanged());
+			Assert::IsTrue(world.IsChanged());
+			Assert::IsFalse(entity.IsChanged());
+			Vector<string> paths = world.ChangedPaths();
+			Assert::AreEqual(1_z, paths.Size());
+			Assert::AreEqual("Sectors[0]/Entities[1]/Health"s, paths[0]);
+			Assert::IsTrue(world.Search(paths[0]).first == &other["Health"]);
+
+			// Appended entries, new nested scopes and writes through references
+			entity["Tag"] = "Hero"s;
+			sector.AppendScope("Entities")["Health"] = 1;
+			entity["Position"].AsVector() = vec4(1.f);
+			entity["Position"].MarkChanged();
+			world["Name"].PushBack("Extra"s);
+			paths = world.ChangedPaths();
+			Assert::AreEqual(6_z, paths.Size());
+			Assert::AreEqual("Name"s, paths[0]);
+			Assert::AreEqual("Sectors[0]/Entities"s, paths[1]);
+			Assert::AreEqual("Sectors[0]/Entities[0]/Position"s, paths[2]);
+			Assert::AreEqual("Sectors[0]/Entities[0]/Tag"s, paths[3]);
+			Assert::AreEqual("Sectors[0]/Entities[1]/Health"s, paths[4]);
+			Assert::AreEqual("Sectors[0]/Entities[2]/Health"s, paths[5]);
+
+			// Clearing a subtree leaves scopes above changed
+			sector.ClearChanges();
+			Assert::IsFalse(sector.IsChanged());
+			Assert::IsFalse(other["Health"].IsChanged());
+			Assert::AreEqual(1_z, world.ChangedPaths().Size());
+			world.ClearChanges();
+			Assert::IsFalse(world.IsChanged());
+
+			// Removing nested scopes changes the table Datum holding them
+			delete &sector["Entities"].AsTable(2);
+			Assert::AreEqual("Sectors[0]/Entities"s, world.ChangedPaths()[0]);
+			world.ClearChanges();
+			entity.Clear();
+			Assert::AreEqual(1_z, world.ChangedPaths().Size());
+			Assert::AreEqual("Sectors[0]/Entities"s, world.ChangedPaths()[0]);
+			world.ClearChanges();
+
+			// Adopted scopes are tracked, copies aren't
+			Scope* adopted = new Scope();
+			(*adopted)["Health"] = 10;
+			sector.Adopt(*adopted, "Entities");
+			Assert::IsTrue(adopted->IsTrackingChanges());
+			world.ClearChanges();
+			(*adopted)["Health"] = 20;
+			Assert::AreEqual("Sectors[0]/Entities[2]/Health"s, world.ChangedPaths()[0]);
+			Scope copy(world);
+			Assert::IsFalse(copy.IsTrackingChanges());
+			copy["Name"] = "Copy"s;
+			Assert::IsFalse(copy.IsChanged());
+
+			// Assigning to a tracked scope changes everything in it
+			world.ClearChanges();
+			other = copy["Sectors"].AsTable()["Entities"].AsTable(1);
+			Assert::IsTrue(other["Health"].IsChanged());
+			Assert::IsTrue(world.IsChanged());
+
+			// Moved scopes keep tracking
+			Scope moved(std::move(world));
+			Assert::IsTrue(moved.IsTrackingChanges());
+			moved.ClearChanges();
+			moved["Name"] = "Moved"s;
+			Assert::IsTrue(moved.IsChanged());
+			Assert::AreEqual("Name"s, moved.ChangedPaths()[0]);
+
+			// Stopping clears everything
+			moved.TrackChanges(false);
+			Assert::IsFalse(moved.IsChanged());
+			moved["Name"] = "Untracked"s;
+			Assert::IsFalse(moved["Name"].IsChanged());
+			Assert::IsFalse(moved.IsChanged());
+		}
+
 		TEST_METHOD(TestClear)
 		{
 			Scope scope;
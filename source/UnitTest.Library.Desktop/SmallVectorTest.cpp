@@ -0,0 +1,240 @@
+#include "pch.h"
+#include "CppUnitTest.h"
+#include "Foo.h"
+#include "SmallVector.h"
+#include <chrono>
+#include <functional>
+#include <string>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using namespace GameEngine;
+
+namespace UnitTestLibraryDesktop
+{
+	TEST_CLASS(SmallVectorTest)
+	{
+	public:
+
+		TEST_METHOD_INITIALIZE(Initialize)
+		{
+#if defined(DEBUG) || defined(_DEBUG)
+			_CrtSetDbgFlag(_CRTDBG_ALLOC_MEM_DF);
+			_CrtMemCheckpoint(&sStartMemState);
+#endif
+		}
+
+		TEST_METHOD_CLEANUP(Cleanup)
+		{
+#if defined(DEBUG) || defined(_DEBUG)
+			_CrtMemState endMemState, diffMemState;
+			_CrtMemCheckpoint(&endMemState);
+			if (_CrtMemDifference(&diffMemState, &sStartMemState, &endMemState))
+			{
+				_CrtMemDumpStatistics(&diffMemState);
+				Assert::Fail(L"Memory Leaks!");
+			}
+#endif
+		}
+
+		TEST_METHOD(TestInlineStorage)
+		{
+			SmallVector<Foo, 4> vector;
+			Assert::IsTrue(vector.IsEmpty());
+			Assert::IsTrue(vector.IsInline());
+			Assert::AreEqual(size_t(4), vector.Capacity());
+			auto function = [&vector]
+			{
+				vector.Front();
+			};
+			Assert::ExpectException<std::exception>(function);
+
+			for (int i = 0; i < 4; ++i)
+			{
+				vector.PushBack(Foo(i));
+				Assert::IsTrue(vector.IsInline());
+				Assert::AreEqual(size_t(4), vector.Capacity());
+			}
+			Assert::AreEqual(Foo(0), vector.Front());
+			Assert::AreEqual(Foo(3), vector.Back());
+
+			// Spill to heap and keep the items
+			vector.EmplaceBack(4);
+			Assert::IsFalse(vector.IsInline());
+			Assert::AreEqual(size_t(8), vector.Capacity());
+			for (int i = 0; i < 5; ++i)
+			{
+				Assert::AreEqual(Foo(i), vector[i]);
+			}
+			auto outOfRange = [&vector]
+			{
+				vector[5];
+			};
+			Assert::ExpectException<std::exception>(outOfRange);
+
+			// Move back to inline storage once items fit
+			vector.PopBack();
+			vector.PopBack();
+			vector.ShrinkToFit();
+			Assert::IsTrue(vector.IsInline());
+			Assert::AreEqual(size_t(4), vector.Capacity());
+			Assert::AreEqual(size_t(3), vector.Size());
+			Assert::AreEqual(Foo(2), vector.Back());
+
+			vector.Reserve(100);
+			Assert::IsFalse(vector.IsInline());
+			Assert::AreEqual(size_t(100), vector.Capacity());
+			vector.Destroy();
+			Assert::IsTrue(vector.IsInline());
+			Assert::IsTrue(vector.IsEmpty());
+			Assert::AreEqual(size_t(4), vector.Capacity());
+		}
+
+		TEST_METHOD(TestCopyAndMove)
+		{
+			SmallVector<Foo, 2> inlineVector = { Foo(0), Foo(1) };
+			SmallVector<Foo, 2> heapVector = { Foo(0), Foo(1), Foo(2) };
+			Assert::IsTrue(inlineVector.IsInline());
+			Assert::IsFalse(heapVector.IsInline());
+
+			// Copy
+			SmallVector<Foo, 2> copy(heapVector);
+			Assert::AreEqual(size_t(3), copy.Size());
+			Assert::AreEqual(Foo(2), copy[2]);
+			copy = inlineVector;
+			Assert::AreEqual(size_t(2), copy.Size());
+			Assert::AreEqual(Foo(1), copy.Back());
+			copy = copy;
+			Assert::AreEqual(size_t(2), copy.Size());
+
+			// Move inline items one by one
+			SmallVector<Foo, 2> movedInline(std::move(inlineVector));
+			Assert::IsTrue(movedInline.IsInline());
+			Assert::AreEqual(size_t(2), movedInline.Size());
+			Assert::AreEqual(Foo(1), movedInline[1]);
+			Assert::IsTrue(inlineVector.IsEmpty());
+
+			// Move heap items by stealing the pointer
+			SmallVector<Foo, 2> movedHeap;
+			movedHeap = std::move(heapVector);
+			Assert::IsFalse(movedHeap.IsInline());
+			Assert::AreEqual(size_t(3), movedHeap.Size());
+			Assert::AreEqual(Foo(2), movedHeap[2]);
+			Assert::IsTrue(heapVector.IsEmpty());
+			Assert::IsTrue(heapVector.IsInline());
+			Assert::AreEqual(size_t(2), heapVector.Capacity());
+
+			movedHeap = std::move(movedInline);
+			Assert::IsTrue(movedHeap.IsInline());
+			Assert::AreEqual(size_t(2), movedHeap.Size());
+			Assert::AreEqual(Foo(0), movedHeap.Front());
+		}
+
+		TEST_METHOD(TestFindRemove)
+		{
+			SmallVector<Foo, 4> vector = { Foo(0), Foo(1), Foo(2), Foo(3), Foo(4), Foo(5) };
+			Assert::AreEqual(Foo(3), *vector.Find(Foo(3)));
+			Assert::IsTrue(vector.Find(Foo(100)) == vector.end());
+
+			const SmallVector<Foo, 4>& constVector = vector;
+			Assert::AreEqual(Foo(3), *constVector.Find(Foo(3)));
+			Assert::IsTrue(constVector.Find(Foo(100)) == constVector.cend());
+
+			vector.Remove(Foo(100));
+			Assert::AreEqual(size_t(6), vector.Size());
+			vector.Remove(Foo(0));
+			vector.Remove(vector.Find(Foo(3)));
+			Assert::AreEqual(size_t(4), vector.Size());
+			Assert::AreEqual(Foo(1), vector[0]);
+			Assert::AreEqual(Foo(2), vector[1]);
+			Assert::AreEqual(Foo(4), vector[2]);
+			Assert::AreEqual(Foo(5), vector[3]);
+
+			vector.Remove(vector.begin() + 3, vector.begin() + 1);
+			Assert::AreEqual(size_t(2), vector.Size());
+			Assert::AreEqual(Foo(5), vector.Back());
+
+			SmallVector<Foo, 4> other;
+			auto function = [&vector, &other]
+			{
+				vector.Remove(other.begin(), vector.end());
+			};
+			Assert::ExpectException<std::exception>(function);
+
+			int expected = 0;
+			SmallVector<int, 4> numbers = { 0, 1, 2, 3, 4 };
+			for (int number : numbers)
+			{
+				Assert::AreEqual(expected++, number);
+			}
+			Assert::AreEqual(5, expected);
+		}
+
+		TEST_METHOD(TestAllocationBenchmark)
+		{
+			// Shape of a spawned entity: a couple of children and one transform callback
+			const int nodeCount = 10000;
+			struct VectorNode
+			{
+				Vector<VectorNode*> mChildren;
+				Vector<std::function<void()>> mCallbacks;
+			};
+			struct SmallVectorNode
+			{
+				SmallVector<SmallVectorNode*, 4> mChildren;
+				SmallVector<std::function<void()>, 2> mCallbacks;
+			};
+
+			auto measure = [nodeCount](auto* nodes, size_t& allocations)
+			{
+				auto start = std::chrono::high_resolution_clock::now();
+#if defined(DEBUG) || defined(_DEBUG)
+				_CrtMemState before, after, difference;
+				_CrtMemCheckpoint(&before);
+#endif
+				for (int i = 0; i < nodeCount; ++i)
+				{
+					nodes[i].mChildren.PushBack(&nodes[(i + 1) % nodeCount]);
+					nodes[i].mChildren.PushBack(&nodes[(i + 2) % nodeCount]);
+					nodes[i].mCallbacks.EmplaceBack([] {});
+				}
+#if defined(DEBUG) || defined(_DEBUG)
+				_CrtMemCheckpoint(&after);
+				_CrtMemDifference(&difference, &before, &after);
+				allocations = difference.lCounts[_NORMAL_BLOCK];
+#else
+				allocations = 0;
+#endif
+				for (int i = 0; i < nodeCount; ++i)
+				{
+					nodes[i].mChildren.Destroy();
+					nodes[i].mCallbacks.Destroy();
+				}
+				auto duration = std::chrono::high_resolution_clock::now() - start;
+				return std::chrono::duration_cast<std::chrono::microseconds>(duration).count();
+			};
+
+			size_t vectorAllocations = 0;
+			size_t smallVectorAllocations = 0;
+			auto vectorNodes = std::make_unique<VectorNode[]>(nodeCount);
+			auto smallVectorNodes = std::make_unique<SmallVectorNode[]>(nodeCount);
+			const long long vectorTime = measure(vectorNodes.get(), vectorAllocations);
+			const long long smallVectorTime = measure(smallVectorNodes.get(), smallVectorAllocations);
+			Logger::WriteMessage(("Vector: " + std::to_string(vectorAllocations) + " allocations " + std::to_string(vectorTime) + "us, SmallVector: "
+				+ std::to_string(smallVectorAllocations) + " allocations " + std::to_string(smallVectorTime) + "us\n").c_str());
+
+#if defined(DEBUG) || defined(_DEBUG)
+			Assert::AreEqual(size_t(2 * nodeCount), vectorAllocations);
+			Assert::AreEqual(size_t(0), smallVectorAllocations);
+#endif
+			for (int i = 0; i < nodeCount; ++i)
+			{
+				Assert::IsTrue(smallVectorNodes[i].mChildren.IsInline());
+			}
+		}
+
+	private:
+		static _CrtMemState sStartMemState;
+	};
+
+	_CrtMemState SmallVectorTest::sStartMemState;
+}
@@ -2,6 +2,10 @@
 #include "CppUnitTest.h"
 #include "Foo.h"
 #include "vector.h"
+#include <algorithm>
+#include <chrono>
+#include <execution>
+#include <string>
 
 using namespace Microsoft::VisualStudio::CppUnitTestFramework;
 using namespace GameEngine;
@@ -82,11 +86,7 @@ namespace UnitTestLibraryDesktop
 					return capacity + 1;
 				}
 			};
-			auto func = [](size_t, size_t capacity)
-			{
-				return capacity + 1;
-			};
-			Vector<Foo> vector2(0, Test());
+			Vector<Foo, Test> vector2(0);
 			Assert::AreEqual(size_t(0), vector2.Capacity());
 			vector2.PushBack(Foo(0));
 			Assert::AreEqual(size_t(1), vector2.Capacity());
@@ -112,11 +112,14 @@ namespace UnitTestLibraryDesktop
 			}
 
 			{
-				auto func = [](size_t, size_t capacity)
+				struct Test
 				{
-					return capacity + 100;
+					size_t operator()(size_t, size_t capacity) const
+					{
+						return capacity + 100;
+					}
 				};
-				Vector<Foo> vector(1, func);
+				Vector<Foo, Test> vector(1);
 				Assert::AreEqual(size_t(0), vector.Size());
 				Assert::AreEqual(size_t(1), vector.Capacity());
 				vector.PushBack(Foo(0));
@@ -128,11 +131,14 @@ namespace UnitTestLibraryDesktop
 
 		TEST_METHOD(TestInitializerConstructor)
 		{
-			auto func = [](size_t, size_t capacity)
+			struct Test
 			{
-				return capacity + 100;
+				size_t operator()(size_t, size_t capacity) const
+				{
+					return capacity + 100;
+				}
 			};
-			Vector<Foo> vector({Foo(0), Foo(1), Foo(2), Foo(3), Foo(4)}, func);
+			Vector<Foo, Test> vector({Foo(0), Foo(1), Foo(2), Foo(3), Foo(4)});
 			Assert::AreEqual(size_t(5), vector.Size());
 			Assert::AreEqual(size_t(5), vector.Capacity());
 			Assert::AreEqual(Foo(0), vector.Front());
@@ -149,12 +155,15 @@ namespace UnitTestLibraryDesktop
 
 		TEST_METHOD(TestCopyConstructor)
 		{
-			auto func = [](size_t, size_t capacity)
+			struct Test
 			{
-				return capacity + 100;
+				size_t operator()(size_t, size_t capacity) const
+				{
+					return capacity + 100;
+				}
 			};
-			Vector<Foo> vector({ Foo(0), Foo(1), Foo(2), Foo(3), Foo(4) }, func);
-			Vector<Foo> vector2(vector);
+			Vector<Foo, Test> vector({ Foo(0), Foo(1), Foo(2), Foo(3), Foo(4) });
+			Vector<Foo, Test> vector2(vector);
 			vector.Destroy();
 
 			Assert::AreEqual(size_t(5), vector2.Size());
@@ -170,19 +179,22 @@ namespace UnitTestLibraryDesktop
 			Assert::AreEqual(size_t(6), vector2.Size());
 			Assert::AreEqual(size_t(105), vector2.Capacity());
 
-			Vector<Foo> vector3(vector);
+			Vector<Foo, Test> vector3(vector);
 			Assert::AreEqual(size_t(0), vector3.Size());
 			Assert::AreEqual(size_t(0), vector3.Capacity());
 		}
 
 		TEST_METHOD(TestMoveContstructor)
 		{
-			auto func = [](size_t, size_t capacity)
+			struct Test
 			{
-				return capacity + 100;
+				size_t operator()(size_t, size_t capacity) const
+				{
+					return capacity + 100;
+				}
 			};
-			Vector<Foo> vector({ Foo(0), Foo(1), Foo(2), Foo(3), Foo(4) }, func);
-			Vector<Foo> vector2 = std::move(vector);
+			Vector<Foo, Test> vector({ Foo(0), Foo(1), Foo(2), Foo(3), Foo(4) });
+			Vector<Foo, Test> vector2 = std::move(vector);
 			Assert::IsTrue(vector.IsEmpty());
 			vector.Destroy();
 
@@ -199,7 +211,7 @@ namespace UnitTestLibraryDesktop
 			Assert::AreEqual(size_t(6), vector2.Size());
 			Assert::AreEqual(size_t(105), vector2.Capacity());
 
-			Vector<Foo> vector3 = std::move(vector);
+			Vector<Foo, Test> vector3 = std::move(vector);
 			Assert::AreEqual(size_t(0), vector3.Size());
 			Assert::AreEqual(size_t(0), vector3.Capacity());
 		}
@@ -207,11 +219,14 @@ namespace UnitTestLibraryDesktop
 		TEST_METHOD(TestCopyAssignment)
 		{
 			// Self copy
-			auto func = [](size_t, size_t capacity)
+			struct Test
 			{
-				return capacity + 1;
+				size_t operator()(size_t, size_t capacity) const
+				{
+					return capacity + 1;
+				}
 			};
-			Vector<Foo> vector({ Foo(0), Foo(1), Foo(2), Foo(3), Foo(4), Foo(5) }, func);
+			Vector<Foo, Test> vector({ Foo(0), Foo(1), Foo(2), Foo(3), Foo(4), Foo(5) });
 			Assert::AreEqual(size_t(6), vector.Size());
 			Assert::AreEqual(size_t(6), vector.Capacity());
 			Assert::AreEqual(Foo(0), vector.Front());
@@ -221,7 +236,7 @@ namespace UnitTestLibraryDesktop
 			Assert::AreEqual(Foo(0), vector.Front());
 
 			// Real copy
-			Vector<Foo> vector2 = { Foo(100) };
+			Vector<Foo, Test> vector2 = { Foo(100) };
 			Assert::AreEqual(size_t(1), vector2.Size());
 			Assert::AreEqual(Foo(100), vector2.Front());
 			Assert::AreEqual(Foo(100), vector2.Back());
@@ -240,11 +255,14 @@ namespace UnitTestLibraryDesktop
 		TEST_METHOD(TestMoveAssignment)
 		{
 			// Self move
-			auto func = [](size_t, size_t capacity)
+			struct Test
 			{
-				return capacity + 1;
+				size_t operator()(size_t, size_t capacity) const
+				{
+					return capacity + 1;
+				}
 			};
-			Vector<Foo> vector({ Foo(0), Foo(1), Foo(2), Foo(3), Foo(4), Foo(5) }, func);
+			Vector<Foo, Test> vector({ Foo(0), Foo(1), Foo(2), Foo(3), Foo(4), Foo(5) });
 			Assert::AreEqual(size_t(6), vector.Size());
 			Assert::AreEqual(size_t(6), vector.Capacity());
 			Assert::AreEqual(Foo(0), vector.Front());
@@ -254,7 +272,7 @@ namespace UnitTestLibraryDesktop
 			Assert::AreEqual(Foo(0), vector.Front());
 
 			// Real move
-			Vector<Foo> vector2 = { Foo(100) };
+			Vector<Foo, Test> vector2 = { Foo(100) };
 			Assert::AreEqual(size_t(1), vector2.Size());
 			Assert::AreEqual(Foo(100), vector2.Front());
 			Assert::AreEqual(Foo(100), vector2.Back());
@@ -1139,6 +1157,209 @@ namespace UnitTestLibraryDesktop
 			}
 		}
 
+		TEST_METHOD(TestRelocation)
+		{
+			// Reserve strategy is part of the type and takes no storage
+			Assert::AreEqual(sizeof(int*) + 2 * sizeof(size_t), sizeof(Vector<int>));
+			Assert::IsTrue(IsTriviallyRelocatable<int>::value);
+			Assert::IsTrue(IsTriviallyRelocatable<Foo*>::value);
+			Assert::IsTrue(IsTriviallyRelocatable<std::shared_ptr<Foo>>::value);
+			Assert::IsTrue(IsTriviallyRelocatable<Vector<Foo>>::value);
+			Assert::IsFalse(IsTriviallyRelocatable<Foo>::value);
+			Assert::IsFalse(IsTriviallyRelocatable<std::string>::value);
+
+			// Trivially relocatable items survive growth, removal and shrinking
+			{
+				Vector<std::shared_ptr<Foo>> vector;
+				for (int i = 0; i < 100; ++i)
+				{
+					vector.PushBack(std::make_shared<Foo>(i));
+				}
+				Assert::AreEqual(size_t(128), vector.Capacity());
+				vector.Remove(vector.begin() + 10, vector.begin() + 20);
+				vector.ShrinkToFit();
+				Assert::AreEqual(size_t(90), vector.Capacity());
+				for (size_t i = 0; i < vector.Size(); ++i)
+				{
+					Assert::AreEqual(1L, vector[i].use_count());
+					Assert::AreEqual(Foo(static_cast<int>(i < 10 ? i : i + 10)), *vector[i]);
+				}
+			}
+
+			// Items that point to themselves are move-constructed into new memory rather than copied byte by byte
+			struct SelfReference
+			{
+				SelfReference(int data) : mData(data) {}
+				SelfReference(const SelfReference& other) : mData(other.mData) {}
+				const SelfReference* mSelf = this;
+				int mData;
+			};
+			Assert::IsFalse(IsTriviallyRelocatable<SelfReference>::value);
+
+			Vector<SelfReference> vector;
+			for (int i = 0; i < 100; ++i)
+			{
+				vector.EmplaceBack(i);
+			}
+			vector.Remove(vector.begin() + 10, vector.begin() + 20);
+			vector.ShrinkToFit();
+			vector.Resize(200, SelfReference(-1));
+			for (size_t i = 0; i < vector.Size(); ++i)
+			{
+				Assert::IsTrue(&vector[i] == vector[i].mSelf);
+				Assert::AreEqual(i < 90 ? static_cast<int>(i < 10 ? i : i + 10) : -1, vector[i].mData);
+			}
+		}
+
+		TEST_METHOD(TestRandomAccessIterator)
+		{
+			static_assert(std::is_same_v<std::iterator_traits<Vector<Foo>::Iterator>::iterator_category, std::random_access_iterator_tag>);
+			static_assert(std::is_same_v<std::iterator_traits<Vector<Foo>::ConstIterator>::reference, const Foo&>);
+
+			Vector<Foo> vector = { Foo(0), Foo(1), Foo(2), Foo(3), Foo(4) };
+			const Vector<Foo>& constVector = vector;
+			Assert::IsTrue(vector.Data() == &vector[0]);
+			Assert::IsTrue(constVector.Data() == &constVector[0]);
+			Assert::IsTrue(Vector<Foo>().Data() == nullptr);
+
+			// Arithmetic
+			auto it = vector.end();
+			--it;
+			Assert::AreEqual(Foo(4), *it);
+			Assert::AreEqual(Foo(4), *it--);
+			Assert::AreEqual(Foo(3), *it);
+			it -= 2;
+			Assert::AreEqual(Foo(1), *it);
+			it += 1;
+			Assert::AreEqual(Foo(2), *it);
+			Assert::AreEqual(Foo(0), *(it - 2));
+			Assert::AreEqual(Foo(4), *(2 + it));
+			Assert::AreEqual(Foo(1), it[-1]);
+			Assert::AreEqual(3, it->Data() + 1);
+			Assert::AreEqual(std::ptrdiff_t(5), vector.end() - vector.begin());
+			Assert::AreEqual(std::ptrdiff_t(-2), it - vector.end() + 1);
+
+			// Moves are clamped to the range of vector
+			Assert::AreEqual(vector.begin(), it - 100);
+			Assert::AreEqual(vector.end(), it + 100);
+			Assert::AreEqual(vector.begin(), --vector.begin());
+
+			// Comparison
+			Assert::IsTrue(vector.begin() < it);
+			Assert::IsTrue(vector.end() > it);
+			Assert::IsTrue(it <= it);
+			Assert::IsTrue(it >= it);
+			Assert::IsFalse(it < it);
+			Vector<Foo> other = { Foo(0) };
+			Assert::ExpectException<std::exception>([&vector, &other] { vector.begin() < other.begin(); });
+			Assert::ExpectException<std::exception>([&vector, &other] { vector.end() - other.begin(); });
+			Assert::ExpectException<std::exception>([] { --Vector<Foo>::Iterator(); });
+
+			// Const iterator
+			auto cit = constVector.end() - 1;
+			Assert::AreEqual(Foo(4), *cit);
+			Assert::AreEqual(Foo(3), *--cit);
+			Assert::AreEqual(Foo(1), cit[-2]);
+			Assert::AreEqual(4, cit->Data() + 1);
+			Assert::AreEqual(std::ptrdiff_t(3), cit - constVector.begin());
+			Assert::IsTrue(constVector.cbegin() < cit);
+			Assert::ExpectException<std::exception>([&constVector] { constVector.cend()[0]; });
+
+			// Standard algorithms that need random access
+			std::reverse(vector.begin(), vector.end());
+			Assert::AreEqual(Foo(4), vector.Front());
+			std::sort(vector.begin(), vector.end(), [](const Foo& lhs, const Foo& rhs) { return lhs.Data() < rhs.Data(); });
+			for (int i = 0; i < 5; ++i)
+			{
+				Assert::AreEqual(Foo(i), vector[i]);
+			}
+			Assert::IsTrue(std::binary_search(constVector.begin(), constVector.end(), Foo(3), [](const Foo& lhs, const Foo& rhs) { return lhs.Data() < rhs.Data(); }));
+
+			Vector<int> numbers;
+			for (int i = 0; i < 1000; ++i)
+			{
+				numbers.PushBack((i * 7919) % 1000);
+			}
+			std::sort(std::execution::par_unseq, numbers.begin(), numbers.end());
+			std::transform(std::execution::par_unseq, numbers.begin(), numbers.end(), numbers.begin(), [](int number) { return number * 2; });
+			for (int i = 0; i < 1000; ++i)
+			{
+				Assert::AreEqual(i * 2, numbers[i]);
+			}
+		}
+
+		TEST_METHOD(TestAlgorithmBenchmark)
+		{
+			// Forward-only view over Vector, the iterator category before random access was supported
+			struct ForwardIterator
+			{
+				using value_type = int;
+				using pointer = int*;
+				using reference = int&;
+				using difference_type = std::ptrdiff_t;
+				using iterator_category = std::forward_iterator_tag;
+
+				int& operator*() const { return *mIterator; }
+				ForwardIterator& operator++() { ++mIterator; return *this; }
+				ForwardIterator operator++(int) { ForwardIterator copy = *this; ++mIterator; return copy; }
+				bool operator==(const ForwardIterator& other) const { return mIterator == other.mIterator; }
+				bool operator!=(const ForwardIterator& other) const { return mIterator != other.mIterator; }
+
+				Vector<int>::Iterator mIterator;
+			};
+
+			const int count = 200000;
+			Vector<int> source;
+			source.Reserve(count);
+			unsigned int seed = 12345;
+			for (int i = 0; i < count; ++i)
+			{
+				seed = seed * 1103515245 + 12345;
+				source.PushBack(static_cast<int>(seed >> 8) % count);
+			}
+
+			auto measure = [](auto function)
+			{
+				auto start = std::chrono::high_resolution_clock::now();
+				function();
+				auto duration = std::chrono::high_resolution_clock::now() - start;
+				return std::chrono::duration_cast<std::chrono::microseconds>(duration).count();
+			};
+			auto isEven = [](int number) { return number % 2 == 0; };
+
+			// Partition, the algorithm used by EventQueue::Update
+			Vector<int> forwardPartition = source;
+			Vector<int> randomPartition = source;
+			Vector<int> parallelPartition = source;
+			const long long forwardPartitionTime = measure([&] { std::partition(ForwardIterator{ forwardPartition.begin() }, ForwardIterator{ forwardPartition.end() }, isEven); });
+			const long long randomPartitionTime = measure([&] { std::partition(randomPartition.begin(), randomPartition.end(), isEven); });
+			const long long parallelPartitionTime = measure([&] { std::partition(std::execution::par_unseq, parallelPartition.begin(), parallelPartition.end(), isEven); });
+			Assert::IsTrue(std::is_partitioned(forwardPartition.begin(), forwardPartition.end(), isEven));
+			Assert::IsTrue(std::is_partitioned(randomPartition.begin(), randomPartition.end(), isEven));
+			Assert::IsTrue(std::is_partitioned(parallelPartition.begin(), parallelPartition.end(), isEven));
+
+			// Sort, which needs random access
+			Vector<int> sorted = source;
+			Vector<int> parallelSorted = source;
+			const long long sortTime = measure([&] { std::sort(sorted.begin(), sorted.end()); });
+			const long long parallelSortTime = measure([&] { std::sort(std::execution::par_unseq, parallelSorted.begin(), parallelSorted.end()); });
+			Assert::IsTrue(std::is_sorted(sorted.begin(), sorted.end()));
+			Assert::IsTrue(std::equal(sorted.begin(), sorted.end(), parallelSorted.begin()));
+
+			// Transform over iterators and over raw data
+			Vector<int> forwardTransformed = source;
+			Vector<int> transformed = source;
+			auto scale = [](int number) { return number * 3 + 1; };
+			const long long forwardTransformTime = measure([&] { std::transform(ForwardIterator{ forwardTransformed.begin() }, ForwardIterator{ forwardTransformed.end() }, ForwardIterator{ forwardTransformed.begin() }, scale); });
+			const long long dataTransformTime = measure([&] { std::transform(std::execution::par_unseq, transformed.Data(), transformed.Data() + transformed.Size(), transformed.Data(), scale); });
+			Assert::IsTrue(std::equal(forwardTransformed.begin(), forwardTransformed.end(), transformed.begin()));
+
+			Logger::WriteMessage(("Partition forward " + std::to_string(forwardPartitionTime) + "us, random access " + std::to_string(randomPartitionTime)
+				+ "us, par_unseq " + std::to_string(parallelPartitionTime) + "us\n").c_str());
+			Logger::WriteMessage(("Sort " + std::to_string(sortTime) + "us, par_unseq " + std::to_string(parallelSortTime) + "us\n").c_str());
+			Logger::WriteMessage(("Transform forward " + std::to_string(forwardTransformTime) + "us, par_unseq over Data() " + std::to_string(dataTransformTime) + "us\n").c_str());
+		}
+
 	private:
 		static _CrtMemState sStartMemState;
 	};